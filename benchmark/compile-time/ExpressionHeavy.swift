@@ -0,0 +1,107 @@
+//===--- ExpressionHeavy.swift --------------------------------------------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2021 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+// Compile-time benchmark: expression-dense code that stresses the constraint
+// solver. The expressions are representative of ordinary application code
+// (moderately sized literal expressions, operator chains, closures with
+// inferred parameter and result types), deliberately avoiding the known
+// exponential corner cases covered by validation-test/compiler_scale.
+
+struct Vector2 {
+  var x: Double
+  var y: Double
+
+  static func + (lhs: Vector2, rhs: Vector2) -> Vector2 {
+    return Vector2(x: lhs.x + rhs.x, y: lhs.y + rhs.y)
+  }
+  static func - (lhs: Vector2, rhs: Vector2) -> Vector2 {
+    return Vector2(x: lhs.x - rhs.x, y: lhs.y - rhs.y)
+  }
+  static func * (lhs: Vector2, rhs: Double) -> Vector2 {
+    return Vector2(x: lhs.x * rhs, y: lhs.y * rhs)
+  }
+}
+
+func interpolate(_ a: Vector2, _ b: Vector2, by t: Double) -> Vector2 {
+  return a + (b - a) * t
+}
+
+func polynomialTable() -> [Double] {
+  let coefficients = [1.0, 0.5, 0.25, 0.125, 0.0625, 0.03125]
+  return (0..<64).map { i -> Double in
+    let x = Double(i) / 64.0
+    return coefficients[0]
+      + coefficients[1] * x
+      + coefficients[2] * x * x
+      + coefficients[3] * x * x * x
+      + coefficients[4] * x * x * x * x
+      + coefficients[5] * x * x * x * x * x
+  }
+}
+
+func statistics(of samples: [Double]) -> (mean: Double, variance: Double) {
+  let mean = samples.reduce(0, +) / Double(samples.count)
+  let variance = samples
+    .map { ($0 - mean) * ($0 - mean) }
+    .reduce(0, +) / Double(samples.count - 1)
+  return (mean, variance)
+}
+
+func histogram(of samples: [Double], bins: Int) -> [Int] {
+  guard let lo = samples.min(), let hi = samples.max(), hi > lo else {
+    return [samples.count]
+  }
+  let width = (hi - lo) / Double(bins)
+  return samples.reduce(into: Array(repeating: 0, count: bins)) {
+    counts, sample in
+    let bin = min(bins - 1, Int((sample - lo) / width))
+    counts[bin] += 1
+  }
+}
+
+func formatReport(label: String, samples: [Double]) -> String {
+  let (mean, variance) = statistics(of: samples)
+  let counts = histogram(of: samples, bins: 10)
+  let bars = counts.map { String(repeating: "#", count: $0) }
+  return """
+    \(label): n=\(samples.count) mean=\(mean) sd=\(variance.squareRoot())
+    \(bars.enumerated().map { "\($0.offset): \($0.element)" }
+          .joined(separator: "\n"))
+    """
+}
+
+func routeLength(through points: [Vector2]) -> Double {
+  return zip(points, points.dropFirst())
+    .map { a, b in ((b.x - a.x) * (b.x - a.x) + (b.y - a.y) * (b.y - a.y)) }
+    .map { $0.squareRoot() }
+    .reduce(0, +)
+}
+
+func scheduleFees(balances: [String: Double]) -> [String: Double] {
+  let tiers: [(threshold: Double, rate: Double)] = [
+    (0, 0.0125), (1_000, 0.0100), (10_000, 0.0075), (100_000, 0.0050),
+  ]
+  return balances.mapValues { balance in
+    let rate = tiers.last { balance >= $0.threshold }?.rate ?? 0.0150
+    return (balance * rate).rounded() / 100 + (balance > 50_000 ? 25 : 0)
+  }
+}
+
+func summarize(route: [Vector2], balances: [String: Double]) -> String {
+  let length = routeLength(through: route)
+  let fees = scheduleFees(balances: balances)
+  let total = fees.values.reduce(0, +)
+  let top = fees.sorted { $0.value > $1.value }.prefix(3)
+    .map { "\($0.key)=\($0.value)" }
+    .joined(separator: ", ")
+  return "length: \(length), total fees: \(total) (top: \(top.isEmpty ? "none" : top))"
+}
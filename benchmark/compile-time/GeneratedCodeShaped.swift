@@ -0,0 +1,159 @@
+//===--- GeneratedCodeShaped.swift ----------------------------------------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2021 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+// Compile-time benchmark: flat, repetitive model code of the shape emitted by
+// schema-driven code generators — many similar declarations with synthesized
+// Codable/Equatable/Hashable conformances and CodingKeys enums. This stresses
+// conformance synthesis and the sheer volume of declaration checking rather
+// than any single hard construct.
+
+public struct APIUserV1: Codable, Equatable, Hashable {
+  public let userId: Int
+  public let displayName: String
+  public let emailAddress: String
+  public let isActive: Bool
+  public let signupTimestamp: Double
+
+  enum CodingKeys: String, CodingKey {
+    case userId = "user_id"
+    case displayName = "display_name"
+    case emailAddress = "email_address"
+    case isActive = "is_active"
+    case signupTimestamp = "signup_timestamp"
+  }
+}
+
+public struct APIGroupV1: Codable, Equatable, Hashable {
+  public let groupId: Int
+  public let groupName: String
+  public let ownerUserId: Int
+  public let memberCount: Int
+  public let isArchived: Bool
+
+  enum CodingKeys: String, CodingKey {
+    case groupId = "group_id"
+    case groupName = "group_name"
+    case ownerUserId = "owner_user_id"
+    case memberCount = "member_count"
+    case isArchived = "is_archived"
+  }
+}
+
+public struct APIDocumentV1: Codable, Equatable, Hashable {
+  public let documentId: Int
+  public let title: String
+  public let authorUserId: Int
+  public let groupId: Int?
+  public let revision: Int
+  public let sizeInBytes: Int
+
+  enum CodingKeys: String, CodingKey {
+    case documentId = "document_id"
+    case title
+    case authorUserId = "author_user_id"
+    case groupId = "group_id"
+    case revision
+    case sizeInBytes = "size_in_bytes"
+  }
+}
+
+public struct APICommentV1: Codable, Equatable, Hashable {
+  public let commentId: Int
+  public let documentId: Int
+  public let authorUserId: Int
+  public let body: String
+  public let postedTimestamp: Double
+  public let editedTimestamp: Double?
+
+  enum CodingKeys: String, CodingKey {
+    case commentId = "comment_id"
+    case documentId = "document_id"
+    case authorUserId = "author_user_id"
+    case body
+    case postedTimestamp = "posted_timestamp"
+    case editedTimestamp = "edited_timestamp"
+  }
+}
+
+public struct APIPermissionV1: Codable, Equatable, Hashable {
+  public let permissionId: Int
+  public let documentId: Int
+  public let userId: Int
+  public let canRead: Bool
+  public let canWrite: Bool
+  public let canShare: Bool
+
+  enum CodingKeys: String, CodingKey {
+    case permissionId = "permission_id"
+    case documentId = "document_id"
+    case userId = "user_id"
+    case canRead = "can_read"
+    case canWrite = "can_write"
+    case canShare = "can_share"
+  }
+}
+
+public struct APIAuditEventV1: Codable, Equatable, Hashable {
+  public let eventId: Int
+  public let actorUserId: Int
+  public let eventKind: String
+  public let subjectDocumentId: Int?
+  public let subjectGroupId: Int?
+  public let eventTimestamp: Double
+
+  enum CodingKeys: String, CodingKey {
+    case eventId = "event_id"
+    case actorUserId = "actor_user_id"
+    case eventKind = "event_kind"
+    case subjectDocumentId = "subject_document_id"
+    case subjectGroupId = "subject_group_id"
+    case eventTimestamp = "event_timestamp"
+  }
+}
+
+public struct APIBatchResponseV1: Codable, Equatable {
+  public let users: [APIUserV1]
+  public let groups: [APIGroupV1]
+  public let documents: [APIDocumentV1]
+  public let comments: [APICommentV1]
+  public let permissions: [APIPermissionV1]
+  public let auditEvents: [APIAuditEventV1]
+  public let nextPageToken: String?
+
+  enum CodingKeys: String, CodingKey {
+    case users
+    case groups
+    case documents
+    case comments
+    case permissions
+    case auditEvents = "audit_events"
+    case nextPageToken = "next_page_token"
+  }
+}
+
+public func validate(_ response: APIBatchResponseV1) -> [String] {
+  var problems: [String] = []
+  let userIds = Set(response.users.map { $0.userId })
+  for group in response.groups where !userIds.contains(group.ownerUserId) {
+    problems.append("group \(group.groupId) has unknown owner")
+  }
+  let documentIds = Set(response.documents.map { $0.documentId })
+  for comment in response.comments
+      where !documentIds.contains(comment.documentId) {
+    problems.append("comment \(comment.commentId) has unknown document")
+  }
+  for permission in response.permissions
+      where !documentIds.contains(permission.documentId) {
+    problems.append("permission \(permission.permissionId) has unknown document")
+  }
+  return problems
+}
@@ -0,0 +1,126 @@
+//===--- ProtocolHeavy.swift ----------------------------------------------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2021 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+// Compile-time benchmark: protocol hierarchies, associated types, conditional
+// conformances and constrained generic algorithms, stressing requirement
+// checking, associated type inference and witness resolution.
+
+protocol Identified {
+  associatedtype ID: Hashable
+  var id: ID { get }
+}
+
+protocol Timestamped {
+  var createdAt: Double { get }
+  var modifiedAt: Double { get }
+}
+
+protocol Record: Identified, Timestamped {
+  associatedtype Payload
+  var payload: Payload { get }
+}
+
+protocol Store {
+  associatedtype Element: Identified
+  mutating func insert(_ element: Element)
+  func lookup(_ id: Element.ID) -> Element?
+  var count: Int { get }
+}
+
+protocol SnapshottingStore: Store {
+  associatedtype Snapshot: Collection where Snapshot.Element == Element
+  func snapshot() -> Snapshot
+}
+
+struct MemoryStore<Element: Identified>: Store {
+  private var elements: [Element.ID: Element] = [:]
+
+  mutating func insert(_ element: Element) {
+    elements[element.id] = element
+  }
+  func lookup(_ id: Element.ID) -> Element? {
+    return elements[id]
+  }
+  var count: Int { return elements.count }
+}
+
+extension MemoryStore: SnapshottingStore {
+  func snapshot() -> [Element] {
+    return Array(elements.values)
+  }
+}
+
+struct Note: Record {
+  let id: Int
+  let createdAt: Double
+  let modifiedAt: Double
+  let payload: String
+}
+
+struct Measurement<Value: Comparable>: Record {
+  let id: String
+  let createdAt: Double
+  let modifiedAt: Double
+  let payload: Value
+}
+
+extension Measurement: Equatable where Value: Equatable {}
+extension Measurement: Hashable where Value: Hashable {
+  func hash(into hasher: inout Hasher) {
+    hasher.combine(id)
+    hasher.combine(payload)
+  }
+}
+
+extension Sequence where Element: Timestamped {
+  func newest() -> Element? {
+    return self.max { $0.modifiedAt < $1.modifiedAt }
+  }
+  func createdAfter(_ cutoff: Double) -> [Element] {
+    return filter { $0.createdAt > cutoff }
+  }
+}
+
+extension Sequence where Element: Record, Element.Payload: Comparable {
+  func largestPayload() -> Element.Payload? {
+    return map { $0.payload }.max()
+  }
+}
+
+func merge<S: SnapshottingStore, T: Store>(_ source: S, into target: inout T)
+    where S.Element == T.Element {
+  for element in source.snapshot() where target.lookup(element.id) == nil {
+    target.insert(element)
+  }
+}
+
+func reconcile<S: SnapshottingStore>(_ stores: [S]) -> MemoryStore<S.Element>
+    where S.Element: Timestamped {
+  var merged = MemoryStore<S.Element>()
+  for store in stores {
+    for element in store.snapshot() {
+      if let existing = merged.lookup(element.id),
+         existing.modifiedAt >= element.modifiedAt {
+        continue
+      }
+      merged.insert(element)
+    }
+  }
+  return merged
+}
+
+func audit<S: SnapshottingStore>(_ store: S, since cutoff: Double) -> Int
+    where S.Element: Record, S.Element.Payload: Comparable {
+  let recent = store.snapshot().createdAfter(cutoff)
+  guard let largest = recent.largestPayload() else { return 0 }
+  return recent.filter { $0.payload == largest }.count
+}
@@ -12,6 +12,7 @@
 
 #if os(Linux)
 import Glibc
+import PerfCounters
 #elseif os(Windows)
 import MSVCRT
 #else
@@ -29,15 +30,26 @@ struct MeasurementMetadata {
   let yields: Int /// Yield Count
 }
 
+/// Hardware performance counter statistics collected across all samples,
+/// normalized per iteration (Linux only).
+struct CounterResults {
+  let instructions: Stats
+  let branchMisses: Stats
+  let cacheMisses: Stats
+}
+
 struct BenchResults {
   typealias T = Int
   private let samples: [T]
   let meta: MeasurementMetadata?
+  let counters: CounterResults?
   let stats: Stats
 
-  init(_ samples: [T], _ metadata: MeasurementMetadata?) {
+  init(_ samples: [T], _ metadata: MeasurementMetadata?,
+       _ counters: CounterResults? = nil) {
     self.samples = samples.sorted()
     self.meta = metadata
+    self.counters = counters
     self.stats = self.samples.reduce(into: Stats(), Stats.collect)
   }
 
@@ -104,6 +116,9 @@ struct TestConfig {
   // Should we log the measurement metadata?
   let logMeta: Bool
 
+  // Should we log the hardware performance counters? (Linux only)
+  let logCounters: Bool
+
   /// After we run the tests, should the harness sleep to allow for utilities
   /// like leaks that require a PID to run on the test harness.
   let afterRunSleep: UInt32?
@@ -128,6 +143,7 @@ struct TestConfig {
       var verbose: Bool?
       var logMemory: Bool?
       var logMeta: Bool?
+      var logCounters: Bool?
       var action: TestAction?
       var tests: [String]?
     }
@@ -175,6 +191,9 @@ struct TestConfig {
                   help: "log the change in maximum resident set size (MAX_RSS)")
     p.addArgument("--meta", \.logMeta, defaultValue: true,
                   help: "log the metadata (memory usage, context switches)")
+    p.addArgument("--counters", \.logCounters, defaultValue: true,
+                  help: "log the hardware performance counters\n" +
+                        "(instructions, branch and cache misses); Linux only")
     p.addArgument("--delim", \.delim,
                   help:"value delimiter used for log output; default: ,",
                   parser: { $0 })
@@ -206,6 +225,7 @@ struct TestConfig {
     verbose = c.verbose ?? false
     logMemory = c.logMemory ?? false
     logMeta = c.logMeta ?? false
+    logCounters = c.logCounters ?? false
     afterRunSleep = c.afterRunSleep
     action = c.action ?? .run
     tests = TestConfig.filterTests(registeredBenchmarks,
@@ -233,6 +253,7 @@ struct TestConfig {
         Verbose: \(verbose)
         LogMemory: \(logMemory)
         LogMeta: \(logMeta)
+        LogCounters: \(logCounters)
         SampleTime: \(sampleTime)
         NumIters: \(numIters ?? 0)
         Quantile: \(quantile ?? 0)
@@ -388,6 +409,17 @@ final class TestRunner {
   let baseline = TestRunner.getResourceUtilization()
   let schedulerQuantum = UInt64(10_000_000) // nanoseconds (== 10ms, macos)
   var yieldCount = 0
+#if os(Linux)
+  /// File descriptors of the hardware performance counters, opened lazily
+  /// when counter logging was requested with `--counters`. Counters that
+  /// could not be opened (e.g. a restrictive perf_event_paranoid setting)
+  /// simply read as 0 and are excluded from the report.
+  lazy var perfCounters = swift_perf_counters_open()
+  var countersAtStart = swift_perf_counter_values()
+  var instructionsStats = Stats()
+  var branchMissesStats = Stats()
+  var cacheMissesStats = Stats()
+#endif
 
   init(_ config: TestConfig) {
     self.c = config
@@ -483,6 +515,15 @@ final class TestRunner {
   }
 
   private func startMeasurement() {
+#if os(Linux)
+    // Snapshot the counters before taking the start time, so that the reads
+    // don't pollute the time measurement; the tiny harness overhead between
+    // here and the invocation of the test function is negligible relative to
+    // the work done in one sample.
+    if c.logCounters {
+      countersAtStart = swift_perf_counters_read(perfCounters)
+    }
+#endif
     let spent = timer.diffTimeInNanoSeconds(from: lastYield, to: end)
     let nextSampleEstimate = UInt64(Double(lastSampleTime) * 1.5)
 
@@ -503,6 +544,46 @@ final class TestRunner {
     let now = yield()
     (start, end, lastYield) = (now, now, now)
     yieldCount = 0
+#if os(Linux)
+    (instructionsStats, branchMissesStats, cacheMissesStats) =
+      (Stats(), Stats(), Stats())
+#endif
+  }
+
+#if os(Linux)
+  /// Fold the per-iteration hardware counter deltas of the last sample into
+  /// the running statistics.
+  private func collectCounters(numIters: Int) {
+    let now = swift_perf_counters_read(perfCounters)
+    func collect(_ s: inout Stats, _ end: UInt64, _ start: UInt64) {
+      Stats.runningMeanVariance(&s, Double(end &- start) / Double(numIters))
+    }
+    collect(&instructionsStats, now.instructions, countersAtStart.instructions)
+    collect(&branchMissesStats, now.branchMisses, countersAtStart.branchMisses)
+    collect(&cacheMissesStats, now.cacheMisses, countersAtStart.cacheMisses)
+  }
+#endif
+
+  /// Returns the per-iteration hardware counter statistics, if the counters
+  /// were measured and at least the instruction counter was functional.
+  func collectCounterResults() -> CounterResults? {
+#if os(Linux)
+    guard c.logCounters, instructionsStats.n > 0,
+          instructionsStats.mean > 0 else { return nil }
+    logVerbose(
+        """
+            INSTRS \(instructionsStats.mean) ± \(instructionsStats.standardDeviation)
+            BR_MISS \(branchMissesStats.mean) ± \(branchMissesStats.standardDeviation)
+            CACHE_MISS \(cacheMissesStats.mean) ± \(cacheMissesStats.standardDeviation)
+        """)
+    return CounterResults(
+      instructions: instructionsStats,
+      branchMisses: branchMissesStats,
+      cacheMisses: cacheMissesStats
+    )
+#else
+    return nil
+#endif
   }
 
   /// Time in nanoseconds spent running the last function
@@ -520,6 +601,12 @@ final class TestRunner {
     fn(numIters)
     stopMeasurement()
 
+#if os(Linux)
+    if c.logCounters {
+      collectCounters(numIters: numIters)
+    }
+#endif
+
 #if SWIFT_RUNTIME_ENABLE_LEAK_CHECKER
     name.withCString { p in stopTrackingObjects(p) }
 #endif
@@ -600,7 +687,7 @@ final class TestRunner {
       samples = samples.map { $0 * lf }
     }
 
-    return BenchResults(samples, collectMetadata())
+    return BenchResults(samples, collectMetadata(), collectCounterResults())
   }
 
   var header: String {
@@ -623,7 +710,10 @@ final class TestRunner {
       (c.quantile.map(quantiles)
         ?? ["MIN", "MAX", "MEAN", "SD", "MEDIAN"].map(withUnit)) +
       (c.logMemory ? ["MAX_RSS(B)"] : []) +
-      (c.logMeta ? ["PAGES", "ICS", "YIELD"] : [])
+      (c.logMeta ? ["PAGES", "ICS", "YIELD"] : []) +
+      (c.logCounters ?
+        ["INSTRS", "INSTRS_SD", "BR_MISS", "BR_MISS_SD",
+         "CACHE_MISS", "CACHE_MISS_SD"] : [])
     ).joined(separator: c.delim)
   }
 
@@ -645,7 +735,11 @@ final class TestRunner {
             ?? [r.min,  r.max, r.mean, r.sd, r.median]) +
           (c.logMemory ? [r.meta?.maxRSS].compactMap { $0 } : []) +
           (c.logMeta ? r.meta.map {
-            [$0.pages, $0.ics, $0.yields] } ?? [] : [])
+            [$0.pages, $0.ics, $0.yields] } ?? [] : []) +
+          (c.logCounters ? r.counters.map {
+            [$0.instructions, $0.branchMisses, $0.cacheMisses].flatMap {
+              [Int($0.mean.rounded()),
+               Int($0.standardDeviation.rounded())] } } ?? [] : [])
         return values.map {
           (c.delta && $0 == 0) ? "" : String($0) } // drop 0s in deltas
       }
@@ -0,0 +1,108 @@
+//===--- PerfCounters.h ----------------------------------------*- C -*---===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2021 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+//
+// Minimal wrappers around the Linux perf_event_open(2) interface, used by the
+// benchmark driver to sample hardware performance counters (executed
+// instructions, branch misses and cache misses) around each measurement.
+//
+// Everything degrades gracefully: when the kernel headers are unavailable,
+// the syscall is not permitted (e.g. a restrictive perf_event_paranoid
+// setting) or a counter is not supported by the PMU, the affected descriptor
+// is -1 and its reads return 0, so the harness keeps running with that
+// counter disabled.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef SWIFT_BENCHMARK_PERF_COUNTERS_H
+#define SWIFT_BENCHMARK_PERF_COUNTERS_H
+
+#include <stdint.h>
+
+/// A snapshot of the raw counter values.
+typedef struct {
+  uint64_t instructions;
+  uint64_t branchMisses;
+  uint64_t cacheMisses;
+} swift_perf_counter_values;
+
+/// File descriptors of the opened counters; -1 marks unavailable counters.
+typedef struct {
+  int instructionsFD;
+  int branchMissesFD;
+  int cacheMissesFD;
+} swift_perf_counters;
+
+#if defined(__linux__) && __has_include(<linux/perf_event.h>)
+
+#include <linux/perf_event.h>
+#include <string.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+static inline int _swift_perf_counter_open(uint32_t type, uint64_t config) {
+  struct perf_event_attr attr;
+  memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.type = type;
+  attr.config = config;
+  // Count only what the benchmark itself executes.
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  return (int)syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+/// Open the hardware counters for the calling process.
+static inline swift_perf_counters swift_perf_counters_open(void) {
+  swift_perf_counters counters;
+  counters.instructionsFD =
+      _swift_perf_counter_open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+  counters.branchMissesFD =
+      _swift_perf_counter_open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+  counters.cacheMissesFD =
+      _swift_perf_counter_open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+  return counters;
+}
+
+static inline uint64_t _swift_perf_counter_read(int fd) {
+  uint64_t value = 0;
+  if (fd < 0 || read(fd, &value, sizeof(value)) != sizeof(value))
+    return 0;
+  return value;
+}
+
+/// Read the current values of all opened counters.
+static inline swift_perf_counter_values
+swift_perf_counters_read(swift_perf_counters counters) {
+  swift_perf_counter_values values;
+  values.instructions = _swift_perf_counter_read(counters.instructionsFD);
+  values.branchMisses = _swift_perf_counter_read(counters.branchMissesFD);
+  values.cacheMisses = _swift_perf_counter_read(counters.cacheMissesFD);
+  return values;
+}
+
+#else // No perf_event support; keep the driver building with counters off.
+
+static inline swift_perf_counters swift_perf_counters_open(void) {
+  swift_perf_counters counters = {-1, -1, -1};
+  return counters;
+}
+
+static inline swift_perf_counter_values
+swift_perf_counters_read(swift_perf_counters counters) {
+  swift_perf_counter_values values = {0, 0, 0};
+  (void)counters;
+  return values;
+}
+
+#endif
+
+#endif // SWIFT_BENCHMARK_PERF_COUNTERS_H
@@ -36,6 +36,7 @@
 #include "llvm/ADT/PointerIntPair.h"
 #include "llvm/ADT/SetVector.h"
 #include "llvm/ADT/SmallPtrSet.h"
+#include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/TinyPtrVector.h"
 #include "llvm/Support/Allocator.h"
@@ -109,7 +110,9 @@ namespace swift {
   class PrecedenceGroupDecl;
   class TupleTypeElt;
   class EnumElementDecl;
+  class ProtocolConformance;
   class ProtocolDecl;
+  class RequirementEnvironment;
   class SubstitutableType;
   class SourceManager;
   class ValueDecl;
@@ -119,6 +122,7 @@ namespace swift {
   class SILBoxType;
   class SILTransform;
   class TypeAliasDecl;
+  class TypeDecl;
   class VarDecl;
   class UnifiedStatsReporter;
   class IndexSubset;
@@ -128,6 +132,10 @@ namespace swift {
 
   enum class KnownProtocolKind : uint8_t;
 
+namespace markup {
+  class MarkupContext;
+}
+
 namespace namelookup {
   class ImportCache;
 }
@@ -472,6 +480,17 @@ public:
   /// specified string.
   Identifier getIdentifier(StringRef Str) const;
 
+  /// Return the cached mangled name for the given entity, running \p mangle
+  /// and caching its result on a miss.
+  ///
+  /// Mangled names are pure functions of the AST, but SIL, IRGen and TBDGen
+  /// each re-mangle the same entities independently; their entry points can
+  /// share results here. Callers are responsible for making \p discriminator
+  /// unambiguous for a given \p entity pointer across all users of the cache.
+  std::string getOrCacheMangledName(
+      const void *entity, unsigned discriminator,
+      llvm::function_ref<std::string()> mangle) const;
+
   /// Decide how to interpret two precedence groups.
   Associativity associateInfixOperators(PrecedenceGroupDecl *left,
                                         PrecedenceGroupDecl *right) const;
@@ -1097,6 +1116,46 @@ public:
   /// to the given protocol or composition type, like <T: type>.
   CanGenericSignature getOpenedArchetypeSignature(Type type);
 
+  /// Retrieve or create the requirement environment used to match witnesses
+  /// against a protocol requirement with the given signature.
+  ///
+  /// Environments are uniqued by conformance, conformance context,
+  /// requirement signature and covariant 'Self' class, so repeated witness
+  /// matching against the same requirement signature reuses the archetype
+  /// substitutions instead of rebuilding a near-identical generic
+  /// environment.
+  const RequirementEnvironment &getOrCreateRequirementEnvironment(
+      DeclContext *conformanceDC, GenericSignature reqSig, ProtocolDecl *proto,
+      ClassDecl *covariantSelf, ProtocolConformance *conformance);
+
+  /// A cached result of resolving a written type annotation: the resolved
+  /// type together with the type declarations bound to the annotation's
+  /// identifier components in traversal order, so that a cache hit can
+  /// rebind an identical annotation. \see cacheResolvedType.
+  struct CachedResolvedAnnotation {
+    Type type;
+    llvm::SmallVector<std::pair<TypeDecl *, DeclContext *>, 2> componentDecls;
+  };
+
+  /// Retrieve the cached result of resolving a written type annotation, or
+  /// nullptr if there is none. The returned entry is only valid until the
+  /// next call to \c cacheResolvedType. \see cacheResolvedType.
+  const CachedResolvedAnnotation *
+  getCachedResolvedType(Identifier annotationText, const DeclContext *dc,
+                        const void *genericSig, uint64_t mode) const;
+
+  /// Cache the result of resolving a written type annotation.
+  ///
+  /// Keys are formed from the annotation's source text (uniqued as an
+  /// identifier), the context the annotation was written in, the generic
+  /// signature in scope, and an opaque encoding of the resolution mode.
+  /// Type resolution consults the cache so that identical annotations
+  /// repeated in the same context resolve without redoing name lookup; it
+  /// only caches resolutions that emitted no diagnostics.
+  void cacheResolvedType(Identifier annotationText, const DeclContext *dc,
+                         const void *genericSig, uint64_t mode,
+                         CachedResolvedAnnotation entry);
+
   GenericSignature getOverrideGenericSignature(const ValueDecl *base,
                                                const ValueDecl *derived);
 
@@ -1143,6 +1202,17 @@ public:
   /// standard library's String implementation.
   bool isASCIIString(StringRef s) const;
 
+  /// Get the cached parsed doc comment for the declaration, if any.
+  ///
+  /// Cached doc comments are parsed into a markup context owned by this
+  /// ASTContext, so they remain valid across request-scoped contexts.
+  DocComment *getDocComment(const Decl *D, bool AllowSerialized);
+  void setDocComment(const Decl *D, bool AllowSerialized, DocComment *DC);
+
+  /// Retrieve the markup context that owns the nodes of doc comments cached
+  /// on this ASTContext.
+  markup::MarkupContext &getDocCommentMarkupContext();
+
 private:
   friend Decl;
   Optional<RawComment> getRawComment(const Decl *D);
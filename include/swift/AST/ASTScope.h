@@ -120,6 +120,7 @@ SourceLoc extractNearestSourceLoc(std::tuple<ASTScopeImpl *, ScopeCreator *>);
 /// -dump-scope-maps expanded
 /// \endcode
 class ASTScopeImpl {
+  friend class swift::ASTScope;
   friend class NodeAdder;
   friend class Portion;
   friend class GenericTypeOrExtensionWholePortion;
@@ -258,6 +259,17 @@ public:
 
   bool getWasExpanded() const { return wasExpanded; }
 
+  /// Discard this scope's children and expansion state so that it is lazily
+  /// re-expanded on the next lookup. Used when the AST node the scope was
+  /// created from is replaced for code completion.
+  void discardExpandedState();
+
+  /// Whether this scope describes the body of \p AFD, as opposed to the
+  /// scope for the declaration itself.
+  virtual bool isBodyScopeOf(const AbstractFunctionDecl *AFD) const {
+    return false;
+  }
+
 protected:
   void setWasExpanded() { wasExpanded = true; }
   virtual ASTScopeImpl *expandSpecifically(ScopeCreator &) = 0;
@@ -301,7 +313,7 @@ protected:
                                                 SourceManager &,
                                                 ScopeCreator &);
 
-private:
+public:
   NullablePtr<ASTScopeImpl> findChildContaining(SourceLoc loc,
                                                 SourceManager &sourceMgr) const;
 
@@ -414,6 +426,13 @@ public:
 
   void expandFunctionBody(AbstractFunctionDecl *AFD);
 
+  /// Tear down just the scopes describing \p AFD's body after it has been
+  /// replaced for code completion, so they re-expand over the new body on
+  /// the next lookup while the rest of the tree stays warm. Returns false
+  /// if the body's scope could not be located, in which case the caller
+  /// must discard the whole tree.
+  bool invalidateFunctionBody(AbstractFunctionDecl *AFD);
+
   const SourceFile *getSourceFile() const override;
   NullablePtr<const void> addressForPrinting() const override { return SF; }
 
@@ -826,6 +845,9 @@ public:
   getSourceRangeOfThisASTNode(bool omitAssertions = false) const override;
   virtual NullablePtr<Decl> getDeclIfAny() const override { return decl; }
   Decl *getDecl() const { return decl; }
+  bool isBodyScopeOf(const AbstractFunctionDecl *AFD) const override {
+    return decl == AFD;
+  }
 
 protected:
   bool lookupLocalsOrMembers(DeclConsumer) const override;
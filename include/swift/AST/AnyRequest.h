@@ -224,6 +224,21 @@ public:
     return getVTable()->isCached(getRawStorage());
   }
 
+  /// Retrieve the type ID of the underlying request.
+  uint64_t getRequestTypeID() const {
+    return getVTable()->typeID;
+  }
+
+  /// Retrieve the TypeID zone the underlying request belongs to.
+  uint8_t getRequestZoneID() const {
+    return uint8_t(getVTable()->typeID >> 8);
+  }
+
+  /// The size of the underlying concrete request, in bytes.
+  size_t getRequestSize() const {
+    return getVTable()->requestSize;
+  }
+
   /// Compare two instances for equality.
   friend bool operator==(const AnyRequestBase<Derived> &lhs,
                          const AnyRequestBase<Derived> &rhs) {
@@ -3962,6 +3962,12 @@ public:
   /// Retrieve the set of protocols inherited from this protocol.
   ArrayRef<ProtocolDecl *> getInheritedProtocols() const;
 
+  /// Retrieve the transitive closure of the protocols inherited from this
+  /// protocol, not including this protocol itself. The result is sorted in
+  /// canonical order and computed once per protocol, so refinement queries
+  /// can binary-search it instead of walking the inheritance graph.
+  ArrayRef<ProtocolDecl *> getAllInheritedProtocols() const;
+
   /// Determine whether this protocol has a superclass.
   bool hasSuperclass() const { return (bool)getSuperclassDecl(); }
 
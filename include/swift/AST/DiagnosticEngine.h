@@ -23,6 +23,7 @@
 #include "swift/AST/DiagnosticConsumer.h"
 #include "swift/AST/TypeLoc.h"
 #include "swift/Localization/LocalizationFormat.h"
+#include "llvm/ADT/DenseSet.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/ADT/StringSet.h"
 #include "llvm/Support/Allocator.h"
@@ -717,6 +718,11 @@ namespace swift {
     /// emitted once all transactions have closed.
     unsigned TransactionCount = 0;
 
+    /// The number of diagnostics flushed so far, including tentative
+    /// diagnostics that a transaction may later abort. Lets clients detect
+    /// whether a region of work raised any diagnostics.
+    unsigned FlushedDiagnosticCount = 0;
+
     /// For batch mode, use this to know where to output a diagnostic from a
     /// non-primary file. It's any location in the buffer of the current primary
     /// input being compiled.
@@ -726,6 +732,20 @@ namespace swift {
     /// Print diagnostic names after their messages
     bool printDiagnosticNames = false;
 
+    /// Suppress exact repetitions of warnings and remarks. The duplicate
+    /// check works on the pre-format representation of a diagnostic (its ID,
+    /// location and interned arguments), so suppressed diagnostics are never
+    /// formatted.
+    bool suppressDuplicateDiagnostics = false;
+
+    /// Whether the last warning or remark was suppressed as a duplicate.
+    /// Trailing notes belong to it and are suppressed with it.
+    bool suppressedLastDiagnostic = false;
+
+    /// The fingerprints of all warnings and remarks which have been handed
+    /// to the consumers. Only used if \c suppressDuplicateDiagnostics is set.
+    llvm::DenseSet<uint64_t> SeenDiagnosticFingerprints;
+
     /// Path to diagnostic documentation directory.
     std::string diagnosticDocumentationPath = "";
 
@@ -741,6 +761,12 @@ namespace swift {
     /// hadAnyError - return true if any *error* diagnostics have been emitted.
     bool hadAnyError() const { return state.hadAnyError(); }
 
+    /// The number of diagnostics flushed so far, including tentative
+    /// diagnostics that a transaction may later abort.
+    unsigned getFlushedDiagnosticCount() const {
+      return FlushedDiagnosticCount;
+    }
+
     bool hasFatalErrorOccurred() const {
       return state.hasFatalErrorOccurred();
     }
@@ -777,6 +803,14 @@ namespace swift {
       return printDiagnosticNames;
     }
 
+    /// Whether to suppress repetitions of the same warning or remark
+    void setSuppressDuplicateDiagnostics(bool val) {
+      suppressDuplicateDiagnostics = val;
+    }
+    bool getSuppressDuplicateDiagnostics() const {
+      return suppressDuplicateDiagnostics;
+    }
+
     void setDiagnosticDocumentationPath(std::string path) {
       diagnosticDocumentationPath = path;
     }
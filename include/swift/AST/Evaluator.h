@@ -28,6 +28,7 @@
 #include "llvm/ADT/Optional.h"
 #include "llvm/ADT/SetVector.h"
 #include "llvm/Support/Error.h"
+#include "llvm/Support/Mutex.h"
 #include "llvm/Support/PrettyStackTrace.h"
 #include <string>
 #include <tuple>
@@ -209,11 +210,47 @@ class Evaluator {
 
   /// A vector containing all of the active evaluation requests, which
   /// is treated as a stack and is used to detect cycles.
-  llvm::SetVector<ActiveRequest> activeRequests;
+  ///
+  /// Use \c getActiveRequests() rather than accessing this directly: when
+  /// the evaluator is shared between threads, each thread tracks its own
+  /// stack, so that cycle detection stays local to a thread and one thread
+  /// does not mistake another thread's in-flight request for a cycle.
+  mutable llvm::SetVector<ActiveRequest> activeRequests;
 
   /// A cache that stores the results of requests.
   llvm::DenseMap<AnyRequest, AnyValue> cache;
 
+  /// Whether the evaluator may be used from multiple threads at once, as
+  /// with experimental parallel type checking. When set, the shared
+  /// request cache, the dependency graph, and the dependency recorder are
+  /// guarded by \c sharedStateMutex, and each thread evaluates requests on
+  /// its own active-request stack.
+  bool isSharedBetweenThreads = false;
+
+  /// Guards \c cache, \c dependencies and \c recorder while
+  /// \c isSharedBetweenThreads is set.
+  mutable llvm::sys::Mutex sharedStateMutex;
+
+  /// RAII object that locks the evaluator's shared mutable state, but only
+  /// when the evaluator has been marked as shared between threads.
+  struct SharedStateLock {
+    const Evaluator &evaluator;
+
+    explicit SharedStateLock(const Evaluator &evaluator)
+        : evaluator(evaluator) {
+      if (evaluator.isSharedBetweenThreads)
+        evaluator.sharedStateMutex.lock();
+    }
+
+    ~SharedStateLock() {
+      if (evaluator.isSharedBetweenThreads)
+        evaluator.sharedStateMutex.unlock();
+    }
+  };
+
+  /// Retrieve the stack of active requests for the current thread.
+  llvm::SetVector<ActiveRequest> &getActiveRequests() const;
+
   /// Track the dependencies of each request.
   ///
   /// This is an adjacency-list representation expressing, for each known
@@ -265,6 +302,18 @@ public:
     return recorder.enumerateReferencesInFile(SF, f);
   }
 
+  /// Record references into the active dependency collector as if a
+  /// dependency-sink request had written them.
+  ///
+  /// This exists for caches that sit in front of the name-lookup requests:
+  /// on a cache hit those requests are never evaluated, so their dependency
+  /// sinks never run, and the cache must record the referenced names itself.
+  void recordDependencies(
+      llvm::function_ref<void(evaluator::DependencyCollector &)> rec) {
+    SharedStateLock lock(*this);
+    recorder.record(getActiveRequests(), rec);
+  }
+
   /// Retrieve the result produced by evaluating a request that can
   /// be cached.
   template<typename Request,
@@ -319,6 +368,7 @@ public:
            typename std::enable_if<!Request::hasExternalCache>::type* = nullptr>
   void cacheOutput(const Request &request,
                    typename Request::OutputType &&output) {
+    SharedStateLock lock(*this);
     cache.insert({AnyRequest(request), std::move(output)});
   }
 
@@ -326,6 +376,7 @@ public:
   template<typename Request,
            typename std::enable_if<!Request::hasExternalCache>::type* = nullptr>
   void clearCachedOutput(const Request &request) {
+    SharedStateLock lock(*this);
     cache.erase(AnyRequest(request));
   }
 
@@ -333,12 +384,40 @@ public:
   ///
   /// Note that this does not clear the caches of requests that use external
   /// caching.
-  void clearCache() { cache.clear(); }
+  void clearCache() {
+    SharedStateLock lock(*this);
+    cache.clear();
+  }
 
-  /// Is the given request, or an equivalent, currently being evaluated?
+  /// Clear all cached results for requests within the given zone.
+  ///
+  /// This allows long-lived clients to bulk-evict an entire category of
+  /// results (e.g. IDE-only requests) without discarding the rest of the
+  /// cache. Like \c clearCache, this does not affect requests that use
+  /// external caching.
+  void clearCacheForZone(Zone zone);
+
+  /// Print the number of cache entries and their approximate memory cost,
+  /// broken down by request kind, for tuning cache policy.
+  ///
+  /// Memory costs are shallow: heap storage owned by cached values is not
+  /// counted.
+  void dumpCacheStats(llvm::raw_ostream &out) const;
+
+  /// Note that the evaluator is about to be used from multiple threads
+  /// simultaneously, or is no longer shared. While shared, the request
+  /// cache, the dependency graph and the dependency recorder are guarded
+  /// by a mutex, and each thread evaluates requests on its own
+  /// active-request stack.
+  ///
+  /// Must only be toggled while no requests are being evaluated.
+  void setSharedBetweenThreads(bool shared);
+
+  /// Is the given request, or an equivalent, currently being evaluated
+  /// on this thread?
   template <typename Request>
   bool hasActiveRequest(const Request &request) const {
-    return activeRequests.count(ActiveRequest(request));
+    return getActiveRequests().count(ActiveRequest(request));
   }
 
 private:
@@ -369,14 +448,17 @@ private:
     // Make sure we remove this from the set of active requests once we're
     // done.
     SWIFT_DEFER {
-      assert(activeRequests.back() == activeReq);
-      activeRequests.pop_back();
+      auto &active = getActiveRequests();
+      assert(active.back() == activeReq);
+      active.pop_back();
     };
 
     // Clear out the dependencies on this request; we're going to recompute
     // them now anyway.
-    if (buildDependencyGraph)
+    if (buildDependencyGraph) {
+      SharedStateLock lock(*this);
       dependencies.find_as(request)->second.clear();
+    }
 
     PrettyStackTraceRequest<Request> prettyStackTrace(request);
 
@@ -423,20 +505,32 @@ private:
   llvm::Expected<typename Request::OutputType>
   getResultCached(const Request &request) {
     // If we already have an entry for this request in the cache, return it.
-    auto known = cache.find_as(request);
-    if (known != cache.end()) {
-      auto r = known->second.template castTo<typename Request::OutputType>();
-      reportEvaluatedResult<Request>(request, r);
-      return r;
+    // The result is copied out before it is reported, so that the lock is
+    // not held while the dependency recorder replays references.
+    Optional<typename Request::OutputType> cached;
+    {
+      SharedStateLock lock(*this);
+      auto known = cache.find_as(request);
+      if (known != cache.end())
+        cached = known->second.template castTo<typename Request::OutputType>();
+    }
+    if (cached) {
+      reportEvaluatedResult<Request>(request, *cached);
+      return *cached;
     }
 
-    // Compute the result.
+    // Compute the result. The lock is not held while evaluating, so two
+    // threads may race to compute the same request; the first insertion
+    // below wins and the results are equivalent.
     auto result = getResultUncached(request);
     if (!result)
       return result;
 
     // Cache the result.
-    cache.insert({AnyRequest(request), *result});
+    {
+      SharedStateLock lock(*this);
+      cache.insert({AnyRequest(request), *result});
+    }
     return result;
   }
 
@@ -446,7 +540,8 @@ private:
                                   !Request::isDependencySink>::type * = nullptr>
   void reportEvaluatedResult(const Request &r,
                              const typename Request::OutputType &o) {
-    recorder.replay(activeRequests, ActiveRequest(r));
+    SharedStateLock lock(*this);
+    recorder.replay(getActiveRequests(), ActiveRequest(r));
   }
 
   // Report the result of evaluating a request that is a dependency sink.
@@ -454,7 +549,8 @@ private:
             typename std::enable_if<Request::isDependencySink>::type * = nullptr>
   void reportEvaluatedResult(const Request &r,
                              const typename Request::OutputType &o) {
-    return recorder.record(activeRequests, [&r, &o](auto &c) {
+    SharedStateLock lock(*this);
+    return recorder.record(getActiveRequests(), [&r, &o](auto &c) {
       return r.writeDependencySink(c, o);
     });
   }
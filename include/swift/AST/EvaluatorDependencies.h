@@ -181,16 +181,32 @@ struct DependencyRecorder {
 
 private:
   /// A stack of dependency sources in the order they were evaluated.
-  llvm::SmallVector<evaluator::DependencySource, 8> dependencySources;
+  ///
+  /// Use \c getDependencySources() rather than accessing this directly:
+  /// when the owning evaluator is shared between threads, each thread
+  /// tracks its own stack of sources.
+  mutable llvm::SmallVector<evaluator::DependencySource, 8> dependencySources;
   llvm::DenseMap<SourceFile *, DependencyCollector::ReferenceSet>
       fileReferences;
   llvm::DenseMap<AnyRequest, DependencyCollector::ReferenceSet>
       requestReferences;
   bool isRecording;
 
+  /// Whether the owning evaluator is shared between threads; see
+  /// \c Evaluator::setSharedBetweenThreads.
+  bool isSharedBetweenThreads = false;
+
+  /// Retrieve the dependency-source stack for the current thread.
+  llvm::SmallVectorImpl<evaluator::DependencySource> &
+  getDependencySources() const;
+
 public:
   explicit DependencyRecorder() : isRecording{false} {};
 
+  /// Note whether the owning evaluator is shared between threads, so that
+  /// each thread tracks its own stack of dependency sources.
+  void setSharedBetweenThreads(bool shared) { isSharedBetweenThreads = shared; }
+
 private:
   /// Records the given \c Reference as a dependency of the current dependency
   /// source.
@@ -260,9 +276,10 @@ public:
   /// come from. Existing callers are being migrated to more reasonable ways
   /// of judging the relevancy of a dependency.
   evaluator::DependencySource getActiveDependencySourceOrNull() const {
-    if (dependencySources.empty())
+    auto &sources = getDependencySources();
+    if (sources.empty())
       return nullptr;
-    return dependencySources.front();
+    return sources.front();
   }
 
 public:
@@ -284,13 +301,13 @@ public:
       if (Source.isNull() || !Source.get()->isPrimary()) {
         return;
       }
-      coll.dependencySources.emplace_back(Source);
+      coll.getDependencySources().emplace_back(Source);
       Coll = &coll;
     }
 
     ~StackRAII() {
       if (Coll.isNonNull())
-        Coll.get()->dependencySources.pop_back();
+        Coll.get()->getDependencySources().pop_back();
     }
   };
 };
@@ -62,6 +62,11 @@ class alignas(1 << DeclAlignInBits) GenericEnvironment final
   GenericSignature Signature = GenericSignature();
   GenericSignatureBuilder *Builder = nullptr;
 
+  /// The forwarding substitution map, lazily built and cached by
+  /// \c getForwardingSubstitutionMap(). Context types are memoized per
+  /// environment, so the map is the same no matter when it is first built.
+  mutable SubstitutionMap ForwardingSubMap;
+
   friend TrailingObjects;
 
   size_t numTrailingObjects(OverloadToken<Type>) const;
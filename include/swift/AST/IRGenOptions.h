@@ -343,6 +343,10 @@ public:
 
   JITDebugArtifact DumpJIT = JITDebugArtifact::None;
 
+  /// In immediate mode, cache JITed code on disk, keyed by module contents,
+  /// and reuse it across runs of the same script.
+  bool UseJITObjectCache = false;
+
   IRGenOptions()
       : DWARFVersion(2), OutputKind(IRGenOutputKind::LLVMAssembly),
         Verify(true), OptMode(OptimizationMode::NotSet),
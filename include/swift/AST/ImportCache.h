@@ -20,6 +20,7 @@
 
 #include "swift/AST/Module.h"
 #include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/DenseSet.h"
 #include "llvm/ADT/FoldingSet.h"
 
 namespace swift {
@@ -106,9 +107,17 @@ class alignas(ImportedModule) ImportCache {
 
   llvm::FoldingSet<ImportSet> ImportSets;
   llvm::DenseMap<const DeclContext *, ImportSet *> ImportSetForDC;
-  llvm::DenseMap<std::tuple<const ModuleDecl *,
-                            const DeclContext *>,
+
+  /// Maps a module to the access paths it is visible through in a given
+  /// import set. Since import sets are uniqued, the entries are shared by
+  /// every DeclContext with the same imports, and they never go stale.
+  llvm::DenseMap<std::pair<const ImportSet *, const ModuleDecl *>,
                  ArrayRef<ImportPath::Access>> VisibilityCache;
+
+  /// The import sets whose entire visibility index has been built in
+  /// VisibilityCache; for these, a missing entry means the module is not
+  /// visible at all.
+  llvm::DenseSet<const ImportSet *> VisibilityIndexedSets;
   llvm::DenseMap<std::tuple<const ModuleDecl *,
                             const ModuleDecl *,
                             const DeclContext *>,
@@ -696,6 +696,12 @@ public:
 
   static void expandFunctionBody(AbstractFunctionDecl *);
 
+  /// Tear down just the scopes for \p AFD's body after it has been replaced
+  /// for code completion, keeping unqualified lookup warm for the rest of
+  /// the file. Returns false if the body's scope could not be located, in
+  /// which case the caller must discard the whole tree.
+  bool invalidateFunctionBody(AbstractFunctionDecl *);
+
   /// Flesh out the tree for dumping
   void buildFullyExpandedTree();
 
@@ -196,6 +196,27 @@ public:
                            ArrayRef<ProtocolDecl *> result) const;
 };
 
+/// Computes the transitive closure of the protocols inherited by a protocol,
+/// sorted in canonical order for binary-search probes.
+class AllInheritedProtocolsRequest
+    : public SimpleRequest<AllInheritedProtocolsRequest,
+                           ArrayRef<ProtocolDecl *>(ProtocolDecl *),
+                           RequestFlags::Cached> {
+public:
+  using SimpleRequest::SimpleRequest;
+
+private:
+  friend SimpleRequest;
+
+  // Evaluation.
+  ArrayRef<ProtocolDecl *>
+  evaluate(Evaluator &evaluator, ProtocolDecl *PD) const;
+
+public:
+  // Caching
+  bool isCached() const { return true; }
+};
+
 /// Requests whether or not this class has designated initializers that are
 /// not public or @usableFromInline.
 class HasMissingDesignatedInitializersRequest :
@@ -433,6 +454,35 @@ public:
                            LookupResult res) const;
 };
 
+/// Performs an unqualified lookup for an operator name.
+///
+/// Operator lookup never searches local scopes, so its results depend only
+/// on the module-scope context, the name, and the lookup options. That lets
+/// these lookups be cached, collapsing the per-expression import set
+/// traversal for operator references down to a single table probe. The
+/// descriptor's context must be a module-scope context and its source
+/// location must be invalid.
+class UnqualifiedOperatorLookupRequest
+    : public SimpleRequest<UnqualifiedOperatorLookupRequest,
+                           LookupResult(UnqualifiedLookupDescriptor),
+                           RequestFlags::Cached |
+                               RequestFlags::DependencySink> {
+public:
+  using SimpleRequest::SimpleRequest;
+
+private:
+  friend SimpleRequest;
+
+  // Evaluation.
+  LookupResult evaluate(Evaluator &evaluator,
+                        UnqualifiedLookupDescriptor desc) const;
+
+public:
+  // Incremental dependencies
+  void writeDependencySink(evaluator::DependencyCollector &tracker,
+                           LookupResult res) const;
+};
+
 using QualifiedLookupResult = SmallVector<ValueDecl *, 4>;
 
 /// Performs a lookup into a given module and its imports.
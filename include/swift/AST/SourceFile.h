@@ -14,9 +14,11 @@
 #define SWIFT_AST_SOURCEFILE_H
 
 #include "swift/AST/FileUnit.h"
+#include "swift/AST/Identifier.h"
 #include "swift/AST/Import.h"
 #include "swift/AST/SynthesizedFileUnit.h"
 #include "swift/Basic/Debug.h"
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/SetVector.h"
 #include "llvm/ADT/SmallPtrSet.h"
 
@@ -97,6 +99,11 @@ private:
   /// This is set during type checking.
   TypeRefinementContext *TRC = nullptr;
 
+  /// The top-level declarations whose refinement context subtrees have been
+  /// added to \c TRC. Subtrees are built lazily, on the first availability
+  /// query inside a declaration.
+  llvm::SmallPtrSet<Decl *, 4> DeclsWithTypeRefinementContexts;
+
   /// Either the class marked \@NS/UIApplicationMain or the synthesized FuncDecl
   /// that calls main on the type marked @main.
   Decl *MainDecl = nullptr;
@@ -123,6 +130,20 @@ private:
   /// The scope map that describes this source file.
   NullablePtr<ASTScope> Scope = nullptr;
 
+  /// Memoized results of \c ASTScope::lookupLocalDecls, keyed by the scope
+  /// the lookup starts from, the name being looked up, and whether the lookup
+  /// stops after the innermost brace statement. Cleared whenever a scope is
+  /// added to the scope tree, since expansion can introduce declarations
+  /// between a cached starting point and the root; replacing the scope tree
+  /// after an edit drops the cache with it.
+  llvm::DenseMap<std::pair<std::pair<const void *, DeclName>, bool>,
+                 SmallVector<ValueDecl *, 1>>
+      LocalLookupCache;
+
+  /// Incremented whenever \p LocalLookupCache is invalidated, so an
+  /// in-progress lookup can tell that the tree grew underneath it.
+  unsigned LocalLookupCacheGeneration = 0;
+
   /// The set of validated opaque return type decls in the source file.
   llvm::SmallVector<OpaqueTypeDecl *, 4> OpaqueReturnTypes;
   llvm::StringMap<OpaqueTypeDecl *> ValidatedOpaqueReturnTypes;
@@ -432,6 +453,45 @@ public:
 
   void clearScope() {
     Scope = nullptr;
+    clearLocalLookupCache();
+  }
+
+  /// Tear down just the scopes describing \p AFD's body, which has been
+  /// replaced for code completion, instead of discarding the whole scope
+  /// tree the way \c clearScope() does. Falls back to \c clearScope() if
+  /// the body's scope cannot be located.
+  void invalidateFunctionBodyScope(AbstractFunctionDecl *AFD);
+
+  /// Retrieve the memoized results of a local-decl lookup for \p name
+  /// starting at \p scope, if one has been performed before.
+  Optional<ArrayRef<ValueDecl *>>
+  getCachedLocalLookupResult(const void *scope, DeclName name,
+                             bool stopAfterInnermostBraceStmt) const {
+    auto known =
+        LocalLookupCache.find({{scope, name}, stopAfterInnermostBraceStmt});
+    if (known == LocalLookupCache.end())
+      return None;
+    return ArrayRef<ValueDecl *>(known->second);
+  }
+
+  /// Memoize the results of a local-decl lookup for \p name starting at
+  /// \p scope.
+  void cacheLocalLookupResult(const void *scope, DeclName name,
+                              bool stopAfterInnermostBraceStmt,
+                              ArrayRef<ValueDecl *> results) {
+    LocalLookupCache[{{scope, name}, stopAfterInnermostBraceStmt}].assign(
+        results.begin(), results.end());
+  }
+
+  /// Invalidate all memoized local-decl lookup results because the scope
+  /// tree grew.
+  void clearLocalLookupCache() {
+    LocalLookupCache.clear();
+    ++LocalLookupCacheGeneration;
+  }
+
+  unsigned getLocalLookupCacheGeneration() const {
+    return LocalLookupCacheGeneration;
   }
 
   /// Retrieves the previously set delayed parser state, asserting that it
@@ -519,6 +579,14 @@ public:
   /// Set the root refinement context for the file.
   void setTypeRefinementContext(TypeRefinementContext *TRC);
 
+  /// Whether the refinement context subtree for the given top-level
+  /// declaration has been built.
+  bool hasBuiltTypeRefinementContext(Decl *D) const;
+
+  /// Note that the refinement context subtree for the given top-level
+  /// declaration has been built.
+  void setBuiltTypeRefinementContext(Decl *D);
+
   /// Whether this file has an interface hash available.
   bool hasInterfaceHash() const {
     return ParsingOpts.contains(ParsingFlags::EnableInterfaceHash);
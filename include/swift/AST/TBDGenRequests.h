@@ -22,6 +22,7 @@
 #include "swift/IRGen/Linking.h"
 #include "swift/SIL/SILDeclRef.h"
 #include "swift/TBDGen/TBDGen.h"
+#include "llvm/TextAPI/MachO/Symbol.h"
 
 namespace llvm {
 
@@ -185,6 +186,62 @@ public:
   }
 };
 
+/// A symbol computed by TBDGen, together with the information needed to emit
+/// it into a TBD file or a symbol list.
+struct TBDSymbol {
+  std::string name;
+  llvm::MachO::SymbolKind kind;
+  SymbolSource source;
+};
+
+/// The full symbol list for a file or module, computed once and shared by the
+/// requests that consume it.
+class TBDSymbolList {
+  friend class TBDSymbolListRequest;
+
+  using Storage = std::vector<TBDSymbol>;
+  const Storage *storage;
+
+  explicit TBDSymbolList(const Storage *storage) : storage(storage) {
+    assert(storage);
+  }
+
+public:
+  ArrayRef<TBDSymbol> get() const { return *storage; }
+
+  friend bool operator==(const TBDSymbolList &lhs, const TBDSymbolList &rhs) {
+    return lhs.storage == rhs.storage;
+  }
+  friend bool operator!=(const TBDSymbolList &lhs, const TBDSymbolList &rhs) {
+    return !(lhs == rhs);
+  }
+
+  friend void simple_display(llvm::raw_ostream &out, const TBDSymbolList &) {
+    out << "(TBD symbol list)";
+  }
+};
+
+/// Computes the symbol list for a file or module by walking its decls once.
+/// TBD file generation, public-symbol listing and symbol-source mapping all
+/// consume the cached result, so only the first of them pays for the walk.
+class TBDSymbolListRequest
+    : public SimpleRequest<TBDSymbolListRequest,
+                           TBDSymbolList(TBDGenDescriptor),
+                           RequestFlags::Cached> {
+public:
+  using SimpleRequest::SimpleRequest;
+
+private:
+  friend SimpleRequest;
+
+  // Evaluation.
+  TBDSymbolList evaluate(Evaluator &evaluator, TBDGenDescriptor desc) const;
+
+public:
+  // Cached.
+  bool isCached() const { return true; }
+};
+
 /// Maps a symbol back to its source for lazy compilation.
 class SymbolSourceMap {
   friend class SymbolSourceMapRequest;
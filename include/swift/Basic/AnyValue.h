@@ -75,6 +75,10 @@ class AnyValue {
 
     /// Display.
     virtual void display(llvm::raw_ostream &out) const = 0;
+
+    /// The size of the concrete holder, in bytes. This is a shallow size;
+    /// heap storage owned by the held value is not counted.
+    virtual size_t getStorageSize() const = 0;
   };
 
   /// Holds a value that can be used as a request input/output.
@@ -103,6 +107,10 @@ class AnyValue {
     virtual void display(llvm::raw_ostream &out) const override {
       simple_display(out, value);
     }
+
+    virtual size_t getStorageSize() const override {
+      return sizeof(*this);
+    }
   };
 
   /// The data stored in this value.
@@ -133,6 +141,11 @@ public:
     return &static_cast<const Holder<T> *>(stored.get())->value;
   }
 
+  /// The approximate (shallow) size of the stored value, in bytes.
+  size_t getStorageSize() const {
+    return stored->getStorageSize();
+  }
+
   /// Compare two instances for equality.
   friend bool operator==(const AnyValue &lhs, const AnyValue &rhs) {
     if (lhs.stored->typeID != rhs.stored->typeID)
@@ -114,7 +114,18 @@ public:
 
   /// Add the low N bits from the given value to the vector.
   void add(size_t numBits, uint64_t value) {
-    append(fromAPInt(APInt(numBits, value)));
+    if (numBits == 0) {
+      return;
+    }
+    APInt word(numBits, value);
+    if (!Bits) {
+      Bits = std::move(word);
+      return;
+    }
+    APInt &v = Bits.getValue();
+    unsigned w = v.getBitWidth();
+    v = v.zext(w + numBits);
+    v.insertBits(word, w);
   }
 
   /// Append a number of clear bits to this vector.
@@ -268,11 +279,9 @@ public:
     if (numBits == 0) {
       return ClusteredBitVector();
     }
-    auto vec = APInt::getNullValue(numBits);
-    if (value) {
-      vec.flipAllBits();
-    }
-    return ClusteredBitVector(vec);
+    auto vec = value ? APInt::getAllOnesValue(numBits)
+                     : APInt::getNullValue(numBits);
+    return ClusteredBitVector(std::move(vec));
   }
 
   /// Pretty-print the vector.
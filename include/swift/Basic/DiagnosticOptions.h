@@ -51,6 +51,14 @@ public:
   /// Suppress all warnings
   bool SuppressWarnings = false;
 
+  /// Suppress exact repetitions of warnings and remarks, e.g. when the same
+  /// diagnostic is produced once per primary file.
+  bool SuppressDuplicateDiagnostics = false;
+
+  /// Write each diagnostic to the serialized diagnostics file as it is
+  /// emitted, instead of on frontend exit.
+  bool EmitSerializedDiagnosticsIncrementally = false;
+
   /// Treat all warnings as errors
   bool WarningsAsErrors = false;
 
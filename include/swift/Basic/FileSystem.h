@@ -13,12 +13,20 @@
 #ifndef SWIFT_BASIC_FILESYSTEM_H
 #define SWIFT_BASIC_FILESYSTEM_H
 
+#include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Support/MemoryBuffer.h"
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
 #include <system_error>
+#include <utility>
+#include <vector>
 
 namespace llvm {
+  class ThreadPool;
   class raw_pwrite_stream;
   class Twine;
 }
@@ -48,6 +56,50 @@ namespace swift {
       llvm::StringRef outputPath,
       llvm::function_ref<void(llvm::raw_pwrite_stream &)> action);
 
+  /// Writes a set of output files without serializing the filesystem work.
+  ///
+  /// Each call to writeFile runs \p action synchronously on the calling
+  /// thread, capturing the output bytes in memory; the actual file creation,
+  /// write and rename-into-place (see swift::atomicallyWritingToFile) are
+  /// performed on a small thread pool so that slow filesystems do not
+  /// serialize a job's output files. All writes are completed by
+  /// waitForCompletion, or at the latest by the destructor.
+  ///
+  /// \p action itself is never run concurrently, so it may freely reference
+  /// state that is not thread-safe (such as the ASTContext).
+  class AsyncOutputWriter {
+    std::unique_ptr<llvm::ThreadPool> Pool;
+    std::mutex ErrorMutex;
+    std::vector<std::pair<std::string, std::error_code>> Errors;
+
+    void recordError(llvm::StringRef outputPath, std::error_code error);
+
+  public:
+    explicit AsyncOutputWriter(unsigned numThreads = 4);
+    ~AsyncOutputWriter();
+
+    /// Schedules the contents produced by \p action to be written to
+    /// \p outputPath. An output path of "-" (stdout) is written synchronously.
+    ///
+    /// Any filesystem error is reported by waitForCompletion rather than
+    /// here, since the write has not happened yet.
+    void writeFile(llvm::StringRef outputPath,
+                   llvm::function_ref<void(llvm::raw_pwrite_stream &)> action);
+
+    /// Like writeFile, but also produces the contents on the background
+    /// thread, for outputs that are expensive to compute. \p action must not
+    /// touch state the calling thread keeps mutating. An output path of "-"
+    /// (stdout) is handled synchronously.
+    void writeFileAsync(llvm::StringRef outputPath,
+                        std::function<void(llvm::raw_pwrite_stream &)> action);
+
+    /// Waits for all scheduled writes to finish and returns the output paths
+    /// that failed, paired with the corresponding error. The result is valid
+    /// until the next call to writeFile.
+    llvm::ArrayRef<std::pair<std::string, std::error_code>>
+    waitForCompletion();
+  };
+
   /// Moves a file from \p source to \p destination, unless there is already
   /// a file at \p destination that contains the same data as \p source.
   ///
@@ -503,6 +503,11 @@ namespace swift {
     /// dumped to llvm::errs().
     bool DebugTimeExpressions = false;
 
+    /// If true, the time spent inferring associated types for each
+    /// conformance, along with the number of candidate states visited, will
+    /// be dumped to llvm::errs().
+    bool DebugTimeAssociatedTypeInference = false;
+
     /// Controls the function bodies to skip during type-checking.
     FunctionBodySkipping SkipFunctionBodies = FunctionBodySkipping::None;
 
@@ -554,6 +559,19 @@ namespace swift {
     /// Enable experimental support for one-way constraints for the
     /// parameters of closures.
     bool EnableOneWayClosureParameters = false;
+
+    /// Enable experimental parallel type checking of the files in a
+    /// frontend job.
+    ///
+    /// When enabled, each file to be type checked is handed to a worker
+    /// thread. The evaluator's shared state is guarded by a lock and each
+    /// thread evaluates requests on its own stack, so cycle detection is
+    /// per-thread. Off by default.
+    bool EnableParallelTypeChecking = false;
+
+    /// If non-empty, the path of an experimental persistent cache of
+    /// constraint solving outcomes keyed by expression fingerprints.
+    std::string SolutionCachePath;
   };
 
   /// Options for controlling the behavior of the Clang importer.
@@ -590,6 +608,17 @@ namespace swift {
     /// Disable validating the persistent PCH.
     bool PCHDisableValidation = false;
 
+    /// Don't verify input files for Clang modules if the module has been
+    /// successfully validated or loaded during this build session.
+    ///
+    /// This lets a driver-coordinated build validate each Clang module once
+    /// per session instead of in every frontend job that loads it.
+    bool ValidateModulesOnce = false;
+
+    /// The path to the file whose modification time is used as the underlying
+    /// Clang build session timestamp when \c ValidateModulesOnce is set.
+    std::string BuildSessionFilePath;
+
     /// \see Mode
     enum class Modes : uint8_t {
       /// Set up Clang for importing modules into Swift and generating IR from
@@ -104,6 +104,15 @@ public:
     }
   }
 
+  /// Return an \c OwnedString referencing the substring of \p Length bytes
+  /// starting at \p Offset. The result shares ownership of the underlying
+  /// buffer with this string instead of making a copy, so slicing a large
+  /// buffer into many small strings does not allocate.
+  OwnedString slice(size_t Offset, size_t Length) const {
+    assert(Offset + Length <= Text.size() && "slice is out of range");
+    return OwnedString(Text.substr(Offset, Length), OwnedPtr);
+  }
+
   /// Returns the length of the string in bytes.
   size_t size() const { return Text.size(); }
 
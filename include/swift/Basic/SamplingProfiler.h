@@ -0,0 +1,49 @@
+//===--- SamplingProfiler.h - Frontend self-profiling -----------*- C++ -*-===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2021 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+//
+// A lightweight in-process sampling profiler. When started, the process's
+// stacks are captured on a CPU-time timer into a fixed-size ring buffer;
+// stopping symbolicates and aggregates the samples into collapsed-stack
+// format ("frame;frame;frame count" per line), which flamegraph and pprof
+// tooling consume directly. Intended for diagnosing slow frontend
+// invocations purely from build artifacts, on machines where attaching an
+// external profiler is impossible; see the -profile-frontend option.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef SWIFT_BASIC_SAMPLINGPROFILER_H
+#define SWIFT_BASIC_SAMPLINGPROFILER_H
+
+#include "llvm/Support/raw_ostream.h"
+
+namespace swift {
+
+/// The profiler's state is process-wide (the sampling signal handler is
+/// global), so only one profiler can be active per process.
+class SamplingProfiler {
+public:
+  /// Whether stack sampling is supported on this platform.
+  static bool isSupported();
+
+  /// Begin sampling the process's stacks every \p sampleIntervalMicroseconds
+  /// of consumed CPU time. No-op when unsupported or already started.
+  static void start(unsigned sampleIntervalMicroseconds);
+
+  /// Stop sampling, then aggregate, symbolicate and write the collected
+  /// samples in collapsed-stack format to \p out. Returns the number of
+  /// samples written; 0 when the profiler was never started.
+  static unsigned stopAndWrite(llvm::raw_ostream &out);
+};
+
+} // end namespace swift
+
+#endif // SWIFT_BASIC_SAMPLINGPROFILER_H
@@ -38,6 +38,11 @@ class SourceManager {
   /// to speed up stats.
   mutable llvm::DenseMap<StringRef, llvm::vfs::Status> StatusCache;
 
+  /// For each buffer, the byte offset at which each line begins, built on
+  /// first use. Buffer contents never change once registered, so the table is
+  /// computed exactly once per buffer.
+  mutable llvm::DenseMap<unsigned, std::vector<unsigned>> LineStartOffsets;
+
   struct ReplacedRangeType {
     SourceRange Original;
     SourceRange New;
@@ -279,6 +284,10 @@ public:
 private:
   const VirtualFile *getVirtualFile(SourceLoc Loc) const;
   unsigned getExternalSourceBufferId(StringRef Path);
+
+  /// Returns the cached line-start offset table for \p BufferId, building it
+  /// on first use.
+  llvm::ArrayRef<unsigned> getLineStarts(unsigned BufferId) const;
   int getLineOffset(SourceLoc Loc) const {
     if (auto VFile = getVirtualFile(Loc))
       return VFile->LineOffset;
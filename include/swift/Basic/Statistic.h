@@ -123,6 +123,18 @@ public:
     const TraceFormatter *Formatter;
   };
 
+  /// A begin or end mark on the timeline of a traced event, recorded with
+  /// -trace-stats-chrome and flushed as Chrome trace JSON, suitable for
+  /// flame-chart viewers such as chrome://tracing or Perfetto.
+  struct ChromeTraceEvent
+  {
+    uint64_t TimeUSec;
+    bool IsEntry;
+    StringRef EventName;
+    const void *Entity;
+    const TraceFormatter *Formatter;
+  };
+
   // We only write fine-grained trace entries when the user passed
   // -trace-stats-events, but we recycle the same FrontendStatsTracers to give
   // us some free recursion-save phase timings whenever -trace-stats-dir is
@@ -143,7 +155,9 @@ private:
   long maxChildRSS = 0;
   SmallString<128> StatsFilename;
   SmallString<128> TraceFilename;
+  SmallString<128> ChromeTraceFilename;
   SmallString<128> ProfileDirname;
+  SmallString<128> FrontendProfileFilename;
   llvm::TimeRecord StartedTime;
   std::thread::id MainThreadID;
 
@@ -156,6 +170,7 @@ private:
   Optional<AlwaysOnFrontendCounters> FrontendCounters;
   Optional<AlwaysOnFrontendCounters> LastTracedFrontendCounters;
   Optional<std::vector<FrontendStatsEvent>> FrontendStatsEvents;
+  Optional<std::vector<ChromeTraceEvent>> ChromeTraceEvents;
 
   // These are unique_ptr so we can use incomplete types here.
   std::unique_ptr<RecursionSafeTimers> RecursiveTimers;
@@ -166,6 +181,11 @@ private:
   /// record any additional stats until we've finished.
   bool IsFlushingTracesAndProfiles;
 
+  /// Whether the in-process sampling profiler was started for this
+  /// invocation (see -profile-frontend); if so, the destructor stops it and
+  /// writes the collapsed-stack profile next to the stats output.
+  bool FrontendProfilerActive;
+
   void publishAlwaysOnStatsToLLVM();
   void printAlwaysOnStatsAndTimers(raw_ostream &OS);
 
@@ -176,7 +196,9 @@ private:
                        clang::SourceManager *CSM,
                        bool TraceEvents,
                        bool ProfileEvents,
-                       bool ProfileEntities);
+                       bool ProfileEntities,
+                       bool TraceChromeEvents,
+                       bool ProfileFrontend);
 public:
   UnifiedStatsReporter(StringRef ProgramName,
                        StringRef ModuleName,
@@ -189,7 +211,9 @@ public:
                        clang::SourceManager *CSM=nullptr,
                        bool TraceEvents=false,
                        bool ProfileEvents=false,
-                       bool ProfileEntities=false);
+                       bool ProfileEntities=false,
+                       bool TraceChromeEvents=false,
+                       bool ProfileFrontend=false);
   ~UnifiedStatsReporter();
 
   AlwaysOnDriverCounters &getDriverCounters();
@@ -331,6 +331,11 @@ class Demangler;
 class Context {
   Demangler *D;
 
+  /// A bounded cache of demangling results, only allocated if
+  /// enableDemanglingCache() was called.
+  class DemanglingCache;
+  DemanglingCache *Cache = nullptr;
+
   friend class Node;
 
 public:
@@ -338,6 +343,18 @@ public:
 
   ~Context();
 
+  /// Enable caching of demangleSymbolAsString() results on this context.
+  ///
+  /// Up to \p MaxSize entries are kept; when the cache is full, the least
+  /// recently used entry is evicted. This is intended for clients which
+  /// demangle the same symbols over and over, e.g. symbolication of many
+  /// stack traces.
+  ///
+  /// Note: The cache does not account for \c DemangleOptions; it assumes
+  /// that all demangleSymbolAsString() calls on this context use the same
+  /// options.
+  void enableDemanglingCache(size_t MaxSize = 4096);
+
   /// Demangle the given symbol and return the parse tree.
   ///
   /// \param MangledName The mangled symbol string, which start a mangling
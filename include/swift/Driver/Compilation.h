@@ -27,6 +27,7 @@
 #include "swift/Driver/FineGrainedDependencyDriverGraph.h"
 #include "swift/Driver/Job.h"
 #include "swift/Driver/Util.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Support/Chrono.h"
 
@@ -256,6 +257,11 @@ private:
   /// by \c BatchCount.
   const Optional<unsigned> BatchSizeLimit;
 
+  /// Per-primary-input compile times (in wall-clock seconds) recorded in the
+  /// previous build's compilation record, used to balance batch-mode
+  /// partitions by predicted cost instead of by file count.
+  llvm::StringMap<double> PreviousCompileTimes;
+
   /// True if temporary files should not be deleted.
   const bool SaveTemps;
 
@@ -278,6 +284,12 @@ private:
   /// -emit-loaded-module-trace, so no other job needs to do it.
   bool PassedEmitLoadedModuleTraceToFrontendJob = false;
 
+  /// When non-null, the executable that runs each subcommand; the
+  /// subcommand's own command line is passed to it as arguments. This lets an
+  /// external transport (an ssh or icecc-style tool) execute jobs on remote
+  /// workers, making parallelism beyond the local core count useful.
+  const char *RemoteExecutionWrapper = nullptr;
+
   /// The limit for the number of files to pass on the command line. Beyond this
   /// limit filelists will be used.
   size_t FilelistThreshold;
@@ -447,6 +459,13 @@ public:
     ShowJobLifecycle = value;
   }
 
+  const char *getRemoteExecutionWrapper() const {
+    return RemoteExecutionWrapper;
+  }
+  void setRemoteExecutionWrapper(const char *wrapper) {
+    RemoteExecutionWrapper = wrapper;
+  }
+
   bool getShowDriverTimeCompilation() const {
     return ShowDriverTimeCompilation;
   }
@@ -499,6 +518,14 @@ public:
     return BatchSizeLimit;
   }
 
+  const llvm::StringMap<double> &getPreviousCompileTimes() const {
+    return PreviousCompileTimes;
+  }
+
+  void setPreviousCompileTimes(llvm::StringMap<double> times) {
+    PreviousCompileTimes = std::move(times);
+  }
+
   /// Requests the path to a file containing all input source files. This can
   /// be shared across jobs.
   ///
@@ -46,6 +46,7 @@ class ToolChain {
   const Driver &D;
   const llvm::Triple Triple;
   mutable llvm::StringMap<std::string> ProgramLookupCache;
+  mutable llvm::StringMap<std::string> SystemProgramLookupCache;
 
 protected:
   ToolChain(const Driver &D, const llvm::Triple &T) : D(D), Triple(T) {}
@@ -190,6 +191,12 @@ protected:
   /// This method is invoked by findProgramRelativeToSwift().
   virtual std::string findProgramRelativeToSwiftImpl(StringRef name) const;
 
+  /// Searches for the given executable in the system PATH.
+  ///
+  /// This method caches its results; a driver constructing many jobs for the
+  /// same tool should only pay for one PATH scan.
+  std::string findProgramInSystemPath(StringRef name) const;
+
   void addInputsOfType(llvm::opt::ArgStringList &Arguments,
                        ArrayRef<const Action *> Inputs,
                        file_types::ID InputType,
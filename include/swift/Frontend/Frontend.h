@@ -643,6 +643,11 @@ private:
 
   void forEachFileToTypeCheck(llvm::function_ref<void(SourceFile &)> fn);
 
+  /// Type check each file to be checked on a pool of worker threads.
+  ///
+  /// Used when experimental parallel type checking is enabled.
+  void performParallelTypeChecking();
+
   void finishTypeChecking();
 
 public:
@@ -93,6 +93,8 @@ public:
     Typecheck,         ///< Parse and type-check only
     DumpParse,         ///< Parse only and dump AST
     DumpInterfaceHash, ///< Parse and dump the interface token hash.
+    DumpDeclSkeleton,  ///< Parse (skipping bodies) and dump the top-level
+                       ///< decl names and imports.
     EmitSyntax,        ///< Parse and dump Syntax tree as JSON
     DumpAST,           ///< Parse, type-check, and dump AST
     PrintAST,          ///< Parse, type-check, and pretty-print AST
@@ -177,6 +179,10 @@ public:
   /// Trace changes to stats to files in StatsOutputDir.
   bool TraceStats = false;
 
+  /// Emit a Chrome-trace-format timeline of stats events to a file in
+  /// StatsOutputDir.
+  bool TraceChromeEvents = false;
+
   /// Profile changes to stats to files in StatsOutputDir.
   bool ProfileEvents = false;
 
@@ -184,6 +190,10 @@ public:
   /// entity.
   bool ProfileEntities = false;
 
+  /// Sample the compiler's own stacks during the invocation and write a
+  /// collapsed-stack profile to StatsOutputDir.
+  bool ProfileFrontend = false;
+
   /// Indicates whether or not an import statement can pick up a Swift source
   /// file (as opposed to a module file).
   bool EnableSourceImport = false;
@@ -282,6 +292,19 @@ public:
   /// of the main Swift module's source files.
   bool ImportPrescan = false;
 
+  /// After performing a dependency scanning action, serialize the scanner's
+  /// internal state to \c DependencyScannerCachePath so a later scan can warm
+  /// up from it.
+  bool SerializeDependencyScannerCache = false;
+
+  /// Before performing a dependency scanning action, load the scanner's
+  /// internal state from \c DependencyScannerCachePath, revalidating cached
+  /// entries against the files they were computed from.
+  bool ReuseDependencyScannerCache = false;
+
+  /// The path at which the dependency scanner's internal state is serialized.
+  std::string DependencyScannerCachePath;
+
   /// When performing an incremental build, ensure that cross-module incremental
   /// build metadata is available in any swift modules emitted by this frontend
   /// job.
@@ -33,10 +33,13 @@ namespace swift {
     /// Clang's serialized diagnostics format.
     ///
     /// \param outputPath the file path to write the diagnostics to.
+    /// \param emitIncrementally if true, append each diagnostic to the file
+    /// as it is emitted instead of writing the file on frontend exit, so
+    /// clients can report diagnostics from a still-running compilation.
     ///
     /// \returns A new diagnostic consumer that serializes diagnostics.
     std::unique_ptr<DiagnosticConsumer>
-    createConsumer(llvm::StringRef outputPath);
+    createConsumer(llvm::StringRef outputPath, bool emitIncrementally = false);
   }
 }
 
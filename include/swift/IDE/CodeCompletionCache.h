@@ -17,6 +17,7 @@
 #include "swift/Basic/ThreadSafeRefCounted.h"
 #include "llvm/ADT/IntrusiveRefCntPtr.h"
 #include "llvm/Support/Chrono.h"
+#include "llvm/Support/MemoryBuffer.h"
 #include <system_error>
 
 namespace swift {
@@ -59,6 +60,11 @@ public:
   struct Value : public llvm::ThreadSafeRefCountedBase<Value> {
     llvm::sys::TimePoint<> ModuleModificationTime;
     CodeCompletionResultSink Sink;
+    /// The memory-mapped on-disk cache file these results were deserialized
+    /// from, if any. Strings in the results reference this buffer directly
+    /// instead of being copied into the sink's allocator, so it must stay
+    /// alive as long as the value itself.
+    std::unique_ptr<llvm::MemoryBuffer> BackingBuffer;
   };
   using ValueRefCntPtr = llvm::IntrusiveRefCntPtr<Value>;
 
@@ -40,20 +40,33 @@ class CompletionInstance {
   struct Options {
     unsigned MaxASTReuseCount = 100;
     unsigned DependencyCheckIntervalSecond = 5;
+
+    /// The maximum number of warm compiler instances kept at once. Keeping
+    /// more than one lets a sequence of completions that alternates between
+    /// files reuse each file's type-checked state.
+    unsigned MaxCachedInstances = 4;
   } Opts;
 
   std::mutex mtx;
 
-  std::unique_ptr<CompilerInstance> CachedCI;
-  llvm::hash_code CachedArgHash;
-  llvm::sys::TimePoint<> DependencyCheckedTimestamp;
-  llvm::StringMap<llvm::hash_code> InMemoryDependencyHash;
-  unsigned CachedReuseCount = 0;
+  /// A warm compiler instance usable for fast completion, along with the
+  /// state needed to decide whether it is still valid.
+  struct CachedInstance {
+    std::unique_ptr<CompilerInstance> CI;
+    llvm::hash_code ArgHash;
+    std::string BufferName;
+    llvm::sys::TimePoint<> DependencyCheckedTimestamp;
+    llvm::StringMap<llvm::hash_code> InMemoryDependencyHash;
+    unsigned ReuseCount = 0;
+  };
+
+  /// The warm instances, in MRU order with the most recently used last.
+  std::vector<CachedInstance> CachedInstances;
 
   void cacheCompilerInstance(std::unique_ptr<CompilerInstance> CI,
                              llvm::hash_code ArgsHash);
 
-  bool shouldCheckDependencies() const;
+  bool shouldCheckDependencies(const CachedInstance &entry) const;
 
   /// Calls \p Callback with cached \c CompilerInstance if it's usable for the
   /// specified completion request.
@@ -154,18 +154,37 @@ public:
 };
 
 class LocalizationProducer {
+  enum class LocalizationProducerState : uint8_t {
+    NotInitialized,
+    Initialized,
+    FailedInitialization
+  };
+
+  /// Keeps track of the current state of the producer, so the heavy lifting
+  /// of loading the translations is only done on the first message lookup
+  /// and a failed initialization isn't retried.
+  LocalizationProducerState state = LocalizationProducerState::NotInitialized;
+
 public:
   /// If the  message isn't available/localized in current context
   /// return the fallback default message.
-  virtual llvm::StringRef getMessageOr(swift::DiagID id,
-                                       llvm::StringRef defaultMessage) const {
-    auto message = getMessage(id);
-    return message.empty() ? defaultMessage : message;
-  }
+  llvm::StringRef getMessageOr(swift::DiagID id,
+                               llvm::StringRef defaultMessage);
 
   virtual ~LocalizationProducer() {}
 
 protected:
+  /// Initialize the producer if it hasn't been initialized before.
+  /// \returns true if the producer is ready to serve messages.
+  bool initializeIfNeeded();
+
+  /// Load the translations maintained by this producer. Deferred until the
+  /// first message lookup so that invocations which don't emit any
+  /// diagnostics never pay for it.
+  /// \returns true if the producer is successfully initialized, false
+  /// otherwise.
+  virtual bool initializeImpl() = 0;
+
   /// Retrieve a message for the given diagnostic id.
   /// \returns empty string if message couldn't be found.
   virtual llvm::StringRef getMessage(swift::DiagID id) const = 0;
@@ -173,6 +192,7 @@ protected:
 
 class YAMLLocalizationProducer final : public LocalizationProducer {
   std::vector<std::string> diagnostics;
+  std::string filePath;
 
 public:
   /// The diagnostics IDs that are no longer available in `.def`
@@ -183,9 +203,10 @@ public:
   /// maintained by this producer, callback gets each translation
   /// with its unique identifier.
   void forEachAvailable(
-      llvm::function_ref<void(swift::DiagID, llvm::StringRef)> callback) const;
+      llvm::function_ref<void(swift::DiagID, llvm::StringRef)> callback);
 
 protected:
+  bool initializeImpl() override;
   llvm::StringRef getMessage(swift::DiagID id) const override;
 };
 
@@ -201,6 +222,7 @@ public:
       std::unique_ptr<llvm::MemoryBuffer> buffer);
 
 protected:
+  bool initializeImpl() override;
   llvm::StringRef getMessage(swift::DiagID id) const override;
 };
 
@@ -24,6 +24,7 @@
 
 namespace swift {
 
+class AsyncOutputWriter;
 class SourceManager;
 
 namespace migrator {
@@ -72,7 +73,8 @@ struct MigrationState : public llvm::ThreadSafeRefCountedBase<MigrationState> {
 
   /// Write all relevant information about the state to OutDir, such as the
   /// input file, output file, replacements, syntax trees, etc.
-  bool print(size_t StateNumber, StringRef OutDir) const;
+  void print(size_t StateNumber, StringRef OutDir,
+             AsyncOutputWriter &Writer) const;
 
   bool noChangesOccurred() const {
     return InputBufferID == OutputBufferID;
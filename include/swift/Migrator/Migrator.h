@@ -21,6 +21,7 @@
 #include "swift/Syntax/References.h"
 
 namespace swift {
+class AsyncOutputWriter;
 class CompilerInstance;
 
 namespace migrator {
@@ -75,21 +76,20 @@ struct Migrator {
   ///   - performSema emitted fatal errors along the way.
   bool performSyntacticPasses(SyntacticPassOptions Opts);
 
-  /// Emit a replacement map from the very start state's output text to the
-  /// final state's output text to the StartInvocation's output file.
-  bool emitRemap() const;
+  /// Schedule emission of a replacement map from the very start state's
+  /// output text to the final state's output text to the StartInvocation's
+  /// output file. The replacement map is computed and written on \p Writer's
+  /// thread pool; failures are reported by its waitForCompletion.
+  void emitRemap(AsyncOutputWriter &Writer) const;
 
-  /// Emit the output text of the final state in States to the path specified
-  /// by -emit-migrated-file-path in StartInvocation.MigratorOptions.
-  ///
-  /// Returns true if an attempt was made and failed.
-  bool emitMigratedFile() const;
+  /// Schedule emission of the output text of the final state in States to the
+  /// path specified by -emit-migrated-file-path in
+  /// StartInvocation.MigratorOptions.
+  void emitMigratedFile(AsyncOutputWriter &Writer) const;
 
-  /// Dump all of the migration states encountered so far to
+  /// Schedule dumps of all the migration states encountered so far to
   /// StartInvocation.MigratorOptions.DumpMigrationStatesDir.
-  ///
-  /// Returns true if an attempt was made and failed.
-  bool dumpStates() const;
+  void dumpStates(AsyncOutputWriter &Writer) const;
 
   /// Get the options for the Migrator.
   const MigratorOptions &getMigratorOptions() const;
@@ -52,6 +52,14 @@ namespace options {
 
   std::unique_ptr<llvm::opt::OptTable> createSwiftOptTable();
 
+  /// Return a process-wide, immutable option table.
+  ///
+  /// Prefer this over \c createSwiftOptTable for argument parsing: building
+  /// the table is not free, and callers like the module interface loader and
+  /// the dependency scanner parse argument lists for many sub-invocations in
+  /// a single process.
+  const llvm::opt::OptTable &getSwiftOptTable();
+
 } // end namespace swift
 
 #endif
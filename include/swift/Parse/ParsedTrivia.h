@@ -18,6 +18,7 @@
 #include "llvm/ADT/SmallVector.h"
 
 namespace swift {
+  class OwnedString;
   class SourceLoc;
   class SourceManager;
 
@@ -61,6 +62,14 @@ public:
   static syntax::Trivia
   convertToSyntaxTrivia(ArrayRef<ParsedTriviaPiece> pieces, SourceLoc loc,
                         const SourceManager &SM, unsigned bufferID);
+
+  /// Like the overload above, but takes the entire text of the buffer
+  /// \p bufferID as \p sourceText. The trivia text is sliced out of
+  /// \p sourceText, sharing ownership of its buffer instead of copying.
+  static syntax::Trivia
+  convertToSyntaxTrivia(ArrayRef<ParsedTriviaPiece> pieces, SourceLoc loc,
+                        const SourceManager &SM, unsigned bufferID,
+                        const OwnedString &sourceText);
 };
 
 using ParsedTriviaList = SmallVector<ParsedTriviaPiece, 3>;
@@ -52,6 +52,17 @@ struct SyntaxReuseRegion {
   AbsolutePosition End;
 };
 
+/// Allows a subsequent parse of an edited source file to reuse unchanged
+/// subtrees of a previously built syntax tree.
+///
+/// Note that reuse deliberately stops at the syntax tree. Reusing semantic
+/// AST nodes (\c Decl etc.) for unchanged top-level declarations is not
+/// possible with the current architecture: semantic nodes are allocated in a
+/// \c ASTContext whose lifetime is tied to a single compiler instance, and
+/// each edit session builds a fresh instance, so nothing from the previous
+/// \c SourceFile may legally outlive it. Clients that want cheap re-parses of
+/// edited files should parse through the libSyntax tree with this cache (see
+/// SourceKit's editor support) rather than expect incremental semantic ASTs.
 class SyntaxParsingCache {
   /// The syntax tree prior to the edit
   SourceFileSyntax OldSyntaxTree;
@@ -269,6 +269,32 @@ private:
   /// Cache for field info lookups.
   std::unordered_map<std::string, RemoteRef<FieldDescriptor>> FieldTypeInfoCache;
 
+  /// Cache for builtin type info lookups.
+  std::unordered_map<std::string, RemoteRef<BuiltinTypeDescriptor>>
+      BuiltinTypeInfoCache;
+
+  /// Cache for capture descriptor lookups, keyed by remote address.
+  std::unordered_map<uint64_t, RemoteRef<CaptureDescriptor>>
+      CaptureDescriptorCache;
+
+  /// Cache of decoded (unsubstituted) typerefs, keyed by the remote address
+  /// of their mangled name. Section data never changes within a session, so
+  /// each mangled name needs to be demangled and decoded at most once no
+  /// matter how many queries revisit it.
+  std::unordered_map<uint64_t, const TypeRef *> DecodedTypeRefCache;
+
+  /// Cache of normalized (remangled) reflection names, keyed by the remote
+  /// address of the raw name.
+  std::unordered_map<uint64_t, std::string> NormalizedReflectionNameCache;
+
+  /// The index of the first ReflectionInfo whose field, builtin and capture
+  /// descriptors have not yet been indexed into the caches above. Each
+  /// image's sections are scanned and normalized at most once; after that,
+  /// lookups (including misses) are plain hash lookups.
+  size_t FirstUnprocessedFieldInfoIndex = 0;
+  size_t FirstUnprocessedBuiltinInfoIndex = 0;
+  size_t FirstUnprocessedCaptureInfoIndex = 0;
+
   TypeConverter TC;
   MetadataSourceBuilder MSB;
 
@@ -627,6 +653,10 @@ public:
     return TypeRefDemangler(string);
   }
 
+  /// Demangle and decode a type reference into an unsubstituted typeref,
+  /// memoizing the result by the remote address of the mangled name.
+  const TypeRef *decodeTypeRef(RemoteRef<char> mangledName);
+
   TypeConverter &getTypeConverter() { return TC; }
 
   const TypeRef *
@@ -21,6 +21,10 @@
 #include "swift/SwiftRemoteMirror/MemoryReaderInterface.h"
 #include "swift/Remote/MemoryReader.h"
 
+#include <algorithm>
+#include <cstdlib>
+#include <unordered_map>
+
 struct MemoryReaderImpl {
   // Opaque pointer passed to all the callback functions.
   void *reader_context;
@@ -40,6 +44,15 @@ namespace remote {
 class CMemoryReader final : public MemoryReader {
   MemoryReaderImpl Impl;
 
+  /// The granularity at which remote memory is cached when read caching
+  /// is enabled.
+  static const uint64_t CachePageSize = 0x1000;
+
+  bool CacheRemoteReads = false;
+
+  /// Locally cached pages of remote memory, keyed by remote page address.
+  std::unordered_map<uint64_t, std::unique_ptr<uint8_t[]>> PageCache;
+
 public:
   CMemoryReader(MemoryReaderImpl Impl) : Impl(Impl) {
     assert(this->Impl.queryDataLayout && "No queryDataLayout implementation");
@@ -82,7 +95,25 @@ public:
     return true;
   }
 
+  /// Enable or disable local caching of remote reads at page granularity.
+  ///
+  /// While caching is enabled, contiguous runs of uncached pages covering a
+  /// requested range are fetched with a single remote read and all reads are
+  /// served from the cache, amortizing the per-read syscall/IPC overhead of
+  /// fine-grained remote reads. Callers must only enable caching while the
+  /// remote process is suspended or otherwise known not to mutate the memory
+  /// being inspected. Disabling caching drops the cached pages.
+  void setCacheRemoteReads(bool enabled) {
+    CacheRemoteReads = enabled;
+    if (!enabled)
+      PageCache.clear();
+  }
+
   ReadBytesResult readBytes(RemoteAddress address, uint64_t size) override {
+      if (CacheRemoteReads && size > 0)
+        if (auto Result = readBytesCached(address, size))
+          return Result;
+
       void *FreeContext;
       auto Ptr = Impl.readBytes(Impl.reader_context, address.getAddressData(), size,
                                 &FreeContext);
@@ -90,11 +121,83 @@ public:
       auto Free = Impl.free;
       if (Free == nullptr)
         return ReadBytesResult(Ptr, [](const void *) {});
-      
+
       auto ReaderContext = Impl.reader_context;
       auto freeLambda = [=](const void *Ptr) { Free(ReaderContext, Ptr, FreeContext); };
       return ReadBytesResult(Ptr, freeLambda);
   }
+
+private:
+  /// Read the given page-aligned range of remote memory into the page cache
+  /// with as few remote reads as possible.
+  ///
+  /// Returns false if any page in the range could not be read.
+  bool cachePages(uint64_t pageAddress, uint64_t length) {
+    // Try to fetch the whole run with a single remote read.
+    void *FreeContext;
+    auto Ptr = Impl.readBytes(Impl.reader_context, pageAddress, length,
+                              &FreeContext);
+    if (Ptr) {
+      for (uint64_t Offset = 0; Offset < length; Offset += CachePageSize) {
+        std::unique_ptr<uint8_t[]> Page(new uint8_t[CachePageSize]);
+        memcpy(Page.get(),
+               reinterpret_cast<const uint8_t *>(Ptr) + Offset, CachePageSize);
+        PageCache[pageAddress + Offset] = std::move(Page);
+      }
+      if (Impl.free)
+        Impl.free(Impl.reader_context, Ptr, FreeContext);
+      return true;
+    }
+
+    // The bulk read fails if the run straddles an unmapped page. Retry page
+    // by page so the mapped portion still gets cached.
+    if (length == CachePageSize)
+      return false;
+    bool Success = true;
+    for (uint64_t Offset = 0; Offset < length; Offset += CachePageSize)
+      Success &= cachePages(pageAddress + Offset, CachePageSize);
+    return Success;
+  }
+
+  /// Serve a read from the page cache, faulting in any uncached pages that
+  /// the requested range covers.
+  ///
+  /// Returns a null result if a page could not be read; the caller falls
+  /// back to an uncached read.
+  ReadBytesResult readBytesCached(RemoteAddress address, uint64_t size) {
+    auto Start = address.getAddressData();
+    auto FirstPage = Start & ~(CachePageSize - 1);
+    auto LastPage = (Start + size - 1) & ~(CachePageSize - 1);
+
+    // Fault in each contiguous run of uncached pages with one remote read.
+    uint64_t RunStart = 0, RunLength = 0;
+    for (auto Page = FirstPage; Page <= LastPage; Page += CachePageSize) {
+      if (PageCache.count(Page)) {
+        if (RunLength && !cachePages(RunStart, RunLength))
+          return nullptr;
+        RunLength = 0;
+        continue;
+      }
+      if (!RunLength)
+        RunStart = Page;
+      RunLength += CachePageSize;
+    }
+    if (RunLength && !cachePages(RunStart, RunLength))
+      return nullptr;
+
+    // Assemble the result from the cached pages.
+    auto *Buf = reinterpret_cast<uint8_t *>(malloc(size));
+    for (uint64_t Offset = 0; Offset < size; ) {
+      auto Page = (Start + Offset) & ~(CachePageSize - 1);
+      auto PageOffset = (Start + Offset) - Page;
+      auto Chunk = std::min(size - Offset, CachePageSize - PageOffset);
+      memcpy(Buf + Offset, PageCache[Page].get() + PageOffset, Chunk);
+      Offset += Chunk;
+    }
+    return ReadBytesResult(Buf, [](const void *ptr) {
+      free(const_cast<void *>(ptr));
+    });
+  }
 };
 
 }
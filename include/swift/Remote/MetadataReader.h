@@ -172,6 +172,11 @@ private:
   /// A cache of built types, keyed by the address of the type.
   std::unordered_map<StoredPointer, BuiltType> TypeCache;
 
+  /// A cache of types built from mangled names handed to us by the client,
+  /// keyed by the mangled name. Debugger clients resolve the same names
+  /// repeatedly within a session.
+  std::unordered_map<std::string, BuiltType> TypeCacheByMangledName;
+
   using MetadataRef = RemoteRef<TargetMetadata<Runtime>>;
   using OwnedMetadataRef =
     std::unique_ptr<const TargetMetadata<Runtime>, delete_with_free>;
@@ -385,6 +390,7 @@ public:
   /// Clear all of the caches in this reader.
   void clear() {
     TypeCache.clear();
+    TypeCacheByMangledName.clear();
     MetadataCache.clear();
     ContextDescriptorCache.clear();
   }
@@ -928,10 +934,19 @@ public:
 
   TypeLookupErrorOr<typename BuilderType::BuiltType>
   readTypeFromMangledName(const char *MangledTypeName, size_t Length) {
+    std::string Name(MangledTypeName, Length);
+    auto Cached = TypeCacheByMangledName.find(Name);
+    if (Cached != TypeCacheByMangledName.end())
+      return Cached->second;
+
     Demangle::Demangler Dem;
     Demangle::NodePointer Demangled =
       Dem.demangleSymbol(StringRef(MangledTypeName, Length));
-    return decodeMangledType(Demangled);
+    auto Result = decodeMangledType(Demangled);
+    // Only cache successes so errors are reported to every caller.
+    if (auto Built = Result.getType())
+      TypeCacheByMangledName.insert({std::move(Name), Built});
+    return Result;
   }
 
   /// Given the address of a context descriptor, attempt to read it, or
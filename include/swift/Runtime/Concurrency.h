@@ -188,6 +188,14 @@ bool swift_task_removeStatusRecord(AsyncTask *task,
 SWIFT_EXPORT_FROM(swift_Concurrency) SWIFT_CC(swift)
 size_t swift_task_getJobFlags(AsyncTask* task);
 
+/// Check whether a task has been cancelled.
+///
+/// This can be called from any thread. It is a single atomic load, so
+/// readers never wait on the status record lock held by a concurrent
+/// cancellation or escalation broadcast.
+SWIFT_EXPORT_FROM(swift_Concurrency) SWIFT_CC(swift)
+bool swift_task_isCancelled(AsyncTask* task);
+
 /// This should have the same representation as an enum like this:
 ///    enum NearestTaskDeadline {
 ///      case none
@@ -267,6 +275,20 @@ void swift_task_enqueueGlobal(Job *job);
 SWIFT_EXPORT_FROM(swift_Concurrency) SWIFT_CC(swift)
 void (*swift_task_enqueueGlobal_hook)(Job *job);
 
+/// Enqueue the given job to run asynchronously on the global
+/// execution pool, after at least the given delay in nanoseconds.
+///
+/// The resumption function pointer and continuation should be set
+/// appropriately in the task.
+SWIFT_EXPORT_FROM(swift_Concurrency) SWIFT_CC(swift)
+void swift_task_enqueueGlobalWithDelay(unsigned long long delay, Job *job);
+
+/// A hook to take over delayed global enqueuing.
+/// TODO: figure out a better abstraction plan than this.
+SWIFT_EXPORT_FROM(swift_Concurrency) SWIFT_CC(swift)
+void (*swift_task_enqueueGlobalWithDelay_hook)(unsigned long long delay,
+                                               Job *job);
+
 /// Initialize the runtime storage for a default actor.
 SWIFT_EXPORT_FROM(swift_Concurrency) SWIFT_CC(swift)
 void swift_defaultActor_initialize(DefaultActor *actor);
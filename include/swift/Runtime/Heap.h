@@ -17,4 +17,18 @@
 #ifndef SWIFT_RUNTIME_HEAP_H
 #define SWIFT_RUNTIME_HEAP_H
 
+#include <cstddef>
+
+#include "swift/Runtime/Config.h"
+
+/// Return the aggregate hit/miss counters of the per-thread small-allocation
+/// cache, which is enabled with SWIFT_ENABLE_SMALL_ALLOCATION_CACHE. A hit is
+/// an allocation served from a thread's magazine; a miss fell through to the
+/// system allocator. Per-thread counts are folded into the totals
+/// periodically and when a thread exits, so the result trails the true
+/// counts slightly. Both counters read zero when the cache is disabled or
+/// unsupported on the platform.
+SWIFT_RUNTIME_EXPORT
+void swift_getSmallAllocationCacheCounters(size_t *outHits, size_t *outMisses);
+
 #endif // SWIFT_RUNTIME_HEAP_H
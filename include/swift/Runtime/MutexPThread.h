@@ -23,6 +23,9 @@
 #if defined(__APPLE__) && defined(__MACH__)
 #include <os/lock.h>
 #define HAS_OS_UNFAIR_LOCK 1
+#elif defined(__linux__)
+#include <cstdint>
+#define HAS_FUTEX_LOCK 1
 #endif
 
 namespace swift {
@@ -33,6 +36,15 @@ typedef pthread_rwlock_t ReadWriteLockHandle;
 
 #if HAS_OS_UNFAIR_LOCK
 typedef os_unfair_lock MutexHandle;
+#elif HAS_FUTEX_LOCK
+/// A 4-byte unfair lock backed by the kernel's futex interface. The word
+/// is 0 when unlocked, 1 when locked with no waiters, and 2 when locked
+/// with possible waiters; a thread only enters the kernel after a short
+/// adaptive spin fails to acquire the word.
+struct FutexLockHandle {
+  uint32_t Word;
+};
+typedef FutexLockHandle MutexHandle;
 #else
 typedef pthread_mutex_t MutexHandle;
 #endif
@@ -96,6 +108,8 @@ struct MutexPlatformHelper {
   staticInit() {
 #if HAS_OS_UNFAIR_LOCK
     return OS_UNFAIR_LOCK_INIT;
+#elif HAS_FUTEX_LOCK
+    return FutexLockHandle{0};
 #else
     return PTHREAD_MUTEX_INITIALIZER;
 #endif  
@@ -106,8 +120,9 @@ struct MutexPlatformHelper {
   static void unlock(ConditionMutexHandle &mutex);
   static bool try_lock(ConditionMutexHandle &mutex);
 
-  // The ConditionMutexHandle versions handle everything on-Apple platforms.
-#if HAS_OS_UNFAIR_LOCK
+  // The ConditionMutexHandle versions handle everything when MutexHandle
+  // is also a pthread mutex.
+#if HAS_OS_UNFAIR_LOCK || HAS_FUTEX_LOCK
 
   static void init(MutexHandle &mutex, bool checked = false);
   static void destroy(MutexHandle &mutex);
@@ -115,7 +130,8 @@ struct MutexPlatformHelper {
   static void unlock(MutexHandle &mutex);
   static bool try_lock(MutexHandle &mutex);
 
-  // os_unfair_lock always checks for errors, so just call through.
+  // These lock implementations don't do separate error checking, so just
+  // call through.
   static void unsafeLock(MutexHandle &mutex) { lock(mutex); }
   static void unsafeUnlock(MutexHandle &mutex) { unlock(mutex); }
 #endif
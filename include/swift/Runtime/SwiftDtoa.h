@@ -101,6 +101,22 @@ int swift_decompose_double(double d,
 // In all cases, it returns the number of ASCII characters actually
 // written, or zero if the buffer was too small.
 size_t swift_format_double(double, char *dest, size_t length);
+
+// Format an array of doubles as a sequence of ASCII strings.
+//
+// Formats `count` values from `values` back-to-back into `dest` using
+// `swift_format_double`, recording the length of each string in the
+// corresponding entry of `lengths`. The strings are packed without
+// separators: entry `i` starts at the sum of the first `i` lengths.
+// Each string is NUL-terminated when written, but the terminator of one
+// entry is overwritten by the first character of the next; only the last
+// string formatted keeps its terminator.
+//
+// Returns the number of values formatted, which is less than `count`
+// only if `dest` ran out of space.
+size_t swift_format_double_batch(const double *values, size_t count,
+                                 char *dest, size_t length,
+                                 size_t *lengths);
 #endif
 
 #if SWIFT_DTOA_FLOAT16_SUPPORT
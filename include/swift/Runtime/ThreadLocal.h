@@ -50,6 +50,19 @@
 #define SWIFT_RUNTIME_ATTRIBUTE_THREAD_LOCAL thread_local
 #endif
 
+/// SWIFT_RUNTIME_ATTRIBUTE_TLS_INITIAL_EXEC - Ask the compiler to use
+/// the initial-exec TLS model for a runtime thread-local on ELF
+/// platforms. The runtime is loaded at program startup, so its
+/// thread-locals can live in the static TLS block; accesses then become
+/// a direct TP-relative load instead of a call to __tls_get_addr.
+#if defined(__ELF__) && defined(__GNUC__) && \
+    !defined(SWIFT_STDLIB_SINGLE_THREADED_RUNTIME)
+#define SWIFT_RUNTIME_ATTRIBUTE_TLS_INITIAL_EXEC \
+  __attribute__((tls_model("initial-exec")))
+#else
+#define SWIFT_RUNTIME_ATTRIBUTE_TLS_INITIAL_EXEC
+#endif
+
 // Implementation of SWIFT_RUNTIME_DECLARE_THREAD_LOCAL
 #if !SWIFT_RUNTIME_SUPPORTS_THREAD_LOCAL
 #include <pthread.h>
@@ -127,7 +140,8 @@ public:
 /// type must be small and trivially copyable.
 #if SWIFT_RUNTIME_SUPPORTS_THREAD_LOCAL
 #define SWIFT_RUNTIME_DECLARE_THREAD_LOCAL(TYPE, NAME) \
-  SWIFT_RUNTIME_ATTRIBUTE_THREAD_LOCAL swift::ThreadLocal<TYPE> NAME
+  SWIFT_RUNTIME_ATTRIBUTE_THREAD_LOCAL \
+  SWIFT_RUNTIME_ATTRIBUTE_TLS_INITIAL_EXEC swift::ThreadLocal<TYPE> NAME
 #else
 #define SWIFT_RUNTIME_DECLARE_THREAD_LOCAL(TYPE, NAME) \
   swift::ThreadLocal<TYPE> NAME
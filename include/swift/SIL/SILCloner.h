@@ -2731,14 +2731,17 @@ SILCloner<ImplClass>::visitSwitchEnumInst(SwitchEnumInst *Inst) {
   if (Inst->hasDefault())
     DefaultBB = getOpBasicBlock(Inst->getDefaultBB());
   SmallVector<std::pair<EnumElementDecl*, SILBasicBlock*>, 8> CaseBBs;
-  for (unsigned i = 0, e = Inst->getNumCases(); i != e; ++i)
+  SmallVector<ProfileCounter, 8> CaseCounts;
+  for (unsigned i = 0, e = Inst->getNumCases(); i != e; ++i) {
     CaseBBs.push_back(std::make_pair(Inst->getCase(i).first,
                                      getOpBasicBlock(Inst->getCase(i).second)));
+    CaseCounts.push_back(Inst->getCaseCount(i));
+  }
   getBuilder().setCurrentDebugScope(getOpScope(Inst->getDebugScope()));
   recordClonedInstruction(
-      Inst, getBuilder().createSwitchEnum(getOpLocation(Inst->getLoc()),
-                                          getOpValue(Inst->getOperand()),
-                                          DefaultBB, CaseBBs));
+      Inst, getBuilder().createSwitchEnum(
+                getOpLocation(Inst->getLoc()), getOpValue(Inst->getOperand()),
+                DefaultBB, CaseBBs, CaseCounts, Inst->getDefaultCount()));
 }
 
 template<typename ImplClass>
@@ -2749,14 +2752,17 @@ visitSwitchEnumAddrInst(SwitchEnumAddrInst *Inst) {
   if (Inst->hasDefault())
     DefaultBB = getOpBasicBlock(Inst->getDefaultBB());
   SmallVector<std::pair<EnumElementDecl*, SILBasicBlock*>, 8> CaseBBs;
-  for (unsigned i = 0, e = Inst->getNumCases(); i != e; ++i)
+  SmallVector<ProfileCounter, 8> CaseCounts;
+  for (unsigned i = 0, e = Inst->getNumCases(); i != e; ++i) {
     CaseBBs.push_back(std::make_pair(Inst->getCase(i).first,
                                      getOpBasicBlock(Inst->getCase(i).second)));
+    CaseCounts.push_back(Inst->getCaseCount(i));
+  }
   getBuilder().setCurrentDebugScope(getOpScope(Inst->getDebugScope()));
   recordClonedInstruction(
-      Inst, getBuilder().createSwitchEnumAddr(getOpLocation(Inst->getLoc()),
-                                              getOpValue(Inst->getOperand()),
-                                              DefaultBB, CaseBBs));
+      Inst, getBuilder().createSwitchEnumAddr(
+                getOpLocation(Inst->getLoc()), getOpValue(Inst->getOperand()),
+                DefaultBB, CaseBBs, CaseCounts, Inst->getDefaultCount()));
 }
   
 
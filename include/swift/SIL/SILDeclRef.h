@@ -225,6 +225,9 @@ struct SILDeclRef {
   };
 
   /// Produce a mangled form of this constant.
+  ///
+  /// The common decl-based case is memoized in the ASTContext, since SILGen,
+  /// IRGen and TBDGen all re-mangle the same references repeatedly.
   std::string mangle(ManglingKind MKind = ManglingKind::Default) const;
 
   /// True if the SILDeclRef references a function.
@@ -432,6 +435,9 @@ struct SILDeclRef {
   bool hasAsync() const;
 
 private:
+  /// The uncached implementation of \c mangle.
+  std::string mangleImpl(ManglingKind MKind) const;
+
   friend struct llvm::DenseMapInfo<swift::SILDeclRef>;
   /// Produces a SILDeclRef from an opaque value.
   explicit SILDeclRef(void *opaqueLoc, Kind kind, bool isForeign,
@@ -151,6 +151,26 @@ private:
   /// Allocator that manages the memory of all the pieces of the SILModule.
   mutable llvm::BumpPtrAllocator BPA;
 
+  /// Alignment of all instruction allocations. Also the size of the header
+  /// which precedes each instruction and records its size class.
+  enum : unsigned { InstAlignment = 16 };
+
+  /// Number of instruction size classes; class \c n holds blocks of
+  /// <tt>(n + 1) * InstAlignment</tt> bytes, so free lists cover instructions
+  /// of up to 512 bytes. Larger allocations (rare, e.g. applies with many
+  /// substitutions) are not recycled and stay in the bump allocator.
+  enum : unsigned { NumInstFreeLists = 32 };
+
+  /// A deallocated instruction block, linked through its own storage.
+  struct InstFreeListNode {
+    InstFreeListNode *Next;
+  };
+
+  /// Per-size-class free lists of deallocated instruction memory.
+  /// \p allocateInst services requests from these before growing \p BPA, so
+  /// create/delete cycles in the optimizer reuse memory.
+  mutable InstFreeListNode *InstFreeLists[NumInstFreeLists] = {};
+
   /// The swift Module associated with this SILModule.
   ModuleDecl *TheSwiftModule;
 
@@ -165,6 +185,16 @@ private:
   llvm::StringMap<SILFunction *> FunctionTable;
   llvm::StringMap<SILFunction *> ZombieFunctionTable;
 
+  /// Generic specializations known to the optimizer, keyed by the generic
+  /// function, the canonical substitution map and the mangling-relevant
+  /// specialization flags. Lets repeated specialization queries probe
+  /// directly instead of materializing the specialized mangled name first.
+  /// Entries are never proactively removed; lookUpSpecialization treats a
+  /// zombie value as a miss and registerSpecialization overwrites it.
+  llvm::DenseMap<std::pair<const SILFunction *,
+                           std::pair<const void *, unsigned>>,
+                 SILFunction *> SpecializationTable;
+
   /// The list of SILFunctions in the module.
   FunctionListType functions;
 
@@ -556,6 +586,21 @@ public:
   /// \return null if this module has no such function
   SILFunction *lookUpFunction(SILDeclRef fnRef);
 
+  /// Look up a previously registered specialization of \p genericFn for the
+  /// given substitutions. \p flags must match the value that was passed to
+  /// registerSpecialization.
+  ///
+  /// \return null if no (live) specialization is registered.
+  SILFunction *lookUpSpecialization(const SILFunction *genericFn,
+                                    SubstitutionMap subs, unsigned flags);
+
+  /// Record \p specialization as the specialization of \p genericFn for the
+  /// given substitutions, so later queries can find it without re-mangling
+  /// its name.
+  void registerSpecialization(const SILFunction *genericFn,
+                              SubstitutionMap subs, unsigned flags,
+                              SILFunction *specialization);
+
   /// Attempt to deserialize the SILFunction. Returns true if deserialization
   /// succeeded, false otherwise.
   bool loadFunction(SILFunction *F);
@@ -679,6 +724,12 @@ public:
   /// invariants.
   void verify() const;
 
+  /// Run the SIL verifier, but only check the bodies of those functions for
+  /// which \p shouldVerifyFunction returns true. Module-level structures
+  /// (symbol uniqueness, vtables, witness tables) are always checked.
+  void verify(llvm::function_ref<bool(const SILFunction &)>
+                  shouldVerifyFunction) const;
+
   /// Check if there are any leaking instructions.
   ///
   /// Aborts with an error if more instructions are allocated than contained in
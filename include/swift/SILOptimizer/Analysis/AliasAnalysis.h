@@ -36,6 +36,10 @@ namespace {
     size_t V1, V2;
     // The TBAAType pair:
     void *T1, *T2;
+    // The cache generation of the queried function at the time the key was
+    // built. Bumping a function's generation makes all of its old keys
+    // unreachable, which invalidates them without scanning the cache.
+    size_t Gen;
   };
 
   /// A key used for the MemoryBehavior Analysis cache.
@@ -47,6 +51,9 @@ namespace {
   struct MemBehaviorKeyTy {
     // The SILValue pair:
     size_t V1, V2;
+    // The cache generation of the queried function at the time the key was
+    // built (see AliasKeyTy::Gen).
+    size_t Gen;
   };
 }
 
@@ -127,6 +134,19 @@ private:
   /// because doing so could give rise to collisions in the other cache.
   ValueEnumerator<SILNode*> MemoryBehaviorNodeToIndex;
 
+  /// The cache generation of each function. Cache keys embed the generation
+  /// of the queried function, so bumping a function's generation invalidates
+  /// all of its cached queries without scanning the caches or discarding the
+  /// results computed for other functions. Unreachable stale entries are
+  /// evicted by the regular cache size limit.
+  llvm::DenseMap<SILFunction *, size_t> FunctionGenerations;
+
+  /// Returns the current cache generation of \p F. Values without a function
+  /// (e.g. SILUndef) share generation zero.
+  size_t getCacheGeneration(SILFunction *F) {
+    return F ? FunctionGenerations.lookup(F) : 0;
+  }
+
   AliasResult aliasAddressProjection(SILValue V1, SILValue V2,
                                      SILValue O1, SILValue O2);
 
@@ -257,11 +277,14 @@ public:
   virtual void invalidate() override {
     AliasCache.clear();
     MemoryBehaviorCache.clear();
+    FunctionGenerations.clear();
   }
 
-  virtual void invalidate(SILFunction *,
+  virtual void invalidate(SILFunction *F,
                           SILAnalysis::InvalidationKind K) override {
-    invalidate();
+    // Invalidate all cached queries for \p F by bumping its generation
+    // instead of discarding the results computed for every other function.
+    ++FunctionGenerations[F];
   }
 
   /// Notify the analysis about a newly created function.
@@ -269,7 +292,12 @@ public:
 
   /// Notify the analysis about a function which will be deleted from the
   /// module.
-  virtual void notifyWillDeleteFunction(SILFunction *F) override {}
+  virtual void notifyWillDeleteFunction(SILFunction *F) override {
+    // Bump rather than erase the generation: if the memory of \p F is reused
+    // for a new function, the cached queries of the old function must not be
+    // visible to queries in the new one.
+    ++FunctionGenerations[F];
+  }
 
   virtual void invalidateFunctionTables() override { }
 };
@@ -288,11 +316,11 @@ namespace llvm {
   template <> struct DenseMapInfo<AliasKeyTy> {
     static inline AliasKeyTy getEmptyKey() {
       auto Allone = std::numeric_limits<size_t>::max();
-      return {0, Allone, nullptr, nullptr};
+      return {0, Allone, nullptr, nullptr, 0};
     }
     static inline AliasKeyTy getTombstoneKey() {
       auto Allone = std::numeric_limits<size_t>::max();
-      return {Allone, 0, nullptr, nullptr};
+      return {Allone, 0, nullptr, nullptr, 0};
     }
     static unsigned getHashValue(const AliasKeyTy Val) {
       unsigned H = 0;
@@ -300,34 +328,37 @@ namespace llvm {
       H ^= DenseMapInfo<size_t>::getHashValue(Val.V2);
       H ^= DenseMapInfo<void *>::getHashValue(Val.T1);
       H ^= DenseMapInfo<void *>::getHashValue(Val.T2);
+      H ^= DenseMapInfo<size_t>::getHashValue(Val.Gen);
       return H;
     }
     static bool isEqual(const AliasKeyTy LHS, const AliasKeyTy RHS) {
       return LHS.V1 == RHS.V1 &&
              LHS.V2 == RHS.V2 &&
              LHS.T1 == RHS.T1 &&
-             LHS.T2 == RHS.T2;
+             LHS.T2 == RHS.T2 &&
+             LHS.Gen == RHS.Gen;
     }
   };
 
   template <> struct DenseMapInfo<MemBehaviorKeyTy> {
     static inline MemBehaviorKeyTy getEmptyKey() {
       auto Allone = std::numeric_limits<size_t>::max();
-      return {0, Allone};
+      return {0, Allone, 0};
     }
     static inline MemBehaviorKeyTy getTombstoneKey() {
       auto Allone = std::numeric_limits<size_t>::max();
-      return {Allone, 0};
+      return {Allone, 0, 0};
     }
     static unsigned getHashValue(const MemBehaviorKeyTy V) {
       unsigned H = 0;
       H ^= DenseMapInfo<size_t>::getHashValue(V.V1);
       H ^= DenseMapInfo<size_t>::getHashValue(V.V2);
+      H ^= DenseMapInfo<size_t>::getHashValue(V.Gen);
       return H;
     }
     static bool isEqual(const MemBehaviorKeyTy LHS,
                         const MemBehaviorKeyTy RHS) {
-      return LHS.V1 == RHS.V1 && LHS.V2 == RHS.V2;
+      return LHS.V1 == RHS.V1 && LHS.V2 == RHS.V2 && LHS.Gen == RHS.Gen;
     }
   };
 }
@@ -223,12 +223,13 @@ protected:
              "already added callees at the begin of visiting a function");
       numVisited++;
       FInfo->StateAndPosition = FunctionInfoBase<FunctionInfo>::Visited;
-      if (FInfo->isValid()) {
-        // Now it's good time to remove invalid caller entries.
-        // Note: we don't have to do this for function which are recomputed.
-        FInfo->removeInvalidCallers();
+      // Now it's a good time to remove invalid caller entries. Functions
+      // which are recomputed can also have caller entries, because the
+      // caller list is retained when a function is invalidated with
+      // invalidateKeepingCallers().
+      FInfo->removeInvalidCallers();
+      if (FInfo->isValid())
         return true;
-      }
       InitiallyUnscheduled.push_back(FInfo);
       // Set to valid.
       FInfo->UpdateID = CurrentUpdateID;
@@ -261,7 +262,11 @@ protected:
         while (Idx < Scheduled.size()) {
           FunctionInfo *FInfo = Scheduled[Idx++];
           for (const auto &E : FInfo->Callers) {
-            if (E.Caller->isVisited() && !E.Caller->isScheduled()) {
+            // Skip stale entries of a retained caller list: only callers
+            // which added their entry in this update-cycle incremented
+            // numUnscheduledCallees.
+            if (E.isValid() && E.Caller->isVisited() &&
+                !E.Caller->isScheduled()) {
               E.Caller->numUnscheduledCallees--;
               tryToSchedule(E.Caller);
             }
@@ -296,6 +301,16 @@ protected:
   /// Returns the ID of the current update-cycle.
   int getCurrentUpdateID() const { return CurrentUpdateID; }
 
+  /// Invalidates only the analysis data of \p FInfo itself, but keeps its
+  /// caller list. This lets a derived analysis defer the invalidation of the
+  /// callers until it is known if the recomputed analysis data actually
+  /// changed.
+  template<typename FunctionInfo>
+  void invalidateKeepingCallers(FunctionInfo *FInfo) {
+    FInfo->clear();
+    FInfo->UpdateID = 0;
+  }
+
   /// Invalidates \p FInfo, including all analysis data which depend on it, i.e.
   /// the callers.
   template<typename FunctionInfo>
@@ -1091,6 +1091,11 @@ private:
   /// Returns true if a release of \p V is known to not capture its content.
   bool deinitIsKnownToNotCapture(SILValue V);
 
+  /// Returns true if the call \p FAS to \p Callee, whose body is not visible
+  /// to the analysis, cannot let any argument escape, based on the callee's
+  /// effects attribute.
+  bool isNonEscapingEffectsCall(FullApplySite FAS, SILFunction *Callee);
+
   /// Sets all operands and results of \p I as global escaping.
   void setAllEscaping(SILInstruction *I, ConnectionGraph *ConGraph);
 
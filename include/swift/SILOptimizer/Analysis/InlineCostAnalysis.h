@@ -0,0 +1,62 @@
+//===--- InlineCostAnalysis.h - Inline cost summaries -----------*- C++ -*-===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2021 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef SWIFT_SILOPTIMIZER_ANALYSIS_INLINECOSTANALYSIS_H
+#define SWIFT_SILOPTIMIZER_ANALYSIS_INLINECOSTANALYSIS_H
+
+#include "swift/SIL/SILFunction.h"
+#include "swift/SILOptimizer/Analysis/Analysis.h"
+
+namespace swift {
+
+/// A summary of the inlining cost of a function body.
+///
+/// Computing the summary requires a scan over every instruction of the
+/// function, so it is cached by InlineCostAnalysis and recomputed only when
+/// the function body changes. This keeps the performance inliner from
+/// re-scanning the same callee every time one of its callers is revisited in
+/// a later inlining round.
+class InlineCostInfo {
+  /// The sum of the instruction inline costs of the function body.
+  int FullCost = 0;
+
+  friend class InlineCostAnalysis;
+  InlineCostInfo(SILFunction *F);
+
+public:
+  /// Returns the cost of the function body.
+  int getFullCost() const { return FullCost; }
+};
+
+/// Caches an InlineCostInfo summary per function.
+class InlineCostAnalysis : public FunctionAnalysisBase<InlineCostInfo> {
+public:
+  InlineCostAnalysis(SILModule *)
+      : FunctionAnalysisBase(SILAnalysisKind::InlineCost) {}
+
+  static bool classof(const SILAnalysis *S) {
+    return S->getKind() == SILAnalysisKind::InlineCost;
+  }
+
+  virtual bool shouldInvalidate(SILAnalysis::InvalidationKind K) override {
+    return K & InvalidationKind::Instructions;
+  }
+
+  virtual std::unique_ptr<InlineCostInfo>
+  newFunctionAnalysis(SILFunction *F) override {
+    return std::unique_ptr<InlineCostInfo>(new InlineCostInfo(F));
+  }
+};
+
+} // end namespace swift
+
+#endif
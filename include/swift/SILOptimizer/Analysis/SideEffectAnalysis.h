@@ -46,6 +46,7 @@ enum class RetainObserveKind {
 /// - bool mergeFrom(const FunctionSideEffects &)
 /// - bool mergeFromApply(const FunctionEffects &, FullApplySite)
 /// - void analyzeInstruction(SILInstruction *)
+/// - copy assignment, used to save the old effects for delta invalidation
 template <typename FunctionEffects>
 class GenericFunctionEffectAnalysis : public BottomUpIPAnalysis {
 
@@ -62,6 +63,16 @@ class GenericFunctionEffectAnalysis : public BottomUpIPAnalysis {
     /// must be updated.
     bool needUpdateCallers = false;
 
+    /// The effects from before the last invalidation of this function. Only
+    /// valid if \p hasSavedEffects is true. It is used in
+    /// updateStaleFunctions() to check if the recomputed effects actually
+    /// changed.
+    FunctionEffects savedEffects;
+
+    /// True if this function was invalidated and awaits an update of its
+    /// callers in updateStaleFunctions().
+    bool hasSavedEffects = false;
+
     FunctionInfo(SILFunction *F) : F(F) {}
 
     /// Clears the analysis data on invalidation.
@@ -88,11 +99,20 @@ class GenericFunctionEffectAnalysis : public BottomUpIPAnalysis {
   /// Callee analysis, used for determining the callees at call sites.
   BasicCalleeAnalysis *BCA;
 
+  /// Functions which have been invalidated, but whose callers are only
+  /// invalidated in updateStaleFunctions() if the recomputed effects are not
+  /// covered by the old effects.
+  llvm::SmallVector<FunctionInfo *, 8> staleFunctions;
+
+  /// True while updateStaleFunctions() is running.
+  bool updatingStaleFunctions = false;
+
 public:
   GenericFunctionEffectAnalysis(SILAnalysisKind kind)
       : BottomUpIPAnalysis(kind) {}
 
   const FunctionEffects &getEffects(SILFunction *F) {
+    updateStaleFunctions();
     FunctionInfo *functionInfo = getFunctionInfo(F);
     if (!functionInfo->isValid())
       recompute(functionInfo);
@@ -128,7 +148,13 @@ public:
   /// Notify the analysis about a function which will be deleted from the
   /// module.
   virtual void notifyWillDeleteFunction(SILFunction *F) override {
-    invalidate(F, InvalidationKind::Nothing);
+    if (FunctionInfo *FInfo = functionInfoMap.lookup(F)) {
+      // The effects cannot be recomputed once the function body is deleted,
+      // so the callers must be invalidated immediately instead of lazily in
+      // updateStaleFunctions().
+      FInfo->hasSavedEffects = false;
+      invalidateIncludingAllCallers(FInfo);
+    }
   }
 
   /// Notify the analysis about changed witness or vtables.
@@ -156,6 +182,16 @@ private:
   /// Recomputes the side-effect information for the function \p Initial and
   /// all called functions, up to a recursion depth of MaxRecursionDepth.
   void recompute(FunctionInfo *initialInfo);
+
+  /// Invalidates the effects of \p FInfo, but not of its callers. The old
+  /// effects are saved and the callers are only invalidated in
+  /// updateStaleFunctions() if the recomputed effects are not covered by the
+  /// old effects.
+  void invalidateDelayingCallers(FunctionInfo *FInfo);
+
+  /// Recomputes the effects of all invalidated functions and invalidates
+  /// callers where the effects actually changed.
+  void updateStaleFunctions();
 };
 
 /// Set \p dest if \p src is set and return true if \p dest was not set
@@ -15,9 +15,11 @@
 #include "swift/SILOptimizer/PassManager/PassPipeline.h"
 #include "swift/SILOptimizer/PassManager/Passes.h"
 #include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/Hashing.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/Support/Casting.h"
 #include "llvm/Support/ErrorHandling.h"
+#include <functional>
 #include <vector>
 
 #ifndef SWIFT_SILOPTIMIZER_PASSMANAGER_PASSMANAGER_H
@@ -41,6 +43,13 @@ void executePassPipelinePlan(SILModule *SM, const SILPassPipelinePlan &plan,
                              bool isMandatory = false,
                              irgen::IRGenModule *IRMod = nullptr);
 
+/// Install a callback that is invoked after every transform executed by any
+/// pass manager, with the transform and its execution time in nanoseconds.
+/// Used by tooling (e.g. sil-opt's -benchmark-iterations mode) to collect
+/// per-pass timings; pass a null function to remove the callback again.
+void setSILPassExecutionTimeCallback(
+    std::function<void(SILTransform *, int64_t)> callback);
+
 /// The SIL pass manager.
 class SILPassManager {
   friend class ExecuteSILPipelineRequest;
@@ -73,6 +82,20 @@ class SILPassManager {
   /// The worklist of functions to be processed by function passes.
   std::vector<WorklistEntry> FunctionWorklist;
 
+  /// The functions of the module in bottom-up call-graph order, cached
+  /// across the function-pass segments of the pipeline. Computing the order
+  /// requires a whole-module walk of the call graph, so we keep it until a
+  /// pass reports a change which can affect the shape of the call graph.
+  std::vector<SILFunction *> BottomUpOrderCache;
+
+  /// The number of functions in the module when \p BottomUpOrderCache was
+  /// computed. A mismatch indicates that functions were added behind the
+  /// pass manager's back, e.g. by deserialization.
+  unsigned BottomUpOrderFunctionCount = 0;
+
+  /// True if \p BottomUpOrderCache is up-to-date.
+  bool BottomUpOrderCacheValid = false;
+
   // Name of the current optimization stage for diagnostics.
   std::string StageName;
 
@@ -87,6 +110,18 @@ class SILPassManager {
   /// A completed-passes mask for each function.
   llvm::DenseMap<SILFunction *, CompletedPasses> CompletedPassesMap;
 
+  /// A structural fingerprint of the body of each function, taken after the
+  /// last pass which ran on it. It is used to detect passes which report an
+  /// invalidation without actually modifying the function, so that their
+  /// conservatism does not defeat pass skipping.
+  llvm::DenseMap<SILFunction *, llvm::hash_code> StructuralHashes;
+
+  /// The structural fingerprint each function had when it was last verified.
+  /// Only maintained with -sil-verify-incrementally, where it lets a
+  /// whole-module verification skip functions that have not changed since
+  /// they last passed the verifier.
+  llvm::DenseMap<SILFunction *, llvm::hash_code> VerifiedFunctionHashes;
+
   /// Stores for each function the number of levels of specializations it is
   /// derived from an original function. E.g. if a function is a signature
   /// optimized specialization of a generic specialization, it has level 2.
@@ -153,6 +188,7 @@ public:
         AP->invalidate();
 
     CurrentPassHasInvalidated = true;
+    BottomUpOrderCacheValid = false;
 
     // Assume that all functions have changed. Clear all masks of all functions.
     CompletedPassesMap.clear();
@@ -185,8 +221,10 @@ public:
     for (auto AP : Analyses)
       if (!AP->isLocked())
         AP->invalidate(F, K);
-    
+
     CurrentPassHasInvalidated = true;
+    if (K & SILAnalysis::InvalidationKind::Calls)
+      BottomUpOrderCacheValid = false;
     // Any change let all passes run again.
     CompletedPassesMap[F].reset();
   }
@@ -200,6 +238,7 @@ public:
         AP->invalidateFunctionTables();
 
     CurrentPassHasInvalidated = true;
+    BottomUpOrderCacheValid = false;
 
     // Assume that all functions have changed. Clear all masks of all functions.
     CompletedPassesMap.clear();
@@ -213,6 +252,11 @@ public:
         AP->notifyWillDeleteFunction(F);
 
     CurrentPassHasInvalidated = true;
+    // The cached order must not keep a dangling pointer to \p F.
+    BottomUpOrderCacheValid = false;
+    // A later function may be allocated at the same address.
+    StructuralHashes.erase(F);
+    VerifiedFunctionHashes.erase(F);
     // Any change let all passes run again.
     CompletedPassesMap[F].reset();
   }
@@ -281,6 +325,10 @@ private:
   /// Run the passes in Transform from \p FromTransIdx to \p ToTransIdx.
   void runFunctionPasses(unsigned FromTransIdx, unsigned ToTransIdx);
 
+  /// Return the functions of the module in bottom-up call-graph order,
+  /// recomputing the cached order if it went stale.
+  llvm::ArrayRef<SILFunction *> getBottomUpFunctionOrder();
+
   /// Helper function to check if the function pass should be run mandatorily
   /// All passes in mandatory pass pipeline and ownership model elimination are
   /// mandatory function passes.
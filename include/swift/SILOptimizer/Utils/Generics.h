@@ -361,9 +361,10 @@ public:
     return SpecializedF;
   }
 
-  StringRef getClonedName() {
-    return ClonedName;
-  }
+  /// Return the mangled name of the specialization, computing it on first
+  /// use. The name is only needed when the module-level specialization
+  /// registry misses.
+  StringRef getClonedName();
 };
 
 // =============================================================================
@@ -1115,6 +1115,12 @@ class Solution {
   /// The fixed score for this solution.
   Score FixedScore;
 
+  /// Memoized results of \c simplifyType. Type variable bindings are fixed
+  /// once a solution has been formed, so a given type always simplifies the
+  /// same way; solution application asks for many of the same types
+  /// repeatedly.
+  mutable llvm::DenseMap<TypeBase *, Type> SimplifiedTypes;
+
 public:
   /// Create a solution for the given constraint system.
   Solution(ConstraintSystem &cs, const Score &score)
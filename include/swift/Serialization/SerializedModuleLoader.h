@@ -16,6 +16,8 @@
 #include "swift/AST/FileUnit.h"
 #include "swift/AST/Module.h"
 #include "swift/AST/ModuleLoader.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/ADT/StringSet.h"
 #include "llvm/Support/MemoryBuffer.h"
 
 namespace swift {
@@ -61,6 +63,23 @@ class SerializedModuleLoaderBase : public ModuleLoader {
 
   SmallVector<std::unique_ptr<ModuleFile>, 2> OrphanedModuleFiles;
 
+  /// For each module search path, the first-extension-stripped names of its
+  /// directory entries, listed once and reused for every import. Lets
+  /// \c findModule answer most candidate existence checks without issuing a
+  /// stat per extension and target triple. A \c None value means the listing
+  /// could not be read and candidates in that directory must be probed
+  /// directly.
+  llvm::StringMap<Optional<llvm::StringSet<>>> SearchPathModuleNamesCache;
+
+  /// Whether \p searchPath might contain any file or directory whose name
+  /// starts with "<moduleName>.", according to a cached directory listing.
+  ///
+  /// Names are compared case-insensitively so the cache stays a superset of
+  /// what a case-insensitive filesystem would match. Returns true when no
+  /// listing is available, so callers fall back to probing the filesystem.
+  bool searchPathMightContainModule(StringRef searchPath,
+                                    StringRef moduleName);
+
 protected:
   ASTContext &Ctx;
   ModuleLoadingMode LoadMode;
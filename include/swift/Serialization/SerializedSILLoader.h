@@ -19,6 +19,7 @@
 #include "swift/SIL/Notifications.h"
 #include "swift/SIL/SILDeclRef.h"
 #include "swift/SIL/SILLinkage.h"
+#include "llvm/ADT/StringMap.h"
 #include <memory>
 #include <vector>
 
@@ -42,6 +43,15 @@ class SerializedSILLoader {
 private:
   std::vector<std::unique_ptr<SILDeserializer>> LoadedSILSections;
 
+  /// Maps a function name to the index of the section in
+  /// \c LoadedSILSections that is known to hold its definition.
+  ///
+  /// Function bodies are decoded lazily at the offsets recorded in each
+  /// module's function table; when a declaration is deferred and the body
+  /// is requested later, this lets us jump straight to the owning module
+  /// instead of probing the hash table of every loaded section again.
+  llvm::StringMap<unsigned> FuncOwningSection;
+
   explicit SerializedSILLoader(
       ASTContext &ctx, SILModule *SILMod,
       DeserializationNotificationHandlerSet *callbacks);
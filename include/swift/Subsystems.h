@@ -137,6 +137,12 @@ namespace swift {
   /// and diagnose problems therein.
   void performTypeChecking(SourceFile &SF);
 
+  /// Build the complete hierarchy of TypeRefinementContexts for the given
+  /// source file. The hierarchy is normally built lazily, one top-level
+  /// declaration at a time; this forces the remainder, for clients that want
+  /// to inspect the whole hierarchy.
+  void buildTypeRefinementContexts(SourceFile &SF);
+
   /// Now that we have type-checked an entire module, perform any type
   /// checking that requires the full module, e.g., Objective-C method
   /// override checking.
@@ -72,6 +72,20 @@ SWIFT_REMOTE_MIRROR_LINKAGE
 void
 swift_reflection_destroyReflectionContext(SwiftReflectionContextRef Context);
 
+/// Enable or disable caching of remote reads at page granularity.
+///
+/// While caching is enabled, uncached pages covering a requested range are
+/// fetched in bulk and all subsequent reads of those pages are served
+/// locally, amortizing the per-read overhead of fine-grained remote reads
+/// during bulk operations such as heap enumeration. The caller must only
+/// enable caching while the remote process is suspended or otherwise known
+/// not to mutate the memory being inspected; disabling caching drops the
+/// cached pages.
+SWIFT_REMOTE_MIRROR_LINKAGE
+void
+swift_reflection_setCacheRemoteReads(SwiftReflectionContextRef ContextRef,
+                                     int EnableCaching);
+
 /// DEPRECATED. Add reflection sections for a loaded Swift image.
 ///
 /// You probably want to use \c swift_reflection_addImage instead.
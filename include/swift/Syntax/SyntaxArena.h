@@ -19,19 +19,43 @@
 
 #include "llvm/ADT/IntrusiveRefCntPtr.h"
 #include "llvm/Support/Allocator.h"
+#include <atomic>
 
 namespace swift {
 namespace syntax {
 
 /// Memory manager for Syntax nodes.
-class SyntaxArena : public llvm::ThreadSafeRefCountedBase<SyntaxArena> {
+class SyntaxArena {
   SyntaxArena(const SyntaxArena &) = delete;
   void operator=(const SyntaxArena &) = delete;
 
   llvm::BumpPtrAllocator Allocator;
 
+  mutable std::atomic<int> RefCount;
+
+  /// Reset \p arena and either put it into the pool of reusable arenas or
+  /// delete it if the pool is full.
+  static void recycle(SyntaxArena *arena);
+
 public:
-  SyntaxArena() {}
+  SyntaxArena() : RefCount(0) {}
+
+  /// Return a fresh arena, reusing the memory slabs of a retired arena if
+  /// one is available. Syntax trees are typically built in bursts (e.g. one
+  /// tree per editor request), so recycling the slabs avoids re-growing the
+  /// allocator from its initial size for every tree.
+  static llvm::IntrusiveRefCntPtr<SyntaxArena> make();
+
+  // This replicates llvm::ThreadSafeRefCountedBase, except that an arena
+  // whose reference count drops to zero is recycled instead of deleted.
+  void Retain() const { RefCount.fetch_add(1, std::memory_order_relaxed); }
+
+  void Release() const {
+    int NewRefCount = RefCount.fetch_sub(1, std::memory_order_acq_rel) - 1;
+    assert(NewRefCount >= 0 && "Reference count was already zero.");
+    if (NewRefCount == 0)
+      recycle(const_cast<SyntaxArena *>(this));
+  }
 
   llvm::BumpPtrAllocator &getAllocator() { return Allocator; }
   void *Allocate(size_t size, size_t alignment) {
@@ -13,6 +13,7 @@
 #ifndef SWIFT_SYNTAX_PARSE_SYNTAXTREECREATOR_H
 #define SWIFT_SYNTAX_PARSE_SYNTAXTREECREATOR_H
 
+#include "swift/Basic/OwnedString.h"
 #include "swift/Parse/SyntaxParseActions.h"
 #include "swift/Syntax/References.h"
 
@@ -38,6 +39,11 @@ class SyntaxTreeCreator: public SyntaxParseActions {
   unsigned BufferID;
   RC<syntax::SyntaxArena> Arena;
 
+  /// A single ref-counted copy of the buffer's text. Token and trivia text
+  /// is sliced out of it, so recording a token shares this one allocation
+  /// instead of copying the text into a fresh one per node.
+  OwnedString SourceText;
+
   /// A cache of nodes that can be reused when creating the current syntax
   /// tree.
   SyntaxParsingCache *SyntaxCache;
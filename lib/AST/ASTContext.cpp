@@ -41,6 +41,7 @@
 #include "swift/AST/PropertyWrappers.h"
 #include "swift/AST/ProtocolConformance.h"
 #include "swift/AST/RawComment.h"
+#include "swift/AST/RequirementEnvironment.h"
 #include "swift/AST/SILLayout.h"
 #include "swift/AST/SemanticAttrs.h"
 #include "swift/AST/SourceFile.h"
@@ -50,6 +51,7 @@
 #include "swift/Basic/SourceManager.h"
 #include "swift/Basic/Statistic.h"
 #include "swift/Basic/StringExtras.h"
+#include "swift/Markup/Markup.h"
 #include "swift/Strings.h"
 #include "swift/Subsystems.h"
 #include "swift/Syntax/References.h"
@@ -59,9 +61,11 @@
 #include "llvm/ADT/Statistic.h"
 #include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/StringSwitch.h"
+#include "llvm/ADT/Hashing.h"
 #include "llvm/IR/LLVMContext.h"
 #include "llvm/Support/Allocator.h"
 #include "llvm/Support/Compiler.h"
+#include "llvm/Support/Mutex.h"
 #include <algorithm>
 #include <memory>
 
@@ -164,10 +168,26 @@ struct ASTContext::Implementation {
   /// DenseMap.
   llvm::MapVector<Identifier, ModuleDecl *> LoadedModules;
 
-  // FIXME: This is a StringMap rather than a StringSet because StringSet
-  // doesn't allow passing in a pre-existing allocator.
-  llvm::StringMap<Identifier::Aligner, llvm::BumpPtrAllocator&>
-  IdentifierTable;
+  /// Identifier uniquing is sharded by string hash so that concurrent
+  /// clients (e.g. a future parallel parse or Sema) contend on separate
+  /// locks instead of serializing on a single table. Each shard owns its
+  /// allocator, and StringMap entries never move on rehash, so the
+  /// Identifier pointer-stability guarantee is unaffected.
+  struct IdentifierTableShard {
+    mutable llvm::sys::SmartMutex<true> Mutex;
+    llvm::BumpPtrAllocator Allocator;
+    // FIXME: This is a StringMap rather than a StringSet because StringSet
+    // doesn't allow passing in a pre-existing allocator.
+    llvm::StringMap<Identifier::Aligner, llvm::BumpPtrAllocator&> Table;
+    IdentifierTableShard() : Table(Allocator) {}
+  };
+  enum : unsigned { NumIdentifierShards = 8 };
+  IdentifierTableShard IdentifierTable[NumIdentifierShards];
+
+  /// Memoized mangled names, keyed by an entity pointer and a
+  /// consumer-defined discriminator. See ASTContext::getOrCacheMangledName.
+  llvm::DenseMap<std::pair<const void *, unsigned>, std::string>
+      MangledNameCache;
 
   /// The declaration of Swift.AssignmentPrecedence.
   PrecedenceGroupDecl *AssignmentPrecedence = nullptr;
@@ -284,6 +304,15 @@ struct ASTContext::Implementation {
   /// Map from Swift declarations to brief comments.
   llvm::DenseMap<const Decl *, StringRef> BriefComments;
 
+  /// Map from Swift declarations to parsed doc comments, keyed additionally
+  /// by whether serialized comment data was allowed when parsing.
+  llvm::DenseMap<llvm::PointerIntPair<const Decl *, 1, bool>, DocComment *>
+      DocComments;
+
+  /// The markup context owning the nodes of cached doc comments. Created
+  /// lazily; most compilations never parse doc markup.
+  std::unique_ptr<markup::MarkupContext> DocCommentMarkupContext;
+
   /// Map from declarations to foreign error conventions.
   /// This applies to both actual imported functions and to @objc functions.
   llvm::DenseMap<const AbstractFunctionDecl *,
@@ -318,6 +347,24 @@ struct ASTContext::Implementation {
   /// The existential signature <T : P> for each P.
   llvm::DenseMap<CanType, CanGenericSignature> ExistentialSignatures;
 
+  /// Requirement environments used when matching witnesses, uniqued by
+  /// requirement signature, conformance, conformance context and covariant
+  /// 'Self' class. The values are allocated separately because callers hold
+  /// references across operations that can grow this map.
+  llvm::DenseMap<std::pair<std::pair<const GenericSignatureImpl *,
+                                     const ProtocolConformance *>,
+                           std::pair<const DeclContext *, const ClassDecl *>>,
+                 std::unique_ptr<RequirementEnvironment>>
+      RequirementEnvironments;
+
+  /// Resolved types for written type annotations, keyed by annotation
+  /// text, declaration context, generic signature and resolution mode.
+  /// \see ASTContext::cacheResolvedType.
+  llvm::DenseMap<std::pair<std::pair<const void *, const DeclContext *>,
+                           std::pair<const void *, uint64_t>>,
+                 ASTContext::CachedResolvedAnnotation>
+      ResolvedAnnotationTypes;
+
   /// Overridden declarations.
   llvm::DenseMap<const ValueDecl *, ArrayRef<ValueDecl *>> Overrides;
 
@@ -367,6 +414,13 @@ struct ASTContext::Implementation {
     llvm::DenseMap<Type, ErrorType *> ErrorTypesWithOriginal;
     llvm::FoldingSet<TypeAliasType> TypeAliasTypes;
     llvm::FoldingSet<TupleType> TupleTypes;
+    /// Flat fast path for the most common tuple shapes: unlabeled 2- and
+    /// 3-element tuples whose elements carry no parameter flags. Keyed by
+    /// the element type pointers directly (third null for pairs), which
+    /// avoids both the FoldingSet profile computation and the bucket-chain
+    /// walk. Tuples stored here are never entered in \c TupleTypes.
+    llvm::DenseMap<std::pair<TypeBase *, std::pair<TypeBase *, TypeBase *>>,
+                   TupleType *> SimpleTupleTypes;
     llvm::DenseMap<llvm::PointerIntPair<TypeBase*, 3, unsigned>,
                    MetatypeType*> MetatypeTypes;
     llvm::DenseMap<llvm::PointerIntPair<TypeBase*, 3, unsigned>,
@@ -511,8 +565,7 @@ struct ASTContext::Implementation {
 };
 
 ASTContext::Implementation::Implementation()
-    : IdentifierTable(Allocator),
-      TheSyntaxArena(new syntax::SyntaxArena())
+    : TheSyntaxArena(syntax::SyntaxArena::make())
 #if !SWIFT_BUILD_ONLY_SYNTAXPARSERLIB
       , IntrinsicScratchContext(new llvm::LLVMContext())
 #endif
@@ -681,11 +734,29 @@ Identifier ASTContext::getIdentifier(StringRef Str) const {
   if (Str.data() == nullptr)
     return Identifier(nullptr);
 
+  auto &shard = getImpl().IdentifierTable[
+      llvm::hash_value(Str) % Implementation::NumIdentifierShards];
+  llvm::sys::SmartScopedLock<true> lock(shard.Mutex);
   auto pair = std::make_pair(Str, Identifier::Aligner());
-  auto I = getImpl().IdentifierTable.insert(pair).first;
+  auto I = shard.Table.insert(pair).first;
   return Identifier(I->getKeyData());
 }
 
+std::string ASTContext::getOrCacheMangledName(
+    const void *entity, unsigned discriminator,
+    llvm::function_ref<std::string()> mangle) const {
+  auto &cache = getImpl().MangledNameCache;
+  auto key = std::make_pair(entity, discriminator);
+  auto known = cache.find(key);
+  if (known != cache.end())
+    return known->second;
+
+  // Note: \p mangle may recurse back into the cache, so don't hold an
+  // iterator across the call.
+  std::string name = mangle();
+  return cache.try_emplace(key, std::move(name)).first->second;
+}
+
 void ASTContext::lookupInSwiftModule(
                    StringRef name,
                    SmallVectorImpl<ValueDecl *> &results) const {
@@ -1658,6 +1729,48 @@ static AllocationArena getArena(GenericSignature genericSig) {
   return AllocationArena::Permanent;
 }
 
+const RequirementEnvironment &ASTContext::getOrCreateRequirementEnvironment(
+    DeclContext *conformanceDC, GenericSignature reqSig, ProtocolDecl *proto,
+    ClassDecl *covariantSelf, ProtocolConformance *conformance) {
+  auto &environments = getImpl().RequirementEnvironments;
+  decltype(environments)::key_type key{{reqSig.getPointer(), conformance},
+                                       {conformanceDC, covariantSelf}};
+  auto known = environments.find(key);
+  if (known != environments.end()) {
+    if (Stats)
+      ++Stats->getFrontendCounters().NumRequirementEnvironmentHits;
+    return *known->second;
+  }
+
+  if (Stats)
+    ++Stats->getFrontendCounters().NumRequirementEnvironmentMisses;
+  auto reqEnv = std::make_unique<RequirementEnvironment>(
+      conformanceDC, reqSig, proto, covariantSelf, conformance);
+  return *environments.insert({key, std::move(reqEnv)}).first->second;
+}
+
+const ASTContext::CachedResolvedAnnotation *
+ASTContext::getCachedResolvedType(Identifier annotationText,
+                                  const DeclContext *dc,
+                                  const void *genericSig,
+                                  uint64_t mode) const {
+  auto &types = getImpl().ResolvedAnnotationTypes;
+  auto known = types.find(
+      {{annotationText.getAsOpaquePointer(), dc}, {genericSig, mode}});
+  if (known == types.end())
+    return nullptr;
+  return &known->second;
+}
+
+void ASTContext::cacheResolvedType(Identifier annotationText,
+                                   const DeclContext *dc,
+                                   const void *genericSig, uint64_t mode,
+                                   CachedResolvedAnnotation entry) {
+  getImpl().ResolvedAnnotationTypes.insert(
+      {{{annotationText.getAsOpaquePointer(), dc}, {genericSig, mode}},
+       std::move(entry)});
+}
+
 void ASTContext::registerGenericSignatureBuilder(
                                        GenericSignature sig,
                                        GenericSignatureBuilder &&builder) {
@@ -1999,6 +2112,27 @@ void ASTContext::setBriefComment(const Decl *D, StringRef Comment) {
   getImpl().BriefComments[D] = Comment;
 }
 
+DocComment *ASTContext::getDocComment(const Decl *D, bool AllowSerialized) {
+  auto &Comments = getImpl().DocComments;
+  auto Known = Comments.find({D, AllowSerialized});
+  if (Known == Comments.end())
+    return nullptr;
+
+  return Known->second;
+}
+
+void ASTContext::setDocComment(const Decl *D, bool AllowSerialized,
+                               DocComment *DC) {
+  getImpl().DocComments[{D, AllowSerialized}] = DC;
+}
+
+markup::MarkupContext &ASTContext::getDocCommentMarkupContext() {
+  auto &MC = getImpl().DocCommentMarkupContext;
+  if (!MC)
+    MC = std::make_unique<markup::MarkupContext>();
+  return *MC;
+}
+
 NormalProtocolConformance *
 ASTContext::getConformance(Type conformingType,
                            ProtocolDecl *protocol,
@@ -2223,6 +2357,7 @@ size_t ASTContext::getTotalMemory() const {
     llvm::capacity_in_bytes(getImpl().ModuleLoaders) +
     llvm::capacity_in_bytes(getImpl().RawComments) +
     llvm::capacity_in_bytes(getImpl().BriefComments) +
+    llvm::capacity_in_bytes(getImpl().DocComments) +
     llvm::capacity_in_bytes(getImpl().ModuleTypes) +
     llvm::capacity_in_bytes(getImpl().GenericParamTypes) +
     // getImpl().GenericFunctionTypes ?
@@ -2236,6 +2371,9 @@ size_t ASTContext::getTotalMemory() const {
     getImpl().OpenedExistentialArchetypes.getMemorySize() +
     getImpl().Permanent.getTotalMemory();
 
+    for (auto &shard : getImpl().IdentifierTable)
+      Size += shard.Allocator.getTotalMemory();
+
     Size += getSolverMemory();
 
     return Size;
@@ -2532,15 +2670,39 @@ Type TupleType::get(ArrayRef<TupleTypeElt> Fields, const ASTContext &C) {
   }
 
   auto arena = getArena(properties);
+  auto &ctxArena = C.getImpl().getArena(arena);
+
+  // Unlabeled 2- and 3-element tuples with default element flags are common
+  // enough to get a flat table keyed directly by the element types.
+  bool isSimple = Fields.size() == 2 || Fields.size() == 3;
+  if (isSimple) {
+    for (const TupleTypeElt &Elt : Fields) {
+      if (Elt.hasName() || Elt.getType().isNull() ||
+          !Elt.getParameterFlags().isNone()) {
+        isSimple = false;
+        break;
+      }
+    }
+  }
+  std::pair<TypeBase *, std::pair<TypeBase *, TypeBase *>> simpleKey;
+  if (isSimple) {
+    simpleKey = {Fields[0].getType().getPointer(),
+                 {Fields[1].getType().getPointer(),
+                  Fields.size() == 3 ? Fields[2].getType().getPointer()
+                                     : nullptr}};
+    if (TupleType *TT = ctxArena.SimpleTupleTypes.lookup(simpleKey))
+      return TT;
+  }
 
   void *InsertPos = nullptr;
-  // Check to see if we've already seen this tuple before.
-  llvm::FoldingSetNodeID ID;
-  TupleType::Profile(ID, Fields);
+  if (!isSimple) {
+    // Check to see if we've already seen this tuple before.
+    llvm::FoldingSetNodeID ID;
+    TupleType::Profile(ID, Fields);
 
-  if (TupleType *TT
-        = C.getImpl().getArena(arena).TupleTypes.FindNodeOrInsertPos(ID,InsertPos))
-    return TT;
+    if (TupleType *TT = ctxArena.TupleTypes.FindNodeOrInsertPos(ID, InsertPos))
+      return TT;
+  }
 
   bool IsCanonical = true;   // All canonical elts means this is canonical.
   for (const TupleTypeElt &Elt : Fields) {
@@ -2555,7 +2717,10 @@ Type TupleType::get(ArrayRef<TupleTypeElt> Fields, const ASTContext &C) {
   void *mem = C.Allocate(bytes, alignof(TupleType), arena);
   auto New = new (mem) TupleType(Fields, IsCanonical ? &C : nullptr, properties,
                                  hasElementWithOwnership);
-  C.getImpl().getArena(arena).TupleTypes.InsertNode(New, InsertPos);
+  if (isSimple)
+    ctxArena.SimpleTupleTypes[simpleKey] = New;
+  else
+    ctxArena.TupleTypes.InsertNode(New, InsertPos);
   return New;
 }
 
@@ -218,6 +218,10 @@ void ASTScope::expandFunctionBodyImpl(AbstractFunctionDecl *AFD) {
   impl->expandFunctionBody(AFD);
 }
 
+bool ASTScope::invalidateFunctionBody(AbstractFunctionDecl *AFD) {
+  return impl->invalidateFunctionBody(AFD);
+}
+
 ASTSourceFileScope *ASTScope::createScopeTree(SourceFile *SF) {
   ScopeCreator *scopeCreator = new (SF->getASTContext()) ScopeCreator(SF);
   return scopeCreator->sourceFileScope;
@@ -245,6 +249,43 @@ void ASTSourceFileScope::expandFunctionBody(AbstractFunctionDecl *AFD) {
   bodyScope->expandAndBeCurrentDetectingRecursion(*scopeCreator);
 }
 
+bool ASTSourceFileScope::invalidateFunctionBody(AbstractFunctionDecl *AFD) {
+  if (!AFD)
+    return false;
+  auto sr = AFD->getOriginalBodySourceRange();
+  if (sr.isInvalid())
+    return false;
+
+  // Walk down only the scopes that already exist; unlike
+  // findInnermostEnclosingScope this must not expand anything, since
+  // expansion of the stale body is exactly what we're here to prevent.
+  // The body scope keeps the original source range even after the body is
+  // replaced, so the walk stays within the ranges the tree was built with.
+  auto &sourceMgr = getSourceManager();
+  ASTScopeImpl *scope = this;
+  while (scope->getWasExpanded()) {
+    auto child = scope->findChildContaining(sr.Start, sourceMgr);
+    if (!child)
+      return false;
+    scope = child.get();
+    if (scope->isBodyScopeOf(AFD)) {
+      scope->discardExpandedState();
+      // Memoized local lookups may hold decls from the old body.
+      const_cast<SourceFile *>(getSourceFile())->clearLocalLookupCache();
+      return true;
+    }
+  }
+
+  // The body scope was never created, so no scopes describe the old body.
+  return true;
+}
+
+void ASTScopeImpl::discardExpandedState() {
+  storedChildren.clear();
+  wasExpanded = false;
+  cachedCharSourceRange = None;
+}
+
 ASTSourceFileScope::ASTSourceFileScope(SourceFile *SF,
                                        ScopeCreator *scopeCreator)
     : SF(SF), scopeCreator(scopeCreator) {}
@@ -592,6 +633,10 @@ void ASTScopeImpl::addChild(ASTScopeImpl *child, ASTContext &ctx) {
     haveAddedCleanup = true;
   }
   storedChildren.push_back(child);
+
+  // The new scope may introduce declarations between a memoized lookup's
+  // starting point and the root, so drop any memoized results.
+  const_cast<SourceFile *>(getSourceFile())->clearLocalLookupCache();
 }
 
 #pragma mark implementations of expansion
@@ -4715,16 +4715,27 @@ bool ProtocolDecl::walkInheritedProtocols(
 
 }
 
+ArrayRef<ProtocolDecl *> ProtocolDecl::getAllInheritedProtocols() const {
+  auto *mutThis = const_cast<ProtocolDecl *>(this);
+  return evaluateOrDefault(getASTContext().evaluator,
+                           AllInheritedProtocolsRequest{mutThis},
+                           {});
+}
+
 bool ProtocolDecl::inheritsFrom(const ProtocolDecl *super) const {
   if (this == super)
     return false;
 
-  return walkInheritedProtocols([super](ProtocolDecl *inherited) {
-    if (inherited == super)
-      return TypeWalker::Action::Stop;
-
-    return TypeWalker::Action::Continue;
-  });
+  // The closure of inherited protocols is canonically sorted, so probe it
+  // with a binary search instead of walking the inheritance graph.
+  auto allInherited = getAllInheritedProtocols();
+  auto found = std::lower_bound(allInherited.begin(), allInherited.end(),
+                                super,
+                                [](const ProtocolDecl *lhs,
+                                   const ProtocolDecl *rhs) {
+                                  return TypeDecl::compare(lhs, rhs) < 0;
+                                });
+  return found != allInherited.end() && *found == super;
 }
 
 bool ProtocolDecl::requiresClass() const {
@@ -29,6 +29,7 @@
 #include "swift/Config.h"
 #include "swift/Localization/LocalizationFormat.h"
 #include "swift/Parse/Lexer.h" // bad dependency
+#include "llvm/ADT/Hashing.h"
 #include "llvm/ADT/SmallString.h"
 #include "llvm/ADT/Twine.h"
 #include "llvm/Support/CommandLine.h"
@@ -857,6 +858,7 @@ DiagnosticState::Behavior DiagnosticState::determineBehavior(DiagID id) {
 
 void DiagnosticEngine::flushActiveDiagnostic() {
   assert(ActiveDiagnostic && "No active diagnostic to flush");
+  ++FlushedDiagnosticCount;
   if (TransactionCount == 0) {
     emitDiagnostic(*ActiveDiagnostic);
   } else {
@@ -1036,8 +1038,99 @@ DiagnosticEngine::diagnosticInfoForDiagnostic(const Diagnostic &diagnostic) {
       diagnostic.getRanges(), diagnostic.getFixIts(), diagnostic.isChildNote());
 }
 
+/// Compute a fingerprint of the pre-format representation of \p diagnostic,
+/// i.e. its ID, location and interned arguments. Returns \c None for the rare
+/// argument kinds which cannot be fingerprinted without formatting.
+static Optional<uint64_t> fingerprintDiagnostic(const Diagnostic &diagnostic,
+                                                SourceLoc loc) {
+  llvm::hash_code hash = llvm::hash_combine((unsigned)diagnostic.getID(),
+                                            loc.getOpaquePointerValue());
+  for (const DiagnosticArgument &arg : diagnostic.getArgs()) {
+    hash = llvm::hash_combine(hash, (unsigned)arg.getKind());
+    switch (arg.getKind()) {
+    case DiagnosticArgumentKind::String:
+      hash = llvm::hash_combine(hash, arg.getAsString());
+      break;
+    case DiagnosticArgumentKind::Integer:
+      hash = llvm::hash_combine(hash, arg.getAsInteger());
+      break;
+    case DiagnosticArgumentKind::Unsigned:
+      hash = llvm::hash_combine(hash, arg.getAsUnsigned());
+      break;
+    case DiagnosticArgumentKind::Identifier:
+      hash = llvm::hash_combine(hash, arg.getAsIdentifier().getOpaqueValue());
+      break;
+    case DiagnosticArgumentKind::ObjCSelector:
+      hash = llvm::hash_combine(hash, arg.getAsObjCSelector().getOpaqueValue());
+      break;
+    case DiagnosticArgumentKind::ValueDecl:
+      hash = llvm::hash_combine(hash, arg.getAsValueDecl());
+      break;
+    case DiagnosticArgumentKind::Type:
+      hash = llvm::hash_combine(hash, arg.getAsType().getPointer());
+      break;
+    case DiagnosticArgumentKind::TypeRepr:
+      hash = llvm::hash_combine(hash, arg.getAsTypeRepr());
+      break;
+    case DiagnosticArgumentKind::FullyQualifiedType:
+      hash = llvm::hash_combine(
+          hash, arg.getAsFullyQualifiedType().getType().getPointer());
+      break;
+    case DiagnosticArgumentKind::PatternKind:
+      hash = llvm::hash_combine(hash, (unsigned)arg.getAsPatternKind());
+      break;
+    case DiagnosticArgumentKind::SelfAccessKind:
+      hash = llvm::hash_combine(hash, (unsigned)arg.getAsSelfAccessKind());
+      break;
+    case DiagnosticArgumentKind::ReferenceOwnership:
+      hash = llvm::hash_combine(hash, (unsigned)arg.getAsReferenceOwnership());
+      break;
+    case DiagnosticArgumentKind::StaticSpellingKind:
+      hash = llvm::hash_combine(hash, (unsigned)arg.getAsStaticSpellingKind());
+      break;
+    case DiagnosticArgumentKind::DescriptiveDeclKind:
+      hash = llvm::hash_combine(hash, (unsigned)arg.getAsDescriptiveDeclKind());
+      break;
+    case DiagnosticArgumentKind::DeclAttribute:
+      hash = llvm::hash_combine(hash, arg.getAsDeclAttribute());
+      break;
+    case DiagnosticArgumentKind::LayoutConstraint:
+      hash = llvm::hash_combine(hash, arg.getAsLayoutConstraint().getPointer());
+      break;
+    case DiagnosticArgumentKind::VersionTuple:
+    case DiagnosticArgumentKind::ActorIsolation:
+      return None;
+    }
+  }
+  return (uint64_t)hash;
+}
+
 void DiagnosticEngine::emitDiagnostic(const Diagnostic &diagnostic) {
   if (auto info = diagnosticInfoForDiagnostic(diagnostic)) {
+    // Suppress exact repetitions of warnings and remarks, together with their
+    // trailing notes. The check works on the pre-format representation, so
+    // suppressed diagnostics are never formatted by a consumer.
+    if (suppressDuplicateDiagnostics) {
+      switch (info->Kind) {
+      case DiagnosticKind::Warning:
+      case DiagnosticKind::Remark: {
+        auto fingerprint = fingerprintDiagnostic(diagnostic, info->Loc);
+        suppressedLastDiagnostic =
+            fingerprint && !SeenDiagnosticFingerprints.insert(*fingerprint).second;
+        if (suppressedLastDiagnostic)
+          return;
+        break;
+      }
+      case DiagnosticKind::Note:
+        // A note belongs to the preceding diagnostic.
+        if (suppressedLastDiagnostic)
+          return;
+        break;
+      case DiagnosticKind::Error:
+        suppressedLastDiagnostic = false;
+        break;
+      }
+    }
     SmallVector<DiagnosticInfo, 1> childInfo;
     TinyPtrVector<DiagnosticInfo *> childInfoPtrs;
     auto childNotes = diagnostic.getChildNotes();
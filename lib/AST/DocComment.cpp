@@ -384,10 +384,20 @@ DocComment *swift::getSingleDocComment(swift::markup::MarkupContext &MC,
                                        const Decl *D, bool AllowSerialized) {
   PrettyStackTraceDecl StackTrace("parsing comment for", D);
 
+  // Check the cache in ASTContext. Cached doc comments are parsed into the
+  // ASTContext's own markup context, so they stay valid after the caller's
+  // request-scoped context is torn down.
+  auto &Context = D->getASTContext();
+  if (auto *Cached = Context.getDocComment(D, AllowSerialized))
+    return Cached;
+
   auto RC = D->getRawComment(AllowSerialized);
   if (RC.isEmpty())
     return nullptr;
-  return DocComment::create(D, MC, RC);
+
+  auto *DC = DocComment::create(D, Context.getDocCommentMarkupContext(), RC);
+  Context.setDocComment(D, AllowSerialized, DC);
+  return DC;
 }
 
 namespace {
@@ -484,7 +494,17 @@ swift::getCascadingDocComment(swift::markup::MarkupContext &MC, const Decl *D,
   if (!docD)
     return nullptr;
 
-  auto *doc = getSingleDocComment(MC, docD, AllowSerialized);
+  // An inherited doc comment is mutated below to describe its origin, so
+  // build a fresh copy in the request's own context rather than going
+  // through the per-decl cache.
+  DocComment *doc = nullptr;
+  if (docD == D) {
+    doc = getSingleDocComment(MC, docD, AllowSerialized);
+  } else {
+    auto RC = docD->getRawComment(AllowSerialized);
+    if (!RC.isEmpty())
+      doc = DocComment::create(docD, MC, RC);
+  }
   assert(doc && "getDocCommentProvidingDecl() returned decl with no comment");
 
   // If the doc-comment is inherited from other decl, add a note about it.
@@ -19,6 +19,7 @@
 #include "swift/Basic/LangOptions.h"
 #include "swift/Basic/Range.h"
 #include "swift/Basic/SourceManager.h"
+#include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/StringExtras.h"
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/FileSystem.h"
@@ -74,22 +75,91 @@ void Evaluator::emitRequestEvaluatorGraphViz(llvm::StringRef graphVizPath) {
   printDependenciesGraphviz(out);
 }
 
+llvm::SetVector<ActiveRequest> &Evaluator::getActiveRequests() const {
+  if (!isSharedBetweenThreads)
+    return activeRequests;
+
+  // Each thread evaluating requests tracks its own stack. The map is keyed
+  // by evaluator so that nested compiler instances on the same thread do
+  // not mix their stacks.
+  static thread_local llvm::DenseMap<const Evaluator *,
+                                     llvm::SetVector<ActiveRequest>>
+      threadActiveRequests;
+  return threadActiveRequests[this];
+}
+
+void Evaluator::setSharedBetweenThreads(bool shared) {
+  assert(activeRequests.empty() &&
+         "cannot change sharing while requests are being evaluated");
+  isSharedBetweenThreads = shared;
+  recorder.setSharedBetweenThreads(shared);
+}
+
+void Evaluator::clearCacheForZone(Zone zone) {
+  SharedStateLock lock(*this);
+  uint8_t zoneID = static_cast<uint8_t>(zone);
+  SmallVector<AnyRequest, 8> requestsToRemove;
+  for (const auto &entry : cache) {
+    if (entry.first.getRequestZoneID() == zoneID)
+      requestsToRemove.push_back(entry.first);
+  }
+  for (const auto &request : requestsToRemove)
+    cache.erase(request);
+}
+
+void Evaluator::dumpCacheStats(llvm::raw_ostream &out) const {
+  struct RequestKindStats {
+    unsigned count = 0;
+    size_t bytes = 0;
+  };
+  llvm::DenseMap<uint64_t, RequestKindStats> statsByKind;
+  size_t numEntries;
+  {
+    SharedStateLock lock(*this);
+    numEntries = cache.size();
+    for (const auto &entry : cache) {
+      auto &kindStats = statsByKind[entry.first.getRequestTypeID()];
+      ++kindStats.count;
+      // Count the request's own storage and the (shallow) size of the cached
+      // value. Heap storage owned by either is not visible from here.
+      kindStats.bytes +=
+          entry.first.getRequestSize() + entry.second.getStorageSize();
+    }
+  }
+
+  SmallVector<std::pair<uint64_t, RequestKindStats>, 16> sortedStats(
+      statsByKind.begin(), statsByKind.end());
+  llvm::sort(sortedStats, [](const auto &lhs, const auto &rhs) {
+    return lhs.second.bytes > rhs.second.bytes;
+  });
+
+  out << "Request evaluator cache: " << numEntries << " entries\n";
+  for (const auto &entry : sortedStats) {
+    out << "  zone " << (entry.first >> 8) << ", request "
+        << (entry.first & 0xFF) << ": " << entry.second.count
+        << " entries, ~" << entry.second.bytes << " bytes\n";
+  }
+}
+
 bool Evaluator::checkDependency(const ActiveRequest &request) {
+  auto &active = getActiveRequests();
   if (buildDependencyGraph) {
+    SharedStateLock lock(*this);
+
     // Insert the request into the dependency graph if we haven't already.
     auto req = AnyRequest(request);
     dependencies.insert({req, {}});
 
     // If there is an active request, record it's dependency on this request.
-    if (!activeRequests.empty()) {
-      auto activeDeps = dependencies.find_as(activeRequests.back());
+    if (!active.empty()) {
+      auto activeDeps = dependencies.find_as(active.back());
       assert(activeDeps != dependencies.end());
       activeDeps->second.push_back(req);
     }
   }
 
   // Record this as an active request.
-  if (activeRequests.insert(request))
+  if (active.insert(request))
     return false;
 
   // Diagnose cycle.
@@ -98,21 +168,22 @@ bool Evaluator::checkDependency(const ActiveRequest &request) {
 }
 
 void Evaluator::diagnoseCycle(const ActiveRequest &request) {
+  auto &active = getActiveRequests();
   if (debugDumpCycles) {
     llvm::errs() << "===CYCLE DETECTED===\n";
     llvm::DenseSet<AnyRequest> visitedAnywhere;
     llvm::SmallVector<AnyRequest, 4> visitedAlongPath;
     std::string prefixStr;
     SmallVector<AnyRequest, 8> highlightPath;
-    for (auto &req : activeRequests)
+    for (auto &req : active)
       highlightPath.push_back(AnyRequest(req));
-    printDependencies(AnyRequest(activeRequests.front()), llvm::errs(),
+    printDependencies(AnyRequest(active.front()), llvm::errs(),
                       visitedAnywhere, visitedAlongPath, highlightPath,
                       prefixStr, /*lastChild=*/true);
   }
 
   request.diagnoseCycle(diags);
-  for (const auto &step : llvm::reverse(activeRequests)) {
+  for (const auto &step : llvm::reverse(active)) {
     if (step == request) return;
 
     step.noteCycleStep(diags);
@@ -369,6 +440,21 @@ void Evaluator::dumpDependenciesGraphviz() const {
   printDependenciesGraphviz(llvm::dbgs());
 }
 
+llvm::SmallVectorImpl<evaluator::DependencySource> &
+evaluator::DependencyRecorder::getDependencySources() const {
+  if (!isSharedBetweenThreads)
+    return dependencySources;
+
+  // Each thread evaluating requests tracks its own stack of dependency
+  // sources, keyed by recorder so that nested compiler instances on the
+  // same thread do not mix their stacks.
+  static thread_local llvm::DenseMap<
+      const DependencyRecorder *,
+      llvm::SmallVector<evaluator::DependencySource, 8>>
+      threadDependencySources;
+  return threadDependencySources[this];
+}
+
 void evaluator::DependencyRecorder::realize(
     const DependencyCollector::Reference &ref) {
   auto *source = getActiveDependencySourceOrNull().get();
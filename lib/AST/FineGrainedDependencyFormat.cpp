@@ -275,7 +275,10 @@ bool swift::fine_grained_dependencies::readFineGrainedDependencyGraph(
 
 bool swift::fine_grained_dependencies::readFineGrainedDependencyGraph(
      StringRef path, SourceFileDepGraph &g) {
-  auto buffer = llvm::MemoryBuffer::getFile(path);
+  // The bitstream reader doesn't need a null terminator, so let the buffer be
+  // mmapped rather than copied.
+  auto buffer = llvm::MemoryBuffer::getFile(path, /*FileSize=*/-1,
+                                            /*RequiresNullTerminator=*/false);
   if (!buffer)
     return false;
 
@@ -172,10 +172,15 @@ Type GenericEnvironment::mapTypeIntoContext(GenericTypeParamType *type) const {
 }
 
 SubstitutionMap GenericEnvironment::getForwardingSubstitutionMap() const {
+  if (ForwardingSubMap)
+    return ForwardingSubMap;
+
   auto genericSig = getGenericSignature();
-  return SubstitutionMap::get(genericSig,
-                              QueryInterfaceTypeSubstitutions(this),
-                              MakeAbstractConformanceForGenericType());
+  ForwardingSubMap =
+      SubstitutionMap::get(genericSig,
+                           QueryInterfaceTypeSubstitutions(this),
+                           MakeAbstractConformanceForGenericType());
+  return ForwardingSubMap;
 }
 
 std::pair<Type, ProtocolConformanceRef>
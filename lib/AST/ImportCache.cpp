@@ -16,6 +16,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "llvm/ADT/DenseSet.h"
+#include "llvm/ADT/MapVector.h"
 #include "swift/AST/ASTContext.h"
 #include "swift/AST/ClangModuleLoader.h"
 #include "swift/AST/FileUnit.h"
@@ -200,10 +201,10 @@ ArrayRef<ImportPath::Access> ImportCache::allocateArray(
 ArrayRef<ImportPath::Access>
 ImportCache::getAllVisibleAccessPaths(const ModuleDecl *mod,
                                       const DeclContext *dc) {
-  dc = dc->getModuleScopeContext();
   auto &ctx = mod->getASTContext();
+  auto *importSet = &getImportSet(dc);
 
-  auto key = std::make_pair(mod, dc);
+  auto key = std::make_pair(importSet, mod);
   auto found = VisibilityCache.find(key);
   if (found != VisibilityCache.end()) {
     if (ctx.Stats)
@@ -214,19 +215,27 @@ ImportCache::getAllVisibleAccessPaths(const ModuleDecl *mod,
   if (ctx.Stats)
     ++ctx.Stats->getFrontendCounters().ModuleVisibilityCacheMiss;
 
-  SmallVector<ImportPath::Access, 1> accessPaths;
-  for (auto next : getImportSet(dc).getAllImports()) {
-    // If we found 'mod', record the access path.
-    if (next.importedModule == mod) {
+  // The first query against an import set builds the visibility index for
+  // every module in the set in a single pass, so that all later queries
+  // are single hash probes regardless of the size of the import closure.
+  if (VisibilityIndexedSets.insert(importSet).second) {
+    llvm::MapVector<const ModuleDecl *, SmallVector<ImportPath::Access, 1>>
+        accessPathsByModule;
+    for (auto next : importSet->getAllImports()) {
       // Make sure the list of access paths is unique.
+      auto &accessPaths = accessPathsByModule[next.importedModule];
       if (!llvm::is_contained(accessPaths, next.accessPath))
         accessPaths.push_back(next.accessPath);
     }
+
+    for (auto &entry : accessPathsByModule)
+      VisibilityCache[{importSet, entry.first}] =
+          allocateArray(ctx, entry.second);
   }
 
-  auto result = allocateArray(ctx, accessPaths);
-  VisibilityCache[key] = result;
-  return result;
+  // If the index doesn't know about 'mod', it is not visible; cache the
+  // negative result too.
+  return VisibilityCache[key];
 }
 
 ArrayRef<ImportPath::Access>
@@ -2445,6 +2445,13 @@ ASTScope &SourceFile::getScope() {
   return *Scope.get();
 }
 
+void SourceFile::invalidateFunctionBodyScope(AbstractFunctionDecl *AFD) {
+  if (!Scope)
+    return;
+  if (!Scope.get()->invalidateFunctionBody(AFD))
+    clearScope();
+}
+
 Identifier
 SourceFile::getDiscriminatorForPrivateValue(const ValueDecl *D) const {
   assert(D->getDeclContext()->getModuleScopeContext() == this);
@@ -2502,6 +2509,14 @@ void SourceFile::setTypeRefinementContext(TypeRefinementContext *Root) {
   TRC = Root;
 }
 
+bool SourceFile::hasBuiltTypeRefinementContext(Decl *D) const {
+  return DeclsWithTypeRefinementContexts.count(D);
+}
+
+void SourceFile::setBuiltTypeRefinementContext(Decl *D) {
+  DeclsWithTypeRefinementContexts.insert(D);
+}
+
 ArrayRef<OpaqueTypeDecl *> SourceFile::getOpaqueReturnTypeDecls() {
   for (auto *vd : UnvalidatedDeclsWithOpaqueReturnTypes.takeVector()) {
     if (auto opaqueDecl = vd->getOpaqueResultTypeDecl()) {
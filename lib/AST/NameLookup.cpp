@@ -2409,6 +2409,32 @@ InheritedProtocolsRequest::evaluate(Evaluator &evaluator,
   return PD->getASTContext().AllocateCopy(result);
 }
 
+ArrayRef<ProtocolDecl *>
+AllInheritedProtocolsRequest::evaluate(Evaluator &evaluator,
+                                       ProtocolDecl *PD) const {
+  // Compute the transitive closure of the inherited protocols, excluding
+  // the protocol itself.
+  llvm::SmallVector<ProtocolDecl *, 4> result;
+  SmallPtrSet<const ProtocolDecl *, 4> known;
+  known.insert(PD);
+  SmallVector<ProtocolDecl *, 4> stack(PD->getInheritedProtocols().begin(),
+                                       PD->getInheritedProtocols().end());
+  while (!stack.empty()) {
+    auto *proto = stack.pop_back_val();
+    if (!known.insert(proto).second)
+      continue;
+
+    result.push_back(proto);
+    stack.append(proto->getInheritedProtocols().begin(),
+                 proto->getInheritedProtocols().end());
+  }
+
+  // Sort canonically so clients can binary-search the closure.
+  llvm::array_pod_sort(result.begin(), result.end(), TypeDecl::compare);
+
+  return PD->getASTContext().AllocateCopy(result);
+}
+
 NominalTypeDecl *
 ExtendedNominalRequest::evaluate(Evaluator &evaluator,
                                  ExtensionDecl *ext) const {
@@ -400,6 +400,16 @@ void UnqualifiedLookupRequest::writeDependencySink(
   track.addTopLevelName(desc.Name.getBaseName());
 }
 
+//----------------------------------------------------------------------------//
+// UnqualifiedOperatorLookupRequest computation.
+//----------------------------------------------------------------------------//
+
+void UnqualifiedOperatorLookupRequest::writeDependencySink(
+    evaluator::DependencyCollector &track, LookupResult res) const {
+  auto &desc = std::get<0>(getStorage());
+  track.addTopLevelName(desc.Name.getBaseName());
+}
+
 // Define request evaluation functions for each of the name lookup requests.
 static AbstractRequestFunction *nameLookupRequestFunctions[] = {
 #define SWIFT_REQUEST(Zone, Name, Sig, Caching, LocOptions)                    \
@@ -192,6 +192,12 @@ SubstitutionMap SubstitutionMap::get(GenericSignature genericSig,
     return SubstitutionMap();
   }
 
+  // If the substitutions are already formed for this signature, don't
+  // rebuild and re-unique the same storage.
+  if (substitutions.getGenericSignature().getPointer() ==
+        genericSig.getPointer())
+    return substitutions;
+
   return SubstitutionMap::get(genericSig,
            [&](SubstitutableType *type) -> Type {
              return substitutions.lookupSubstitution(
@@ -16,6 +16,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "swift/AST/ASTContext.h"
+#include "swift/AST/ASTScope.h"
 #include "swift/AST/ASTVisitor.h"
 #include "swift/AST/DebuggerClient.h"
 #include "swift/AST/ImportCache.h"
@@ -23,6 +24,7 @@
 #include "swift/AST/NameLookup.h"
 #include "swift/AST/NameLookupRequests.h"
 #include "swift/AST/PropertyWrappers.h"
+#include "swift/AST/SourceFile.h"
 #include "swift/Basic/Debug.h"
 #include "swift/Basic/STLExtras.h"
 #include "swift/Basic/SourceManager.h"
@@ -668,6 +670,30 @@ bool ASTScopeDeclConsumerForUnqualifiedLookup::lookInMembers(
 LookupResult
 UnqualifiedLookupRequest::evaluate(Evaluator &evaluator,
                                    UnqualifiedLookupDescriptor desc) const {
+  // Operator lookup is always global, so the result depends only on the
+  // module-scope context. Normalize the descriptor and delegate to a cached
+  // request so that repeated references to the same operator don't each
+  // re-walk the import set.
+  if (desc.Name.isOperator()) {
+    desc.DC = desc.DC->getModuleScopeContext();
+    desc.Loc = SourceLoc();
+    return evaluateOrDefault(evaluator,
+                             UnqualifiedOperatorLookupRequest{desc}, {});
+  }
+
+  SmallVector<LookupResultEntry, 4> results;
+  size_t indexOfFirstOuterResult = 0;
+  UnqualifiedLookupFactory factory(desc.Name, desc.DC, desc.Loc, desc.Options,
+                                   results, indexOfFirstOuterResult);
+  factory.performUnqualifiedLookup();
+  return LookupResult(results, indexOfFirstOuterResult);
+}
+
+LookupResult
+UnqualifiedOperatorLookupRequest::evaluate(
+    Evaluator &evaluator, UnqualifiedLookupDescriptor desc) const {
+  assert(desc.Name.isOperator() && desc.DC->isModuleScopeContext() &&
+         "expected a normalized descriptor for operator lookup");
   SmallVector<LookupResultEntry, 4> results;
   size_t indexOfFirstOuterResult = 0;
   UnqualifiedLookupFactory factory(desc.Name, desc.DC, desc.Loc, desc.Options,
@@ -827,9 +853,38 @@ public:
 void ASTScope::lookupLocalDecls(SourceFile *sf, DeclName name, SourceLoc loc,
                                 bool stopAfterInnermostBraceStmt,
                                 SmallVectorImpl<ValueDecl *> &results) {
+  // Lookups of the same name from the same scope repeat frequently, and the
+  // results of a walk depend only on the scope the walk starts from and the
+  // name, so memoize them on the source file. Growing the scope tree
+  // invalidates the cache (see ASTScopeImpl::addChild).
+  const auto *start =
+      ast_scope::ASTScopeImpl::findStartingScopeForLookup(sf, loc);
+  if (!start)
+    return;
+
+  if (auto cached = sf->getCachedLocalLookupResult(
+          start, name, stopAfterInnermostBraceStmt)) {
+    if (auto *s = sf->getASTContext().Stats)
+      ++s->getFrontendCounters().NumASTScopeLocalLookupCacheHits;
+    results.append(cached->begin(), cached->end());
+    return;
+  }
+
+  if (auto *s = sf->getASTContext().Stats)
+    ++s->getFrontendCounters().NumASTScopeLookups;
+
+  const unsigned sizeBefore = results.size();
+  const unsigned generation = sf->getLocalLookupCacheGeneration();
   ASTScopeDeclConsumerForLocalLookup consumer(name, stopAfterInnermostBraceStmt,
                                               results);
-  ASTScope::unqualifiedLookup(sf, loc, consumer);
+  start->lookup(nullptr, nullptr, consumer);
+
+  // The walk itself can grow the tree (e.g. by realizing auxiliary
+  // declarations); only memoize results that are still valid.
+  if (sf->getLocalLookupCacheGeneration() == generation)
+    sf->cacheLocalLookupResult(
+        start, name, stopAfterInnermostBraceStmt,
+        llvm::makeArrayRef(results).drop_front(sizeBefore));
 }
 
 ValueDecl *ASTScope::lookupSingleLocalDecl(SourceFile *sf, DeclName name,
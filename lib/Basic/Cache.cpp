@@ -14,12 +14,19 @@
 #include "Darwin/Cache-Mac.cpp"
 #else
 
-//  This file implements a default caching implementation that never evicts
-//  its entries.
+//  This file implements a default caching implementation for platforms
+//  without libcache.  The cache is sharded so that concurrent clients on
+//  different keys do not contend on a single lock, values are kept alive
+//  until they are neither cached nor retained by a client, and entries can
+//  be evicted by least-recent-use when a cost budget is configured via the
+//  SWIFT_CACHE_COST_LIMIT environment variable.  Without a budget the cache
+//  never evicts, matching libcache's behavior in the absence of memory
+//  pressure.
 
 #include "swift/Basic/Cache.h"
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/Support/Mutex.h"
+#include <cstdlib>
 
 using namespace swift::sys;
 using llvm::StringRef;
@@ -32,14 +39,6 @@ struct DefaultCacheKey {
   //DefaultCacheKey() = default;
   DefaultCacheKey(void *Key, CacheImpl::CallBacks *CBs) : Key(Key), CBs(CBs) {}
 };
-
-struct DefaultCache {
-  llvm::sys::Mutex Mux;
-  CacheImpl::CallBacks CBs;
-  llvm::DenseMap<DefaultCacheKey, void *> Entries;
-
-  explicit DefaultCache(CacheImpl::CallBacks CBs) : CBs(std::move(CBs)) { }
-};
 } // end anonymous namespace
 
 namespace llvm {
@@ -67,21 +66,171 @@ template<> struct DenseMapInfo<DefaultCacheKey> {
 };
 } // namespace llvm
 
+namespace {
+/// Lifetime state for a cached value.  The value release callback runs once
+/// per cache reference, but the last release is deferred until no client
+/// retains are outstanding, so a value is never destroyed while a caller of
+/// \c getAndRetain() or \c setAndRetain() can still reference it.
+struct DefaultCacheValue {
+  /// References held by cache entries; the value retain callback was
+  /// invoked once for each.
+  unsigned CacheRefs = 0;
+  /// Outstanding client retains from \c setAndRetain()/\c getAndRetain()
+  /// not yet balanced by \c releaseValue().
+  unsigned ClientRefs = 0;
+  /// Final releases deferred by \c releaseCacheValue() because client
+  /// retains were still outstanding.  They are settled as soon as the value
+  /// regains a cache reference, or run when the last client retain drops.
+  unsigned DeferredReleases = 0;
+};
+
+struct DefaultCacheEntry {
+  void *Value = nullptr;
+  size_t Cost = 0;
+  /// Shard-local logical timestamp of the last access, used to pick
+  /// eviction victims.
+  unsigned LastUse = 0;
+};
+
+struct DefaultCacheShard {
+  llvm::sys::Mutex Mux;
+  llvm::DenseMap<DefaultCacheKey, DefaultCacheEntry> Entries;
+  size_t TotalCost = 0;
+  unsigned Clock = 0;
+};
+
+struct DefaultCacheValueShard {
+  llvm::sys::Mutex Mux;
+  llvm::DenseMap<void *, DefaultCacheValue> Values;
+};
+
+struct DefaultCache {
+  static const size_t NumShards = 16;
+
+  CacheImpl::CallBacks CBs;
+  /// Entries are sharded by key hash; value lifetime state is sharded
+  /// separately by value pointer since \c releaseValue() only receives the
+  /// value.  Lock order is always key shard before value shard.
+  DefaultCacheShard Shards[NumShards];
+  DefaultCacheValueShard ValueShards[NumShards];
+  /// Total cost budget across all shards; zero disables eviction.
+  size_t CostLimit = 0;
+
+  explicit DefaultCache(CacheImpl::CallBacks CBs) : CBs(std::move(CBs)) {
+    if (const char *CostLimitStr = ::getenv("SWIFT_CACHE_COST_LIMIT"))
+      CostLimit = std::strtoull(CostLimitStr, nullptr, 10);
+  }
+
+  DefaultCacheShard &getShard(const DefaultCacheKey &CKey) {
+    uintptr_t Hash = CBs.keyHashCB(CKey.Key, nullptr);
+    return Shards[Hash % NumShards];
+  }
+
+  DefaultCacheValueShard &getValueShard(void *Value) {
+    return ValueShards[(reinterpret_cast<uintptr_t>(Value) >> 4) % NumShards];
+  }
+
+  /// Registers references to \p Value, creating its lifetime state on first
+  /// use.  Only cache references invoke the value retain callback; client
+  /// retains merely pin the value until \c releaseValue().
+  void retainValue(void *Value, bool ForCache, bool ForClient) {
+    auto &Shard = getValueShard(Value);
+    llvm::sys::ScopedLock L(Shard.Mux);
+    DefaultCacheValue &CV = Shard.Values[Value];
+    if (ForCache) {
+      ++CV.CacheRefs;
+      CBs.valueRetainCB(Value, nullptr);
+    }
+    if (ForClient)
+      ++CV.ClientRefs;
+
+    // Settle any releases deferred while the value had no cache reference;
+    // now that it has one again, running them can no longer destroy the
+    // value.  Without this, re-inserting a value whose deferred release is
+    // still pending would leak a reference.
+    while (CV.DeferredReleases > 0 && CV.CacheRefs > 0) {
+      --CV.DeferredReleases;
+      CBs.valueReleaseCB(Value, nullptr);
+    }
+  }
+
+  /// Drops one cache reference to \p Value.  The matching release callback
+  /// runs immediately unless it is the last reference overall, in which case
+  /// it is deferred until the last client retain is released.
+  void releaseCacheValue(void *Value) {
+    auto &Shard = getValueShard(Value);
+    llvm::sys::ScopedLock L(Shard.Mux);
+    auto It = Shard.Values.find(Value);
+    assert(It != Shard.Values.end() && It->second.CacheRefs > 0 &&
+           "releasing value that is not in the cache");
+    --It->second.CacheRefs;
+    if (It->second.CacheRefs > 0) {
+      CBs.valueReleaseCB(Value, nullptr);
+      return;
+    }
+    if (It->second.ClientRefs > 0) {
+      // Remember the deferred release so that it is not lost if the value
+      // is re-inserted before the last client retain is dropped.
+      ++It->second.DeferredReleases;
+      return;
+    }
+    assert(It->second.DeferredReleases == 0 &&
+           "deferred releases must be settled while cache references exist");
+    Shard.Values.erase(It);
+    CBs.valueReleaseCB(Value, nullptr);
+  }
+
+  /// Evicts least-recently-used entries from \p Shard until its share of the
+  /// cost budget is respected.  The entry for \p JustSetKey is exempt so a
+  /// value can be retrieved right after it was stored even if its cost alone
+  /// exceeds the budget.  Assumes the shard lock is held.
+  void evictIfNeeded(DefaultCacheShard &Shard, void *JustSetKey) {
+    if (CostLimit == 0)
+      return;
+    size_t ShardCostLimit = CostLimit / NumShards;
+    while (Shard.TotalCost > ShardCostLimit) {
+      auto Victim = Shard.Entries.end();
+      for (auto I = Shard.Entries.begin(), E = Shard.Entries.end(); I != E;
+           ++I) {
+        if (I->first.Key == JustSetKey)
+          continue;
+        if (Victim == Shard.Entries.end() ||
+            I->second.LastUse < Victim->second.LastUse)
+          Victim = I;
+      }
+      if (Victim == Shard.Entries.end())
+        break;
+      CBs.keyDestroyCB(Victim->first.Key, nullptr);
+      Shard.TotalCost -= Victim->second.Cost;
+      void *Value = Victim->second.Value;
+      Shard.Entries.erase(Victim);
+      releaseCacheValue(Value);
+    }
+  }
+};
+} // end anonymous namespace
+
 CacheImpl::ImplTy CacheImpl::create(StringRef Name, const CallBacks &CBs) {
   return new DefaultCache(CBs);
 }
 
 void CacheImpl::setAndRetain(void *Key, void *Value, size_t Cost) {
   DefaultCache &DCache = *static_cast<DefaultCache*>(Impl);
-  llvm::sys::ScopedLock L(DCache.Mux);
-
   DefaultCacheKey CKey(Key, &DCache.CBs);
-  auto Entry = DCache.Entries.find(CKey);
+  auto &Shard = DCache.getShard(CKey);
+  llvm::sys::ScopedLock L(Shard.Mux);
+
+  auto Entry = Shard.Entries.find(CKey);
 
   // If there is no existing entry, retain the value and insert the entry.
-  if (Entry == DCache.Entries.end()) {
-    DCache.CBs.valueRetainCB(Value, nullptr);
-    DCache.Entries[CKey] = Value;
+  if (Entry == Shard.Entries.end()) {
+    DCache.retainValue(Value, /*ForCache=*/true, /*ForClient=*/true);
+    DefaultCacheEntry &NewEntry = Shard.Entries[CKey];
+    NewEntry.Value = Value;
+    NewEntry.Cost = Cost;
+    NewEntry.LastUse = ++Shard.Clock;
+    Shard.TotalCost += Cost;
+    DCache.evictIfNeeded(Shard, Key);
     return;
   }
 
@@ -90,46 +239,73 @@ void CacheImpl::setAndRetain(void *Key, void *Value, size_t Cost) {
   std::swap(Entry->first.Key, Key);
   DCache.CBs.keyDestroyCB(Key, nullptr);
 
-  // Replace the value, if necessary.
-  if (Entry->second != Value) {
-    DCache.CBs.valueRetainCB(Value, nullptr);
-    std::swap(Entry->second, Value);
-    DCache.CBs.valueReleaseCB(Value, nullptr);
-  }
+  Shard.TotalCost -= Entry->second.Cost;
+  Shard.TotalCost += Cost;
+  Entry->second.Cost = Cost;
+  Entry->second.LastUse = ++Shard.Clock;
 
-  // FIXME: Not thread-safe! It should avoid deleting the value until
-  // 'releaseValue is called on it.
+  // Replace the value, if necessary.  If the same value is stored again the
+  // cache already holds its reference and only the client retain is new.
+  if (Entry->second.Value == Value) {
+    DCache.retainValue(Value, /*ForCache=*/false, /*ForClient=*/true);
+  } else {
+    DCache.retainValue(Value, /*ForCache=*/true, /*ForClient=*/true);
+    void *OldValue = Entry->second.Value;
+    Entry->second.Value = Value;
+    DCache.releaseCacheValue(OldValue);
+  }
+  DCache.evictIfNeeded(Shard, Entry->first.Key);
 }
 
 bool CacheImpl::getAndRetain(const void *Key, void **Value_out) {
   DefaultCache &DCache = *static_cast<DefaultCache*>(Impl);
-  llvm::sys::ScopedLock L(DCache.Mux);
-
   DefaultCacheKey CKey(const_cast<void*>(Key), &DCache.CBs);
-  auto Entry = DCache.Entries.find(CKey);
-  if (Entry != DCache.Entries.end()) {
-    // FIXME: Not thread-safe! It should avoid deleting the value until
-    // 'releaseValue is called on it.
-    *Value_out = Entry->second;
+  auto &Shard = DCache.getShard(CKey);
+  llvm::sys::ScopedLock L(Shard.Mux);
+
+  auto Entry = Shard.Entries.find(CKey);
+  if (Entry != Shard.Entries.end()) {
+    Entry->second.LastUse = ++Shard.Clock;
+    DCache.retainValue(Entry->second.Value, /*ForCache=*/false,
+                       /*ForClient=*/true);
+    *Value_out = Entry->second.Value;
     return true;
   }
   return false;
 }
 
 void CacheImpl::releaseValue(void *Value) {
-  // FIXME: Implementation.
+  DefaultCache &DCache = *static_cast<DefaultCache*>(Impl);
+  auto &Shard = DCache.getValueShard(Value);
+  llvm::sys::ScopedLock L(Shard.Mux);
+
+  auto It = Shard.Values.find(Value);
+  assert(It != Shard.Values.end() && It->second.ClientRefs > 0 &&
+         "releasing value that was not retained");
+  --It->second.ClientRefs;
+  if (It->second.ClientRefs == 0 && It->second.CacheRefs == 0) {
+    // The value was removed or evicted while client retains were
+    // outstanding; run the releases deferred since then.
+    unsigned Deferred = It->second.DeferredReleases;
+    Shard.Values.erase(It);
+    while (Deferred-- > 0)
+      DCache.CBs.valueReleaseCB(Value, nullptr);
+  }
 }
 
 bool CacheImpl::remove(const void *Key) {
   DefaultCache &DCache = *static_cast<DefaultCache*>(Impl);
-  llvm::sys::ScopedLock L(DCache.Mux);
-
   DefaultCacheKey CKey(const_cast<void*>(Key), &DCache.CBs);
-  auto Entry = DCache.Entries.find(CKey);
-  if (Entry != DCache.Entries.end()) {
+  auto &Shard = DCache.getShard(CKey);
+  llvm::sys::ScopedLock L(Shard.Mux);
+
+  auto Entry = Shard.Entries.find(CKey);
+  if (Entry != Shard.Entries.end()) {
     DCache.CBs.keyDestroyCB(Entry->first.Key, nullptr);
-    DCache.CBs.valueReleaseCB(Entry->second, nullptr);
-    DCache.Entries.erase(Entry);
+    Shard.TotalCost -= Entry->second.Cost;
+    void *Value = Entry->second.Value;
+    Shard.Entries.erase(Entry);
+    DCache.releaseCacheValue(Value);
     return true;
   }
   return false;
@@ -137,13 +313,15 @@ bool CacheImpl::remove(const void *Key) {
 
 void CacheImpl::removeAll() {
   DefaultCache &DCache = *static_cast<DefaultCache*>(Impl);
-  llvm::sys::ScopedLock L(DCache.Mux);
-
-  for (auto Entry : DCache.Entries) {
-    DCache.CBs.keyDestroyCB(Entry.first.Key, nullptr);
-    DCache.CBs.valueReleaseCB(Entry.second, nullptr);
+  for (auto &Shard : DCache.Shards) {
+    llvm::sys::ScopedLock L(Shard.Mux);
+    for (auto &Entry : Shard.Entries) {
+      DCache.CBs.keyDestroyCB(Entry.first.Key, nullptr);
+      DCache.releaseCacheValue(Entry.second.Value);
+    }
+    Shard.Entries.clear();
+    Shard.TotalCost = 0;
   }
-  DCache.Entries.clear();
 }
 
 void CacheImpl::destroy() {
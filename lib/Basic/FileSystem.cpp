@@ -14,13 +14,16 @@
 
 #include "swift/Basic/LLVM.h"
 #include "clang/Basic/FileManager.h"
+#include "llvm/ADT/SmallString.h"
 #include "llvm/ADT/Twine.h"
 #include "llvm/Support/Errc.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/Process.h"
 #include "llvm/Support/Signals.h"
+#include "llvm/Support/ThreadPool.h"
 #include "llvm/Support/VirtualFileSystem.h"
+#include "llvm/Support/raw_ostream.h"
 
 using namespace swift;
 
@@ -164,6 +167,76 @@ std::error_code swift::atomicallyWritingToFile(
   return swift::moveFileIfDifferent(temporaryPath.getValue(), outputPath);
 }
 
+AsyncOutputWriter::AsyncOutputWriter(unsigned numThreads)
+    : Pool(std::make_unique<llvm::ThreadPool>(
+          llvm::hardware_concurrency(numThreads))) {}
+
+AsyncOutputWriter::~AsyncOutputWriter() {
+  Pool->wait();
+}
+
+void AsyncOutputWriter::recordError(StringRef outputPath,
+                                    std::error_code error) {
+  std::lock_guard<std::mutex> lock(ErrorMutex);
+  Errors.emplace_back(outputPath.str(), error);
+}
+
+void AsyncOutputWriter::writeFile(
+    StringRef outputPath,
+    llvm::function_ref<void(llvm::raw_pwrite_stream &)> action) {
+  // stdout has to be written in the order the writes were requested, so don't
+  // hand it to the pool.
+  if (outputPath == "-") {
+    if (std::error_code error = atomicallyWritingToFile(outputPath, action))
+      recordError(outputPath, error);
+    return;
+  }
+
+  // Capture the output bytes on the calling thread; only the filesystem work
+  // runs in the background.
+  auto buffer = std::make_shared<llvm::SmallString<0>>();
+  {
+    llvm::raw_svector_ostream OS(*buffer);
+    action(OS);
+  }
+
+  std::string path = outputPath.str();
+  Pool->async([this, path, buffer] {
+    std::error_code error = atomicallyWritingToFile(
+        path, [&](llvm::raw_pwrite_stream &out) {
+          out.write(buffer->data(), buffer->size());
+        });
+    if (error)
+      recordError(path, error);
+  });
+}
+
+void AsyncOutputWriter::writeFileAsync(
+    StringRef outputPath,
+    std::function<void(llvm::raw_pwrite_stream &)> action) {
+  // stdout has to be written in the order the writes were requested, so don't
+  // hand it to the pool.
+  if (outputPath == "-") {
+    if (std::error_code error = atomicallyWritingToFile(outputPath, action))
+      recordError(outputPath, error);
+    return;
+  }
+
+  std::string path = outputPath.str();
+  Pool->async([this, path, action = std::move(action)] {
+    std::error_code error = atomicallyWritingToFile(path, action);
+    if (error)
+      recordError(path, error);
+  });
+}
+
+llvm::ArrayRef<std::pair<std::string, std::error_code>>
+AsyncOutputWriter::waitForCompletion() {
+  Pool->wait();
+  // No tasks are in flight anymore, so Errors can be read unlocked.
+  return Errors;
+}
+
 llvm::ErrorOr<FileDifference>
 swift::areFilesDifferent(const llvm::Twine &source,
                          const llvm::Twine &destination,
@@ -231,7 +231,7 @@ OutputFileMap::parse(std::unique_ptr<llvm::MemoryBuffer> Buffer,
         continue;
 
       llvm::SmallString<128> PathStorage;
-      OutputMap.insert(std::pair<file_types::ID, std::string>(
+      auto InsertedPair = OutputMap.insert(std::pair<file_types::ID, std::string>(
           Kind, resolvePath(Path, PathStorage).str()));
 
       // HACK: fake up an SwiftRanges & CompiledSource output filenames
@@ -240,7 +240,7 @@ OutputFileMap::parse(std::unique_ptr<llvm::MemoryBuffer> Buffer,
         // Not for the master-swiftdeps
         llvm::SmallString<128> Storage;
         if (!InputPath->getValue(Storage).empty()) {
-          std::string baseName = OutputMap[Kind];
+          std::string baseName = InsertedPair.first->second;
           baseName.resize(baseName.size() -
                           getExtension(file_types::TY_SwiftDeps).size());
           auto insertFilename = [&](file_types::ID type) {
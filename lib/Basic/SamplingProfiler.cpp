@@ -0,0 +1,166 @@
+//===--- SamplingProfiler.cpp - Frontend self-profiling -------------------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2021 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+#include "swift/Basic/SamplingProfiler.h"
+#include "swift/Demangling/Demangle.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/Demangle/Demangle.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <vector>
+
+#if (defined(__APPLE__) || defined(__linux__)) && __has_include(<execinfo.h>)
+#define SWIFT_HAVE_SAMPLING_PROFILER 1
+#include <dlfcn.h>
+#include <execinfo.h>
+#include <signal.h>
+#include <sys/time.h>
+#endif
+
+using namespace swift;
+
+#ifdef SWIFT_HAVE_SAMPLING_PROFILER
+
+/// The ring buffer of raw samples. It is statically sized so the signal
+/// handler performs no allocation; when full, the oldest samples are
+/// overwritten, keeping the most recent window of execution — for a slow
+/// invocation that is the part being diagnosed. The buffer lives in BSS, so
+/// untouched slots cost only address space.
+static const unsigned MaxSamples = 8192;
+static const unsigned MaxFrames = 64;
+static void *SampleFrames[MaxSamples][MaxFrames];
+static uint8_t SampleDepths[MaxSamples];
+static std::atomic<uint64_t> SampleCount{0};
+static std::atomic<bool> ProfilerActive{false};
+static struct sigaction SavedAction;
+
+static void sampleHandler(int) {
+  // backtrace(3) is not formally async-signal-safe, but it takes no locks and
+  // allocates nothing after its first call, which start() performs eagerly;
+  // this is the approach taken by common in-process sampling profilers.
+  uint64_t slot =
+      SampleCount.fetch_add(1, std::memory_order_relaxed) % MaxSamples;
+  int depth = ::backtrace(SampleFrames[slot], MaxFrames);
+  SampleDepths[slot] = depth < 0 ? 0 : uint8_t(depth);
+}
+
+bool SamplingProfiler::isSupported() { return true; }
+
+void SamplingProfiler::start(unsigned sampleIntervalMicroseconds) {
+  if (ProfilerActive.exchange(true))
+    return;
+
+  // Force any lazy initialization inside backtrace() to happen outside the
+  // signal handler.
+  void *scratch[2];
+  (void)::backtrace(scratch, 2);
+  SampleCount.store(0);
+
+  struct sigaction action;
+  memset(&action, 0, sizeof(action));
+  action.sa_handler = sampleHandler;
+  sigemptyset(&action.sa_mask);
+  action.sa_flags = SA_RESTART;
+  sigaction(SIGPROF, &action, &SavedAction);
+
+  struct itimerval interval;
+  interval.it_interval.tv_sec = sampleIntervalMicroseconds / 1000000;
+  interval.it_interval.tv_usec = sampleIntervalMicroseconds % 1000000;
+  interval.it_value = interval.it_interval;
+  setitimer(ITIMER_PROF, &interval, nullptr);
+}
+
+/// Return a human-readable name for the frame at \p addr. Frame separators
+/// (';') and newlines are not allowed in collapsed-stack frame names and are
+/// replaced.
+static std::string symbolizeFrame(void *addr) {
+  Dl_info info;
+  if (!dladdr(addr, &info) || !info.dli_sname)
+    return "<unknown>";
+
+  // The frontend is mostly C++, with Swift runtime and stdlib symbols mixed
+  // in when profiling a Swift-hosted process; try the itanium demangler
+  // first and the Swift demangler for the rest.
+  std::string name;
+  if (char *demangled =
+          llvm::itaniumDemangle(info.dli_sname, nullptr, nullptr, nullptr)) {
+    name = demangled;
+    ::free(demangled);
+  } else if (Demangle::isSwiftSymbol(info.dli_sname)) {
+    name = Demangle::demangleSymbolAsString(
+        std::string(info.dli_sname),
+        Demangle::DemangleOptions::SimplifiedUIDemangleOptions());
+  } else {
+    name = info.dli_sname;
+  }
+  std::replace(name.begin(), name.end(), ';', ',');
+  std::replace(name.begin(), name.end(), '\n', ' ');
+  return name;
+}
+
+unsigned SamplingProfiler::stopAndWrite(llvm::raw_ostream &out) {
+  if (!ProfilerActive.load())
+    return 0;
+
+  struct itimerval off;
+  memset(&off, 0, sizeof(off));
+  setitimer(ITIMER_PROF, &off, nullptr);
+  sigaction(SIGPROF, &SavedAction, nullptr);
+  ProfilerActive.store(false);
+
+  uint64_t count = SampleCount.load();
+  unsigned numSamples = unsigned(std::min<uint64_t>(count, MaxSamples));
+
+  // Aggregate identical stacks, dropping the two innermost frames, which
+  // belong to the sampling machinery (the signal handler and trampoline)
+  // rather than the interrupted code.
+  std::map<std::vector<void *>, unsigned> stacks;
+  for (unsigned i = 0; i != numSamples; ++i) {
+    unsigned depth = SampleDepths[i];
+    unsigned skip = depth > 2 ? 2 : 0;
+    std::vector<void *> stack(SampleFrames[i] + skip, SampleFrames[i] + depth);
+    ++stacks[stack];
+  }
+
+  // Symbolicate every distinct frame once; stacks share most frames.
+  llvm::DenseMap<void *, std::string> frameNames;
+  for (const auto &entry : stacks) {
+    // backtrace() records the innermost frame first; collapsed-stack format
+    // is root-first.
+    bool first = true;
+    for (auto frame = entry.first.rbegin(), e = entry.first.rend();
+         frame != e; ++frame) {
+      auto cached = frameNames.find(*frame);
+      if (cached == frameNames.end())
+        cached = frameNames.insert({*frame, symbolizeFrame(*frame)}).first;
+      if (!first)
+        out << ';';
+      out << cached->second;
+      first = false;
+    }
+    out << ' ' << entry.second << '\n';
+  }
+  return numSamples;
+}
+
+#else // !SWIFT_HAVE_SAMPLING_PROFILER
+
+bool SamplingProfiler::isSupported() { return false; }
+void SamplingProfiler::start(unsigned sampleIntervalMicroseconds) {}
+unsigned SamplingProfiler::stopAndWrite(llvm::raw_ostream &out) { return 0; }
+
+#endif // SWIFT_HAVE_SAMPLING_PROFILER
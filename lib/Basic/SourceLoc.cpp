@@ -340,6 +340,19 @@ SourceManager::getLineLength(unsigned BufferId, unsigned Line) const {
   return None;
 }
 
+llvm::ArrayRef<unsigned> SourceManager::getLineStarts(unsigned BufferId) const {
+  auto &starts = LineStartOffsets[BufferId];
+  if (starts.empty()) {
+    StringRef text = getEntireTextForBuffer(BufferId);
+    starts.push_back(0);
+    // StringRef::find lowers to memchr, which scans a vector-width at a time.
+    for (size_t pos = text.find('\n'); pos != StringRef::npos;
+         pos = text.find('\n', pos + 1))
+      starts.push_back(pos + 1);
+  }
+  return starts;
+}
+
 llvm::Optional<unsigned> SourceManager::resolveFromLineCol(unsigned BufferId,
                                                            unsigned Line,
                                                            unsigned Col) const {
@@ -347,21 +360,13 @@ llvm::Optional<unsigned> SourceManager::resolveFromLineCol(unsigned BufferId,
     return None;
   }
   const bool LineEnd = Col == ~0u;
-  auto InputBuf = getLLVMSourceMgr().getMemoryBuffer(BufferId);
-  const char *Ptr = InputBuf->getBufferStart();
-  const char *End = InputBuf->getBufferEnd();
-  const char *LineStart = Ptr;
-  --Line;
-  for (; Line && (Ptr < End); ++Ptr) {
-    if (*Ptr == '\n') {
-      --Line;
-      LineStart = Ptr+1;
-    }
-  }
-  if (Line != 0) {
+  auto LineStarts = getLineStarts(BufferId);
+  if (Line > LineStarts.size()) {
     return None;
   }
-  Ptr = LineStart;
+  auto InputBuf = getLLVMSourceMgr().getMemoryBuffer(BufferId);
+  const char *End = InputBuf->getBufferEnd();
+  const char *Ptr = InputBuf->getBufferStart() + LineStarts[Line - 1];
   if (Col == 0)   {
       return Ptr - InputBuf->getBufferStart();
   }
@@ -14,11 +14,13 @@
 #include "clang/Basic/SourceLocation.h"
 #include "clang/Basic/SourceManager.h"
 #include "swift/Basic/Statistic.h"
+#include "swift/Basic/SamplingProfiler.h"
 #include "swift/AST/Decl.h"
 #include "swift/AST/Expr.h"
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/Config/config.h"
 #include "llvm/Support/FileSystem.h"
+#include "llvm/Support/JSON.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/Process.h"
 #include "llvm/Support/raw_ostream.h"
@@ -90,12 +92,24 @@ makeTraceFileName(StringRef ProgramName,
   return makeFileName("trace", ProgramName, AuxName, "csv");
 }
 
+static std::string
+makeChromeTraceFileName(StringRef ProgramName,
+                        StringRef AuxName) {
+  return makeFileName("trace", ProgramName, AuxName, "json");
+}
+
 static std::string
 makeProfileDirName(StringRef ProgramName,
                    StringRef AuxName) {
   return makeFileName("profile", ProgramName, AuxName, "dir");
 }
 
+static std::string
+makeFrontendProfileFileName(StringRef ProgramName,
+                            StringRef AuxName) {
+  return makeFileName("profile", ProgramName, AuxName, "collapsed");
+}
+
 // LLVM's statistics-reporting machinery is sensitive to filenames containing
 // YAML-quote-requiring characters, which occur surprisingly often in the wild;
 // we only need a recognizable and likely-unique name for a target here, not an
@@ -312,7 +326,9 @@ UnifiedStatsReporter::UnifiedStatsReporter(StringRef ProgramName,
                                            clang::SourceManager *CSM,
                                            bool TraceEvents,
                                            bool ProfileEvents,
-                                           bool ProfileEntities)
+                                           bool ProfileEntities,
+                                           bool TraceChromeEvents,
+                                           bool ProfileFrontend)
   : UnifiedStatsReporter(ProgramName,
                          auxName(ModuleName,
                                  InputName,
@@ -321,7 +337,8 @@ UnifiedStatsReporter::UnifiedStatsReporter(StringRef ProgramName,
                                  OptType),
                          Directory,
                          SM, CSM,
-                         TraceEvents, ProfileEvents, ProfileEntities)
+                         TraceEvents, ProfileEvents, ProfileEntities,
+                         TraceChromeEvents, ProfileFrontend)
 {
 }
 
@@ -332,12 +349,16 @@ UnifiedStatsReporter::UnifiedStatsReporter(StringRef ProgramName,
                                            clang::SourceManager *CSM,
                                            bool TraceEvents,
                                            bool ProfileEvents,
-                                           bool ProfileEntities)
+                                           bool ProfileEntities,
+                                           bool TraceChromeEvents,
+                                           bool ProfileFrontend)
   : currentProcessExitStatusSet(false),
     currentProcessExitStatus(EXIT_FAILURE),
     StatsFilename(Directory),
     TraceFilename(Directory),
+    ChromeTraceFilename(Directory),
     ProfileDirname(Directory),
+    FrontendProfileFilename(Directory),
     StartedTime(llvm::TimeRecord::getCurrentTime()),
     MainThreadID(std::this_thread::get_id()),
     Timer(std::make_unique<NamedRegionTimer>(AuxName,
@@ -346,16 +367,29 @@ UnifiedStatsReporter::UnifiedStatsReporter(StringRef ProgramName,
     SourceMgr(SM),
     ClangSourceMgr(CSM),
     RecursiveTimers(std::make_unique<RecursionSafeTimers>()),
-    IsFlushingTracesAndProfiles(false)
+    IsFlushingTracesAndProfiles(false),
+    FrontendProfilerActive(false)
 {
   path::append(StatsFilename, makeStatsFileName(ProgramName, AuxName));
   path::append(TraceFilename, makeTraceFileName(ProgramName, AuxName));
+  path::append(ChromeTraceFilename,
+               makeChromeTraceFileName(ProgramName, AuxName));
   path::append(ProfileDirname, makeProfileDirName(ProgramName, AuxName));
+  path::append(FrontendProfileFilename,
+               makeFrontendProfileFileName(ProgramName, AuxName));
+  if (ProfileFrontend && SamplingProfiler::isSupported()) {
+    // Sample at 1kHz of CPU time; enough resolution to attribute a slow
+    // invocation without distorting it.
+    SamplingProfiler::start(/*sampleIntervalMicroseconds=*/1000);
+    FrontendProfilerActive = true;
+  }
   EnableStatistics(/*PrintOnExit=*/false);
-  if (TraceEvents || ProfileEvents || ProfileEntities)
+  if (TraceEvents || TraceChromeEvents || ProfileEvents || ProfileEntities)
     LastTracedFrontendCounters.emplace();
   if (TraceEvents)
     FrontendStatsEvents.emplace();
+  if (TraceChromeEvents)
+    ChromeTraceEvents.emplace();
   if (ProfileEvents)
     EventProfilers =std::make_unique<StatsProfilers>();
   if (ProfileEntities)
@@ -633,6 +667,16 @@ UnifiedStatsReporter::saveAnyFrontendStatsEvents(
 #undef FRONTEND_STATISTIC
   }
 
+  if (ChromeTraceEvents) {
+    // Chrome trace timestamps are relative wall-clock microseconds; every
+    // entry needs a matching exit, so these are recorded unconditionally
+    // rather than only when counters changed.
+    auto NowUS = uint64_t(1000000.0 *
+                          (Now.getWallTime() - StartedTime.getWallTime()));
+    ChromeTraceEvents->emplace_back(ChromeTraceEvent{
+        NowUS, IsEntry, T.EventName, T.Entity, T.Formatter});
+  }
+
   // Save all counters (changed or otherwise).
   Last = Curr;
 }
@@ -642,6 +686,22 @@ UnifiedStatsReporter::TraceFormatter::~TraceFormatter() {}
 UnifiedStatsReporter::~UnifiedStatsReporter()
 {
   assert(MainThreadID == std::this_thread::get_id());
+
+  // Stop the sampling profiler first, so flushing the stats below isn't
+  // attributed to the profiled invocation.
+  if (FrontendProfilerActive) {
+    FrontendProfilerActive = false;
+    std::error_code EC;
+    raw_fd_ostream pstream(FrontendProfileFilename, EC,
+                           fs::F_Append | fs::F_Text);
+    if (EC) {
+      llvm::errs() << "Error opening sample profile file '"
+                   << FrontendProfileFilename << "' for writing\n";
+      SamplingProfiler::stopAndWrite(llvm::nulls());
+    } else {
+      SamplingProfiler::stopAndWrite(pstream);
+    }
+  }
   // If nobody's marked this process as successful yet,
   // mark it as failing.
   if (currentProcessExitStatus != EXIT_SUCCESS) {
@@ -748,6 +808,36 @@ UnifiedStatsReporter::flushTracesAndProfiles() {
     }
   }
 
+  if (ChromeTraceEvents) {
+    std::error_code EC;
+    raw_fd_ostream jstream(ChromeTraceFilename, EC, fs::F_Text);
+    if (EC) {
+      llvm::errs() << "Error opening -trace-stats-chrome file '"
+                   << ChromeTraceFilename << "' for writing\n";
+      return;
+    }
+    llvm::json::OStream JOS(jstream);
+    JOS.array([&] {
+      for (auto const &E : *ChromeTraceEvents) {
+        JOS.object([&] {
+          SmallString<64> Name(E.EventName);
+          if (E.Formatter) {
+            llvm::raw_svector_ostream NOS(Name);
+            NOS << ' ';
+            E.Formatter->traceName(E.Entity, NOS);
+          }
+          JOS.attribute("name", Name.str());
+          JOS.attribute("cat", "swift");
+          JOS.attribute("ph", E.IsEntry ? "B" : "E");
+          JOS.attribute("ts", int64_t(E.TimeUSec));
+          JOS.attribute("pid", 1);
+          JOS.attribute("tid", 1);
+        });
+      }
+    });
+    jstream << '\n';
+  }
+
   if (EventProfilers || EntityProfilers) {
     std::error_code EC = llvm::sys::fs::create_directories(ProfileDirname);
     if (EC) {
@@ -782,6 +872,7 @@ UnifiedStatsReporter::flushTracesAndProfiles() {
   }
   LastTracedFrontendCounters.reset();
   FrontendStatsEvents.reset();
+  ChromeTraceEvents.reset();
   EventProfilers.reset();
   EntityProfilers.reset();
 }
@@ -64,6 +64,8 @@
 #include "llvm/ADT/StringExtras.h"
 #include "llvm/Support/CrashRecoveryContext.h"
 #include "llvm/Support/FileCollector.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MD5.h"
 #include "llvm/Support/Memory.h"
 #include "llvm/Support/Path.h"
 #include <algorithm>
@@ -661,6 +663,12 @@ importer::getNormalInvocationArguments(
     invocationArgStrs.push_back("-fmodules-validate-system-headers");
   }
 
+  if (importerOpts.ValidateModulesOnce) {
+    invocationArgStrs.push_back("-fbuild-session-file=" +
+                                importerOpts.BuildSessionFilePath);
+    invocationArgStrs.push_back("-fmodules-validate-once-per-build-session");
+  }
+
   if (importerOpts.DetailedPreprocessingRecord) {
     invocationArgStrs.insert(invocationArgStrs.end(), {
       "-Xclang", "-detailed-preprocessing-record",
@@ -873,8 +881,25 @@ ClangImporter::getPCHFilename(const ClangImporterOptions &ImporterOptions,
     return None;
   }
 
-  SmallString<256> PCHBasename { llvm::sys::path::filename(BridgingHeader) };
-  llvm::sys::path::replace_extension(PCHBasename, "");
+  // Key the PCH on the bridging header's content rather than its path, so
+  // that targets with identical bridging content (and identical Swift and
+  // Clang configuration hashes below) map to a single PCH in the output
+  // directory instead of each building and validating their own.
+  SmallString<256> PCHBasename;
+  if (auto buffer = Impl.Instance->getVirtualFileSystem().getBufferForFile(
+          BridgingHeader)) {
+    llvm::MD5 contentHash;
+    contentHash.update((*buffer)->getBuffer());
+    llvm::MD5::MD5Result result;
+    contentHash.final(result);
+    PCHBasename = "bridging-content_";
+    PCHBasename.append(result.digest());
+  } else {
+    // If the header cannot be read, fall back to a path-derived name; the
+    // PCH emission below will diagnose the problem.
+    PCHBasename = llvm::sys::path::filename(BridgingHeader);
+    llvm::sys::path::replace_extension(PCHBasename, "");
+  }
   PCHBasename.append("-swift_");
   PCHBasename.append(SwiftPCHHash);
   PCHBasename.append("-clang_");
@@ -904,11 +929,31 @@ ClangImporter::getOrCreatePCH(const ClangImporterOptions &ImporterOptions,
         << EC.message();
       return None;
     }
+    // Emit to a process-unique temporary and rename it into place. Several
+    // frontends may race to produce the same content-keyed PCH; this way
+    // none of them can observe a partially-written file, and whichever one
+    // loses the race simply uses the winner's output.
+    SmallString<256> TempPCHPath { PCHFilename.getValue() + "-%%%%%%.tmp" };
+    int TempFD;
+    if (llvm::sys::fs::createUniqueFile(TempPCHPath.str(), TempFD,
+                                        TempPCHPath)) {
+      // Fall back to emitting directly to the final path.
+      TempPCHPath = PCHFilename.getValue();
+    } else {
+      // Only the unique path matters; PCH emission reopens it for writing.
+      llvm::raw_fd_ostream(TempFD, /*shouldClose=*/true).flush();
+    }
     auto FailedToEmit = emitBridgingPCH(ImporterOptions.BridgingHeader,
-                                        PCHFilename.getValue());
+                                        TempPCHPath);
     if (FailedToEmit) {
+      llvm::sys::fs::remove(TempPCHPath);
       return None;
     }
+    if (llvm::sys::fs::rename(TempPCHPath, PCHFilename.getValue())) {
+      llvm::sys::fs::remove(TempPCHPath);
+      if (!llvm::sys::fs::exists(PCHFilename.getValue()))
+        return None;
+    }
   }
 
   return PCHFilename.getValue();
@@ -3870,13 +3915,16 @@ ClangImporter::Implementation::loadNamedMembers(
   // Force the members of the entire inheritance hierarchy to be loaded and
   // deserialized before loading the named member of a class. This warms up
   // ClangImporter::Implementation::MembersForNominal, used for computing
-  // property overrides.
+  // property overrides. Only Clang-imported superclasses matter here;
+  // MembersForNominal is only ever populated by the importer, so a Swift
+  // superclass need not be searched.
   //
   // FIXME: If getOverriddenDecl() kicked off a request for imported decls,
   // we could postpone this until overrides are actually requested.
   if (auto *classDecl = dyn_cast<ClassDecl>(D))
     if (auto *superclassDecl = classDecl->getSuperclassDecl())
-      (void) const_cast<ClassDecl *>(superclassDecl)->lookupDirect(N);
+      if (superclassDecl->hasClangNode())
+        (void) const_cast<ClassDecl *>(superclassDecl)->lookupDirect(N);
 
   TinyPtrVector<ValueDecl *> Members;
   for (auto entry : table->lookup(SerializedSwiftName(N),
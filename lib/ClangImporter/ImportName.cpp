@@ -2193,17 +2193,14 @@ NameImporter::importMacroName(const clang::IdentifierInfo *clangIdentifier,
 ImportedName NameImporter::importName(const clang::NamedDecl *decl,
                                       ImportNameVersion version,
                                       clang::DeclarationName givenName) {
-  CacheKeyType key(decl, version);
-  if (!givenName) {
-    if (auto cachedRes = importNameCache[key]) {
-      ++ImportNameNumCacheHits;
-      return cachedRes;
-    }
+  CacheKeyType key(decl, {version, givenName});
+  if (auto cachedRes = importNameCache[key]) {
+    ++ImportNameNumCacheHits;
+    return cachedRes;
   }
   ++ImportNameNumCacheMisses;
   auto res = importNameImpl(decl, version, givenName);
-  if (!givenName)
-    importNameCache[key] = res;
+  importNameCache[key] = res;
   return res;
 }
 
@@ -361,9 +361,11 @@ class NameImporter {
 
   // TODO: remove when we drop the options (i.e. import all names)
   using CacheKeyType =
-      std::pair<const clang::NamedDecl *, ImportNameVersion>;
+      std::pair<const clang::NamedDecl *,
+                std::pair<ImportNameVersion, clang::DeclarationName>>;
 
-  /// Cache for repeated calls
+  /// Cache for repeated calls. Queries with an alternate name are keyed by
+  /// that name; the common case uses an empty DeclarationName.
   llvm::DenseMap<CacheKeyType, ImportedName> importNameCache;
 
   /// The set of property names that show up in the defining module of
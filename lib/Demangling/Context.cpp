@@ -18,6 +18,9 @@
 #include "swift/Demangling/ManglingMacros.h"
 #include "swift/Demangling/NamespaceMacros.h"
 
+#include <list>
+#include <unordered_map>
+
 namespace swift {
 namespace Demangle {
 SWIFT_BEGIN_INLINE_NAMESPACE
@@ -26,13 +29,54 @@ SWIFT_BEGIN_INLINE_NAMESPACE
 // Context member functions     //
 //////////////////////////////////
 
+/// An LRU cache of mangled-name -> demangled-string results.
+class Context::DemanglingCache {
+  using EntryList = std::list<std::pair<std::string, std::string>>;
+
+  size_t MaxSize;
+
+  /// The cached entries, most recently used first.
+  EntryList Entries;
+
+  /// Maps mangled names to their position in \c Entries.
+  std::unordered_map<std::string, EntryList::iterator> Map;
+
+public:
+  DemanglingCache(size_t MaxSize) : MaxSize(MaxSize) {}
+
+  /// Return the cached demangling for \p MangledName or nullptr. A hit moves
+  /// the entry to the front of the LRU list.
+  const std::string *lookup(llvm::StringRef MangledName) {
+    auto It = Map.find(MangledName.str());
+    if (It == Map.end())
+      return nullptr;
+    Entries.splice(Entries.begin(), Entries, It->second);
+    return &It->second->second;
+  }
+
+  void insert(llvm::StringRef MangledName, const std::string &Demangled) {
+    if (Map.size() >= MaxSize) {
+      Map.erase(Entries.back().first);
+      Entries.pop_back();
+    }
+    Entries.emplace_front(MangledName.str(), Demangled);
+    Map[Entries.front().first] = Entries.begin();
+  }
+};
+
 Context::Context() : D(new Demangler) {
 }
 
 Context::~Context() {
+  delete Cache;
   delete D;
 }
 
+void Context::enableDemanglingCache(size_t MaxSize) {
+  if (!Cache)
+    Cache = new DemanglingCache(MaxSize);
+}
+
 void Context::clear() {
   D->clear();
 }
@@ -50,12 +94,21 @@ NodePointer Context::demangleTypeAsNode(llvm::StringRef MangledName) {
 
 std::string Context::demangleSymbolAsString(llvm::StringRef MangledName,
                                             const DemangleOptions &Options) {
+  if (Cache) {
+    if (const std::string *demangling = Cache->lookup(MangledName))
+      return *demangling;
+  }
+
   NodePointer root = demangleSymbolAsNode(MangledName);
-  if (!root) return MangledName.str();
 
-  std::string demangling = nodeToString(root, Options);
+  std::string demangling;
+  if (root)
+    demangling = nodeToString(root, Options);
   if (demangling.empty())
-    return MangledName.str();
+    demangling = MangledName.str();
+
+  if (Cache)
+    Cache->insert(MangledName, demangling);
   return demangling;
 }
 
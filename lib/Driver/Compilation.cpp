@@ -41,6 +41,7 @@
 #include "llvm/Support/Chrono.h"
 #include "llvm/Support/Compiler.h"
 #include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Format.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/Timer.h"
 #include "llvm/Support/YAMLParser.h"
@@ -49,6 +50,7 @@
 #include "CompilationRecord.h"
 
 #include <fstream>
+#include <list>
 #include <signal.h>
 
 #define DEBUG_TYPE "batch-mode"
@@ -255,6 +257,20 @@ namespace driver {
     llvm::SmallDenseMap<const Job *, std::unique_ptr<llvm::Timer>, 16>
     DriverTimers;
 
+    /// Wall-clock start times of running jobs, used to attribute compile time
+    /// to primary inputs for the compilation record.
+    llvm::SmallDenseMap<const Job *, std::chrono::steady_clock::time_point, 16>
+    JobStartTimes;
+
+    /// Measured wall-clock seconds per primary input, persisted in the
+    /// compilation record to guide the next build's batch partitioning.
+    llvm::StringMap<double> MeasuredCompileTimes;
+
+    /// Owns the argument vectors of tasks dispatched through the remote
+    /// execution wrapper, since TaskQueue tasks only hold a reference to
+    /// their arguments.
+    std::list<llvm::SmallVector<const char *, 128>> RemoteJobArgs;
+
     void noteBuilding(const Job *cmd, const bool willBeBuilding,
                       const bool isTentative, const bool forRanges,
                       StringRef reason) const {
@@ -365,6 +381,17 @@ namespace driver {
              "not implemented for compilations with multiple jobs");
       if (Comp.getShowJobLifecycle())
         llvm::outs() << "Added to TaskQueue: " << LogJob(Cmd) << "\n";
+      if (const char *Wrapper = Comp.getRemoteExecutionWrapper()) {
+        // Run the wrapper instead and hand it the job's command line, so it
+        // can transport the invocation to a remote worker.
+        RemoteJobArgs.emplace_back();
+        auto &WrappedArgs = RemoteJobArgs.back();
+        WrappedArgs.push_back(Cmd->getExecutable());
+        auto Args = Cmd->getArgumentsForTaskExecution();
+        WrappedArgs.append(Args.begin(), Args.end());
+        TQ->addTask(Wrapper, WrappedArgs, llvm::None, (void *)Cmd);
+        return;
+      }
       TQ->addTask(Cmd->getExecutable(), Cmd->getArgumentsForTaskExecution(),
                   llvm::None, (void *)Cmd);
     }
@@ -406,6 +433,8 @@ namespace driver {
       // TODO: properly handle task began.
       const Job *BeganCmd = (const Job *)Context;
 
+      JobStartTimes.insert({BeganCmd, std::chrono::steady_clock::now()});
+
       if (Comp.getShowDriverTimeCompilation()) {
         llvm::SmallString<128> TimerName;
         llvm::raw_svector_ostream OS(TimerName);
@@ -438,6 +467,36 @@ namespace driver {
       }
     }
 
+    /// Record the wall-clock time spent by a successfully finished job
+    /// against its primary inputs, for the compilation record.
+    ///
+    /// The driver can't observe per-file time within a batch job, so a
+    /// batch's time is attributed evenly across its constituents.
+    void recordCompileTimes(const Job *FinishedCmd) {
+      auto StartIt = JobStartTimes.find(FinishedCmd);
+      if (StartIt == JobStartTimes.end())
+        return;
+      double Elapsed =
+          std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                        StartIt->second)
+              .count();
+      JobStartTimes.erase(StartIt);
+
+      SmallVector<StringRef, 16> Primaries;
+      FinishedCmd->forEachContainedJobAndPID(
+          0, [&](const Job *J, Job::PID) {
+            StringRef Primary = J->getFirstSwiftPrimaryInput();
+            if (!Primary.empty())
+              Primaries.push_back(Primary);
+          });
+      if (Primaries.empty())
+        return;
+
+      double PerPrimary = Elapsed / Primaries.size();
+      for (StringRef Primary : Primaries)
+        MeasuredCompileTimes[Primary] = PerPrimary;
+    }
+
     /// Note that a .swiftdeps file failed to load and take corrective actions:
     /// disable incremental logic and schedule all existing deferred commands.
     void
@@ -638,6 +697,8 @@ namespace driver {
         if (Comp.getShowDriverTimeCompilation()) {
           DriverTimers[FinishedCmd]->stopTimer();
         }
+        if (ReturnCode == EXIT_SUCCESS)
+          recordCompileTimes(FinishedCmd);
         processOutputOfFinishedProcess(Pid, ReturnCode, FinishedCmd, Output,
                                        ProcInfo);
       }
@@ -1352,7 +1413,16 @@ namespace driver {
     /// subsequence of the full set of inputs, not just a subset.
     std::vector<size_t>
     assignJobsToPartitions(size_t PartitionSize,
-                           size_t NumJobs) {
+                           ArrayRef<const Job *> Jobs) {
+      size_t NumJobs = Jobs.size();
+
+      // If the previous build recorded per-file compile times, balance the
+      // batches by predicted cost rather than by file count. The seeded
+      // shuffle takes precedence since it exists to test partition-invariance.
+      if (Comp.getBatchSeed() == 0 &&
+          !Comp.getPreviousCompileTimes().empty())
+        return assignJobsToPartitionsByCost(PartitionSize, Jobs);
+
       size_t Remainder = NumJobs % PartitionSize;
       size_t TargetSize = NumJobs / PartitionSize;
       std::vector<size_t> PartitionIndex;
@@ -1371,6 +1441,46 @@ namespace driver {
       return PartitionIndex;
     }
 
+    /// Build a vector of partition indices using longest-processing-time-first
+    /// bin packing: visit jobs from most to least expensive (according to the
+    /// previous build's recorded compile times), assigning each to the
+    /// partition with the smallest predicted load, so that known-hot files
+    /// don't pile up in one batch. Jobs with no recorded time are costed at
+    /// the mean of the recorded ones. Since the returned indices are still
+    /// consumed in input order, each batch remains a subsequence of the full
+    /// set of inputs.
+    std::vector<size_t>
+    assignJobsToPartitionsByCost(size_t PartitionSize,
+                                 ArrayRef<const Job *> Jobs) {
+      const llvm::StringMap<double> &Times = Comp.getPreviousCompileTimes();
+      double TotalKnown = 0.0;
+      for (const auto &Entry : Times)
+        TotalKnown += Entry.getValue();
+      double DefaultCost = TotalKnown / Times.size();
+
+      std::vector<std::pair<double, size_t>> Costs;
+      Costs.reserve(Jobs.size());
+      for (size_t I = 0; I < Jobs.size(); ++I) {
+        auto It = Times.find(Jobs[I]->getFirstSwiftPrimaryInput());
+        Costs.push_back({It != Times.end() ? It->getValue() : DefaultCost, I});
+      }
+      std::stable_sort(Costs.begin(), Costs.end(),
+                       [](const std::pair<double, size_t> &LHS,
+                          const std::pair<double, size_t> &RHS) {
+                         return LHS.first > RHS.first;
+                       });
+
+      std::vector<double> Load(PartitionSize, 0.0);
+      std::vector<size_t> PartitionIndex(Jobs.size());
+      for (const auto &Cost : Costs) {
+        size_t Best =
+            std::min_element(Load.begin(), Load.end()) - Load.begin();
+        Load[Best] += Cost.first;
+        PartitionIndex[Cost.second] = Best;
+      }
+      return PartitionIndex;
+    }
+
     /// Create \c NumberOfParallelCommands batches and assign each job to a
     /// batch either filling each partition in order or, if seeded with a
     /// nonzero value, pseudo-randomly (but determinstically and nearly-evenly).
@@ -1383,7 +1493,7 @@ namespace driver {
 
       assert(!Partition.empty());
       auto PartitionIndex = assignJobsToPartitions(Partition.size(),
-                                                   Batchable.size());
+                                                   Batchable);
       assert(PartitionIndex.size() == Batchable.size());
       auto const &TC = Comp.getToolChain();
       for_each(Batchable, PartitionIndex, [&](const Job *Cmd, size_t Idx) {
@@ -1686,6 +1796,10 @@ namespace driver {
     }
 
   public:
+    const llvm::StringMap<double> &getMeasuredCompileTimes() const {
+      return MeasuredCompileTimes;
+    }
+
     void populateInputInfoMap(InputInfoMap &inputs) const {
       for (auto &entry : UnfinishedCommands) {
         for (auto *action : entry.first->getSource().getInputs()) {
@@ -1851,7 +1965,8 @@ static void checkForOutOfDateInputs(DiagnosticEngine &diags,
 
 static void writeCompilationRecord(StringRef path, StringRef argsHash,
                                    llvm::sys::TimePoint<> buildTime,
-                                   const InputInfoMap &inputs) {
+                                   const InputInfoMap &inputs,
+                                   const llvm::StringMap<double> &compileTimes) {
   // Before writing to the dependencies file path, preserve any previous file
   // that may have been there. No error handling -- this is just a nicety, it
   // doesn't matter if it fails.
@@ -1901,6 +2016,19 @@ static void writeCompilationRecord(StringRef path, StringRef argsHash,
     writeTimeValue(out, entry.second.previousModTime);
     out << "\n";
   }
+
+  if (!compileTimes.empty()) {
+    out << compilation_record::getName(TopLevelKey::CompileTimes) << ":\n";
+    // Iterate the (sorted) input map rather than the time map for a
+    // deterministic order.
+    for (auto &entry : inputs) {
+      auto time = compileTimes.find(entry.first->getValue());
+      if (time == compileTimes.end())
+        continue;
+      out << "  \"" << llvm::yaml::escape(entry.first->getValue()) << "\": "
+          << llvm::format("%.6f", time->getValue()) << "\n";
+    }
+  }
 }
 
 using SourceFileDepGraph = swift::fine_grained_dependencies::SourceFileDepGraph;
@@ -2069,9 +2197,16 @@ Compilation::performJobsImpl(std::unique_ptr<TaskQueue> &&TQ) {
     State.populateInputInfoMap(InputInfo);
     checkForOutOfDateInputs(Diags, InputInfo);
 
+    // Merge this build's measured compile times over the previous build's, so
+    // times for up-to-date files that didn't run this time are carried
+    // forward.
+    llvm::StringMap<double> CompileTimes = getPreviousCompileTimes();
+    for (const auto &measured : State.getMeasuredCompileTimes())
+      CompileTimes[measured.getKey()] = measured.getValue();
+
     auto result = std::move(State).takeResult();
     writeCompilationRecord(CompilationRecordPath, ArgsHash, BuildStartTime,
-                           InputInfo);
+                           InputInfo, CompileTimes);
     if (EnableCrossModuleIncrementalBuild) {
       // Write out our priors adjacent to the build record so we can pick
       // the up in a subsequent build.
@@ -34,6 +34,11 @@ enum class TopLevelKey {
   /// The key for the list of inputs to the compilation that produced the
   /// compilation record.
   Inputs,
+  /// The key for the map of per-primary-input compile times (in wall-clock
+  /// seconds) observed by the build that produced the compilation record.
+  /// This key is optional and advisory; it is used to balance batch-mode
+  /// partitions in subsequent builds.
+  CompileTimes,
 };
 
 /// \returns A string representation of the given key.
@@ -43,6 +48,7 @@ inline static StringRef getName(TopLevelKey Key) {
   case TopLevelKey::Options: return "options";
   case TopLevelKey::BuildTime: return "build_time";
   case TopLevelKey::Inputs: return "inputs";
+  case TopLevelKey::CompileTimes: return "compile_times";
   }
 
   // Work around MSVC warning: not all control paths return a value
@@ -455,6 +455,7 @@ static void dealWithRemovedInputs(ArrayRef<StringRef> removedInputs,
 /// Returns why ignore incrementality
 static std::string
 populateOutOfDateMap(InputInfoMap &map, llvm::sys::TimePoint<> &LastBuildTime,
+                     llvm::StringMap<double> &previousCompileTimes,
                      StringRef argsHashStr, const InputFileList &inputs,
                      StringRef buildRecordPath,
                      const bool EnableSourceRangeDependencies,
@@ -603,6 +604,32 @@ populateOutOfDateMap(InputInfoMap &map, llvm::sys::TimePoint<> &LastBuildTime,
         auto inputName = key->getValue(scratch);
         previousInputs[inputName] = { *previousBuildState, timeValue };
       }
+    } else if (keyStr ==
+               compilation_record::getName(TopLevelKey::CompileTimes)) {
+      // Compile times are advisory (they only inform batch partitioning), so
+      // a malformed entry drops the times rather than invalidating the whole
+      // record.
+      auto *timesMap = dyn_cast<yaml::MappingNode>(i->getValue());
+      if (!timesMap)
+        continue;
+
+      // FIXME: LLVM's YAML support does incremental parsing in such a way
+      // that for-range loops break.
+      for (auto i = timesMap->begin(), e = timesMap->end(); i != e; ++i) {
+        auto *key = dyn_cast<yaml::ScalarNode>(i->getKey());
+        auto *value = dyn_cast<yaml::ScalarNode>(i->getValue());
+        if (!key || !value) {
+          previousCompileTimes.clear();
+          break;
+        }
+        double seconds;
+        SmallString<16> valueScratch;
+        if (value->getValue(valueScratch).getAsDouble(seconds)) {
+          previousCompileTimes.clear();
+          break;
+        }
+        previousCompileTimes[key->getValue(scratch)] = seconds;
+      }
     }
   }
 
@@ -953,12 +980,14 @@ Driver::buildCompilation(const ToolChain &TC,
   computeArgsHash(ArgsHash, *TranslatedArgList);
   llvm::sys::TimePoint<> LastBuildTime = llvm::sys::TimePoint<>::min();
   InputInfoMap outOfDateMap;
+  llvm::StringMap<double> previousCompileTimes;
   std::string whyIgnoreIncrementallity =
       !Incremental
           ? ""
           : buildRecordPath.empty()
                 ? "no build record path"
-                : populateOutOfDateMap(outOfDateMap, LastBuildTime, ArgsHash,
+                : populateOutOfDateMap(outOfDateMap, LastBuildTime,
+                                       previousCompileTimes, ArgsHash,
                                        Inputs, buildRecordPath,
                                        EnableSourceRangeDependencies,
                                        ShowIncrementalBuildDecisions);
@@ -993,6 +1022,10 @@ Driver::buildCompilation(const ToolChain &TC,
       computeContinueBuildingAfterErrors(BatchMode, ArgList.get());
   const bool ShowJobLifecycle =
       ArgList->hasArg(options::OPT_driver_show_job_lifecycle);
+  const char *RemoteExecutionWrapper = nullptr;
+  if (const Arg *A =
+          ArgList->getLastArg(options::OPT_driver_remote_execution_wrapper))
+    RemoteExecutionWrapper = A->getValue();
 
   // In order to confine the values below, while still moving the argument
   // list, and preserving the interface to Compilation, enclose the call to the
@@ -1052,6 +1085,8 @@ Driver::buildCompilation(const ToolChain &TC,
     // clang-format on
   }
 
+  C->setPreviousCompileTimes(std::move(previousCompileTimes));
+
   // Construct the graph of Actions.
   SmallVector<const Action *, 8> TopLevelActions;
   buildActions(TopLevelActions, TC, OI,
@@ -1084,6 +1119,9 @@ Driver::buildCompilation(const ToolChain &TC,
   if (ShowJobLifecycle)
     C->setShowJobLifecycle();
 
+  if (RemoteExecutionWrapper)
+    C->setRemoteExecutionWrapper(RemoteExecutionWrapper);
+
   // This has to happen after building jobs, because otherwise we won't even
   // emit .swiftdeps files for the next build.
   if (!whyIgnoreIncrementallity.empty())
@@ -1939,6 +1977,11 @@ void Driver::buildActions(SmallVectorImpl<const Action *> &TopLevelActions,
   ModuleInputs AllModuleInputs;
   SmallVector<const Action *, 2> AllLinkerInputs;
 
+  // In single-compile mode there is no merge-module step; the compile job
+  // itself emits the module (and any module interface). Track it so steps
+  // that hang off the emitted module can still be scheduled.
+  JobAction *SingleCompileAction = nullptr;
+
   switch (OI.CompilerMode) {
   case OutputInfo::Mode::StandardCompile: {
 
@@ -2092,6 +2135,7 @@ void Driver::buildActions(SmallVectorImpl<const Action *> &TopLevelActions,
         JobAction *CA =
             C.createAction<CompileJobAction>(file_types::TY_LLVM_BC);
         AllModuleInputs.addInput(CA);
+        SingleCompileAction = CA;
 
         int InputIndex = 0;
         for (const InputPair &Input : Inputs) {
@@ -2129,6 +2173,7 @@ void Driver::buildActions(SmallVectorImpl<const Action *> &TopLevelActions,
     }
     AllModuleInputs.addInput(CA);
     AllLinkerInputs.push_back(CA);
+    SingleCompileAction = CA;
     break;
   }
   case OutputInfo::Mode::BatchModeCompile: {
@@ -2266,7 +2311,16 @@ void Driver::buildActions(SmallVectorImpl<const Action *> &TopLevelActions,
   bool verifyInterfacesByDefault = true;
 #endif
 
-  if (MergeModuleAction
+  // The module interface is emitted by the merge-module step in multi-compile
+  // mode, and by the single compile job itself in whole-module mode. Hanging
+  // verification off that job (rather than running it as a separate serial
+  // step after the build) lets it overlap with the backend and link jobs.
+  JobAction *ModuleEmitterAction = MergeModuleAction;
+  if (!ModuleEmitterAction && OI.ShouldGenerateModule &&
+      OI.CompilerMode == OutputInfo::Mode::SingleCompile)
+    ModuleEmitterAction = SingleCompileAction;
+
+  if (ModuleEmitterAction
       && Args.hasArg(options::OPT_enable_library_evolution)
       && Args.hasFlag(options::OPT_verify_emitted_module_interface,
                       options::OPT_no_verify_emitted_module_interface,
@@ -2274,13 +2328,13 @@ void Driver::buildActions(SmallVectorImpl<const Action *> &TopLevelActions,
     if (Args.hasArgNoClaim(options::OPT_emit_module_interface,
                            options::OPT_emit_module_interface_path)) {
       TopLevelActions.push_back(
-          C.createAction<VerifyModuleInterfaceJobAction>(MergeModuleAction,
+          C.createAction<VerifyModuleInterfaceJobAction>(ModuleEmitterAction,
               file_types::TY_SwiftModuleInterfaceFile));
     }
 
     if (Args.hasArgNoClaim(options::OPT_emit_private_module_interface_path)) {
       TopLevelActions.push_back(
-          C.createAction<VerifyModuleInterfaceJobAction>(MergeModuleAction,
+          C.createAction<VerifyModuleInterfaceJobAction>(ModuleEmitterAction,
               file_types::TY_PrivateSwiftModuleInterfaceFile));
     }
   }
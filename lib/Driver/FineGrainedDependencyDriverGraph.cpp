@@ -74,7 +74,10 @@ ModuleDepGraph::Changes ModuleDepGraph::loadFromPath(const Job *Cmd,
     llvm::sys::path::append(driverDotFileBasePath, "driver");
   }
 
-  auto buffer = llvm::MemoryBuffer::getFile(path);
+  // The bitstream reader doesn't need a null terminator, so let the buffer be
+  // mmapped rather than copied.
+  auto buffer = llvm::MemoryBuffer::getFile(path, /*FileSize=*/-1,
+                                            /*RequiresNullTerminator=*/false);
   if (!buffer)
     return None;
   auto r = loadFromBuffer(Cmd, *buffer.get(), diags);
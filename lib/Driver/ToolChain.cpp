@@ -131,10 +131,10 @@ std::unique_ptr<Job> ToolChain::constructJob(
     if (!relativePath.empty()) {
       executablePath = C.getArgs().MakeArgString(relativePath);
     } else {
-      auto systemPath =
-          llvm::sys::findProgramByName(invocationInfo.ExecutableName);
-      if (systemPath) {
-        executablePath = C.getArgs().MakeArgString(systemPath.get());
+      std::string systemPath =
+          findProgramInSystemPath(invocationInfo.ExecutableName);
+      if (!systemPath.empty()) {
+        executablePath = C.getArgs().MakeArgString(systemPath);
       } else {
         // For debugging purposes.
         executablePath = invocationInfo.ExecutableName;
@@ -165,6 +165,18 @@ ToolChain::findProgramRelativeToSwift(StringRef executableName) const {
   return insertionResult.first->getValue();
 }
 
+std::string
+ToolChain::findProgramInSystemPath(StringRef executableName) const {
+  auto insertionResult =
+      SystemProgramLookupCache.insert(std::make_pair(executableName, ""));
+  if (insertionResult.second) {
+    auto result = llvm::sys::findProgramByName(executableName);
+    if (result)
+      insertionResult.first->setValue(std::move(result.get()));
+  }
+  return insertionResult.first->getValue();
+}
+
 std::string
 ToolChain::findProgramRelativeToSwiftImpl(StringRef executableName) const {
   StringRef swiftPath = getDriver().getSwiftProgramPath();
@@ -118,8 +118,11 @@ bool ArgsToFrontendInputsConverter::forAllFilesInFilelist(
   if (!pathArg)
     return false;
   StringRef path = pathArg->getValue();
+  // Filelists are only ever tokenized into StringRefs, so opt out of null
+  // termination to let the buffer be memory-mapped regardless of its size.
   llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> filelistBufferOrError =
-      llvm::MemoryBuffer::getFile(path);
+      llvm::MemoryBuffer::getFile(path, /*FileSize=*/-1,
+                                  /*RequiresNullTerminator=*/false);
   if (!filelistBufferOrError) {
     Diags.diagnose(SourceLoc(), diag::cannot_open_file, path,
                    filelistBufferOrError.getError().message());
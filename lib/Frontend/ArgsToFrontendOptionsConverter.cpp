@@ -92,6 +92,13 @@ bool ArgsToFrontendOptionsConverter::convert(
 
   Opts.ImportPrescan |= Args.hasArg(OPT_import_prescan);
 
+  Opts.SerializeDependencyScannerCache |=
+      Args.hasArg(OPT_serialize_dependency_scan_cache);
+  Opts.ReuseDependencyScannerCache |=
+      Args.hasArg(OPT_load_dependency_scan_cache);
+  if (const Arg *A = Args.getLastArg(OPT_dependency_scan_cache_path))
+    Opts.DependencyScannerCachePath = A->getValue();
+
   Opts.EnableExperimentalCrossModuleIncrementalBuild |=
       Args.hasArg(OPT_enable_experimental_cross_module_incremental_build);
 
@@ -264,12 +271,18 @@ void ArgsToFrontendOptionsConverter::computeDebugTimeOptions() {
     if (Args.getLastArg(OPT_trace_stats_events)) {
       Opts.TraceStats = true;
     }
+    if (Args.getLastArg(OPT_trace_stats_chrome)) {
+      Opts.TraceChromeEvents = true;
+    }
     if (Args.getLastArg(OPT_profile_stats_events)) {
       Opts.ProfileEvents = true;
     }
     if (Args.getLastArg(OPT_profile_stats_entities)) {
       Opts.ProfileEntities = true;
     }
+    if (Args.getLastArg(OPT_profile_frontend)) {
+      Opts.ProfileFrontend = true;
+    }
   }
 }
 
@@ -400,6 +413,8 @@ ArgsToFrontendOptionsConverter::determineRequestedAction(const ArgList &args) {
     return FrontendOptions::ActionType::DumpTypeRefinementContexts;
   if (Opt.matches(OPT_dump_interface_hash))
     return FrontendOptions::ActionType::DumpInterfaceHash;
+  if (Opt.matches(OPT_dump_decl_skeleton))
+    return FrontendOptions::ActionType::DumpDeclSkeleton;
   if (Opt.matches(OPT_dump_type_info))
     return FrontendOptions::ActionType::DumpTypeInfo;
   if (Opt.matches(OPT_print_ast))
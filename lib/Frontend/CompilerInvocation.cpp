@@ -740,6 +740,8 @@ static bool ParseTypeCheckerArgs(TypeCheckerOptions &Opts, ArgList &Args,
   Opts.DebugTimeFunctionBodies |= Args.hasArg(OPT_debug_time_function_bodies);
   Opts.DebugTimeExpressions |=
       Args.hasArg(OPT_debug_time_expression_type_checking);
+  Opts.DebugTimeAssociatedTypeInference |=
+      Args.hasArg(OPT_debug_time_associated_type_inference);
 
   // Check for SkipFunctionBodies arguments in order from skipping less to
   // skipping more.
@@ -781,6 +783,10 @@ static bool ParseTypeCheckerArgs(TypeCheckerOptions &Opts, ArgList &Args,
       Args.hasArg(OPT_experimental_one_way_closure_params);
 
   Opts.DebugConstraintSolver |= Args.hasArg(OPT_debug_constraints);
+  Opts.EnableParallelTypeChecking |=
+      Args.hasArg(OPT_enable_experimental_parallel_type_checking);
+  if (const Arg *A = Args.getLastArg(OPT_experimental_solution_cache_path))
+    Opts.SolutionCachePath = A->getValue();
   Opts.DebugGenericSignatures |= Args.hasArg(OPT_debug_generic_signatures);
 
   for (const Arg *A : Args.filtered(OPT_debug_constraints_on_line)) {
@@ -864,6 +870,10 @@ static bool ParseClangImporterArgs(ClangImporterOptions &Opts,
     Opts.PCHDisableValidation |= Args.hasArg(OPT_pch_disable_validation);
   }
 
+  Opts.ValidateModulesOnce |= Args.hasArg(OPT_validate_clang_modules_once);
+  if (auto *A = Args.getLastArg(OPT_clang_build_session_file))
+    Opts.BuildSessionFilePath = A->getValue();
+
   if (Args.hasFlag(options::OPT_warnings_as_errors,
                    options::OPT_no_warnings_as_errors, false))
     Opts.ExtraArgs.push_back("-Werror");
@@ -978,6 +988,10 @@ static bool ParseDiagnosticArgs(DiagnosticOptions &Opts, ArgList &Args,
 
   Opts.FixitCodeForAllDiagnostics |= Args.hasArg(OPT_fixit_all);
   Opts.SuppressWarnings |= Args.hasArg(OPT_suppress_warnings);
+  Opts.SuppressDuplicateDiagnostics |=
+      Args.hasArg(OPT_suppress_duplicate_diagnostics);
+  Opts.EmitSerializedDiagnosticsIncrementally |=
+      Args.hasArg(OPT_serialize_diagnostics_incrementally);
   Opts.WarningsAsErrors = Args.hasFlag(options::OPT_warnings_as_errors,
                                        options::OPT_no_warnings_as_errors,
                                        false);
@@ -1461,6 +1475,8 @@ static bool ParseIRGenArgs(IRGenOptions &Opts, ArgList &Args,
 
   if (Args.hasArg(OPT_use_jit)) {
     Opts.UseJIT = true;
+    if (Args.hasArg(OPT_enable_jit_object_cache))
+      Opts.UseJITObjectCache = true;
     if (const Arg *A = Args.getLastArg(OPT_dump_jit)) {
       llvm::Optional<swift::JITDebugArtifact> artifact =
           llvm::StringSwitch<llvm::Optional<swift::JITDebugArtifact>>(A->getValue())
@@ -1773,9 +1789,9 @@ bool CompilerInvocation::parseArgs(
   // Parse frontend command line options using Swift's option table.
   unsigned MissingIndex;
   unsigned MissingCount;
-  std::unique_ptr<llvm::opt::OptTable> Table = createSwiftOptTable();
+  const llvm::opt::OptTable &Table = getSwiftOptTable();
   llvm::opt::InputArgList ParsedArgs =
-      Table->ParseArgs(Args, MissingIndex, MissingCount, FrontendOption);
+      Table.ParseArgs(Args, MissingIndex, MissingCount, FrontendOption);
   if (MissingCount) {
     Diags.diagnose(SourceLoc(), diag::error_missing_arg_value,
                    ParsedArgs.getArgString(MissingIndex), MissingCount);
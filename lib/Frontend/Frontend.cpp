@@ -45,6 +45,9 @@
 #include "llvm/Support/Path.h"
 #include "llvm/Support/Process.h"
 
+#include <atomic>
+#include <thread>
+
 using namespace swift;
 
 CompilerInstance::CompilerInstance() = default;
@@ -278,7 +281,9 @@ void CompilerInstance::setupStatsReporter() {
       getClangSourceManager(getASTContext()),
       Invok.getFrontendOptions().TraceStats,
       Invok.getFrontendOptions().ProfileEvents,
-      Invok.getFrontendOptions().ProfileEntities);
+      Invok.getFrontendOptions().ProfileEntities,
+      Invok.getFrontendOptions().TraceChromeEvents,
+      Invok.getFrontendOptions().ProfileFrontend);
   // Hand the stats reporter down to the ASTContext so the rest of the compiler
   // can use it.
   getASTContext().setStatsReporter(Reporter.get());
@@ -421,6 +426,9 @@ void CompilerInstance::setUpDiagnosticOptions() {
   if (Invocation.getDiagnosticOptions().SuppressWarnings) {
     Diagnostics.setSuppressWarnings(true);
   }
+  if (Invocation.getDiagnosticOptions().SuppressDuplicateDiagnostics) {
+    Diagnostics.setSuppressDuplicateDiagnostics(true);
+  }
   if (Invocation.getDiagnosticOptions().WarningsAsErrors) {
     Diagnostics.setWarningsAsErrors(true);
   }
@@ -963,11 +971,55 @@ void CompilerInstance::performSema() {
 
   FrontendStatsTracer tracer(getStatsReporter(), "perform-sema");
 
+  if (getASTContext().TypeCheckerOpts.EnableParallelTypeChecking) {
+    performParallelTypeChecking();
+  } else {
+    forEachFileToTypeCheck([&](SourceFile &SF) {
+      performTypeChecking(SF);
+    });
+  }
+
+  finishTypeChecking();
+}
+
+void CompilerInstance::performParallelTypeChecking() {
+  SmallVector<SourceFile *, 16> filesToCheck;
   forEachFileToTypeCheck([&](SourceFile &SF) {
-    performTypeChecking(SF);
+    filesToCheck.push_back(&SF);
   });
 
-  finishTypeChecking();
+  unsigned numThreads = std::min<unsigned>(
+      std::thread::hardware_concurrency(), filesToCheck.size());
+  if (numThreads <= 1) {
+    for (auto *SF : filesToCheck)
+      performTypeChecking(*SF);
+    return;
+  }
+
+  // Hand each file to a worker thread. The evaluator serializes access to
+  // its shared state (the request cache, the dependency graph, and the
+  // dependency recorder) for the duration, and each thread evaluates
+  // requests on its own active-request stack; requests evaluated on two
+  // threads at once race benignly and the first cached result wins.
+  getASTContext().evaluator.setSharedBetweenThreads(true);
+  std::atomic<size_t> nextFileIndex(0);
+  auto worker = [&] {
+    while (true) {
+      size_t index = nextFileIndex.fetch_add(1);
+      if (index >= filesToCheck.size())
+        return;
+      performTypeChecking(*filesToCheck[index]);
+    }
+  };
+
+  // The main thread acts as the 0-th worker.
+  std::vector<std::thread> threads;
+  for (unsigned i = 1; i < numThreads; ++i)
+    threads.emplace_back(worker);
+  worker();
+  for (auto &thread : threads)
+    thread.join();
+  getASTContext().evaluator.setSharedBetweenThreads(false);
 }
 
 bool CompilerInstance::loadStdlibIfNeeded() {
@@ -1068,9 +1120,11 @@ CompilerInstance::getSourceFileParsingOptions(bool forPrimary) const {
 
   if (forPrimary || isWholeModuleCompilation()) {
     // Disable delayed body parsing for primaries and in WMO, unless
-    // forcefully skipping function bodies
+    // forcefully skipping function bodies. The decl skeleton dump only needs
+    // top-level names, so it always leaves bodies delayed.
     auto typeOpts = getASTContext().TypeCheckerOpts;
-    if (typeOpts.SkipFunctionBodies == FunctionBodySkipping::None)
+    if (typeOpts.SkipFunctionBodies == FunctionBodySkipping::None &&
+        action != FrontendOptions::ActionType::DumpDeclSkeleton)
       opts |= SourceFile::ParsingFlags::DisableDelayedBodies;
   } else {
     // Suppress parse warnings for non-primaries, as they'll get parsed multiple
@@ -38,6 +38,7 @@ bool FrontendOptions::needsProperModuleName(ActionType action) {
   case ActionType::DumpAST:
   case ActionType::EmitSyntax:
   case ActionType::DumpInterfaceHash:
+  case ActionType::DumpDeclSkeleton:
   case ActionType::PrintAST:
   case ActionType::DumpScopeMaps:
   case ActionType::DumpTypeRefinementContexts:
@@ -78,6 +79,7 @@ bool FrontendOptions::shouldActionOnlyParse(ActionType action) {
   case ActionType::DumpParse:
   case ActionType::EmitSyntax:
   case ActionType::DumpInterfaceHash:
+  case ActionType::DumpDeclSkeleton:
   case ActionType::EmitImportedModules:
   case ActionType::ScanDependencies:
   case ActionType::ScanClangDependencies:
@@ -96,6 +98,7 @@ bool FrontendOptions::doesActionRequireSwiftStandardLibrary(ActionType action) {
   case ActionType::DumpParse:
   case ActionType::EmitSyntax:
   case ActionType::DumpInterfaceHash:
+  case ActionType::DumpDeclSkeleton:
   case ActionType::EmitImportedModules:
   case ActionType::ScanDependencies:
   case ActionType::ScanClangDependencies:
@@ -144,6 +147,7 @@ bool FrontendOptions::doesActionRequireInputs(ActionType action) {
   case ActionType::DumpParse:
   case ActionType::EmitSyntax:
   case ActionType::DumpInterfaceHash:
+  case ActionType::DumpDeclSkeleton:
   case ActionType::EmitImportedModules:
   case ActionType::ScanDependencies:
   case ActionType::ScanClangDependencies:
@@ -189,6 +193,7 @@ bool FrontendOptions::doesActionPerformEndOfPipelineActions(ActionType action) {
   case ActionType::DumpParse:
   case ActionType::EmitSyntax:
   case ActionType::DumpInterfaceHash:
+  case ActionType::DumpDeclSkeleton:
   case ActionType::EmitImportedModules:
   case ActionType::ScanDependencies:
   case ActionType::ScanClangDependencies:
@@ -254,6 +259,7 @@ FrontendOptions::formatForPrincipalOutputFileForAction(ActionType action) {
   case ActionType::TypecheckModuleFromInterface:
   case ActionType::DumpParse:
   case ActionType::DumpInterfaceHash:
+  case ActionType::DumpDeclSkeleton:
   case ActionType::DumpAST:
   case ActionType::EmitSyntax:
   case ActionType::PrintAST:
@@ -322,6 +328,7 @@ bool FrontendOptions::canActionEmitDependencies(ActionType action) {
   case ActionType::Parse:
   case ActionType::DumpParse:
   case ActionType::DumpInterfaceHash:
+  case ActionType::DumpDeclSkeleton:
   case ActionType::DumpAST:
   case ActionType::EmitSyntax:
   case ActionType::PrintAST:
@@ -365,6 +372,7 @@ bool FrontendOptions::canActionEmitReferenceDependencies(ActionType action) {
   case ActionType::ResolveImports:
   case ActionType::DumpParse:
   case ActionType::DumpInterfaceHash:
+  case ActionType::DumpDeclSkeleton:
   case ActionType::DumpAST:
   case ActionType::EmitSyntax:
   case ActionType::PrintAST:
@@ -415,6 +423,7 @@ bool FrontendOptions::canActionEmitModuleSummary(ActionType action) {
   case ActionType::ResolveImports:
   case ActionType::DumpParse:
   case ActionType::DumpInterfaceHash:
+  case ActionType::DumpDeclSkeleton:
   case ActionType::DumpAST:
   case ActionType::EmitSyntax:
   case ActionType::PrintAST:
@@ -457,6 +466,7 @@ bool FrontendOptions::canActionEmitObjCHeader(ActionType action) {
   case ActionType::ResolveImports:
   case ActionType::DumpParse:
   case ActionType::DumpInterfaceHash:
+  case ActionType::DumpDeclSkeleton:
   case ActionType::DumpAST:
   case ActionType::EmitSyntax:
   case ActionType::PrintAST:
@@ -498,6 +508,7 @@ bool FrontendOptions::canActionEmitLoadedModuleTrace(ActionType action) {
   case ActionType::Parse:
   case ActionType::DumpParse:
   case ActionType::DumpInterfaceHash:
+  case ActionType::DumpDeclSkeleton:
   case ActionType::DumpAST:
   case ActionType::EmitSyntax:
   case ActionType::PrintAST:
@@ -542,6 +553,7 @@ bool FrontendOptions::canActionEmitModule(ActionType action) {
   case ActionType::Typecheck:
   case ActionType::DumpParse:
   case ActionType::DumpInterfaceHash:
+  case ActionType::DumpDeclSkeleton:
   case ActionType::DumpAST:
   case ActionType::EmitSyntax:
   case ActionType::PrintAST:
@@ -587,6 +599,7 @@ bool FrontendOptions::canActionEmitInterface(ActionType action) {
   case ActionType::ResolveImports:
   case ActionType::DumpParse:
   case ActionType::DumpInterfaceHash:
+  case ActionType::DumpDeclSkeleton:
   case ActionType::DumpAST:
   case ActionType::EmitSyntax:
   case ActionType::PrintAST:
@@ -631,6 +644,7 @@ bool FrontendOptions::doesActionProduceOutput(ActionType action) {
   case ActionType::DumpAST:
   case ActionType::EmitSyntax:
   case ActionType::DumpInterfaceHash:
+  case ActionType::DumpDeclSkeleton:
   case ActionType::PrintAST:
   case ActionType::DumpScopeMaps:
   case ActionType::DumpTypeRefinementContexts:
@@ -687,6 +701,7 @@ bool FrontendOptions::doesActionProduceTextualOutput(ActionType action) {
   case ActionType::TypecheckModuleFromInterface:
   case ActionType::DumpParse:
   case ActionType::DumpInterfaceHash:
+  case ActionType::DumpDeclSkeleton:
   case ActionType::DumpAST:
   case ActionType::EmitSyntax:
   case ActionType::PrintAST:
@@ -716,6 +731,7 @@ bool FrontendOptions::doesActionGenerateSIL(ActionType action) {
   case ActionType::Typecheck:
   case ActionType::DumpParse:
   case ActionType::DumpInterfaceHash:
+  case ActionType::DumpDeclSkeleton:
   case ActionType::EmitSyntax:
   case ActionType::DumpAST:
   case ActionType::PrintAST:
@@ -756,6 +772,7 @@ bool FrontendOptions::doesActionGenerateIR(ActionType action) {
   case ActionType::Parse:
   case ActionType::DumpParse:
   case ActionType::DumpInterfaceHash:
+  case ActionType::DumpDeclSkeleton:
   case ActionType::DumpAST:
   case ActionType::EmitSyntax:
   case ActionType::PrintAST:
@@ -273,8 +273,18 @@ bool ModuleInterfaceBuilder::buildSwiftModule(StringRef OutPath,
                                               bool ShouldSerializeDeps,
                           std::unique_ptr<llvm::MemoryBuffer> *ModuleBuffer,
                           llvm::function_ref<void()> RemarkRebuild,
+                          llvm::function_ref<
+                              bool(std::unique_ptr<llvm::MemoryBuffer> *)>
+                              RecheckCache,
                           ArrayRef<std::string> CompiledCandidates) {
+  bool WaitedForLock = false;
   auto build = [&]() {
+    // If we had to wait on the lock, another process may have produced an
+    // up-to-date module in the meantime (e.g. when many cold-cache jobs race
+    // on the same interfaces); re-check the cache before doing an expensive
+    // build of our own.
+    if (WaitedForLock && RecheckCache && RecheckCache(ModuleBuffer))
+      return false;
     if (RemarkRebuild) {
       RemarkRebuild();
     }
@@ -309,6 +319,7 @@ bool ModuleInterfaceBuilder::buildSwiftModule(StringRef OutPath,
   case llvm::LockFileManager::LFS_Shared: {
     // Someone else is responsible for building the module. Wait for them to
     // finish.
+    WaitedForLock = true;
     switch (Locked.waitForUnlock(256)) {
     case llvm::LockFileManager::Res_Success: {
       // This process may have a different module output path. If the other
@@ -110,10 +110,18 @@ public:
     extraDependencies.push_back(path);
   }
 
-  bool buildSwiftModule(StringRef OutPath, bool ShouldSerializeDeps,
-                        std::unique_ptr<llvm::MemoryBuffer> *ModuleBuffer,
-                        llvm::function_ref<void()> RemarkRebuild = nullptr,
-                        ArrayRef<std::string> CandidateModules = {});
+  /// \param RecheckCache If provided and the interface file lock was
+  /// contended, this is called before building to check whether another
+  /// process produced an up-to-date module while we waited. If it returns
+  /// true the build is skipped, and \p ModuleBuffer (if non-null) has been
+  /// filled in with the discovered module.
+  bool buildSwiftModule(
+      StringRef OutPath, bool ShouldSerializeDeps,
+      std::unique_ptr<llvm::MemoryBuffer> *ModuleBuffer,
+      llvm::function_ref<void()> RemarkRebuild = nullptr,
+      llvm::function_ref<bool(std::unique_ptr<llvm::MemoryBuffer> *)>
+          RecheckCache = nullptr,
+      ArrayRef<std::string> CandidateModules = {});
 };
 
 } // end namespace swift
@@ -930,10 +930,23 @@ class ModuleInterfaceLoaderImpl {
     if (rebuildInfo.sawOutOfDateModule(modulePath))
       builder.addExtraDependency(modulePath);
 
+    // If the builder had to wait for another process's build of this module,
+    // revalidate the cached output instead of rebuilding it ourselves.
+    auto recheckCache = [&](std::unique_ptr<llvm::MemoryBuffer> *buffer) {
+      SmallVector<FileDependency, 16> deps;
+      std::unique_ptr<llvm::MemoryBuffer> buf;
+      if (!swiftModuleIsUpToDate(cachedOutputPath, deps, buf))
+        return false;
+      if (buffer)
+        *buffer = std::move(buf);
+      return true;
+    };
+
     if (builder.buildSwiftModule(cachedOutputPath, /*shouldSerializeDeps*/true,
                                  &moduleBuffer,
                                  Opts.remarkOnRebuildFromInterface ? remarkRebuild:
-                                   llvm::function_ref<void()>()))
+                                   llvm::function_ref<void()>(),
+                                 recheckCache))
       return std::make_error_code(std::errc::invalid_argument);
 
     assert(moduleBuffer &&
@@ -1108,6 +1121,7 @@ bool ModuleInterfaceLoader::buildSwiftModuleFromSwiftInterface(
   //        we want to ship the built swiftmodules to another machine.
   return builder.buildSwiftModule(OutPath, /*shouldSerializeDeps*/true,
                                   /*ModuleBuffer*/nullptr, nullptr,
+                                  /*RecheckCache*/nullptr,
                                   SearchPathOpts.CandidateCompiledModules);
 }
 
@@ -58,9 +58,10 @@ using RecordData = SmallVector<uint64_t, 64>;
 using RecordDataImpl = SmallVectorImpl<uint64_t>;
 
 struct SharedState : llvm::RefCountedBase<SharedState> {
-  SharedState(StringRef serializedDiagnosticsPath)
+  SharedState(StringRef serializedDiagnosticsPath, bool emitIncrementally)
       : Stream(Buffer),
         SerializedDiagnosticsPath(serializedDiagnosticsPath),
+        EmitIncrementally(emitIncrementally),
         EmittedAnyDiagBlocks(false) {}
 
   /// The byte buffer for the serialized content.
@@ -90,6 +91,18 @@ struct SharedState : llvm::RefCountedBase<SharedState> {
   /// Map for uniquing strings.
   DiagFlagsTy DiagFlags;
 
+  /// Whether to append each completed diagnostic block to the output file as
+  /// it is produced instead of writing the whole file on frontend exit, so
+  /// that clients watching the file can report diagnostics from a
+  /// still-running compilation.
+  bool EmitIncrementally;
+
+  /// The output file stream in incremental mode, opened on the first flush.
+  std::unique_ptr<llvm::raw_fd_ostream> StreamedOS;
+
+  /// The number of buffer bytes already written to \c StreamedOS.
+  size_t FlushedSize = 0;
+
   /// Whether we have already started emission of any DIAG blocks. Once
   /// this becomes \c true, we never close a DIAG block until we know that we're
   /// starting another one or we're done.
@@ -104,8 +117,9 @@ class SerializedDiagnosticConsumer : public DiagnosticConsumer {
   bool CompilationWasComplete = true;
 
 public:
-  SerializedDiagnosticConsumer(StringRef serializedDiagnosticsPath)
-      : State(new SharedState(serializedDiagnosticsPath)) {
+  SerializedDiagnosticConsumer(StringRef serializedDiagnosticsPath,
+                               bool emitIncrementally)
+      : State(new SharedState(serializedDiagnosticsPath, emitIncrementally)) {
     emitPreamble();
   }
 
@@ -126,6 +140,18 @@ public:
     if (State->EmittedAnyDiagBlocks)
       exitDiagBlock();
 
+    // If we have been streaming the bitstream to the file, append whatever
+    // is left and close the stream. If the compilation did not complete,
+    // emit the truncated file expected by the driver instead (see below) by
+    // reopening the path, which truncates what was streamed so far.
+    if (State->StreamedOS) {
+      if (CompilationWasComplete)
+        flushCompletedBlocks();
+      State->StreamedOS.reset();
+      if (CompilationWasComplete)
+        return false;
+    }
+
     // Write the generated bitstream to the file.
     std::error_code EC;
     std::unique_ptr<llvm::raw_fd_ostream> OS;
@@ -184,6 +210,36 @@ private:
     State->Stream.ExitBlock();
   }
 
+  /// In incremental mode, append the finalized prefix of the bitstream
+  /// buffer to the output file so that other processes can observe
+  /// diagnostics while the frontend is still running.
+  ///
+  /// This must only be called when no block is open: exiting a block
+  /// backpatches its length, so bytes are only stable once every enclosing
+  /// block has been exited.
+  void flushCompletedBlocks() {
+    if (!State->EmitIncrementally)
+      return;
+    if (!State->StreamedOS) {
+      std::error_code EC;
+      State->StreamedOS.reset(new llvm::raw_fd_ostream(
+          State->SerializedDiagnosticsPath, EC, llvm::sys::fs::F_None));
+      if (EC) {
+        // Fall back to writing the file on frontend exit, which will
+        // diagnose the failure to open the path.
+        State->EmitIncrementally = false;
+        State->StreamedOS.reset();
+        return;
+      }
+    }
+    assert(State->Stream.GetCurrentBitNo() % 32 == 0 &&
+           "flushing a partially-written word");
+    State->StreamedOS->write(State->Buffer.data() + State->FlushedSize,
+                             State->Buffer.size() - State->FlushedSize);
+    State->StreamedOS->flush();
+    State->FlushedSize = State->Buffer.size();
+  }
+
   // Record identifier for the file.
   unsigned getEmitFile(StringRef Filename);
 
@@ -205,8 +261,10 @@ private:
 
 namespace swift {
 namespace serialized_diagnostics {
-  std::unique_ptr<DiagnosticConsumer> createConsumer(StringRef outputPath) {
-    return std::make_unique<SerializedDiagnosticConsumer>(outputPath);
+  std::unique_ptr<DiagnosticConsumer> createConsumer(StringRef outputPath,
+                                                     bool emitIncrementally) {
+    return std::make_unique<SerializedDiagnosticConsumer>(outputPath,
+                                                          emitIncrementally);
   }
 } // namespace serialized_diagnostics
 } // namespace swift
@@ -513,8 +571,12 @@ void SerializedDiagnosticConsumer::handleDiagnostic(
   // than waiting for beginDiagnostic, in case associated notes
   // are emitted before we get there.
   if (Info.Kind != DiagnosticKind::Note) {
-    if (State->EmittedAnyDiagBlocks)
+    if (State->EmittedAnyDiagBlocks) {
       exitDiagBlock();
+      // The previous diagnostic and its notes are now final; stream them out
+      // if we're emitting incrementally.
+      flushCompletedBlocks();
+    }
 
     enterDiagBlock();
     State->EmittedAnyDiagBlocks = true;
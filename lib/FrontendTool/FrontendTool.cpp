@@ -36,6 +36,8 @@
 #include "swift/AST/IRGenRequests.h"
 #include "swift/AST/NameLookup.h"
 #include "swift/AST/ASTMangler.h"
+#include "swift/AST/Pattern.h"
+#include "swift/AST/TypeRepr.h"
 #include "swift/AST/TBDGenRequests.h"
 #include "swift/AST/TypeRefinementContext.h"
 #include "swift/Basic/Dwarf.h"
@@ -507,6 +509,68 @@ static bool dumpAST(CompilerInstance &Instance) {
   return Instance.getASTContext().hadError();
 }
 
+/// Prints the imports and top-level declaration names of the given file, one
+/// per line. The output is consumed by the driver to build a provisional
+/// dependency graph for scheduling before any type checking has run.
+static void printDeclSkeleton(SourceFile &SF, raw_ostream &out) {
+  for (Decl *D : SF.getTopLevelDecls()) {
+    if (auto *ID = dyn_cast<ImportDecl>(D)) {
+      // Only the top-level module name matters (i.e. A in A.B.C).
+      out << "import " << ID->getModulePath().front().Item << "\n";
+      continue;
+    }
+    if (auto *PBD = dyn_cast<PatternBindingDecl>(D)) {
+      for (unsigned i = 0, e = PBD->getNumPatternEntries(); i != e; ++i) {
+        PBD->getPattern(i)->forEachVariable(
+            [&](VarDecl *VD) { out << "provides " << VD->getName() << "\n"; });
+      }
+      continue;
+    }
+    if (auto *ED = dyn_cast<ExtensionDecl>(D)) {
+      // The extended type hasn't been resolved; print the type as written.
+      out << "extends ";
+      if (auto *repr = ED->getExtendedTypeRepr())
+        repr->print(out);
+      out << "\n";
+      continue;
+    }
+    if (auto *OD = dyn_cast<OperatorDecl>(D)) {
+      out << "provides " << OD->getName() << "\n";
+      continue;
+    }
+    if (auto *PGD = dyn_cast<PrecedenceGroupDecl>(D)) {
+      out << "provides " << PGD->getName() << "\n";
+      continue;
+    }
+    // Variables are covered by their pattern binding above.
+    if (isa<VarDecl>(D))
+      continue;
+    if (auto *VD = dyn_cast<ValueDecl>(D)) {
+      if (VD->getName())
+        out << "provides " << VD->getName() << "\n";
+      continue;
+    }
+  }
+}
+
+/// Dumps the decl skeleton of all available primary source files. If
+/// corresponding output files were specified, use them; otherwise, dump the
+/// skeleton to stdout. Function and type bodies are never parsed in this mode.
+static bool dumpDeclSkeleton(CompilerInstance &Instance) {
+  auto primaryFiles = Instance.getPrimarySourceFiles();
+  if (!primaryFiles.empty()) {
+    for (SourceFile *sourceFile : primaryFiles) {
+      auto PSPs = Instance.getPrimarySpecificPathsForSourceFile(*sourceFile);
+      auto OutputFilename = PSPs.OutputFilename;
+      auto OS = getFileOutputStream(OutputFilename, Instance.getASTContext());
+      printDeclSkeleton(*sourceFile, *OS);
+    }
+  } else {
+    printDeclSkeleton(getPrimaryOrMainSourceFile(Instance), llvm::outs());
+  }
+  return Instance.getASTContext().hadError();
+}
+
 static bool emitReferenceDependencies(CompilerInstance &Instance,
                                       SourceFile *const SF,
                                       StringRef outputPath) {
@@ -1127,13 +1191,19 @@ static bool performAction(CompilerInstance &Instance,
   case FrontendOptions::ActionType::DumpTypeRefinementContexts:
     return withSemanticAnalysis(
         Instance, observer, [](CompilerInstance &Instance) {
-          getPrimaryOrMainSourceFile(Instance).getTypeRefinementContext()->dump(
+          auto &SF = getPrimaryOrMainSourceFile(Instance);
+          // The hierarchy is built lazily during type checking; force the
+          // rest of it so the dump covers the whole file.
+          buildTypeRefinementContexts(SF);
+          SF.getTypeRefinementContext()->dump(
               llvm::errs(), Instance.getASTContext().SourceMgr);
           return Instance.getASTContext().hadError();
         });
   case FrontendOptions::ActionType::DumpInterfaceHash:
     getPrimaryOrMainSourceFile(Instance).dumpInterfaceHash(llvm::errs());
     return Context.hadError();
+  case FrontendOptions::ActionType::DumpDeclSkeleton:
+    return dumpDeclSkeleton(Instance);
   case FrontendOptions::ActionType::EmitSyntax:
     return emitSyntax(getPrimaryOrMainSourceFile(Instance),
                       opts.InputsAndOutputs.getSingleOutputFilename());
@@ -1682,15 +1752,17 @@ createDispatchingDiagnosticConsumerIfNeeded(
 /// If no serialized diagnostics are being produced, returns null.
 static std::unique_ptr<DiagnosticConsumer>
 createSerializedDiagnosticConsumerIfNeeded(
-    const FrontendInputsAndOutputs &inputsAndOutputs) {
+    const FrontendInputsAndOutputs &inputsAndOutputs,
+    bool emitIncrementally) {
   return createDispatchingDiagnosticConsumerIfNeeded(
       inputsAndOutputs,
-      [](const InputFile &input) -> std::unique_ptr<DiagnosticConsumer> {
+      [emitIncrementally](
+          const InputFile &input) -> std::unique_ptr<DiagnosticConsumer> {
         auto serializedDiagnosticsPath = input.getSerializedDiagnosticsPath();
         if (serializedDiagnosticsPath.empty())
           return nullptr;
         return serialized_diagnostics::createConsumer(
-            serializedDiagnosticsPath);
+            serializedDiagnosticsPath, emitIncrementally);
       });
 }
 
@@ -2003,7 +2075,9 @@ int swift::performFrontend(ArrayRef<const char *> Args,
   // for details.
   std::unique_ptr<DiagnosticConsumer> SerializedConsumerDispatcher =
       createSerializedDiagnosticConsumerIfNeeded(
-        Invocation.getFrontendOptions().InputsAndOutputs);
+        Invocation.getFrontendOptions().InputsAndOutputs,
+        Invocation.getDiagnosticOptions()
+            .EmitSerializedDiagnosticsIncrementally);
   if (SerializedConsumerDispatcher)
     Instance->addDiagnosticConsumer(SerializedConsumerDispatcher.get());
 
@@ -34,9 +34,11 @@
 #include "llvm/ADT/StringSet.h"
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/StringSaver.h"
 #include "llvm/Support/YAMLTraits.h"
 #include "llvm/Support/YAMLParser.h"
+#include <chrono>
 #include <set>
 
 using namespace swift;
@@ -794,6 +796,251 @@ bool swift::batchScanModuleDependencies(CompilerInstance &instance,
   return false;
 }
 
+namespace {
+/// A flattened snapshot of a single scanned module, suitable for YAML
+/// serialization. Only the fields relevant to the module's kind are
+/// populated; the rest stay empty.
+struct SerializedScannedModule {
+  std::string name;
+  ModuleDependenciesKind kind;
+  std::vector<std::string> moduleDependencies;
+  // Swift textual (interface) modules.
+  std::string swiftInterfaceFile;
+  std::vector<std::string> compiledModuleCandidates;
+  std::vector<std::string> buildCommandLine;
+  std::vector<std::string> extraPCMArgs;
+  std::string contextHash;
+  bool isFramework = false;
+  // Swift binary and placeholder modules.
+  std::string compiledModulePath;
+  std::string moduleDocPath;
+  std::string sourceInfoPath;
+  // Clang modules.
+  std::string moduleMapFile;
+  std::vector<std::string> nonPathCommandLine;
+  std::vector<std::string> fileDependencies;
+};
+
+/// The root document of a serialized dependency scanner cache: the time the
+/// scan was taken, used to revalidate entries on reload, and the modules
+/// themselves.
+struct SerializedScannerCache {
+  uint64_t scanTimestamp = 0;
+  std::vector<SerializedScannedModule> modules;
+};
+} // namespace
+
+LLVM_YAML_IS_SEQUENCE_VECTOR(SerializedScannedModule)
+
+namespace llvm {
+namespace yaml {
+template <>
+struct ScalarEnumerationTraits<ModuleDependenciesKind> {
+  static void enumeration(IO &io, ModuleDependenciesKind &kind) {
+    io.enumCase(kind, "swiftTextual", ModuleDependenciesKind::SwiftTextual);
+    io.enumCase(kind, "swiftBinary", ModuleDependenciesKind::SwiftBinary);
+    io.enumCase(kind, "swiftPlaceholder",
+                ModuleDependenciesKind::SwiftPlaceholder);
+    io.enumCase(kind, "clang", ModuleDependenciesKind::Clang);
+  }
+};
+
+template <>
+struct MappingTraits<SerializedScannedModule> {
+  static void mapping(IO &io, SerializedScannedModule &M) {
+    io.mapRequired("name", M.name);
+    io.mapRequired("kind", M.kind);
+    io.mapOptional("moduleDependencies", M.moduleDependencies);
+    io.mapOptional("swiftInterfaceFile", M.swiftInterfaceFile);
+    io.mapOptional("compiledModuleCandidates", M.compiledModuleCandidates);
+    io.mapOptional("buildCommandLine", M.buildCommandLine);
+    io.mapOptional("extraPCMArgs", M.extraPCMArgs);
+    io.mapOptional("contextHash", M.contextHash);
+    io.mapOptional("isFramework", M.isFramework);
+    io.mapOptional("compiledModulePath", M.compiledModulePath);
+    io.mapOptional("moduleDocPath", M.moduleDocPath);
+    io.mapOptional("sourceInfoPath", M.sourceInfoPath);
+    io.mapOptional("moduleMapFile", M.moduleMapFile);
+    io.mapOptional("nonPathCommandLine", M.nonPathCommandLine);
+    io.mapOptional("fileDependencies", M.fileDependencies);
+  }
+};
+
+template <>
+struct MappingTraits<SerializedScannerCache> {
+  static void mapping(IO &io, SerializedScannerCache &C) {
+    io.mapRequired("scanTimestamp", C.scanTimestamp);
+    io.mapOptional("modules", C.modules);
+  }
+};
+} // namespace yaml
+} // namespace llvm
+
+/// Retrieve \p path's last modification time in nanoseconds since the epoch,
+/// or None if the file cannot be stat'ed.
+static Optional<uint64_t> getFileModTime(StringRef path) {
+  llvm::sys::fs::file_status status;
+  if (llvm::sys::fs::status(path, status))
+    return None;
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             status.getLastModificationTime().time_since_epoch())
+      .count();
+}
+
+/// Check that every file a cached scanner entry was derived from still exists
+/// and has not been touched since the scan that produced the cache.
+static bool isCacheEntryUpToDate(const SerializedScannedModule &module,
+                                 uint64_t scanTimestamp) {
+  auto isUnchanged = [&](StringRef path) {
+    auto modTime = getFileModTime(path);
+    return modTime && *modTime <= scanTimestamp;
+  };
+  switch (module.kind) {
+  case ModuleDependenciesKind::SwiftTextual:
+    return !module.swiftInterfaceFile.empty() &&
+           isUnchanged(module.swiftInterfaceFile);
+  case ModuleDependenciesKind::SwiftBinary:
+  case ModuleDependenciesKind::SwiftPlaceholder:
+    return !module.compiledModulePath.empty() &&
+           isUnchanged(module.compiledModulePath);
+  case ModuleDependenciesKind::Clang:
+    return !module.moduleMapFile.empty() && isUnchanged(module.moduleMapFile) &&
+           llvm::all_of(module.fileDependencies, isUnchanged);
+  }
+  llvm_unreachable("Unhandled ModuleDependenciesKind in switch.");
+}
+
+/// Pre-populate the module dependencies cache from a serialized cache left
+/// behind by a previous scan, dropping any entries whose inputs have changed
+/// since that scan. Entries loaded here short-circuit rescanning: the scanner
+/// consults the cache before touching the filesystem for a module.
+static void loadDependencyScannerCacheIfPossible(CompilerInstance &instance,
+                                                 ModuleDependenciesCache &cache) {
+  const FrontendOptions &opts = instance.getInvocation().getFrontendOptions();
+  StringRef path = opts.DependencyScannerCachePath;
+  if (path.empty())
+    return;
+
+  auto bufferOrErr = llvm::MemoryBuffer::getFile(path);
+  if (!bufferOrErr)
+    return;
+
+  SerializedScannerCache loaded;
+  Input yin(bufferOrErr.get()->getBuffer());
+  yin >> loaded;
+  if (yin.error())
+    return;
+
+  for (const auto &module : loaded.modules) {
+    if (cache.findDependencies(module.name, module.kind))
+      continue;
+    if (!isCacheEntryUpToDate(module, loaded.scanTimestamp))
+      continue;
+
+    Optional<ModuleDependencies> deps;
+    switch (module.kind) {
+    case ModuleDependenciesKind::SwiftTextual: {
+      std::vector<StringRef> buildCommandLine(module.buildCommandLine.begin(),
+                                              module.buildCommandLine.end());
+      std::vector<StringRef> extraPCMArgs(module.extraPCMArgs.begin(),
+                                          module.extraPCMArgs.end());
+      deps = ModuleDependencies::forSwiftInterface(
+          module.swiftInterfaceFile, module.compiledModuleCandidates,
+          buildCommandLine, extraPCMArgs, module.contextHash,
+          module.isFramework);
+      break;
+    }
+    case ModuleDependenciesKind::SwiftBinary:
+      deps = ModuleDependencies::forSwiftBinaryModule(
+          module.compiledModulePath, module.moduleDocPath,
+          module.sourceInfoPath, module.isFramework);
+      break;
+    case ModuleDependenciesKind::SwiftPlaceholder:
+      deps = ModuleDependencies::forPlaceholderSwiftModuleStub(
+          module.compiledModulePath, module.moduleDocPath,
+          module.sourceInfoPath);
+      break;
+    case ModuleDependenciesKind::Clang:
+      deps = ModuleDependencies::forClangModule(
+          module.moduleMapFile, module.contextHash, module.nonPathCommandLine,
+          module.fileDependencies);
+      break;
+    }
+    for (const auto &dep : module.moduleDependencies)
+      deps->addModuleDependency(dep, /*alreadyAddedModules=*/nullptr);
+    cache.recordDependencies(module.name, std::move(*deps));
+  }
+}
+
+/// Serialize the module dependencies cache to \c DependencyScannerCachePath so
+/// a subsequent scan can start from it. The main module and any entry we could
+/// not revalidate on reload (a textual module without an interface file, say)
+/// are omitted.
+static void serializeDependencyScannerCache(CompilerInstance &instance,
+                                            const ModuleDependenciesCache &cache) {
+  const FrontendOptions &opts = instance.getInvocation().getFrontendOptions();
+  StringRef path = opts.DependencyScannerCachePath;
+  if (path.empty())
+    return;
+
+  SerializedScannerCache result;
+  result.scanTimestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                             std::chrono::system_clock::now().time_since_epoch())
+                             .count();
+
+  StringRef mainModuleName = instance.getMainModule()->getNameStr();
+  for (const auto &moduleID : cache.getAllModules()) {
+    auto deps = cache.findDependencies(moduleID.first, moduleID.second);
+    if (!deps)
+      continue;
+
+    SerializedScannedModule module;
+    module.name = moduleID.first;
+    module.kind = moduleID.second;
+    module.moduleDependencies = deps->getModuleDependencies().vec();
+
+    if (auto *textualDeps = deps->getAsSwiftTextualModule()) {
+      // The main module and any other textual module without an interface
+      // file cannot be revalidated on reload; don't serialize them.
+      if (moduleID.first == mainModuleName ||
+          !textualDeps->swiftInterfaceFile)
+        continue;
+      module.swiftInterfaceFile = *textualDeps->swiftInterfaceFile;
+      module.compiledModuleCandidates = textualDeps->compiledModuleCandidates;
+      module.buildCommandLine = textualDeps->buildCommandLine;
+      module.extraPCMArgs = textualDeps->extraPCMArgs;
+      module.contextHash = textualDeps->contextHash;
+      module.isFramework = textualDeps->isFramework;
+    } else if (auto *binaryDeps = deps->getAsSwiftBinaryModule()) {
+      module.compiledModulePath = binaryDeps->compiledModulePath;
+      module.moduleDocPath = binaryDeps->moduleDocPath;
+      module.sourceInfoPath = binaryDeps->sourceInfoPath;
+      module.isFramework = binaryDeps->isFramework;
+    } else if (auto *placeholderDeps =
+                   deps->getAsPlaceholderDependencyModule()) {
+      module.compiledModulePath = placeholderDeps->compiledModulePath;
+      module.moduleDocPath = placeholderDeps->moduleDocPath;
+      module.sourceInfoPath = placeholderDeps->sourceInfoPath;
+    } else if (auto *clangDeps = deps->getAsClangModule()) {
+      module.moduleMapFile = clangDeps->moduleMapFile;
+      module.contextHash = clangDeps->contextHash;
+      module.nonPathCommandLine = clangDeps->nonPathCommandLine;
+      module.fileDependencies = clangDeps->fileDependencies;
+    }
+    result.modules.push_back(std::move(module));
+  }
+
+  std::error_code EC;
+  llvm::raw_fd_ostream out(path, EC, llvm::sys::fs::F_None);
+  if (EC) {
+    instance.getDiags().diagnose(SourceLoc(), diag::error_opening_output,
+                                 path, EC.message());
+    return;
+  }
+  Output yout(out);
+  yout << result;
+}
+
 bool swift::scanDependencies(CompilerInstance &instance) {
   ASTContext &Context = instance.getASTContext();
   ModuleDecl *mainModule = instance.getMainModule();
@@ -896,6 +1143,12 @@ bool swift::scanDependencies(CompilerInstance &instance) {
   ModuleDependenciesCache *cache = instance.getModuleDependencyCache();
   assert(cache &&
          "Dependency Scanner expected a ModuleDependenciesCache on a compiler instance.");
+
+  // If asked to, warm the cache from the results of a prior scan. Cached
+  // modules whose inputs haven't changed since then won't be rescanned.
+  if (invocation.getFrontendOptions().ReuseDependencyScannerCache)
+    loadDependencyScannerCacheIfPossible(instance, *cache);
+
   cache->recordDependencies(mainModuleName, std::move(mainDependencies));
 
   auto &ctx = instance.getASTContext();
@@ -937,6 +1190,10 @@ bool swift::scanDependencies(CompilerInstance &instance) {
   // Write out the JSON description.
   writeJSON(out, instance, *cache, ASTDelegate, allModules.getArrayRef());
 
+  // If asked to, leave the cache behind for the next scan to start from.
+  if (FEOpts.SerializeDependencyScannerCache)
+    serializeDependencyScannerCache(instance, *cache);
+
   // Update the dependency tracker.
   if (auto depTracker = instance.getDependencyTracker()) {
     for (auto module : allModules) {
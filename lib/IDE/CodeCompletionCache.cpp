@@ -39,7 +39,8 @@ namespace swift {
     struct CacheValueCostInfo<swift::ide::CodeCompletionCacheImpl::Value> {
       static size_t
       getCost(const swift::ide::CodeCompletionCacheImpl::Value &V) {
-        return V.Sink.Allocator->getTotalMemory();
+        return V.Sink.Allocator->getTotalMemory() +
+               (V.BackingBuffer ? V.BackingBuffer->getBufferSize() : 0);
       }
     };
   } // namespace sys
@@ -103,8 +104,14 @@ CodeCompletionCache::~CodeCompletionCache() {}
 static constexpr uint32_t onDiskCompletionCacheVersion = 1;
 
 /// Deserializes CodeCompletionResults from \p in and stores them in \p V.
+///
+/// On success, takes ownership of \p in: strings in the deserialized results
+/// point directly into the (typically memory-mapped) buffer rather than being
+/// copied into the sink's allocator, so the buffer is retained as the value's
+/// backing store.
+///
 /// \see writeCacheModule.
-static bool readCachedModule(llvm::MemoryBuffer *in,
+static bool readCachedModule(std::unique_ptr<llvm::MemoryBuffer> in,
                              const CodeCompletionCache::Key &K,
                              CodeCompletionCache::Value &V,
                              bool allowOutOfDate = false) {
@@ -159,7 +166,8 @@ static bool readCachedModule(llvm::MemoryBuffer *in,
 
     const char *p = strings + index;
     auto size = read32le(p);
-    return copyString(*V.Sink.Allocator, StringRef(p, size));
+    // Reference the backing buffer directly rather than copying.
+    return StringRef(p, size);
   };
 
   // CHUNKS
@@ -241,6 +249,8 @@ static bool readCachedModule(llvm::MemoryBuffer *in,
     V.Sink.Results.push_back(result);
   }
 
+  // The results reference strings in the buffer, so keep it alive.
+  V.BackingBuffer = std::move(in);
   return true;
 }
 
@@ -425,14 +435,17 @@ static std::string getName(StringRef cacheDirectory,
 
 Optional<CodeCompletionCache::ValueRefCntPtr>
 OnDiskCodeCompletionCache::get(const Key &K) {
-  // Try to find the cached file.
-  auto bufferOrErr = llvm::MemoryBuffer::getFile(getName(cacheDirectory, K));
+  // Try to find the cached file. The reader doesn't need null termination, so
+  // the file can be memory-mapped instead of read into memory up front.
+  auto bufferOrErr =
+      llvm::MemoryBuffer::getFile(getName(cacheDirectory, K), /*FileSize=*/-1,
+                                  /*RequiresNullTerminator=*/false);
   if (!bufferOrErr)
     return None;
 
   // Read the cached results, failing if they are out of date.
   auto V = CodeCompletionCache::createValue();
-  if (!readCachedModule(bufferOrErr.get().get(), K, *V))
+  if (!readCachedModule(std::move(bufferOrErr.get()), K, *V))
     return None;
 
   return V;
@@ -468,7 +481,8 @@ std::error_code OnDiskCodeCompletionCache::set(const Key &K, ValueRefCntPtr V) {
 Optional<CodeCompletionCache::ValueRefCntPtr>
 OnDiskCodeCompletionCache::getFromFile(StringRef filename) {
   // Try to find the cached file.
-  auto bufferOrErr = llvm::MemoryBuffer::getFile(filename);
+  auto bufferOrErr = llvm::MemoryBuffer::getFile(filename, /*FileSize=*/-1,
+                                                 /*RequiresNullTerminator=*/false);
   if (!bufferOrErr)
     return None;
 
@@ -478,7 +492,7 @@ OnDiskCodeCompletionCache::getFromFile(StringRef filename) {
 
   // Read the cached results.
   auto V = CodeCompletionCache::createValue();
-  if (!readCachedModule(bufferOrErr.get().get(), K, *V,
+  if (!readCachedModule(std::move(bufferOrErr.get()), K, *V,
                         /*allowOutOfDate*/ true))
     return None;
 
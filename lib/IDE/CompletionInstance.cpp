@@ -30,8 +30,11 @@
 #include "swift/Subsystems.h"
 #include "clang/AST/ASTContext.h"
 #include "llvm/ADT/Hashing.h"
+#include "llvm/ADT/STLExtras.h"
 #include "llvm/Support/MemoryBuffer.h"
 
+#include <algorithm>
+
 using namespace swift;
 using namespace ide;
 
@@ -330,14 +333,21 @@ bool CompletionInstance::performCachedOperationIfPossible(
   llvm::PrettyStackTraceString trace(
       "While performing cached completion if possible");
 
-  if (!CachedCI)
-    return false;
-  if (CachedReuseCount >= Opts.MaxASTReuseCount)
+  // Find a warm instance for this invocation and completion buffer.
+  auto bufferName = completionBuffer->getBufferIdentifier();
+  auto entryIt =
+      llvm::find_if(CachedInstances, [&](const CachedInstance &entry) {
+        return entry.ArgHash == ArgsHash && entry.BufferName == bufferName;
+      });
+  if (entryIt == CachedInstances.end())
     return false;
-  if (CachedArgHash != ArgsHash)
+  if (entryIt->ReuseCount >= Opts.MaxASTReuseCount) {
+    CachedInstances.erase(entryIt);
     return false;
+  }
+  auto &entry = *entryIt;
 
-  auto &CI = *CachedCI;
+  auto &CI = *entry.CI;
   auto *oldSF = CI.getCodeCompletionFile();
   assert(oldSF->getBufferID());
 
@@ -346,16 +356,17 @@ bool CompletionInstance::performCachedOperationIfPossible(
   auto &oldInfo = oldState->getCodeCompletionDelayedDeclState();
 
   auto &SM = CI.getSourceMgr();
-  auto bufferName = completionBuffer->getBufferIdentifier();
   if (SM.getIdentifierForBuffer(*oldSF->getBufferID()) != bufferName)
     return false;
 
-  if (shouldCheckDependencies()) {
+  if (shouldCheckDependencies(entry)) {
     if (areAnyDependentFilesInvalidated(
             CI, *FileSystem, *oldSF->getBufferID(),
-            DependencyCheckedTimestamp, InMemoryDependencyHash))
+            entry.DependencyCheckedTimestamp, entry.InMemoryDependencyHash)) {
+      CachedInstances.erase(entryIt);
       return false;
-    DependencyCheckedTimestamp = std::chrono::system_clock::now();
+    }
+    entry.DependencyCheckedTimestamp = std::chrono::system_clock::now();
   }
 
   // Parse the new buffer into temporary SourceFile.
@@ -452,7 +463,9 @@ bool CompletionInstance::performCachedOperationIfPossible(
     auto *AFD = cast<AbstractFunctionDecl>(DC);
     AFD->setBodyToBeReparsed(newBodyRange);
     SM.setReplacedRange({AFD->getOriginalBodySourceRange(), newBodyRange});
-    oldSF->clearScope();
+    // Only the replaced body's scopes are stale; the rest of the scope tree
+    // (and the unqualified lookups cached against it) can be reused.
+    oldSF->invalidateFunctionBodyScope(AFD);
 
     traceDC = AFD;
     break;
@@ -521,7 +534,9 @@ bool CompletionInstance::performCachedOperationIfPossible(
       CI.removeDiagnosticConsumer(DiagC);
   }
 
-  CachedReuseCount += 1;
+  // Mark the instance most recently used.
+  entry.ReuseCount += 1;
+  std::rotate(entryIt, std::next(entryIt), CachedInstances.end());
 
   return true;
 }
@@ -589,23 +604,35 @@ bool CompletionInstance::performNewOperation(
 
 void CompletionInstance::cacheCompilerInstance(
     std::unique_ptr<CompilerInstance> CI, llvm::hash_code ArgsHash) {
-  CachedCI = std::move(CI);
-  CachedArgHash = ArgsHash;
-  auto now = std::chrono::system_clock::now();
-  DependencyCheckedTimestamp = now;
-  CachedReuseCount = 0;
-  InMemoryDependencyHash.clear();
-  cacheDependencyHashIfNeeded(
-      *CachedCI,
-      CachedCI->getASTContext().SourceMgr.getCodeCompletionBufferID(),
-      InMemoryDependencyHash);
+  CachedInstance entry;
+  entry.CI = std::move(CI);
+  entry.ArgHash = ArgsHash;
+  auto &SM = entry.CI->getASTContext().SourceMgr;
+  auto bufferID = SM.getCodeCompletionBufferID();
+  entry.BufferName = SM.getIdentifierForBuffer(bufferID).str();
+  entry.DependencyCheckedTimestamp = std::chrono::system_clock::now();
+  cacheDependencyHashIfNeeded(*entry.CI, bufferID,
+                              entry.InMemoryDependencyHash);
+
+  // Replace any existing instance for the same invocation and buffer, then
+  // evict the least recently used instances when over capacity.
+  CachedInstances.erase(
+      std::remove_if(CachedInstances.begin(), CachedInstances.end(),
+                     [&](const CachedInstance &existing) {
+                       return existing.ArgHash == entry.ArgHash &&
+                              existing.BufferName == entry.BufferName;
+                     }),
+      CachedInstances.end());
+  CachedInstances.push_back(std::move(entry));
+  while (CachedInstances.size() > Opts.MaxCachedInstances)
+    CachedInstances.erase(CachedInstances.begin());
 }
 
-bool CompletionInstance::shouldCheckDependencies() const {
-  assert(CachedCI);
+bool CompletionInstance::shouldCheckDependencies(
+    const CachedInstance &entry) const {
   using namespace std::chrono;
   auto now = system_clock::now();
-  auto threshold = DependencyCheckedTimestamp +
+  auto threshold = entry.DependencyCheckedTimestamp +
                    seconds(Opts.DependencyCheckIntervalSecond);
   return threshold < now;
 }
@@ -304,7 +304,8 @@ bool swift::ide::removeCodeCompletionExpr(ASTContext &Ctx, Expr *&expr) {
 //===----------------------------------------------------------------------===//
 
 void swift::ide::collectPossibleReturnTypesFromContext(
-    DeclContext *DC, SmallVectorImpl<Type> &candidates) {
+    DeclContext *DC, SmallVectorImpl<Type> &candidates,
+    ExprContextAnalysisCache *Cache) {
   if (auto FD = dyn_cast<AbstractFunctionDecl>(DC)) {
     auto Ty = FD->getInterfaceType();
     if (FD->getDeclContext()->isTypeContext())
@@ -346,7 +347,7 @@ void swift::ide::collectPossibleReturnTypesFromContext(
         }
       } else {
         // Otherwise, check the context type of the closure.
-        ExprContextInfo closureCtxInfo(CE->getParent(), CE);
+        ExprContextInfo closureCtxInfo(CE->getParent(), CE, Cache);
         for (auto closureTy : closureCtxInfo.getPossibleTypes()) {
           if (auto funcTy = closureTy->getAs<AnyFunctionType>())
             candidates.push_back(funcTy->getResult());
@@ -583,7 +584,8 @@ static void collectPossibleCalleesByQualifiedLookup(
 /// declarations.
 static bool collectPossibleCalleesForUnresolvedMember(
     DeclContext &DC, UnresolvedMemberExpr *unresolvedMemberExpr,
-    SmallVectorImpl<FunctionTypeAndDecl> &candidates) {
+    SmallVectorImpl<FunctionTypeAndDecl> &candidates,
+    ExprContextAnalysisCache *Cache) {
   auto collectMembers = [&](Type expectedTy) {
     if (!expectedTy->mayHaveMembers())
       return;
@@ -593,7 +595,7 @@ static bool collectPossibleCalleesForUnresolvedMember(
   };
 
   // Get the context of the expression itself.
-  ExprContextInfo contextInfo(&DC, unresolvedMemberExpr);
+  ExprContextInfo contextInfo(&DC, unresolvedMemberExpr, Cache);
   for (auto expectedTy : contextInfo.getPossibleTypes()) {
     collectMembers(expectedTy);
     // If this is an optional type, let's also check its base type.
@@ -607,7 +609,8 @@ static bool collectPossibleCalleesForUnresolvedMember(
 /// For the given \c callExpr, collect possible callee types and declarations.
 static bool collectPossibleCalleesForApply(
     DeclContext &DC, ApplyExpr *callExpr,
-    SmallVectorImpl<FunctionTypeAndDecl> &candidates) {
+    SmallVectorImpl<FunctionTypeAndDecl> &candidates,
+    ExprContextAnalysisCache *Cache) {
   auto *fnExpr = callExpr->getFn();
 
   if (auto *DRE = dyn_cast<DeclRefExpr>(fnExpr)) {
@@ -646,7 +649,7 @@ static bool collectPossibleCalleesForApply(
     collectPossibleCalleesByQualifiedLookup(
         DC, CRCE->getArg(), DeclNameRef::createConstructor(), candidates);
   } else if (auto *UME = dyn_cast<UnresolvedMemberExpr>(fnExpr)) {
-    collectPossibleCalleesForUnresolvedMember(DC, UME, candidates);
+    collectPossibleCalleesForUnresolvedMember(DC, UME, candidates, Cache);
   }
 
   if (!candidates.empty())
@@ -752,6 +755,9 @@ class ExprContextAnalyzer {
   Expr *&AnalyzedExpr;
   bool &implicitSingleExpressionReturn;
 
+  /// Memoizes the analyses of enclosing expressions this one recurses into.
+  ExprContextAnalysisCache *Cache;
+
   void recordPossibleType(Type ty) {
     if (!ty || ty->is<ErrorType>())
       return;
@@ -769,7 +775,7 @@ class ExprContextAnalyzer {
     SmallVector<FunctionTypeAndDecl, 2> Candidates;
     Expr *Arg = nullptr;
     if (auto *applyExpr = dyn_cast<ApplyExpr>(E)) {
-      if (!collectPossibleCalleesForApply(*DC, applyExpr, Candidates))
+      if (!collectPossibleCalleesForApply(*DC, applyExpr, Candidates, Cache))
         return false;
       Arg = applyExpr->getArg();
     } else if (auto *subscriptExpr = dyn_cast<SubscriptExpr>(E)) {
@@ -865,7 +871,7 @@ class ExprContextAnalyzer {
       }
 
       // Check context types of the array literal expression.
-      ExprContextInfo arrayCtxtInfo(DC, Parent);
+      ExprContextInfo arrayCtxtInfo(DC, Parent, Cache);
       for (auto arrayT : arrayCtxtInfo.getPossibleTypes()) {
         if (auto boundGenericT = arrayT->getAs<BoundGenericType>()) {
           // let _: [Element] = [#HERE#]
@@ -883,7 +889,7 @@ class ExprContextAnalyzer {
     }
     case ExprKind::Dictionary: {
       // Check context types of the dictionary literal expression.
-      ExprContextInfo dictCtxtInfo(DC, Parent);
+      ExprContextInfo dictCtxtInfo(DC, Parent, Cache);
 
       for (auto dictT : dictCtxtInfo.getPossibleTypes()) {
         if (auto boundGenericT = dictT->getAs<BoundGenericType>()) {
@@ -918,7 +924,7 @@ class ExprContextAnalyzer {
         recordPossibleType(Context.getBoolDecl()->getDeclaredInterfaceType());
         break;
       }
-      ExprContextInfo ternaryCtxtInfo(DC, Parent);
+      ExprContextInfo ternaryCtxtInfo(DC, Parent, Cache);
       for (auto ternaryT : ternaryCtxtInfo.getPossibleTypes())
         recordPossibleType(ternaryT);
       break;
@@ -948,7 +954,7 @@ class ExprContextAnalyzer {
       if (Parent->getType() && Parent->getType()->is<TupleType>()) {
         tupleT = Parent->getType()->castTo<TupleType>();
       } else {
-        ExprContextInfo tupleCtxtInfo(DC, Parent);
+        ExprContextInfo tupleCtxtInfo(DC, Parent, Cache);
         for (auto possibleT : tupleCtxtInfo.getPossibleTypes()) {
           if (auto possibleTupleT = possibleT->getAs<TupleType>()) {
             tupleT = possibleTupleT;
@@ -973,7 +979,7 @@ class ExprContextAnalyzer {
       assert(hasImplicitSingleExpressionReturn(CE->getBody()));
       implicitSingleExpressionReturn = true;
       SmallVector<Type, 2> candidates;
-      collectPossibleReturnTypesFromContext(CE, candidates);
+      collectPossibleReturnTypesFromContext(CE, candidates, Cache);
       for (auto ty : candidates)
         recordPossibleType(ty);
       break;
@@ -987,7 +993,7 @@ class ExprContextAnalyzer {
     switch (Parent->getKind()) {
     case StmtKind::Return: {
       SmallVector<Type, 2> candidates;
-      collectPossibleReturnTypesFromContext(DC, candidates);
+      collectPossibleReturnTypesFromContext(DC, candidates, Cache);
       for (auto ty : candidates)
         recordPossibleType(ty);
       break;
@@ -1055,7 +1061,7 @@ class ExprContextAnalyzer {
         assert(hasImplicitSingleExpressionReturn(FD->getBody()));
         implicitSingleExpressionReturn = true;
         SmallVector<Type, 2> candidates;
-        collectPossibleReturnTypesFromContext(DC, candidates);
+        collectPossibleReturnTypesFromContext(DC, candidates, Cache);
         for (auto ty : candidates)
           recordPossibleType(ty);
         break;
@@ -1142,12 +1148,14 @@ public:
       DeclContext *DC, Expr *ParsedExpr, SmallVectorImpl<Type> &PossibleTypes,
       SmallVectorImpl<PossibleParamInfo> &PossibleArgs,
       SmallVectorImpl<FunctionTypeAndDecl> &PossibleCallees,
-      Expr *&AnalyzedExpr, bool &implicitSingleExpressionReturn)
+      Expr *&AnalyzedExpr, bool &implicitSingleExpressionReturn,
+      ExprContextAnalysisCache *Cache)
       : DC(DC), ParsedExpr(ParsedExpr), SM(DC->getASTContext().SourceMgr),
         Context(DC->getASTContext()), PossibleTypes(PossibleTypes),
         PossibleParams(PossibleArgs), PossibleCallees(PossibleCallees),
         AnalyzedExpr(AnalyzedExpr),
-        implicitSingleExpressionReturn(implicitSingleExpressionReturn) {}
+        implicitSingleExpressionReturn(implicitSingleExpressionReturn),
+        Cache(Cache) {}
 
   void Analyze() {
     // We cannot analyze without target.
@@ -1253,9 +1261,26 @@ public:
 
 } // end anonymous namespace
 
-ExprContextInfo::ExprContextInfo(DeclContext *DC, Expr *TargetExpr) {
+ExprContextInfo::ExprContextInfo(DeclContext *DC, Expr *TargetExpr,
+                                 ExprContextAnalysisCache *Cache) {
+  // If the caller didn't provide a cache, create one for the recursion into
+  // the contexts of enclosing expressions.
+  Optional<ExprContextAnalysisCache> OwnedCache;
+  if (!Cache) {
+    OwnedCache.emplace();
+    Cache = OwnedCache.getPointer();
+  }
+
+  auto Key = std::make_pair(DC, TargetExpr);
+  auto Cached = Cache->Results.find(Key);
+  if (Cached != Cache->Results.end()) {
+    *this = Cached->second;
+    return;
+  }
+
   ExprContextAnalyzer Analyzer(DC, TargetExpr, PossibleTypes, PossibleParams,
                                PossibleCallees, AnalyzedExpr,
-                               implicitSingleExpressionReturn);
+                               implicitSingleExpressionReturn, Cache);
   Analyzer.Analyze();
+  Cache->Results.insert({Key, *this});
 }
@@ -17,6 +17,7 @@
 #include "swift/AST/Types.h"
 #include "swift/Basic/LLVM.h"
 #include "swift/Basic/SourceLoc.h"
+#include "llvm/ADT/DenseMap.h"
 
 namespace swift {
 class DeclContext;
@@ -25,6 +26,7 @@ class ValueDecl;
 
 namespace ide {
 enum class SemanticContextKind;
+class ExprContextAnalysisCache;
 
 /// Type check parent contexts of the given decl context, and the body of the
 /// given context until \c Loc if the context is a function body.
@@ -43,8 +45,12 @@ bool removeCodeCompletionExpr(ASTContext &Ctx, Expr *&expr);
 
 /// Collects possible expected return types of the given decl context.
 /// \p DC should be an \c AbstractFunctionDecl or an \c AbstractClosureExpr.
+/// \p Cache, if non-null, memoizes the context analyses this may perform for
+/// closures without an explicit result type.
 void collectPossibleReturnTypesFromContext(DeclContext *DC,
-                                           SmallVectorImpl<Type> &candidates);
+                                           SmallVectorImpl<Type> &candidates,
+                                           ExprContextAnalysisCache *Cache =
+                                               nullptr);
 
 struct FunctionTypeAndDecl {
   AnyFunctionType *Type;
@@ -85,7 +91,12 @@ class ExprContextInfo {
   bool implicitSingleExpressionReturn = false;
 
 public:
-  ExprContextInfo(DeclContext *DC, Expr *TargetExpr);
+  /// Analyzes the context of \p TargetExpr. If \p Cache is null, the analysis
+  /// creates its own cache for the recursion into enclosing expressions;
+  /// passing an explicit cache additionally shares analyses between several
+  /// \c ExprContextInfo instances on the same type-checked AST.
+  ExprContextInfo(DeclContext *DC, Expr *TargetExpr,
+                  ExprContextAnalysisCache *Cache = nullptr);
 
   // Returns a list of possible context types.
   ArrayRef<Type> getPossibleTypes() const { return PossibleTypes; }
@@ -116,6 +127,23 @@ public:
   }
 };
 
+/// Memoizes \c ExprContextInfo analyses performed while answering a single
+/// completion-like request.
+///
+/// Analyzing the context of an expression recurses into the contexts of its
+/// ancestors (array/dictionary/tuple literals, ternary expressions,
+/// unresolved members, and single-expression closures). Without memoization
+/// each nesting level re-analyzes -- and possibly re-type checks -- every
+/// level above it.
+///
+/// The cache is only valid as long as the AST it was computed from is not
+/// mutated by further parsing or type checking, so it must not outlive the
+/// request it was created for.
+class ExprContextAnalysisCache {
+  friend class ExprContextInfo;
+  llvm::DenseMap<std::pair<DeclContext *, Expr *>, ExprContextInfo> Results;
+};
+
 } // namespace ide
 } // namespace swift
 
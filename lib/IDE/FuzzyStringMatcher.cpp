@@ -14,6 +14,7 @@
 #include "clang/Basic/CharInfo.h"
 #include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/SmallString.h"
+#include <cstring>
 
 using namespace swift;
 using namespace swift::ide;
@@ -57,17 +58,32 @@ bool FuzzyStringMatcher::matchesCandidate(StringRef candidate) const {
   if (patternLength > candidateLength)
     return false;
 
-  // Do all of the pattern characters match the candidate in order?
-  unsigned pidx = 0, cidx = 0;
-  while (pidx < patternLength && cidx < candidateLength) {
-    char c = candidate[cidx];
-    char p = lowercasePattern[pidx];
-    if (p == c || p == toLowercase(c))
-      ++pidx;
-    ++cidx;
+  // Do all of the pattern characters match the candidate in order? Scanning
+  // for each pattern character with memchr lets the C library use vector
+  // loads to skip runs of non-matching characters, which is where nearly all
+  // of the time goes when filtering a large result list against a short
+  // pattern: most candidates are rejected without ever being read a byte at
+  // a time.
+  const char *cursor = candidate.begin();
+  const char *end = candidate.end();
+  for (unsigned pidx = 0; pidx < patternLength; ++pidx) {
+    char lower = lowercasePattern[pidx];
+    const char *next =
+        static_cast<const char *>(::memchr(cursor, lower, end - cursor));
+    char upper = toUppercase(lower);
+    if (upper != lower) {
+      // Take whichever case variant appears first.
+      const char *limit = next ? next : end;
+      if (const char *upperNext = static_cast<const char *>(
+              ::memchr(cursor, upper, limit - cursor)))
+        next = upperNext;
+    }
+    if (!next)
+      return false;
+    cursor = next + 1;
   }
 
-  return pidx == patternLength;
+  return true;
 }
 
 static bool isTokenizingChar(char c) {
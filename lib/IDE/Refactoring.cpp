@@ -631,6 +631,11 @@ public:
 
   RenameRangeCollector(const ValueDecl *D, StringRef newName)
       : newName(newName.str()) {
+    // Only pay for indexing local symbols when the rename target is itself
+    // local; a non-local symbol's occurrences can never be reported as local
+    // symbols, and skipping them avoids building an index symbol (USR and
+    // all) for every local variable in the scope being searched.
+    includeLocals = index::isLocalSymbol(D);
     llvm::raw_string_ostream OS(USR);
     printValueDeclUSR(D, OS);
   }
@@ -638,7 +643,7 @@ public:
   ArrayRef<RenameLoc> results() const { return locations; }
 
 private:
-  bool indexLocals() override { return true; }
+  bool indexLocals() override { return includeLocals; }
   void failed(StringRef error) override {}
   bool startDependency(StringRef name, StringRef path, bool isClangModule, bool isSystem) override {
     return true;
@@ -664,6 +669,7 @@ private:
 private:
   std::string USR;
   std::string newName;
+  bool includeLocals = true;
   StringScratchSpace stringStorage;
   std::vector<RenameLoc> locations;
 };
@@ -17,6 +17,7 @@
 #include "llvm/IR/Constants.h"
 
 #include "GenConstant.h"
+#include "GenEnum.h"
 #include "GenIntegerLiteral.h"
 #include "GenStruct.h"
 #include "GenTuple.h"
@@ -159,6 +160,18 @@ static llvm::Constant *emitConstantValue(IRGenModule &IGM, SILValue operand) {
     auto *val = emitConstantValue(IGM, VTBI->getOperand());
     auto *sTy = IGM.getTypeInfo(VTBI->getType()).getStorageType();
     return llvm::ConstantExpr::getIntToPtr(val, sTy);
+  } else if (auto *EI = dyn_cast<EnumInst>(operand)) {
+    assert(!EI->hasOperand() &&
+           "enum case with payload is not a constant");
+    auto &strategy = getEnumImplStrategy(IGM, EI->getType());
+    auto bitPattern = strategy.getBitPatternForNoPayloadElement(EI->getElement());
+    auto *sTy = IGM.getTypeInfo(EI->getType()).getStorageType();
+    // A single-case enum is empty and has no significant bits.
+    if (bitPattern.size() == 0)
+      return llvm::UndefValue::get(sTy);
+    auto *intTy = cast<llvm::IntegerType>(sTy);
+    return llvm::ConstantInt::get(
+        intTy, bitPattern.asAPInt().zextOrTrunc(intTy->getBitWidth()));
   } else {
     llvm_unreachable("Unsupported SILInstruction in static initializer!");
   }
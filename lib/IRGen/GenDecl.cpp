@@ -1323,9 +1323,15 @@ void IRGenerator::addLazyFunction(SILFunction *f) {
   if (const SILFunction *orig = f->getOriginOfSpecialization()) {
     // f is a specialization. Try to emit all specializations of the same
     // original function into the same IGM. This increases the chances that
-    // specializations are merged by LLVM's function merging.
-    auto iter =
-      IGMForSpecializations.insert(std::make_pair(orig, CurrentIGM)).first;
+    // specializations are merged by LLVM's function merging. The first
+    // specialization of a family picks the least-loaded IGM, so these shared
+    // definitions spread across the output files instead of piling into
+    // whichever module happened to reference them first.
+    auto iter = IGMForSpecializations.find(orig);
+    if (iter == IGMForSpecializations.end())
+      iter = IGMForSpecializations
+                 .insert(std::make_pair(orig, pickLeastLoadedIGM(f)))
+                 .first;
     DefaultIGMForFunction.insert(std::make_pair(f, iter->second));
     return;
   }
@@ -1337,8 +1343,14 @@ void IRGenerator::addLazyFunction(SILFunction *f) {
   if (CurrentIGM == nullptr)
     return;
 
+  // Shared functions can be emitted into any output file; balance them by
+  // estimated cost. Everything else stays in the IGM which referenced it
+  // first.
+  IRGenModule *IGM = hasSharedVisibility(f->getLinkage())
+                         ? pickLeastLoadedIGM(f)
+                         : CurrentIGM;
   // Don't update the map if we already have an entry.
-  DefaultIGMForFunction.insert(std::make_pair(f, CurrentIGM));
+  DefaultIGMForFunction.insert(std::make_pair(f, IGM));
 }
 
 bool IRGenerator::hasLazyMetadata(TypeDecl *type) {
@@ -2944,6 +2956,13 @@ llvm::Function *IRGenModule::getAddrOfSILFunction(
   fn = createFunction(*this, link, signature, insertBefore,
                       f->getOptimizationMode());
 
+  // A reabstraction thunk is identified purely by its mangled name and
+  // nothing relies on its address identity, so mark it unnamed_addr. This
+  // lets LLVM's function merging and linker-level identical code folding
+  // collapse thunks with different manglings that lower to the same code.
+  if (f->isThunk() == IsReabstractionThunk)
+    fn->setUnnamedAddr(llvm::GlobalValue::UnnamedAddr::Global);
+
   // If `hasCReferences` is true, then the function is either marked with
   // @_silgen_name OR @_cdecl.  If it is the latter, it must have a definition
   // associated with it.  The combination of the two allows us to identify the
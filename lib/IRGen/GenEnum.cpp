@@ -3977,21 +3977,35 @@ namespace {
     emitIndirectCaseTest(IRGenFunction &IGF, SILType T,
                          Address enumAddr,
                          EnumElementDecl *Case) const override {
+      unsigned tagIndex = getTagIndex(Case);
+
       if (TIK >= Fixed) {
+        // If the payload-discriminating tag lives entirely in the extra tag
+        // bits and the case being tested carries a payload, the tag value
+        // alone identifies the case, so we can test the extra tag bits in
+        // place without loading the payload area at all.
+        if (PayloadTagBits.count() == 0 && ExtraTagBitCount > 0 &&
+            tagIndex < ElementsWithPayload.size()) {
+          llvm::Value *extraTag =
+            IGF.Builder.CreateLoad(projectExtraTagBits(IGF, enumAddr));
+          llvm::Value *expectedTag =
+            llvm::ConstantInt::get(ExtraTagTy, tagIndex);
+          return IGF.Builder.CreateICmpEQ(extraTag, expectedTag);
+        }
+
         // Load the fixed-size representation and switch directly.
         Explosion value;
         loadForSwitch(IGF, enumAddr, value);
         return emitValueCaseTest(IGF, value, Case);
       }
-      
+
       // Use the runtime to dynamically switch.
       auto tag = loadDynamicTag(IGF, enumAddr, T);
-      unsigned tagIndex = getTagIndex(Case);
       llvm::Value *expectedTag
         = llvm::ConstantInt::get(IGM.Int32Ty, tagIndex);
       return IGF.Builder.CreateICmpEQ(tag, expectedTag);
     }
-    
+
     llvm::Value *
     emitValueCaseTest(IRGenFunction &IGF, Explosion &value,
                       EnumElementDecl *Case) const override {
@@ -7182,14 +7196,19 @@ llvm::APInt irgen::gatherBits(const llvm::APInt &mask,
   assert(mask.getBitWidth() == value.getBitWidth());
   llvm::APInt result = llvm::APInt(mask.countPopulation(), 0);
   unsigned j = 0;
-  for (unsigned i = 0; i < mask.getBitWidth(); ++i) {
-    if (!mask[i]) {
-      continue;
-    }
-    if (value[i]) {
-      result.setBit(j);
+  // Visit only the set bits of each mask word, skipping clear words (the
+  // common case for sparse spare-bit masks of large types) outright.
+  for (unsigned w = 0, e = mask.getNumWords(); w != e; ++w) {
+    uint64_t maskWord = mask.getRawData()[w];
+    uint64_t valueWord = value.getRawData()[w];
+    while (maskWord) {
+      unsigned i = llvm::countTrailingZeros(maskWord);
+      if (valueWord & (uint64_t(1) << i)) {
+        result.setBit(j);
+      }
+      ++j;
+      maskWord &= maskWord - 1;
     }
-    ++j;
   }
   return result;
 }
@@ -7198,14 +7217,16 @@ llvm::APInt irgen::gatherBits(const llvm::APInt &mask,
 /// move them to the bit positions indicated by the mask.
 llvm::APInt irgen::scatterBits(const llvm::APInt &mask, unsigned value) {
   llvm::APInt result(mask.getBitWidth(), 0);
-  for (unsigned i = 0; i < mask.getBitWidth() && value != 0; ++i) {
-    if (!mask[i]) {
-      continue;
-    }
-    if (value & 1) {
-      result.setBit(i);
+  for (unsigned w = 0, e = mask.getNumWords(); w != e && value != 0; ++w) {
+    uint64_t maskWord = mask.getRawData()[w];
+    while (maskWord && value != 0) {
+      unsigned i = llvm::countTrailingZeros(maskWord);
+      if (value & 1) {
+        result.setBit(w * llvm::APInt::APINT_BITS_PER_WORD + i);
+      }
+      value >>= 1;
+      maskWord &= maskWord - 1;
     }
-    value >>= 1;
   }
   return result;
 }
@@ -1370,6 +1370,11 @@ static void performParallelIRGeneration(IRGenDescriptor desc) {
 
   llvm::sys::Mutex DiagMutex;
 
+  // Schedule the most expensive modules first, so one enormous output file
+  // fetched late cannot serialize the whole backend phase behind a single
+  // thread while the others sit idle.
+  irgen.sortQueueByEstimatedCost();
+
   // Start all the threads and do the LLVM compilation.
 
   LLVMCodeGenThreads codeGenThreads(&irgen, &DiagMutex, Opts.NumThreads - 1);
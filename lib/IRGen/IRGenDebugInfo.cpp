@@ -109,6 +109,19 @@ class IRGenDebugInfoImpl : public IRGenDebugInfo {
   llvm::DenseMap<const SILDebugScope *, llvm::TrackingMDNodeRef> ScopeCache;
   llvm::DenseMap<const SILDebugScope *, llvm::TrackingMDNodeRef> InlinedAtCache;
   llvm::DenseMap<const void *, SILLocation::DebugLoc> DebugLocCache;
+  /// The scope-dependent part of a debug location. It combines the scope, its
+  /// inlined-at chain and whether locations in the scope are hidden from the
+  /// debugger, so that setCurrentLoc() performs a single table lookup per
+  /// instruction instead of re-deriving all three, which includes a walk up
+  /// the scope chain.
+  struct ResolvedScope {
+    llvm::TrackingMDNodeRef Scope;
+    llvm::TrackingMDNodeRef InlinedAt;
+    /// The scope is in a thunk or a transparent function, whose locations
+    /// are hidden from the debugger.
+    bool HasCompilerGeneratedLoc;
+  };
+  llvm::DenseMap<const SILDebugScope *, ResolvedScope> ResolvedScopeCache;
   llvm::DenseMap<TypeBase *, llvm::TrackingMDNodeRef> DITypeCache;
   llvm::DenseMap<const void *, llvm::TrackingMDNodeRef> DIModuleCache;
   llvm::StringMap<llvm::TrackingMDNodeRef> DIFileCache;
@@ -378,6 +391,17 @@ private:
     return InlinedAt;
   }
 
+  /// Plain-pointer view of a ResolvedScope cache entry.
+  struct ResolvedLoc {
+    llvm::DIScope *Scope;
+    llvm::MDNode *InlinedAt;
+    bool HasCompilerGeneratedLoc;
+  };
+
+  /// Resolve the scope-dependent part of a debug location and cache the
+  /// result.
+  ResolvedLoc resolveScope(const SILDebugScope *DS);
+
 #ifndef NDEBUG
   /// Perform a couple of sanity checks on scopes.
   static bool parentScopesAreSane(const SILDebugScope *DS) {
@@ -1703,6 +1727,9 @@ private:
       UID = llvm::MDString::get(IGM.getLLVMContext(), MangledName);
       if (llvm::Metadata *CachedTy = DIRefMap.lookup(UID)) {
         auto DITy = cast<llvm::DIType>(CachedTy);
+        // Also record the result under this sugared type pointer, so the
+        // next request for it doesn't have to mangle the name again.
+        DITypeCache.insert({DbgTy.getType(), llvm::TrackingMDNodeRef(DITy)});
         return DITy;
       }
     }
@@ -1940,11 +1967,36 @@ bool IRGenDebugInfoImpl::lineEntryIsSane(SILLocation::DebugLoc DL,
 }
 #endif
 
+IRGenDebugInfoImpl::ResolvedLoc
+IRGenDebugInfoImpl::resolveScope(const SILDebugScope *DS) {
+  auto Cached = ResolvedScopeCache.find(DS);
+  if (Cached != ResolvedScopeCache.end()) {
+    auto &RS = Cached->second;
+    return {cast_or_null<llvm::DIScope>((llvm::MDNode *)RS.Scope),
+            (llvm::MDNode *)RS.InlinedAt, RS.HasCompilerGeneratedLoc};
+  }
+
+  llvm::DIScope *Scope = getOrCreateScope(DS);
+  llvm::MDNode *InlinedAt = nullptr;
+  bool HasCompilerGeneratedLoc = false;
+  if (Scope) {
+    InlinedAt = createInlinedAt(DS);
+    SILFunction *Fn = DS->getInlinedFunction();
+    HasCompilerGeneratedLoc = Fn && (Fn->isThunk() || Fn->isTransparent());
+  }
+  ResolvedScopeCache.insert(
+      {DS, {llvm::TrackingMDNodeRef(Scope), llvm::TrackingMDNodeRef(InlinedAt),
+            HasCompilerGeneratedLoc}});
+  return {Scope, InlinedAt, HasCompilerGeneratedLoc};
+}
+
 void IRGenDebugInfoImpl::setCurrentLoc(IRBuilder &Builder,
                                        const SILDebugScope *DS,
                                        SILLocation Loc) {
   assert(DS && "empty scope");
-  auto *Scope = getOrCreateScope(DS);
+  // A single table lookup for everything which only depends on the scope.
+  ResolvedLoc RL = resolveScope(DS);
+  auto *Scope = RL.Scope;
   if (!Scope)
     return;
 
@@ -1952,8 +2004,7 @@ void IRGenDebugInfoImpl::setCurrentLoc(IRBuilder &Builder,
   //       avoid those line locations near user code to reduce the number
   //       of breaks in the linetables.
   SILLocation::DebugLoc L;
-  SILFunction *Fn = DS->getInlinedFunction();
-  if (Fn && (Fn->isThunk() || Fn->isTransparent())) {
+  if (RL.HasCompilerGeneratedLoc) {
     L = SILLocation::getCompilerGeneratedDebugLoc();
   } else if (DS == LastScope && Loc.isAutoGenerated()) {
     // Reuse the last source location if we are still in the same
@@ -1983,7 +2034,6 @@ void IRGenDebugInfoImpl::setCurrentLoc(IRBuilder &Builder,
     // We changed files in the middle of a scope. This happens, for
     // example, when constructors are inlined. Create a new scope to
     // reflect this.
-    auto File = getOrCreateFile(L.Filename);
     Scope = DBuilder.createLexicalBlockFile(Scope, File);
   }
 
@@ -1993,7 +2043,7 @@ void IRGenDebugInfoImpl::setCurrentLoc(IRBuilder &Builder,
   LastDebugLoc = L;
   LastScope = DS;
 
-  auto *InlinedAt = createInlinedAt(DS);
+  auto *InlinedAt = RL.InlinedAt;
   assert(((!InlinedAt) || (InlinedAt && Scope)) && "inlined w/o scope");
   assert(parentScopesAreSane(DS) && "parent scope sanity check failed");
   auto DL = llvm::DebugLoc::get(L.Line, L.Column, Scope, InlinedAt);
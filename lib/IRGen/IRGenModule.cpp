@@ -1608,18 +1608,24 @@ void IRGenModule::error(SourceLoc loc, const Twine &message) {
 bool IRGenModule::useDllStorage() { return ::useDllStorage(Triple); }
 
 bool IRGenModule::shouldPrespecializeGenericMetadata() {
-  auto canPrespecializeTarget =
-      (Triple.isOSDarwin() || Triple.isTvOS() || Triple.isOSLinux());
-  if (canPrespecializeTarget && isStandardLibrary()) {
-    return true;
-  }
-  auto &context = getSwiftModule()->getASTContext();
-  auto deploymentAvailability =
-      AvailabilityContext::forDeploymentTarget(context);
-  return IRGen.Opts.PrespecializeGenericMetadata &&
-         deploymentAvailability.isContainedIn(
-             context.getPrespecializedGenericMetadataAvailability()) &&
-         canPrespecializeTarget;
+  if (CanPrespecializeGenericMetadata)
+    return *CanPrespecializeGenericMetadata;
+  auto compute = [&]() -> bool {
+    auto canPrespecializeTarget =
+        (Triple.isOSDarwin() || Triple.isTvOS() || Triple.isOSLinux());
+    if (canPrespecializeTarget && isStandardLibrary()) {
+      return true;
+    }
+    auto &context = getSwiftModule()->getASTContext();
+    auto deploymentAvailability =
+        AvailabilityContext::forDeploymentTarget(context);
+    return IRGen.Opts.PrespecializeGenericMetadata &&
+           deploymentAvailability.isContainedIn(
+               context.getPrespecializedGenericMetadataAvailability()) &&
+           canPrespecializeTarget;
+  };
+  CanPrespecializeGenericMetadata = compute();
+  return *CanPrespecializeGenericMetadata;
 }
 
 void IRGenerator::addGenModule(SourceFile *SF, IRGenModule *IGM) {
@@ -1631,6 +1637,27 @@ void IRGenerator::addGenModule(SourceFile *SF, IRGenModule *IGM) {
   Queue.push_back(IGM);
 }
 
+void IRGenerator::sortQueueByEstimatedCost() {
+  assert(QueueIndex == 0 && "sorting the queue after codegen started");
+
+  // Estimate the codegen cost of each module by its number of LLVM
+  // instructions. This is a rough proxy, but it only has to separate the
+  // enormous modules from the cheap ones.
+  llvm::DenseMap<IRGenModule *, uint64_t> costs;
+  for (IRGenModule *IGM : Queue) {
+    uint64_t cost = 0;
+    for (const llvm::Function &F : *IGM->getModule())
+      for (const llvm::BasicBlock &BB : F)
+        cost += BB.size();
+    costs[IGM] = cost;
+  }
+
+  std::stable_sort(Queue.begin(), Queue.end(),
+                   [&](IRGenModule *lhs, IRGenModule *rhs) {
+                     return costs[lhs] > costs[rhs];
+                   });
+}
+
 IRGenModule *IRGenerator::getGenModule(DeclContext *ctxt) {
   if (GenModules.size() == 1 || !ctxt) {
     return getPrimaryIGM();
@@ -1659,6 +1686,45 @@ IRGenModule *IRGenerator::getGenModule(SILFunction *f) {
   return getPrimaryIGM();
 }
 
+IRGenModule *IRGenerator::pickLeastLoadedIGM(SILFunction *f) {
+  if (GenModules.size() == 1)
+    return getPrimaryIGM();
+
+  auto estimateCost = [](const SILFunction *fn) -> uint64_t {
+    uint64_t cost = 0;
+    for (const SILBasicBlock &BB : *fn)
+      cost += std::distance(BB.begin(), BB.end());
+    // Even a trivial function costs something to emit.
+    return cost + 1;
+  };
+
+  // Seed the cost map with the functions that are pinned to their source
+  // file's IGM, so that an enormous single file starts out "full" and lazy
+  // definitions flow to the cheaper output files.
+  if (!SeededIGMCosts) {
+    SeededIGMCosts = true;
+    for (SILFunction &fn : SIL.getFunctions()) {
+      if (auto *dc = fn.getDeclContext())
+        if (dc->getParentSourceFile())
+          EstimatedIGMCost[getGenModule(dc)] += estimateCost(&fn);
+    }
+  }
+
+  IRGenModule *best = nullptr;
+  uint64_t bestCost = 0;
+  for (IRGenModule *IGM : Queue) {
+    uint64_t cost = EstimatedIGMCost[IGM];
+    if (!best || cost < bestCost) {
+      best = IGM;
+      bestCost = cost;
+    }
+  }
+  assert(best && "no IGM added to the queue yet");
+
+  EstimatedIGMCost[best] += estimateCost(f);
+  return best;
+}
+
 uint32_t swift::irgen::getSwiftABIVersion() {
   return IRGenModule::swiftVersion;
 }
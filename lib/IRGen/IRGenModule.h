@@ -225,6 +225,12 @@ private:
   // chances of function merging.
   llvm::DenseMap<const SILFunction *, IRGenModule *> IGMForSpecializations;
 
+  // Estimated emission cost (in SIL instructions) assigned to each IGM, used
+  // to pick a home for shared functions that are not tied to a source file.
+  // Seeded from the per-file function bodies on first use.
+  llvm::DenseMap<const IRGenModule *, uint64_t> EstimatedIGMCost;
+  bool SeededIGMCosts = false;
+
   // The IGM of the first source file.
   IRGenModule *PrimaryIGM = nullptr;
 
@@ -365,6 +371,13 @@ public:
   /// first time.
   IRGenModule *getGenModule(SILFunction *f);
 
+  /// Pick the IGM with the smallest estimated emission cost to host \p f,
+  /// and account for \p f's cost there. Used for shared functions which are
+  /// not tied to a source file, so they spread across the output files
+  /// instead of piling into whichever module referenced them first. The
+  /// choice depends only on reference order, so output stays deterministic.
+  IRGenModule *pickLeastLoadedIGM(SILFunction *f);
+
   /// Returns the primary IRGenModule. This is the first added IRGenModule.
   /// It is used for everything which cannot be correlated to a specific source
   /// file. And of course, in single-threaded compilation there is only the
@@ -506,6 +519,12 @@ public:
     return it->second;
   }
   
+  /// Order the queue of IRGenModules so that the modules with the highest
+  /// estimated codegen cost are fetched first. Called once before the
+  /// codegen threads start; longest-processing-time-first scheduling keeps
+  /// a single large module from becoming the tail of the backend phase.
+  void sortQueueByEstimatedCost();
+
   /// In multi-threaded compilation fetch the next IRGenModule from the queue.
   IRGenModule *fetchFromQueue() {
     int idx = QueueIndex++;
@@ -847,7 +866,14 @@ public:
   bool useDllStorage();
 
   bool shouldPrespecializeGenericMetadata();
-  
+
+private:
+  /// Lazily computed result of \c shouldPrespecializeGenericMetadata; the
+  /// predicate is consulted for every specialized metadata candidate.
+  Optional<bool> CanPrespecializeGenericMetadata;
+
+public:
+
   Size getAtomicBoolSize() const { return AtomicBoolSize; }
   Alignment getAtomicBoolAlignment() const { return AtomicBoolAlign; }
 
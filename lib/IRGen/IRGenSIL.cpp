@@ -37,6 +37,7 @@
 #include "swift/SIL/SILModule.h"
 #include "swift/SIL/SILType.h"
 #include "swift/SIL/SILVisitor.h"
+#include "swift/SIL/SILWitnessTable.h"
 #include "swift/SIL/TerminatorUtils.h"
 #include "clang/AST/ASTContext.h"
 #include "clang/AST/DeclCXX.h"
@@ -1963,6 +1964,11 @@ void IRGenSILFunction::emitSILFunction() {
   if (IGM.DebugInfo)
     IGM.DebugInfo->emitFunction(*CurSILFn, CurFn);
 
+  // Publish the profile-based entry count to LLVM, so that the backend can
+  // use it for hot/cold function and block placement.
+  if (CurSILFn->getEntryCount())
+    CurFn->setEntryCount(CurSILFn->getEntryCount().getValue());
+
   // Map the entry bb.
   LoweredBBs[&*CurSILFn->begin()] = LoweredBB(&CurFn->back(), {});
   // Create LLVM basic blocks for the other bbs.
@@ -6116,6 +6122,49 @@ IRGenSILFunction::visitProjectExistentialBoxInst(ProjectExistentialBoxInst *i) {
   }
 }
 
+/// If the given conformance is concrete and its witness table is available in
+/// the SIL module, find the witness for \p member so we can reference it
+/// directly instead of loading it from the table at runtime. Returns null if
+/// dispatch has to go through the witness table.
+static SILFunction *getConstantWitnessFunction(IRGenModule &IGM,
+                                               ProtocolConformanceRef conformance,
+                                               SILDeclRef member) {
+  if (!conformance.isConcrete())
+    return nullptr;
+
+  // Don't deserialize a witness table just for this; IRGen should not be
+  // adding new SIL to the module at this point.
+  auto *wt = IGM.getSILModule().lookUpWitnessTable(conformance.getConcrete(),
+                                                   /*deserializeLazily=*/false);
+  if (!wt)
+    return nullptr;
+
+  SILFunction *witness = nullptr;
+  for (auto &entry : wt->getEntries()) {
+    if (entry.getKind() != SILWitnessTable::Method)
+      continue;
+    if (entry.getMethodWitness().Requirement == member) {
+      witness = entry.getMethodWitness().Witness;
+      break;
+    }
+  }
+  if (!witness)
+    return nullptr;
+
+  // We can only form a direct reference if the witness is either defined in
+  // this module or visible outside of the module that defines it.
+  if (!witness->isDefinition() && !hasPublicVisibility(witness->getLinkage()))
+    return nullptr;
+
+  // Async witnesses are dispatched through their async function pointer, and
+  // dynamically replaceable witnesses must stay behind the table so the
+  // replacement is honored.
+  if (witness->isAsync() || witness->isDynamicallyReplaceable())
+    return nullptr;
+
+  return witness;
+}
+
 void IRGenSILFunction::visitWitnessMethodInst(swift::WitnessMethodInst *i) {
   CanType baseTy = i->getLookupType();
   ProtocolConformanceRef conformance = i->getConformance();
@@ -6135,6 +6184,21 @@ void IRGenSILFunction::visitWitnessMethodInst(swift::WitnessMethodInst *i) {
     return;
   }
 
+  // The SIL optimizer rewrites applies of statically known witness methods
+  // into direct applies, but it cannot reach every site (and does not run at
+  // all at -Onone). If the witness is visible in the SIL witness table,
+  // reference it directly rather than loading it from the table at runtime.
+  if (auto *witness = getConstantWitnessFunction(IGM, conformance, member)) {
+    auto fnType = IGM.getSILTypes().getConstantFunctionType(
+        IGM.getMaximalTypeExpansionContext(), member);
+    auto sig = IGM.getSignature(fnType);
+    llvm::Constant *fnPtr = IGM.getAddrOfSILFunction(witness, NotForDefinition);
+    fnPtr = llvm::ConstantExpr::getBitCast(fnPtr,
+                                           sig.getType()->getPointerTo());
+    setLoweredFunctionPointer(i, FunctionPointer::forDirect(fnType, fnPtr, sig));
+    return;
+  }
+
   // It would be nice if this weren't discarded.
   llvm::Value *baseMetadataCache = nullptr;
 
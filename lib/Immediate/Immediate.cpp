@@ -29,13 +29,19 @@
 #include "swift/IRGen/IRGenPublic.h"
 #include "swift/SILOptimizer/PassManager/Passes.h"
 #include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/StringExtras.h"
 #include "llvm/Config/config.h"
+#include "llvm/ExecutionEngine/ObjectCache.h"
+#include "llvm/ExecutionEngine/Orc/CompileUtils.h"
 #include "llvm/ExecutionEngine/Orc/DebugUtils.h"
 #include "llvm/ExecutionEngine/Orc/JITTargetMachineBuilder.h"
 #include "llvm/ExecutionEngine/Orc/LLJIT.h"
 #include "llvm/IR/LLVMContext.h"
 #include "llvm/Transforms/IPO.h"
 #include "llvm/Transforms/IPO/PassManagerBuilder.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MD5.h"
+#include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Path.h"
 
 #define DEBUG_TYPE "swift-immediate"
@@ -76,6 +82,73 @@ static void *loadRuntimeLib(StringRef sharedLibName,
   return nullptr;
 }
 
+namespace {
+/// An on-disk cache of JITed code, keyed by a hash of the contents of each
+/// compiled module and of the target configuration, so that repeated
+/// immediate-mode runs of an unchanged script reuse the code compiled by
+/// earlier runs. With lazy compilation, each function is compiled in its own
+/// little module, so a cached script warms up one small object at a time.
+class ImmediateObjectCache : public llvm::ObjectCache {
+  llvm::SmallString<128> CacheDir;
+  std::string TargetKey;
+
+public:
+  explicit ImmediateObjectCache(std::string targetKey)
+      : TargetKey(std::move(targetKey)) {
+    if (llvm::sys::path::cache_directory(CacheDir))
+      llvm::sys::path::append(CacheDir, "org.swift.immediate");
+    else
+      CacheDir.clear();
+  }
+
+  /// Whether a cache directory could be determined for this process.
+  bool isValid() const { return !CacheDir.empty(); }
+
+  void notifyObjectCompiled(const llvm::Module *M,
+                            llvm::MemoryBufferRef Obj) override {
+    if (llvm::sys::fs::create_directories(CacheDir))
+      return;
+    llvm::SmallString<160> Path(CacheDir);
+    llvm::sys::path::append(Path, getCacheKey(M));
+    std::error_code Error;
+    llvm::raw_fd_ostream OS(Path, Error, llvm::sys::fs::OF_None);
+    if (Error)
+      return;
+    OS << Obj.getBuffer();
+  }
+
+  std::unique_ptr<llvm::MemoryBuffer>
+  getObject(const llvm::Module *M) override {
+    llvm::SmallString<160> Path(CacheDir);
+    llvm::sys::path::append(Path, getCacheKey(M));
+    auto Buffer = llvm::MemoryBuffer::getFile(Path);
+    if (!Buffer)
+      return nullptr;
+    return std::move(*Buffer);
+  }
+
+private:
+  /// Key entries on the contents of the module rather than on the name of the
+  /// script, so that any edit invalidates the stale object and identical code
+  /// compiled from different paths shares an entry.
+  std::string getCacheKey(const llvm::Module *M) const {
+    llvm::SmallString<0> IRText;
+    {
+      llvm::raw_svector_ostream OS(IRText);
+      M->print(OS, /*AssemblyAnnotationWriter=*/nullptr);
+    }
+    llvm::MD5 Hash;
+    Hash.update(TargetKey);
+    Hash.update(IRText);
+    llvm::MD5::MD5Result Result;
+    Hash.final(Result);
+    std::string Key = Result.digest().str().str();
+    Key += ".o";
+    return Key;
+  }
+};
+} // end anonymous namespace
+
 static void DumpLLVMIR(const llvm::Module &M) {
   std::string path = (M.getName() + ".ll").str();
   for (size_t count = 0; llvm::sys::fs::exists(path); )
@@ -281,18 +354,61 @@ int swift::RunImmediately(CompilerInstance &CI,
   std::tie(TargetOpt, CPU, Features, Triple)
     = getIRTargetOptions(IRGenOpts, swiftModule->getASTContext());
 
+  // If requested, cache compiled code on disk so that later runs of the same
+  // script skip code generation for modules compiled by earlier runs.
+  std::unique_ptr<ImmediateObjectCache> ObjectCache;
+  if (IRGenOpts.UseJITObjectCache) {
+    std::string TargetKey = Triple + CPU + llvm::join(Features, ",");
+    auto Cache = std::make_unique<ImmediateObjectCache>(std::move(TargetKey));
+    if (Cache->isValid())
+      ObjectCache = std::move(Cache);
+  }
+
+  auto TMBuilder = llvm::orc::JITTargetMachineBuilder(llvm::Triple(Triple))
+                       .setRelocationModel(llvm::Reloc::PIC_)
+                       .setOptions(std::move(TargetOpt))
+                       .setCPU(std::move(CPU))
+                       .addFeatures(Features)
+                       .setCodeGenOptLevel(llvm::CodeGenOpt::Default);
+
+  auto CreateCompileFunction =
+      [&ObjectCache](llvm::orc::JITTargetMachineBuilder JTMB)
+      -> llvm::Expected<
+          std::unique_ptr<llvm::orc::IRCompileLayer::IRCompiler>> {
+    auto TM = JTMB.createTargetMachine();
+    if (!TM)
+      return TM.takeError();
+    return std::make_unique<llvm::orc::TMOwningSimpleCompiler>(
+        std::move(*TM), ObjectCache.get());
+  };
+
   std::unique_ptr<llvm::orc::LLJIT> JIT;
+  llvm::orc::LLLazyJIT *LazyJIT = nullptr;
 
+  // Prefer a lazy JIT: each function is extracted into its own module and
+  // only compiled, via a call-through stub, the first time it is actually
+  // executed, so scripts only pay for the code they reach. Lazy call-through
+  // stubs are not implemented for every target, so fall back to compiling the
+  // whole module eagerly if the lazy JIT cannot be built.
   {
+    llvm::orc::LLLazyJITBuilder Builder;
+    Builder.setJITTargetMachineBuilder(TMBuilder);
+    Builder.setCompileFunctionCreator(CreateCompileFunction);
+    if (auto JITOrErr = Builder.create()) {
+      JIT = std::move(*JITOrErr);
+      LazyJIT = static_cast<llvm::orc::LLLazyJIT *>(JIT.get());
+    } else {
+      LLVM_DEBUG(llvm::dbgs() << "Cannot build a lazy JIT for " << Triple
+                              << "; compiling eagerly\n");
+      llvm::consumeError(JITOrErr.takeError());
+    }
+  }
+
+  if (!JIT) {
     auto JITOrErr =
       llvm::orc::LLJITBuilder()
-        .setJITTargetMachineBuilder(
-            llvm::orc::JITTargetMachineBuilder(llvm::Triple(Triple))
-              .setRelocationModel(llvm::Reloc::PIC_)
-              .setOptions(std::move(TargetOpt))
-              .setCPU(std::move(CPU))
-              .addFeatures(Features)
-              .setCodeGenOptLevel(llvm::CodeGenOpt::Default))
+        .setJITTargetMachineBuilder(std::move(TMBuilder))
+        .setCompileFunctionCreator(CreateCompileFunction)
         .create();
 
     if (!JITOrErr) {
@@ -330,7 +446,10 @@ int swift::RunImmediately(CompilerInstance &CI,
              Module->dump());
 
   {
-    if (auto Err = JIT->addIRModule(std::move(GenModule).intoThreadSafeContext())) {
+    auto TSM = std::move(GenModule).intoThreadSafeContext();
+    auto Err = LazyJIT ? LazyJIT->addLazyIRModule(std::move(TSM))
+                       : JIT->addIRModule(std::move(TSM));
+    if (Err) {
       llvm::logAllUnhandledErrors(std::move(Err), llvm::errs(), "");
       return -1;
     }
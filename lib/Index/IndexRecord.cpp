@@ -30,6 +30,7 @@
 #include "clang/Index/IndexRecordWriter.h"
 #include "clang/Index/IndexUnitWriter.h"
 #include "clang/Lex/Preprocessor.h"
+#include "llvm/ADT/StringSet.h"
 #include "llvm/Support/Path.h"
 
 using namespace swift;
@@ -267,8 +268,8 @@ StringRef StdlibGroupsIndexRecordingConsumer::findGroupForSymbol(const IndexSymb
   llvm_unreachable("did not find group name for reference");
 }
 
-static bool writeRecord(SymbolTracker &record, std::string Filename,
-                        std::string indexStorePath, DiagnosticEngine *diags,
+static bool writeRecord(SymbolTracker &record, std::string indexStorePath,
+                        DiagnosticEngine *diags,
                         std::string &outRecordFile) {
   if (record.getOccurrences().empty()) {
     outRecordFile = std::string();
@@ -277,8 +278,13 @@ static bool writeRecord(SymbolTracker &record, std::string Filename,
 
   IndexRecordWriter recordWriter(indexStorePath);
   std::string error;
+  // Name the record file purely by the hash of its contents instead of by the
+  // file it was produced from. Generated sources frequently yield identical
+  // occurrence sets; with a content-addressed name the writer finds the
+  // existing record and all units reference a single shared file rather than
+  // each writing its own copy.
   auto result = recordWriter.beginRecord(
-      Filename, record.hashRecord(), error, &outRecordFile);
+      "record", record.hashRecord(), error, &outRecordFile);
   switch (result) {
   case IndexRecordWriter::Result::Failure:
     diags->diagnose(SourceLoc(), diag::error_write_index_record, error);
@@ -321,13 +327,12 @@ static bool writeRecord(SymbolTracker &record, std::string Filename,
 }
 
 static std::unique_ptr<IndexRecordingConsumer>
-makeRecordingConsumer(std::string Filename, std::string indexStorePath,
+makeRecordingConsumer(std::string indexStorePath,
                       DiagnosticEngine *diags,
                       std::string *outRecordFile,
                       bool *outFailed) {
   return std::make_unique<IndexRecordingConsumer>([=](SymbolTracker &record) {
-    *outFailed = writeRecord(record, Filename, indexStorePath, diags,
-                             *outRecordFile);
+    *outFailed = writeRecord(record, indexStorePath, diags, *outRecordFile);
   });
 }
 
@@ -337,9 +342,8 @@ recordSourceFile(SourceFile *SF, StringRef indexStorePath,
                  llvm::function_ref<void(StringRef, StringRef)> callback) {
   std::string recordFile;
   bool failed = false;
-  auto consumer =
-      makeRecordingConsumer(SF->getFilename().str(), indexStorePath.str(),
-                            &diags, &recordFile, &failed);
+  auto consumer = makeRecordingConsumer(indexStorePath.str(), &diags,
+                                        &recordFile, &failed);
   indexSourceFile(SF, *consumer);
 
   if (!failed && !recordFile.empty())
@@ -381,6 +385,7 @@ emitDataForSwiftSerializedModule(ModuleDecl *module,
                                  const clang::CompilerInstance &clangCI,
                                  DiagnosticEngine &diags,
                                  IndexUnitWriter &parentUnitWriter,
+                                 llvm::StringSet<> &processedModules,
                                  SourceFile *initialFile);
 
 static void addModuleDependencies(ArrayRef<ImportedModule> imports,
@@ -392,6 +397,7 @@ static void addModuleDependencies(ArrayRef<ImportedModule> imports,
                                   DiagnosticEngine &diags,
                                   IndexUnitWriter &unitWriter,
                                   StringScratchSpace &moduleNameScratch,
+                                  llvm::StringSet<> &processedModules,
                                   SourceFile *initialFile = nullptr) {
   auto &fileMgr = clangCI.getFileManager();
 
@@ -423,8 +429,11 @@ static void addModuleDependencies(ArrayRef<ImportedModule> imports,
                 moduleName = clangMod->getTopLevelModuleName();
                 // FIXME: clang's -Rremarks do not seem to go through Swift's
                 // diagnostic emitter.
-                clang::index::emitIndexDataForModuleFile(clangMod,
-                                                         clangCI, unitWriter);
+                // Many units reference the same module file; only hand it to
+                // the clang emitter once per invocation.
+                if (processedModules.insert(LFU->getFilename()).second)
+                  clang::index::emitIndexDataForModuleFile(clangMod,
+                                                           clangCI, unitWriter);
               }
             }
           } else {
@@ -438,7 +447,8 @@ static void addModuleDependencies(ArrayRef<ImportedModule> imports,
               emitDataForSwiftSerializedModule(mod, indexStorePath,
                                                indexSystemModules, skipStdlib,
                                                targetTriple, clangCI, diags,
-                                               unitWriter, initialFile);
+                                               unitWriter, processedModules,
+                                               initialFile);
               withoutUnitName = false;
             }
 
@@ -469,10 +479,17 @@ emitDataForSwiftSerializedModule(ModuleDecl *module,
                                  const clang::CompilerInstance &clangCI,
                                  DiagnosticEngine &diags,
                                  IndexUnitWriter &parentUnitWriter,
+                                 llvm::StringSet<> &processedModules,
                                  SourceFile *initialFile) {
   StringRef filename = module->getModuleFilename();
   std::string moduleName = module->getNameStr().str();
 
+  // An invocation indexing many source files reaches the same serialized
+  // modules through every one of them; the stat-based up-to-date check below
+  // and the module walk only need to happen once per invocation.
+  if (!processedModules.insert(filename).second)
+    return false;
+
   // If this is a cross-import overlay, make sure we use the name of the
   // underlying module instead.
   if (ModuleDecl *declaring = module->getDeclaringModuleIfCrossImportOverlay())
@@ -498,8 +515,8 @@ emitDataForSwiftSerializedModule(ModuleDecl *module,
   if (!module->isStdlibModule()) {
     std::string recordFile;
     bool failed = false;
-    auto consumer = makeRecordingConsumer(filename.str(), indexStorePath.str(),
-                                          &diags, &recordFile, &failed);
+    auto consumer = makeRecordingConsumer(indexStorePath.str(), &diags,
+                                          &recordFile, &failed);
     indexModule(module, *consumer);
 
     if (failed)
@@ -521,29 +538,14 @@ emitDataForSwiftSerializedModule(ModuleDecl *module,
           buf += ch;
       }
     };
-    auto appendGroupNameForFilename = [](StringRef groupName, SmallString<256> &buf) {
-      if (groupName.empty())
-        return;
-      buf += '_';
-      for (char ch : groupName) {
-        if (ch == '/' || ch ==' ')
-          buf += '_';
-        else
-          buf += ch;
-      }
-    };
-
     bool failed = false;
     StdlibGroupsIndexRecordingConsumer groupIndexConsumer([&](StringRef groupName, SymbolTracker &tracker) -> bool {
       SmallString<128> moduleName;
       makeSubmoduleNameFromGroupName(groupName, moduleName);
-      SmallString<256> fileNameWithGroup = filename;
-      appendGroupNameForFilename(groupName, fileNameWithGroup);
 
       std::string outRecordFile;
-      failed =
-          failed || writeRecord(tracker, std::string(fileNameWithGroup.str()),
-                                indexStorePath.str(), &diags, outRecordFile);
+      failed = failed || writeRecord(tracker, indexStorePath.str(), &diags,
+                                     outRecordFile);
       if (failed)
         return false;
       records.emplace_back(outRecordFile, moduleName.str().str());
@@ -586,7 +588,7 @@ emitDataForSwiftSerializedModule(ModuleDecl *module,
   StringScratchSpace moduleNameScratch;
   addModuleDependencies(imports, indexStorePath, indexSystemModules, skipStdlib,
                         targetTriple, clangCI, diags, unitWriter,
-                        moduleNameScratch, initialFile);
+                        moduleNameScratch, processedModules, initialFile);
 
   if (unitWriter.write(error)) {
     diags.diagnose(SourceLoc(), diag::error_write_index_unit, error);
@@ -603,7 +605,8 @@ recordSourceFileUnit(SourceFile *primarySourceFile, StringRef indexUnitToken,
                      StringRef targetTriple,
                      ArrayRef<const clang::FileEntry *> fileDependencies,
                      const clang::CompilerInstance &clangCI,
-                     DiagnosticEngine &diags) {
+                     DiagnosticEngine &diags,
+                     llvm::StringSet<> &processedModules) {
   auto &fileMgr = clangCI.getFileManager();
   auto *module = primarySourceFile->getParentModule();
   bool isSystem = module->isSystemModule();
@@ -627,7 +630,7 @@ recordSourceFileUnit(SourceFile *primarySourceFile, StringRef indexUnitToken,
   StringScratchSpace moduleNameScratch;
   addModuleDependencies(imports, indexStorePath, indexSystemModules, skipStdlib,
                         targetTriple, clangCI, diags, unitWriter,
-                        moduleNameScratch, primarySourceFile);
+                        moduleNameScratch, processedModules, primarySourceFile);
 
   // File dependencies.
   for (auto *F : fileDependencies)
@@ -705,11 +708,12 @@ bool index::indexAndRecord(SourceFile *primarySourceFile,
   collectFileDependencies(fileDependencies, dependencyTracker, module, fileMgr);
 #endif
 
+  llvm::StringSet<> processedModules;
   return recordSourceFileUnit(primarySourceFile, indexUnitToken,
                               indexStorePath, indexSystemModules, skipStdlib,
                               isDebugCompilation, targetTriple,
                               fileDependencies.getArrayRef(),
-                              clangCI, diags);
+                              clangCI, diags, processedModules);
 }
 
 bool index::indexAndRecord(ModuleDecl *module,
@@ -744,7 +748,9 @@ bool index::indexAndRecord(ModuleDecl *module,
   collectFileDependencies(fileDependencies, dependencyTracker, module, fileMgr);
 #endif
 
-  // Write a unit for each source file.
+  // Write a unit for each source file. The processed-modules set is shared
+  // across the files so that common dependencies are only emitted once.
+  llvm::StringSet<> processedModules;
   unsigned unitIndex = 0;
   for (auto *F : module->getFiles()) {
     if (auto *SF = dyn_cast<SourceFile>(F)) {
@@ -756,7 +762,7 @@ bool index::indexAndRecord(ModuleDecl *module,
                                indexStorePath, indexSystemModules, skipStdlib,
                                isDebugCompilation, targetTriple,
                                fileDependencies.getArrayRef(),
-                               clangCI, diags))
+                               clangCI, diags, processedModules))
         return true;
       unitIndex += 1;
     }
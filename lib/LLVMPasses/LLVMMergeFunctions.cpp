@@ -38,6 +38,7 @@
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/SmallSet.h"
 #include "llvm/ADT/Statistic.h"
+#include "llvm/ADT/StringExtras.h"
 #include "llvm/ADT/Hashing.h"
 #include "llvm/ADT/Triple.h"
 #include "llvm/IR/Attributes.h"
@@ -1055,17 +1056,64 @@ void SwiftMergeFunctions::mergeWithParams(const FunctionInfos &FInfos,
   FunctionType *funcType =
                   FunctionType::get(OrigTy->getReturnType(), ParamTypes, false);
 
+  // If the body we reuse is ODR-unique across translation units, identical
+  // merged functions are created independently in every IRGen output partition
+  // which contains the same group of specializations. Give such a merged
+  // function a deterministic name and linkonce_odr linkage, so that the linker
+  // collapses all copies into a single one instead of every partition carrying
+  // its own private copy.
+  // Pointer-signing parameters are excluded, because their discriminators are
+  // derived from the whole equivalence class and not just from the reused
+  // body.
+  bool ShareAcrossModules = FirstF->hasLinkOnceODRLinkage();
+  for (const ParamInfo &PI : Params) {
+    if (PI.needsPointerSigning)
+      ShareAcrossModules = false;
+  }
+
+  SmallString<128> NewName(FirstF->getName());
+  NewName += "Tm";
+  if (ShareAcrossModules) {
+    // The semantics of the merged function is fully determined by the reused
+    // body, which the ODR name already identifies, plus the positions and
+    // types of the parameterized operands. Hash the latter into the name, so
+    // that equivalence classes which group differently in another partition
+    // get a different merged function.
+    DenseMap<const Instruction *, unsigned> InstNumbers;
+    unsigned InstIdx = 0;
+    for (const BasicBlock &BB : *FirstF) {
+      for (const Instruction &I : BB)
+        InstNumbers[&I] = InstIdx++;
+    }
+    std::string Signature;
+    raw_string_ostream SigStream(Signature);
+    for (const ParamInfo &PI : Params) {
+      SigStream << *PI.Values[0]->getType();
+      for (const OpLocation &OL : PI.Uses)
+        SigStream << ' ' << InstNumbers[OL.I] << ':' << OL.OpIndex;
+      SigStream << '\n';
+    }
+    NewName += llvm::utohexstr(clang::getStableStringHash(SigStream.str()));
+  }
+
   // Create the new function.
   // TODO: Use a better name than just adding a suffix. Ideally it would be
   // a name which can be demangled in a meaningful way.
   Function *NewFunction = Function::Create(funcType,
                                            FirstF->getLinkage(),
-                                           FirstF->getName() + "Tm");
+                                           NewName);
   NewFunction->copyAttributesFrom(FirstF);
   // NOTE: this function is not externally available, do ensure that we reset
   // the DLL storage
   NewFunction->setDLLStorageClass(GlobalValue::DefaultStorageClass);
-  NewFunction->setLinkage(GlobalValue::InternalLinkage);
+  if (ShareAcrossModules) {
+    NewFunction->setLinkage(GlobalValue::LinkOnceODRLinkage);
+    NewFunction->setVisibility(GlobalValue::HiddenVisibility);
+    if (FirstF->hasComdat())
+      NewFunction->setComdat(module->getOrInsertComdat(NewFunction->getName()));
+  } else {
+    NewFunction->setLinkage(GlobalValue::InternalLinkage);
+  }
 
   // Insert the new function after the last function in the equivalence class.
   FirstF->getParent()->getFunctionList().insert(
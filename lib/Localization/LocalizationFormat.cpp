@@ -85,14 +85,36 @@ bool SerializedLocalizationWriter::emit(llvm::StringRef filePath) {
   return OS.has_error();
 }
 
+llvm::StringRef
+LocalizationProducer::getMessageOr(swift::DiagID id,
+                                   llvm::StringRef defaultMessage) {
+  if (!initializeIfNeeded())
+    return defaultMessage;
+  auto message = getMessage(id);
+  return message.empty() ? defaultMessage : message;
+}
+
+bool LocalizationProducer::initializeIfNeeded() {
+  if (state == LocalizationProducerState::NotInitialized) {
+    state = initializeImpl() ? LocalizationProducerState::Initialized
+                             : LocalizationProducerState::FailedInitialization;
+  }
+  return state == LocalizationProducerState::Initialized;
+}
+
 SerializedLocalizationProducer::SerializedLocalizationProducer(
     std::unique_ptr<llvm::MemoryBuffer> buffer)
-    : Buffer(std::move(buffer)) {
+    : Buffer(std::move(buffer)) {}
+
+bool SerializedLocalizationProducer::initializeImpl() {
+  if (Buffer.get()->getBufferSize() < sizeof(offset_type))
+    return false;
   auto base =
       reinterpret_cast<const unsigned char *>(Buffer.get()->getBufferStart());
   auto tableOffset = endian::read<offset_type>(base, little);
   SerializedTable.reset(SerializedLocalizationTable::Create(
       base + tableOffset, base + sizeof(offset_type), base));
+  return true;
 }
 
 llvm::StringRef
@@ -103,12 +125,18 @@ SerializedLocalizationProducer::getMessage(swift::DiagID id) const {
   return {(const char *)value.getDataPtr(), value.getDataLen()};
 }
 
-YAMLLocalizationProducer::YAMLLocalizationProducer(llvm::StringRef filePath) {
+YAMLLocalizationProducer::YAMLLocalizationProducer(llvm::StringRef filePath)
+    : filePath(filePath) {}
+
+bool YAMLLocalizationProducer::initializeImpl() {
   auto FileBufOrErr = llvm::MemoryBuffer::getFileOrSTDIN(filePath);
+  if (!FileBufOrErr)
+    return false;
   llvm::MemoryBuffer *document = FileBufOrErr->get();
   diag::LocalizationInput yin(document->getBuffer());
   yin >> diagnostics;
   unknownIDs = std::move(yin.unknownIDs);
+  return true;
 }
 
 llvm::StringRef YAMLLocalizationProducer::getMessage(swift::DiagID id) const {
@@ -116,7 +144,9 @@ llvm::StringRef YAMLLocalizationProducer::getMessage(swift::DiagID id) const {
 }
 
 void YAMLLocalizationProducer::forEachAvailable(
-    llvm::function_ref<void(swift::DiagID, llvm::StringRef)> callback) const {
+    llvm::function_ref<void(swift::DiagID, llvm::StringRef)> callback) {
+  if (!initializeIfNeeded())
+    return;
   for (uint32_t i = 0, n = diagnostics.size(); i != n; ++i) {
     auto translation = diagnostics[i];
     if (!translation.empty())
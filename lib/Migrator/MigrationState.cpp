@@ -10,6 +10,7 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include "swift/Basic/FileSystem.h"
 #include "swift/Basic/SourceManager.h"
 #include "swift/Migrator/MigrationState.h"
 #include "llvm/Support/Path.h"
@@ -32,24 +33,17 @@ std::string MigrationState::getOutputText() const {
   return SrcMgr.getEntireTextForBuffer(OutputBufferID).str();
 }
 
-static bool quickDumpText(StringRef OutFilename, StringRef Text) {
-  std::error_code Error;
-  llvm::raw_fd_ostream FileOS(OutFilename,
-                              Error, llvm::sys::fs::F_Text);
-  if (FileOS.has_error()) {
-    return true;
-  }
-
-  FileOS << Text;
-
-  FileOS.flush();
-
-  return FileOS.has_error();
+static void quickDumpText(StringRef OutFilename, StringRef Text,
+                          AsyncOutputWriter &Writer) {
+  // writeFile captures the bytes before returning, so the text only needs to
+  // live for the duration of this call.
+  Writer.writeFile(OutFilename, [Text](llvm::raw_pwrite_stream &FileOS) {
+    FileOS << Text;
+  });
 }
 
-bool MigrationState::print(size_t StateNumber, StringRef OutDir) const {
-  auto Failed = false;
-
+void MigrationState::print(size_t StateNumber, StringRef OutDir,
+                           AsyncOutputWriter &Writer) const {
   SmallString<256> InputFileStatePath;
   llvm::sys::path::append(InputFileStatePath, OutDir);
 
@@ -62,7 +56,7 @@ bool MigrationState::print(size_t StateNumber, StringRef OutDir) const {
     llvm::sys::path::replace_extension(InputFileStatePath, ".swift");
   }
 
-  Failed |= quickDumpText(InputFileStatePath, getInputText());
+  quickDumpText(InputFileStatePath, getInputText(), Writer);
 
   SmallString<256> OutputFileStatePath;
   llvm::sys::path::append(OutputFileStatePath, OutDir);
@@ -76,7 +70,5 @@ bool MigrationState::print(size_t StateNumber, StringRef OutDir) const {
     llvm::sys::path::replace_extension(OutputFileStatePath, ".swift");
   }
 
-  Failed |= quickDumpText(OutputFileStatePath, getOutputText());
-
-  return Failed;
+  quickDumpText(OutputFileStatePath, getOutputText(), Writer);
 }
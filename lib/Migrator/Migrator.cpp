@@ -10,6 +10,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "Diff.h"
+#include "swift/Basic/FileSystem.h"
 #include "swift/Frontend/Frontend.h"
 #include "swift/Migrator/ASTMigratorPass.h"
 #include "swift/Migrator/EditorAdapter.h"
@@ -87,10 +88,13 @@ bool migrator::updateCodeAndEmitRemapIfNeeded(CompilerInstance *Instance) {
   // TODO: Document replacement map format.
 
 
-  auto EmitRemapFailed = M.emitRemap();
-  auto EmitMigratedFailed = M.emitMigratedFile();
-  auto DumpMigrationStatesFailed = M.dumpStates();
-  return EmitRemapFailed || EmitMigratedFailed || DumpMigrationStatesFailed;
+  // The remap file, the migrated file, and the state dumps are all derived
+  // from the final state history, so compute and write them in parallel.
+  AsyncOutputWriter Writer;
+  M.emitRemap(Writer);
+  M.emitMigratedFile(Writer);
+  M.dumpStates(Writer);
+  return !Writer.waitForCompletion().empty();
 }
 
 Migrator::Migrator(CompilerInstance *StartInstance,
@@ -373,59 +377,46 @@ void printRemap(const StringRef OriginalFilename,
 
 } // end anonymous namespace
 
-bool Migrator::emitRemap() const {
+void Migrator::emitRemap(AsyncOutputWriter &Writer) const {
   const auto &RemapPath = getMigratorOptions().EmitRemapFilePath;
   if (RemapPath.empty()) {
-    return false;
-  }
-
-  std::error_code Error;
-  llvm::raw_fd_ostream FileOS(RemapPath,
-                              Error, llvm::sys::fs::F_Text);
-  if (FileOS.has_error()) {
-    return true;
+    return;
   }
 
-  auto InputText = States.front()->getOutputText();
-  auto OutputText = States.back()->getOutputText();
-  printRemap(getInputFilename(), InputText, OutputText, FileOS);
-
-  FileOS.flush();
-  return FileOS.has_error();
+  // Computing the replacement map diffs the input against the final output,
+  // which is the expensive part of emission, so do it on the pool as well.
+  std::string Filename = getInputFilename().str();
+  std::string InputText = States.front()->getOutputText();
+  std::string OutputText = States.back()->getOutputText();
+  Writer.writeFileAsync(RemapPath,
+                        [Filename = std::move(Filename),
+                         InputText = std::move(InputText),
+                         OutputText = std::move(OutputText)](
+                            llvm::raw_pwrite_stream &FileOS) {
+    printRemap(Filename, InputText, OutputText, FileOS);
+  });
 }
 
-bool Migrator::emitMigratedFile() const {
+void Migrator::emitMigratedFile(AsyncOutputWriter &Writer) const {
   const auto &OutFilename = getMigratorOptions().EmitMigratedFilePath;
   if (OutFilename.empty()) {
-    return false;
-  }
-
-  std::error_code Error;
-  llvm::raw_fd_ostream FileOS(OutFilename,
-                              Error, llvm::sys::fs::F_Text);
-  if (FileOS.has_error()) {
-    return true;
+    return;
   }
 
-  FileOS << States.back()->getOutputText();
-
-  FileOS.flush();
-
-  return FileOS.has_error();
+  Writer.writeFile(OutFilename, [this](llvm::raw_pwrite_stream &FileOS) {
+    FileOS << States.back()->getOutputText();
+  });
 }
 
-bool Migrator::dumpStates() const {
+void Migrator::dumpStates(AsyncOutputWriter &Writer) const {
   const auto &OutDir = getMigratorOptions().DumpMigrationStatesDir;
   if (OutDir.empty()) {
-    return false;
+    return;
   }
 
-  auto Failed = false;
   for (size_t i = 0; i < States.size(); ++i) {
-    Failed |= States[i]->print(i, OutDir);
+    States[i]->print(i, OutDir, Writer);
   }
-
-  return Failed;
 }
 
 const MigratorOptions &Migrator::getMigratorOptions() const {
@@ -44,3 +44,8 @@ public:
 std::unique_ptr<OptTable> swift::createSwiftOptTable() {
   return std::unique_ptr<OptTable>(new SwiftOptTable());
 }
+
+const OptTable &swift::getSwiftOptTable() {
+  static SwiftOptTable Table;
+  return Table;
+}
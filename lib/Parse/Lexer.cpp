@@ -32,6 +32,12 @@
 
 #include <limits>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
 using namespace swift;
 using namespace swift::syntax;
 
@@ -374,12 +380,105 @@ static void diagnoseEmbeddedNul(DiagnosticEngine *Diags, const char *Ptr) {
       .fixItRemoveChars(NulLoc, NulEndLoc);
 }
 
+//===----------------------------------------------------------------------===//
+// Bulk character scanning
+//===----------------------------------------------------------------------===//
+//
+// The hottest lexer loops advance over long runs of "boring" bytes: ASCII
+// identifier characters and plain comment text. Where SSE2 or NEON is
+// available, classify 16 bytes per step and leave anything interesting
+// (token boundaries, newlines, nul, non-ASCII) to the exact scalar code.
+
+/// Is \p c an ASCII identifier-continuation character ([A-Za-z0-9_$])?
+static bool isASCIIIdentifierByte(char c) {
+  return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+         (c >= '0' && c <= '9') || c == '_' || c == '$';
+}
+
+/// Advance \p Ptr over ASCII identifier-continuation characters. Stops at
+/// the first byte outside [A-Za-z0-9_$], including any byte with the high
+/// bit set, which the caller must decode as a full code point.
+static void advanceOverASCIIIdentifier(const char *&Ptr, const char *End) {
+#if defined(__SSE2__)
+  while (End - Ptr >= 16) {
+    __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(Ptr));
+    // Case-fold the letters; bytes with the high bit set become "negative"
+    // for the signed comparisons and are classified as non-identifier.
+    __m128i folded = _mm_or_si128(chunk, _mm_set1_epi8(0x20));
+    __m128i isAlpha =
+        _mm_and_si128(_mm_cmpgt_epi8(folded, _mm_set1_epi8('a' - 1)),
+                      _mm_cmplt_epi8(folded, _mm_set1_epi8('z' + 1)));
+    __m128i isDigit =
+        _mm_and_si128(_mm_cmpgt_epi8(chunk, _mm_set1_epi8('0' - 1)),
+                      _mm_cmplt_epi8(chunk, _mm_set1_epi8('9' + 1)));
+    __m128i isOther =
+        _mm_or_si128(_mm_cmpeq_epi8(chunk, _mm_set1_epi8('_')),
+                     _mm_cmpeq_epi8(chunk, _mm_set1_epi8('$')));
+    __m128i valid = _mm_or_si128(_mm_or_si128(isAlpha, isDigit), isOther);
+    if (_mm_movemask_epi8(valid) != 0xFFFF)
+      break;
+    Ptr += 16;
+  }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+  while (End - Ptr >= 16) {
+    uint8x16_t chunk = vld1q_u8(reinterpret_cast<const uint8_t *>(Ptr));
+    uint8x16_t folded = vorrq_u8(chunk, vdupq_n_u8(0x20));
+    uint8x16_t isAlpha = vandq_u8(vcgeq_u8(folded, vdupq_n_u8('a')),
+                                  vcleq_u8(folded, vdupq_n_u8('z')));
+    uint8x16_t isDigit = vandq_u8(vcgeq_u8(chunk, vdupq_n_u8('0')),
+                                  vcleq_u8(chunk, vdupq_n_u8('9')));
+    uint8x16_t isOther = vorrq_u8(vceqq_u8(chunk, vdupq_n_u8('_')),
+                                  vceqq_u8(chunk, vdupq_n_u8('$')));
+    uint8x16_t valid = vorrq_u8(vorrq_u8(isAlpha, isDigit), isOther);
+    if (vminvq_u8(valid) == 0)
+      break;
+    Ptr += 16;
+  }
+#endif
+  while (Ptr < End && isASCIIIdentifierByte(*Ptr))
+    ++Ptr;
+}
+
+/// Advance \p Ptr over plain single-line text: anything other than a
+/// newline, carriage return, nul, or a byte with the high bit set, all of
+/// which the caller handles exactly.
+static void advanceOverPlainLineBytes(const char *&Ptr, const char *End) {
+#if defined(__SSE2__)
+  while (End - Ptr >= 16) {
+    __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(Ptr));
+    // Plain bytes are 0x01-0x7f minus '\n' and '\r'; the signed comparison
+    // against zero rejects both nul and high-bit bytes.
+    __m128i plain = _mm_cmpgt_epi8(chunk, _mm_setzero_si128());
+    plain = _mm_andnot_si128(_mm_cmpeq_epi8(chunk, _mm_set1_epi8('\n')), plain);
+    plain = _mm_andnot_si128(_mm_cmpeq_epi8(chunk, _mm_set1_epi8('\r')), plain);
+    if (_mm_movemask_epi8(plain) != 0xFFFF)
+      break;
+    Ptr += 16;
+  }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+  while (End - Ptr >= 16) {
+    uint8x16_t chunk = vld1q_u8(reinterpret_cast<const uint8_t *>(Ptr));
+    uint8x16_t plain = vandq_u8(vcgeq_u8(chunk, vdupq_n_u8(0x01)),
+                                vcleq_u8(chunk, vdupq_n_u8(0x7f)));
+    plain = vbicq_u8(plain, vceqq_u8(chunk, vdupq_n_u8('\n')));
+    plain = vbicq_u8(plain, vceqq_u8(chunk, vdupq_n_u8('\r')));
+    if (vminvq_u8(plain) == 0)
+      break;
+    Ptr += 16;
+  }
+#endif
+  while (Ptr < End && *Ptr != '\n' && *Ptr != '\r' && *Ptr != 0 &&
+         !(*Ptr & 0x80))
+    ++Ptr;
+}
+
 /// Advance \p CurPtr to the end of line or the end of file. Returns \c true
 /// if it stopped at the end of line, \c false if it stopped at the end of file.
 static bool advanceToEndOfLine(const char *&CurPtr, const char *BufferEnd,
                                const char *CodeCompletionPtr = nullptr,
                                DiagnosticEngine *Diags = nullptr) {
   while (1) {
+    advanceOverPlainLineBytes(CurPtr, BufferEnd);
     switch (*CurPtr++) {
     case '\n':
     case '\r':
@@ -662,8 +761,12 @@ void Lexer::lexIdentifier() {
   assert(didStart && "Unexpected start");
   (void) didStart;
 
-  // Lex [a-zA-Z_$0-9[[:XID_Continue:]]]*
-  while (advanceIfValidContinuationOfIdentifier(CurPtr, BufferEnd));
+  // Lex [a-zA-Z_$0-9[[:XID_Continue:]]]*. Runs of ASCII identifier
+  // characters are consumed in bulk; only non-ASCII continuations take the
+  // code-point decoding path.
+  do {
+    advanceOverASCIIIdentifier(CurPtr, BufferEnd);
+  } while (advanceIfValidContinuationOfIdentifier(CurPtr, BufferEnd));
 
   tok Kind = kindOfIdentifier(StringRef(TokStart, CurPtr-TokStart),
                               LexMode == LexerMode::SIL);
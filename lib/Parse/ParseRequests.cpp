@@ -113,8 +113,7 @@ BraceStmt *ParseAbstractFunctionBodyRequest::evaluate(
   case BodyKind::Unparsed: {
     // FIXME: How do we configure code completion?
     SourceFile &sf = *afd->getDeclContext()->getParentSourceFile();
-    SourceManager &sourceMgr = sf.getASTContext().SourceMgr;
-    unsigned bufferID = sourceMgr.findBufferContainingLoc(afd->getLoc());
+    unsigned bufferID = *sf.getBufferID();
     Parser parser(bufferID, sf, /*SIL*/ nullptr);
     parser.SyntaxContext->disable();
     auto body = parser.parseAbstractFunctionBodyDelayed(afd);
@@ -12,6 +12,7 @@
 
 #include "swift/Parse/ParsedTrivia.h"
 #include "swift/Syntax/Trivia.h"
+#include "swift/Basic/OwnedString.h"
 #include "swift/Basic/SourceManager.h"
 
 using namespace swift;
@@ -33,6 +34,22 @@ ParsedTriviaPiece::convertToSyntaxTrivia(ArrayRef<ParsedTriviaPiece> pieces,
   return trivia;
 }
 
+Trivia
+ParsedTriviaPiece::convertToSyntaxTrivia(ArrayRef<ParsedTriviaPiece> pieces,
+                                         SourceLoc loc,
+                                         const SourceManager &SM,
+                                         unsigned bufferID,
+                                         const OwnedString &sourceText) {
+  Trivia trivia;
+  size_t offset = SM.getLocOffsetInBuffer(loc, bufferID);
+  for (const auto &piece : pieces) {
+    auto text = sourceText.slice(offset, piece.getLength());
+    trivia.push_back(TriviaPiece::fromText(piece.getKind(), text));
+    offset += piece.getLength();
+  }
+  return trivia;
+}
+
 Trivia
 ParsedTrivia::convertToSyntaxTrivia(SourceLoc loc, const SourceManager &SM,
                                     unsigned bufferID) const {
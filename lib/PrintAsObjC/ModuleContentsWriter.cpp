@@ -483,8 +483,7 @@ public:
     decls.erase(newEnd, decls.end());
 
     // REVERSE sort the decls, since we are going to copy them onto a stack.
-    llvm::array_pod_sort(decls.begin(), decls.end(),
-                         [](Decl * const *lhs, Decl * const *rhs) -> int {
+    auto comparator = [](Decl * const *lhs, Decl * const *rhs) -> int {
       enum : int {
         Ascending = -1,
         Equivalent = 0,
@@ -546,7 +545,16 @@ public:
         return Equivalent;
       StringRef lhsProtoName = (*mismatch.first)->getName().str();
       return lhsProtoName.compare((*mismatch.second)->getName().str());
-    });
+    };
+
+    // Sort stably so that extensions the comparator considers equivalent keep
+    // their deterministic top-level order. An unstable sort makes the emitted
+    // header's bytes depend on the sort implementation's tie-breaking, which
+    // spuriously dirties the header on rebuilds.
+    std::stable_sort(decls.begin(), decls.end(),
+                     [&comparator](Decl *lhs, Decl *rhs) {
+                       return comparator(&lhs, &rhs) < 0;
+                     });
 
     assert(declsToWrite.empty());
     declsToWrite.assign(decls.begin(), decls.end());
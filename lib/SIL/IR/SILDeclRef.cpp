@@ -689,6 +689,21 @@ static void mangleClangDecl(raw_ostream &buffer,
 }
 
 std::string SILDeclRef::mangle(ManglingKind MKind) const {
+  // The mangling is a pure function of the reference. Memoize the common
+  // decl-based case; the excluded cases either recurse into this one or
+  // carry extra state in `pointer` that the key below doesn't cover.
+  if (hasDecl() && !getDerivativeFunctionIdentifier() &&
+      !getSpecializedSignature()) {
+    unsigned discriminator = unsigned(kind) | unsigned(isForeign) << 4 |
+                             unsigned(MKind) << 5 | defaultArgIndex << 8;
+    return getDecl()->getASTContext().getOrCacheMangledName(
+        loc.getOpaqueValue(), discriminator,
+        [&] { return mangleImpl(MKind); });
+  }
+  return mangleImpl(MKind);
+}
+
+std::string SILDeclRef::mangleImpl(ManglingKind MKind) const {
   using namespace Mangle;
   ASTMangler mangler;
 
@@ -165,6 +165,22 @@ bool SILGlobalVariable::isValidStaticInitializerInst(const SILInstruction *I,
           return false;
       }
       return false;
+    case SILInstructionKind::EnumInst: {
+      // Case constants of C-like enums have a fixed bit pattern which can be
+      // emitted statically. Cases with payloads and resilient layouts are not
+      // supported.
+      auto *EI = cast<EnumInst>(I);
+      if (EI->hasOperand())
+        return false;
+      EnumDecl *decl = EI->getElement()->getParentEnum();
+      if (decl->isResilient())
+        return false;
+      for (EnumElementDecl *element : decl->getAllElements()) {
+        if (element->hasAssociatedValues())
+          return false;
+      }
+      return true;
+    }
     case SILInstructionKind::StructInst:
     case SILInstructionKind::TupleInst:
     case SILInstructionKind::IntegerLiteralInst:
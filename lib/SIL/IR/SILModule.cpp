@@ -35,6 +35,11 @@
 using namespace swift;
 using namespace Lowering;
 
+STATISTIC(NumInstsAllocated, "Number of SILInstruction allocations");
+STATISTIC(NumInstsDeallocated, "Number of SILInstruction deallocations");
+STATISTIC(NumInstsRecycled,
+          "Number of SILInstruction allocations served from a free list");
+
 class SILModule::SerializationCallback final
     : public DeserializationNotificationHandler {
   void didDeserialize(ModuleDecl *M, SILFunction *fn) override {
@@ -194,11 +199,49 @@ void *SILModule::allocate(unsigned Size, unsigned Align) const {
 }
 
 void *SILModule::allocateInst(unsigned Size, unsigned Align) const {
-  return AlignedAlloc(Size, Align);
+  // With -use-malloc every instruction gets fresh memory, which lets address
+  // sanitizers catch use-after-free of deleted instructions.
+  if (getASTContext().LangOpts.UseMalloc)
+    return AlignedAlloc(Size, Align);
+
+  assert(Align <= InstAlignment &&
+         "instruction requires stronger alignment than the SIL allocator "
+         "provides");
+  // Reserve a header in front of the instruction to remember its size class
+  // on deallocation. The header is InstAlignment bytes so the instruction
+  // itself stays InstAlignment-aligned.
+  unsigned totalSize = llvm::alignTo(Size + InstAlignment, InstAlignment);
+  unsigned sizeClass = totalSize / InstAlignment - 1;
+  void *mem;
+  if (sizeClass < NumInstFreeLists && InstFreeLists[sizeClass]) {
+    mem = InstFreeLists[sizeClass];
+    InstFreeLists[sizeClass] = InstFreeLists[sizeClass]->Next;
+    ++NumInstsRecycled;
+  } else {
+    mem = BPA.Allocate(totalSize, InstAlignment);
+  }
+  ++NumInstsAllocated;
+  *reinterpret_cast<unsigned *>(mem) = sizeClass;
+  return reinterpret_cast<char *>(mem) + InstAlignment;
 }
 
 void SILModule::deallocateInst(SILInstruction *I) {
-  AlignedFree(I);
+  if (getASTContext().LangOpts.UseMalloc) {
+    AlignedFree(I);
+    return;
+  }
+
+  ++NumInstsDeallocated;
+  void *mem = reinterpret_cast<char *>(I) - InstAlignment;
+  unsigned sizeClass = *reinterpret_cast<unsigned *>(mem);
+  // Blocks beyond the largest size class are simply retained by the bump
+  // allocator.
+  if (sizeClass >= NumInstFreeLists)
+    return;
+
+  auto *node = reinterpret_cast<InstFreeListNode *>(mem);
+  node->Next = InstFreeLists[sizeClass];
+  InstFreeLists[sizeClass] = node;
 }
 
 SILWitnessTable *
@@ -384,6 +427,28 @@ SILFunction *SILModule::lookUpFunction(SILDeclRef fnRef) {
   return lookUpFunction(name);
 }
 
+SILFunction *SILModule::lookUpSpecialization(const SILFunction *genericFn,
+                                             SubstitutionMap subs,
+                                             unsigned flags) {
+  auto iter = SpecializationTable.find(
+      {genericFn, {subs.getCanonical().getOpaqueValue(), flags}});
+  if (iter == SpecializationTable.end())
+    return nullptr;
+  // Dead functions are moved to the zombie list rather than freed, so a stale
+  // entry is safe to inspect; treat it as a miss.
+  if (iter->second->isZombie())
+    return nullptr;
+  return iter->second;
+}
+
+void SILModule::registerSpecialization(const SILFunction *genericFn,
+                                       SubstitutionMap subs, unsigned flags,
+                                       SILFunction *specialization) {
+  SpecializationTable[{genericFn,
+                       {subs.getCanonical().getOpaqueValue(), flags}}] =
+      specialization;
+}
+
 bool SILModule::loadFunction(SILFunction *F) {
   SILFunction *NewF =
     getSILLoader()->lookupSILFunction(F, /*onlyUpdateLinkage*/ false);
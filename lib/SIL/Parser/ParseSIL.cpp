@@ -366,6 +366,8 @@ namespace {
 
     /// Parses the basic block arguments as part of branch instruction.
     bool parseSILBBArgsAtBranch(SmallVector<SILValue, 6> &Args, SILBuilder &B);
+    bool parseSILBranchProfileCounts(ProfileCounter &TrueCount,
+                                     ProfileCounter &FalseCount);
 
     bool parseSILLocation(SILLocation &L);
     bool parseScopeRef(SILDebugScope *&DS);
@@ -1681,6 +1683,43 @@ bool SILParser::parseSILBBArgsAtBranch(SmallVector<SILValue, 6> &Args,
   return false;
 }
 
+/// Parse the optional profile count annotations on a two-successor
+/// terminator, in the form the printer emits them:
+///
+///   sil-branch-counts ::= ('!true_count' '(' integer ')')?
+///                         ('!false_count' '(' integer ')')?
+bool SILParser::parseSILBranchProfileCounts(ProfileCounter &TrueCount,
+                                            ProfileCounter &FalseCount) {
+  while (P.Tok.is(tok::sil_exclamation)) {
+    P.consumeToken(tok::sil_exclamation);
+
+    Identifier CountName;
+    SourceLoc NameLoc;
+    if (parseSILIdentifier(CountName, NameLoc, diag::expected_tok_in_sil_instr,
+                           "true_count or false_count"))
+      return true;
+    bool IsTrueCount = CountName.str() == "true_count";
+    if (!IsTrueCount && CountName.str() != "false_count") {
+      P.diagnose(NameLoc, diag::expected_tok_in_sil_instr,
+                 "true_count or false_count");
+      return true;
+    }
+
+    uint64_t Count;
+    if (P.parseToken(tok::l_paren, diag::expected_tok_in_sil_instr, "(") ||
+        parseInteger(Count, Diagnostic(diag::expected_tok_in_sil_instr,
+                                       "integer literal")) ||
+        P.parseToken(tok::r_paren, diag::expected_tok_in_sil_instr, ")"))
+      return true;
+
+    if (IsTrueCount)
+      TrueCount = ProfileCounter(Count);
+    else
+      FalseCount = ProfileCounter(Count);
+  }
+  return false;
+}
+
 /// Parse the substitution list for an apply instruction or
 /// specialized protocol conformance.
 bool SILParser::parseSubstitutions(SmallVectorImpl<ParsedSubstitution> &parsed,
@@ -4253,14 +4292,19 @@ bool SILParser::parseSpecificSILInstruction(SILBuilder &B,
           P.parseToken(tok::comma, diag::expected_tok_in_sil_instr, ",") ||
           parseSILIdentifier(BBName2, NameLoc2,
                              diag::expected_sil_block_name) ||
-          parseSILBBArgsAtBranch(Args2, B) || parseSILDebugLocation(InstLoc, B))
+          parseSILBBArgsAtBranch(Args2, B))
+        return true;
+
+      ProfileCounter TrueCount, FalseCount;
+      if (parseSILBranchProfileCounts(TrueCount, FalseCount) ||
+          parseSILDebugLocation(InstLoc, B))
         return true;
 
       auto I1Ty = SILType::getBuiltinIntegerType(1, SILMod.getASTContext());
       SILValue CondVal = getLocalValue(Cond, I1Ty, InstLoc, B);
       ResultVal = B.createCondBranch(
           InstLoc, CondVal, getBBForReference(BBName, NameLoc), Args,
-          getBBForReference(BBName2, NameLoc2), Args2);
+          getBBForReference(BBName2, NameLoc2), Args2, TrueCount, FalseCount);
       break;
     }
     case SILInstructionKind::UnreachableInst:
@@ -5828,6 +5828,11 @@ void SILGlobalVariable::verify() const {
 
 /// Verify the module.
 void SILModule::verify() const {
+  verify([](const SILFunction &) { return true; });
+}
+
+void SILModule::verify(
+    llvm::function_ref<bool(const SILFunction &)> shouldVerifyFunction) const {
   if (!verificationEnabled(*this))
     return;
 
@@ -5842,7 +5847,8 @@ void SILModule::verify() const {
       llvm::errs() << "Symbol redefined: " << f.getName() << "!\n";
       assert(false && "triggering standard assertion failure routine");
     }
-    f.verify(/*singleFunction*/ false);
+    if (shouldVerifyFunction(f))
+      f.verify(/*singleFunction*/ false);
   }
 
   // Check all globals.
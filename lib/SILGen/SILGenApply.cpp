@@ -5029,6 +5029,94 @@ RValue SILGenFunction::emitApplyOfPropertyWrapperBackingInitializer(
   return emission.apply(C);
 }
 
+/// Returns true if the given nominal is one of the compiler-known signed
+/// standard library integer types.
+static bool isKnownSignedIntegerDecl(ASTContext &ctx, NominalTypeDecl *decl) {
+  return decl == ctx.getIntDecl() || decl == ctx.getInt8Decl() ||
+         decl == ctx.getInt16Decl() || decl == ctx.getInt32Decl() ||
+         decl == ctx.getInt64Decl();
+}
+
+/// Returns true if the given nominal is one of the compiler-known unsigned
+/// standard library integer types.
+static bool isKnownUnsignedIntegerDecl(ASTContext &ctx, NominalTypeDecl *decl) {
+  return decl == ctx.getUIntDecl() || decl == ctx.getUInt8Decl() ||
+         decl == ctx.getUInt16Decl() || decl == ctx.getUInt32Decl() ||
+         decl == ctx.getUInt64Decl();
+}
+
+/// Try to emit an integer or boolean literal of a compiler-known standard
+/// library type as a folded integer_literal wrapped in a struct, instead of
+/// applying the builtin literal initializer and leaving it to mandatory
+/// inlining and constant folding to reduce the call.
+///
+/// Returns None if the literal's type doesn't have a known fixed layout or
+/// if its value needs the initializer's overflow checking, in which case
+/// the caller emits the usual initializer call.
+static Optional<RValue> tryEmitFoldedNumericLiteral(SILGenFunction &SGF,
+                                                    LiteralExpr *literal) {
+  // Only fold when optimizing; at -Onone, keep the naive initializer
+  // application so raw SILGen output stays uniform for debugging.
+  if (!SGF.getOptions().shouldOptimize())
+    return None;
+
+  auto &ctx = SGF.getASTContext();
+  auto *structDecl = dyn_cast_or_null<StructDecl>(
+      literal->getType()->getAnyNominal());
+  if (!structDecl)
+    return None;
+
+  bool isSigned = false;
+  if (isa<IntegerLiteralExpr>(literal)) {
+    isSigned = isKnownSignedIntegerDecl(ctx, structDecl);
+    if (!isSigned && !isKnownUnsignedIntegerDecl(ctx, structDecl))
+      return None;
+  } else if (isa<BooleanLiteralExpr>(literal)) {
+    if (structDecl != ctx.getBoolDecl())
+      return None;
+  } else {
+    return None;
+  }
+
+  // The stored value must be directly constructible here.
+  if (structDecl->isResilient(SGF.SGM.SwiftModule,
+                              SGF.F.getResilienceExpansion()))
+    return None;
+
+  auto props = structDecl->getStoredProperties();
+  if (props.size() != 1)
+    return None;
+
+  auto loweredTy = SGF.getLoweredType(literal->getType());
+  auto fieldTy = loweredTy.getFieldType(props[0], SGF.SGM.M,
+                                        SGF.getTypeExpansionContext());
+  auto builtinTy = fieldTy.getAs<BuiltinIntegerType>();
+  if (!builtinTy || !builtinTy->isFixedWidth())
+    return None;
+  unsigned width = builtinTy->getFixedWidth();
+
+  APInt value(width, 0);
+  if (auto *intLiteral = dyn_cast<IntegerLiteralExpr>(literal)) {
+    auto raw = intLiteral->getRawValue();
+    bool fits = isSigned ? raw.getMinSignedBits() <= width
+                         : (!raw.isNegative() && raw.getActiveBits() <= width);
+    // If the value doesn't fit, emit the initializer call so that constant
+    // folding diagnoses the overflow as usual.
+    if (!fits)
+      return None;
+    value = raw.sextOrTrunc(width);
+  } else {
+    if (width != 1)
+      return None;
+    if (cast<BooleanLiteralExpr>(literal)->getValue())
+      value = 1;
+  }
+
+  SILValue lit = SGF.B.createIntegerLiteral(literal, fieldTy, value);
+  SILValue wrapped = SGF.B.createStruct(literal, loweredTy, lit);
+  return RValue(SGF, literal, ManagedValue::forUnmanaged(wrapped));
+}
+
 /// Emit a literal that applies the various initializers.
 RValue SILGenFunction::emitLiteral(LiteralExpr *literal, SGFContext C) {
   ConcreteDeclRef builtinInit;
@@ -5040,6 +5128,13 @@ RValue SILGenFunction::emitLiteral(LiteralExpr *literal, SGFContext C) {
     builtinInit = literal->getInitializer();
   }
 
+  // Fully-constant literals of the compiler-known integer and boolean types
+  // can be emitted in already-folded form.
+  if (!init) {
+    if (auto folded = tryEmitFoldedNumericLiteral(*this, literal))
+      return std::move(*folded);
+  }
+
   // Emit the raw, builtin literal arguments.
   PreparedArguments builtinLiteralArgs =
       buildBuiltinLiteralArgs(*this, C, literal);
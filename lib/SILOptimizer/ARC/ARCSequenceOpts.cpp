@@ -38,6 +38,8 @@
 using namespace swift;
 
 STATISTIC(NumRefCountOpsRemoved, "Total number of increments removed");
+STATISTIC(NumMatchingSetsEliminated,
+          "Total number of matched retain/release sets eliminated");
 
 llvm::cl::opt<bool> EnableLoopARC("enable-loop-arc", llvm::cl::init(true));
 
@@ -66,6 +68,19 @@ void ARCPairingContext::optimizeMatchingSet(
     DeadInsts.push_back(Decrement);
     ++NumRefCountOpsRemoved;
   }
+
+  if (MatchSet.Increments.empty())
+    return;
+
+  ++NumMatchingSetsEliminated;
+  ORE.emit([&]() {
+    using namespace OptRemark;
+    return RemarkPassed("PairEliminated", **MatchSet.Increments.begin())
+           << "eliminated " << NV("NumIncrements", MatchSet.Increments.size())
+           << " retain(s) paired with "
+           << NV("NumDecrements", MatchSet.Decrements.size())
+           << " release(s) of " << NV("Type", MatchSet.Ptr->getType());
+  });
 }
 
 bool ARCPairingContext::performMatching(
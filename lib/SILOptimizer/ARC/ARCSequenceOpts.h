@@ -16,6 +16,7 @@
 #include "GlobalARCSequenceDataflow.h"
 #include "GlobalLoopARCSequenceDataflow.h"
 #include "ARCMatchingSet.h"
+#include "swift/SIL/OptimizationRemark.h"
 #include "swift/SIL/SILValue.h"
 #include "swift/SILOptimizer/Utils/LoopUtils.h"
 #include "llvm/ADT/SetVector.h"
@@ -37,8 +38,13 @@ struct ARCPairingContext {
   RCIdentityFunctionInfo *RCIA;
   bool MadeChange = false;
 
+  /// Reports each eliminated matching set so that paired retain/release
+  /// traffic can be tracked per function build-over-build.
+  OptRemark::Emitter ORE;
+
   ARCPairingContext(SILFunction &F, RCIdentityFunctionInfo *RCIA)
-      : F(F), DecToIncStateMap(), IncToDecStateMap(), RCIA(RCIA) {}
+      : F(F), DecToIncStateMap(), IncToDecStateMap(), RCIA(RCIA),
+        ORE("arc-sequence-opts", F) {}
   bool performMatching(llvm::SmallVectorImpl<SILInstruction *> &DeadInsts);
 
   void optimizeMatchingSet(ARCMatchingSet &MatchSet,
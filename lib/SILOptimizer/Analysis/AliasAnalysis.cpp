@@ -24,12 +24,15 @@
 #include "swift/SILOptimizer/Analysis/ValueTracking.h"
 #include "swift/SILOptimizer/PassManager/PassManager.h"
 #include "swift/SILOptimizer/Utils/InstOptUtils.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/raw_ostream.h"
 
 using namespace swift;
 
+STATISTIC(NumAliasCacheHits, "Number of alias queries answered from the cache");
+STATISTIC(NumAliasEvaluations, "Number of full alias query evaluations");
 
 // The AliasAnalysis Cache must not grow beyond this size.
 // We limit the size of the AA cache to 2**14 because we want to limit the
@@ -551,6 +554,7 @@ AliasResult AliasAnalysis::alias(SILValue V1, SILValue V2,
   // Check if we've already computed this result.
   auto It = AliasCache.find(Key);
   if (It != AliasCache.end()) {
+    ++NumAliasCacheHits;
     return It->second;
   }
 
@@ -564,6 +568,7 @@ AliasResult AliasAnalysis::alias(SILValue V1, SILValue V2,
   }
 
   // Calculate the aliasing result and store it in the cache.
+  ++NumAliasEvaluations;
   auto Result = aliasInner(V1, V2, TBAAType1, TBAAType2);
   AliasCache[Key] = Result;
   return Result;
@@ -793,5 +798,8 @@ AliasKeyTy AliasAnalysis::toAliasKey(SILValue V1, SILValue V2,
          "~0 index reserved for empty/tombstone keys");
   void *t1 = Type1.getOpaqueValue();
   void *t2 = Type2.getOpaqueValue();
-  return {idx1, idx2, t1, t2};
+  SILFunction *F = V1->getFunction();
+  if (!F)
+    F = V2->getFunction();
+  return {idx1, idx2, t1, t2, getCacheGeneration(F)};
 }
@@ -2040,6 +2040,13 @@ void EscapeAnalysis::analyzeInstruction(SILInstruction *I,
       if (Fn->getName() == "swift_bufferAllocate")
         // The call is a buffer allocation, e.g. for Array.
         return;
+
+      // The callee body is not visible, e.g. because it is defined in another
+      // module. Its effects attribute, which is serialized into the
+      // swiftmodule, may still prove that no argument escapes at this call
+      // site.
+      if (isNonEscapingEffectsCall(FAS, Fn))
+        return;
     }
   }
 
@@ -2339,6 +2346,46 @@ analyzeSelectInst(SelectInst *SI, ConnectionGraph *ConGraph) {
   }
 }
 
+/// Returns true if the call \p FAS to the not-visible function \p Callee
+/// cannot let any argument escape, based on the callee's effects attribute.
+///
+/// A callee which does not write memory cannot store an argument anywhere.
+/// The only remaining way for an argument to escape such a callee is to be
+/// forwarded into a result. The connection graph cannot distinguish a
+/// forwarded argument from a pointer to unknown global memory, so we require
+/// that no result can contain a pointer.
+/// Like SideEffectAnalysis, we trust the (unchecked) effects attribute, but
+/// not if the callee has owned parameters: the release of an owned parameter
+/// can call a deinit, which can have arbitrary effects.
+bool EscapeAnalysis::isNonEscapingEffectsCall(FullApplySite FAS,
+                                              SILFunction *Callee) {
+  switch (Callee->getEffectsKind()) {
+  case EffectsKind::ReadNone:
+  case EffectsKind::ReadOnly:
+    break;
+  default:
+    return false;
+  }
+  if (Callee->hasOwnedParameters())
+    return false;
+
+  // The error existential of a try_apply can always contain a reference.
+  if (isa<TryApplyInst>(FAS.getInstruction()))
+    return false;
+
+  for (SILValue result : FAS.getInstruction()->getResults()) {
+    if (isPointer(result))
+      return false;
+  }
+  SILFunction *F = FAS.getFunction();
+  for (SILValue indirectResult : FAS.getIndirectSILResults()) {
+    if (findCachedPointerKind(indirectResult->getType().getObjectType(), *F) >
+        NoPointer)
+      return false;
+  }
+  return true;
+}
+
 bool EscapeAnalysis::deinitIsKnownToNotCapture(SILValue V) {
   for (;;) {
     // The deinit of an array buffer does not capture the array elements.
@@ -0,0 +1,34 @@
+//===--- InlineCostAnalysis.cpp - Inline cost summaries -------------------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2021 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+#define DEBUG_TYPE "sil-inline-cost-analysis"
+#include "swift/SILOptimizer/Analysis/InlineCostAnalysis.h"
+#include "swift/SILOptimizer/Utils/SILInliner.h"
+#include "llvm/ADT/Statistic.h"
+
+using namespace swift;
+
+STATISTIC(NumCostScanInstVisits,
+          "Number of instructions visited while computing inline costs");
+
+InlineCostInfo::InlineCostInfo(SILFunction *F) {
+  for (SILBasicBlock &block : *F) {
+    for (SILInstruction &I : block) {
+      ++NumCostScanInstVisits;
+      FullCost += (int)instructionInlineCost(I);
+    }
+  }
+}
+
+SILAnalysis *swift::createInlineCostAnalysis(SILModule *M) {
+  return new InlineCostAnalysis(M);
+}
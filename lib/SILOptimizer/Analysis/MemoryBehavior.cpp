@@ -19,10 +19,16 @@
 #include "swift/SILOptimizer/Analysis/EscapeAnalysis.h"
 #include "swift/SILOptimizer/Analysis/SideEffectAnalysis.h"
 #include "swift/SILOptimizer/Analysis/ValueTracking.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/Support/Debug.h"
 
 using namespace swift;
 
+STATISTIC(NumMemBehaviorCacheHits,
+          "Number of memory behavior queries answered from the cache");
+STATISTIC(NumMemBehaviorEvaluations,
+          "Number of full memory behavior query evaluations");
+
 // The MemoryBehavior Cache must not grow beyond this size.
 // We limit the size of the MB cache to 2**14 because we want to limit the
 // memory usage of this cache.
@@ -521,6 +527,7 @@ AliasAnalysis::computeMemoryBehavior(SILInstruction *Inst, SILValue V) {
   // Check if we've already computed this result.
   auto It = MemoryBehaviorCache.find(Key);
   if (It != MemoryBehaviorCache.end()) {
+    ++NumMemBehaviorCacheHits;
     return It->second;
   }
 
@@ -534,6 +541,7 @@ AliasAnalysis::computeMemoryBehavior(SILInstruction *Inst, SILValue V) {
   }
 
   // Calculate the aliasing result and store it in the cache.
+  ++NumMemBehaviorEvaluations;
   auto Result = computeMemoryBehaviorInner(Inst, V);
   MemoryBehaviorCache[Key] = Result;
   return Result;
@@ -557,5 +565,5 @@ MemBehaviorKeyTy AliasAnalysis::toMemoryBehaviorKey(SILInstruction *V1,
       V2->getRepresentativeSILNodeInObject());
   assert(idx2 != std::numeric_limits<size_t>::max() &&
          "~0 index reserved for empty/tombstone keys");
-  return {idx1, idx2};
+  return {idx1, idx2, getCacheGeneration(V1->getFunction())};
 }
@@ -17,6 +17,14 @@
 #include "swift/SILOptimizer/Analysis/BasicCalleeAnalysis.h"
 #include "swift/SILOptimizer/Analysis/FunctionOrder.h"
 #include "swift/SILOptimizer/PassManager/PassManager.h"
+#include "llvm/ADT/Statistic.h"
+
+STATISTIC(NumStaleRecomputes,
+          "Number of effect summaries recomputed after an invalidation");
+STATISTIC(NumUnchangedSummaries,
+          "Number of recomputed effect summaries covered by the old summary");
+STATISTIC(NumCallerInvalidations,
+          "Number of callers invalidated because a summary changed");
 
 using namespace swift;
 
@@ -34,6 +42,7 @@ template <typename FunctionEffects>
 void GenericFunctionEffectAnalysis<FunctionEffects>::invalidate() {
   functionInfoMap.clear();
   allocator.DestroyAll();
+  staleFunctions.clear();
   LLVM_DEBUG(llvm::dbgs() << "invalidate all\n");
 }
 
@@ -42,8 +51,61 @@ void GenericFunctionEffectAnalysis<FunctionEffects>::invalidate(
     SILFunction *F, InvalidationKind K) {
   if (FunctionInfo *FInfo = functionInfoMap.lookup(F)) {
     LLVM_DEBUG(llvm::dbgs() << "  invalidate " << FInfo->F->getName() << '\n');
-    invalidateIncludingAllCallers(FInfo);
+    invalidateDelayingCallers(FInfo);
+  }
+}
+
+template <typename FunctionEffects>
+void GenericFunctionEffectAnalysis<FunctionEffects>::invalidateDelayingCallers(
+    FunctionInfo *FInfo) {
+  // Save the old effects so that updateStaleFunctions() can check if the
+  // recomputed effects actually changed. Don't save anything if the function
+  // is already awaiting an update: the oldest effects are the ones the
+  // callers have seen.
+  if (FInfo->isValid() && !FInfo->hasSavedEffects) {
+    FInfo->savedEffects = FInfo->functionEffects;
+    FInfo->hasSavedEffects = true;
+    staleFunctions.push_back(FInfo);
   }
+  invalidateKeepingCallers(FInfo);
+}
+
+template <typename FunctionEffects>
+void GenericFunctionEffectAnalysis<FunctionEffects>::updateStaleFunctions() {
+  if (updatingStaleFunctions || staleFunctions.empty())
+    return;
+  updatingStaleFunctions = true;
+  while (!staleFunctions.empty()) {
+    FunctionInfo *FInfo = staleFunctions.pop_back_val();
+    if (!FInfo->hasSavedEffects)
+      continue;
+    FunctionEffects oldEffects = FInfo->savedEffects;
+    FInfo->hasSavedEffects = false;
+    FInfo->savedEffects.clear();
+    if (!FInfo->isValid()) {
+      recompute(FInfo);
+      ++NumStaleRecomputes;
+    }
+    // If merging the new effects into the old ones does not change anything,
+    // the new effects are covered by the old ones. The callers then still
+    // hold a conservatively correct summary and stay valid.
+    if (!oldEffects.mergeFrom(FInfo->functionEffects)) {
+      ++NumUnchangedSummaries;
+      continue;
+    }
+    LLVM_DEBUG(llvm::dbgs() << "  effects changed for "
+                            << FInfo->F->getName() << '\n');
+    // The effects changed: the callers are out of date. Again only invalidate
+    // one level up the call-graph, so that the change check is repeated for
+    // each level.
+    for (const auto &E : FInfo->getCallers()) {
+      if (E.isValid() && E.Caller->isValid()) {
+        ++NumCallerInvalidations;
+        invalidateDelayingCallers(E.Caller);
+      }
+    }
+  }
+  updatingStaleFunctions = false;
 }
 
 template <typename FunctionEffects>
@@ -164,7 +226,10 @@ void GenericFunctionEffectAnalysis<FunctionEffects>::recompute(
 
       // Propagate the function effects to all callers.
       for (const auto &E : functionInfo->getCallers()) {
-        assert(E.isValid());
+        // The retained caller list of a re-analyzed function can still
+        // contain entries of invalidated callers.
+        if (!E.isValid())
+          continue;
 
         // Only include callers which we are actually recomputing.
         if (!bottomUpOrder.wasRecomputedWithCurrentUpdateID(E.Caller))
@@ -45,6 +45,7 @@
 #include "swift/SILOptimizer/Utils/SILInliner.h"
 #include "swift/SILOptimizer/Utils/SILOptFunctionBuilder.h"
 #include "swift/SILOptimizer/Utils/SpecializationMangler.h"
+#include "swift/SILOptimizer/Utils/StackNesting.h"
 #include "llvm/ADT/Statistic.h"
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/Debug.h"
@@ -882,6 +883,43 @@ public:
     // with self-recursion.
     addFunctionToPassManagerWorklist(FST.getOptimizedFunction(), F);
 
+    // If the original function was deserialized from another module (e.g. by
+    // cross-module-optimization) it stays available-externally, so the thunk
+    // it has just been turned into is never emitted into this module. Any
+    // apply of it that the inliner misses would resolve at link time to the
+    // unoptimized entry point in the defining module. Inline the thunk into
+    // all known apply sites now so local callers reach the optimized entry
+    // point directly.
+    if (F->isAvailableExternally()) {
+      llvm::SmallVector<SILFunction *, 8> Callers;
+      for (const auto &CallerState : FuncInfo.getAllReferencingCallers())
+        Callers.push_back(CallerState.first);
+      for (SILFunction *Caller : Callers) {
+        llvm::SmallVector<FullApplySite, 8> ApplySites;
+        for (SILBasicBlock &BB : *Caller) {
+          for (SILInstruction &I : BB) {
+            auto FAS = FullApplySite::isa(&I);
+            if (FAS && FAS.getReferencedFunctionOrNull() == F &&
+                SILInliner::canInlineApplySite(FAS))
+              ApplySites.push_back(FAS);
+          }
+        }
+        if (ApplySites.empty())
+          continue;
+
+        bool invalidatedStackNesting = false;
+        for (FullApplySite FAS : ApplySites) {
+          invalidatedStackNesting |= SILInliner::invalidatesStackNesting(FAS);
+          SILInliner::inlineFullApply(
+              FAS, SILInliner::InlineKind::PerformanceInline, FuncBuilder);
+        }
+        if (invalidatedStackNesting)
+          StackNesting().correctStackNesting(Caller);
+        PM->invalidateAnalysis(Caller,
+                               SILAnalysis::InvalidationKind::FunctionBody);
+      }
+    }
+
     if (!OptForPartialApply) {
       // We have to restart the pipeline for this thunk in order to run the
       // inliner (and other opts) again. This is important if the new
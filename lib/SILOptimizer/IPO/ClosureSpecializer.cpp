@@ -1044,6 +1044,12 @@ static bool isClosureAppliedIn(SILFunction *Callee, unsigned closureArgIdx,
              "any other non-argument operands than the callee?");
 
       SILFunction *ApplyCallee = UserAI.getReferencedFunctionOrNull();
+      // If the closure is forwarded into another module, the body may still
+      // be available in serialized SIL; deserialize it so the profitability
+      // check can look through cross-module forwarding chains.
+      if (ApplyCallee && ApplyCallee->isExternalDeclaration() &&
+          HandledFuncs.size() < RecursionBudget)
+        Callee->getModule().loadFunction(ApplyCallee);
       if (ApplyCallee && !ApplyCallee->isExternalDeclaration() &&
           HandledFuncs.count(ApplyCallee) == 0 &&
           HandledFuncs.size() < RecursionBudget) {
@@ -1189,9 +1195,22 @@ bool SILClosureSpecializerTransform::gatherCallSites(
         // If AI does not have a function_ref definition as its callee, we can
         // not do anything here... so continue...
         SILFunction *ApplyCallee = AI.getReferencedFunctionOrNull();
-        if (!ApplyCallee || ApplyCallee->isExternalDeclaration())
+        if (!ApplyCallee)
           continue;
 
+        // With cross-module-optimization the callee's body can be available
+        // in serialized SIL even though it lives in another module. Try to
+        // deserialize it: the specialized clone gets shared linkage and is
+        // code-gen'd here, so a constant closure from this module no longer
+        // pays for context allocation and indirect calls on the way into the
+        // callee.
+        if (ApplyCallee->isExternalDeclaration()) {
+          SILModule &M = Caller->getModule();
+          if (!M.loadFunction(ApplyCallee))
+            continue;
+          M.linkFunction(ApplyCallee);
+        }
+
         // Don't specialize non-fragile callees if the caller is fragile;
         // the specialized callee will have shared linkage, and thus cannot
         // be referenced from the fragile caller.
@@ -169,6 +169,10 @@ class LetPropertiesOpt {
   // Set of properties which already fulfill all conditions, except
   // the available of constant, statically known initializer.
   llvm::SmallPtrSet<VarDecl *, 16> PotentialConstantLetProperty;
+  // Classes defined in other modules whose designated initializers were all
+  // serialized and are deserialized into this module, so that every
+  // assignment to their let properties is visible to this pass.
+  llvm::SmallPtrSet<ClassDecl *, 8> AnalyzableImportedClasses;
 
 public:
   LetPropertiesOpt(SILModule *M): Module(M) {}
@@ -177,6 +181,7 @@ public:
 
 protected:
   bool isConstantLetProperty(VarDecl *Property);
+  bool deserializeClassInitializers(ClassDecl *Class);
   void collectPropertyAccess(SingleValueInstruction *I, VarDecl *Property,
                              bool NonRemovable);
   void optimizeLetPropertyAccess(VarDecl *SILG, const InitSequence &Init);
@@ -388,14 +393,21 @@ static bool isAssignableExternally(VarDecl *Property, SILModule *Module) {
 
 // Checks if a given property may have any unknown uses which cannot
 // be analyzed by this pass.
-static bool mayHaveUnknownUses(VarDecl *Property, SILModule *Module) {
+static bool mayHaveUnknownUses(
+    VarDecl *Property, SILModule *Module,
+    const llvm::SmallPtrSetImpl<ClassDecl *> &AnalyzableImportedClasses) {
   if (Property->getDeclContext()->getParentModule() !=
       Module->getSwiftModule()) {
+    // We don't see the bodies of initializers from a different module
+    // unless all of them are fragile. If all designated initializers of
+    // the class were deserialized, all assignments to this property are
+    // analyzable: only the class itself can initialize its let properties,
+    // neither subclasses nor extensions can do it.
+    auto *Class = dyn_cast<ClassDecl>(Property->getDeclContext());
+    if (Class && AnalyzableImportedClasses.count(Class))
+      return false;
     LLVM_DEBUG(llvm::dbgs() << "Property " << *Property
                             << " is defined in a different module\n");
-    // We don't see the bodies of initializers from a different module
-    // unless all of them are fragile.
-    // TODO: Support fragile initializers.
     return true;
   }
 
@@ -409,6 +421,53 @@ static bool mayHaveUnknownUses(VarDecl *Property, SILModule *Module) {
 }
 
 
+/// Try to deserialize all designated initializers of a class defined in
+/// another module, so that the assignments to its let properties become
+/// visible to this pass. Returns true on success.
+///
+/// Only convenience initializers may be skipped, because they have to
+/// delegate to a designated initializer and thus cannot assign let
+/// properties themselves.
+bool LetPropertiesOpt::deserializeClassInitializers(ClassDecl *Class) {
+  // A resilient class may add or change its initializers in a future
+  // version of its module.
+  if (Class->isResilient(Module->getSwiftModule(),
+                         ResilienceExpansion::Maximal))
+    return false;
+
+  // Initialization of Clang-imported and ObjC classes is not visible as SIL.
+  if (Class->hasClangNode() || Class->isObjC())
+    return false;
+
+  bool FoundDesignatedInit = false;
+  for (auto *Member : Class->lookupDirect(DeclBaseName::createConstructor())) {
+    auto *Ctor = dyn_cast<ConstructorDecl>(Member);
+    if (!Ctor)
+      continue;
+    if (Ctor->isConvenienceInit())
+      continue;
+    // A dynamically replaceable initializer may assign anything.
+    if (Ctor->isNativeDynamic())
+      return false;
+
+    // Deserialize the body of the initializer. This only succeeds if the
+    // initializer was serialized, i.e. if it is @inlinable or the module
+    // was compiled with cross-module optimization.
+    SILDeclRef InitRef(Ctor, SILDeclRef::Kind::Initializer);
+    SILFunction *InitF =
+        Module->findFunction(InitRef.mangle(), SILLinkage::PublicExternal);
+    if (!InitF)
+      return false;
+    if (InitF->isExternalDeclaration() && !Module->loadFunction(InitF))
+      return false;
+    if (!InitF->isDefinition())
+      return false;
+    FoundDesignatedInit = true;
+  }
+
+  return FoundDesignatedInit;
+}
+
 /// Check if a given property is a non-static let property
 /// with known constant value.
 bool LetPropertiesOpt::isConstantLetProperty(VarDecl *Property) {
@@ -428,7 +487,7 @@ bool LetPropertiesOpt::isConstantLetProperty(VarDecl *Property) {
   // Check the visibility of this property. If its visibility
   // implies that this optimization pass cannot analyze all uses,
   // don't process it.
-  if (mayHaveUnknownUses(Property, Module)) {
+  if (mayHaveUnknownUses(Property, Module, AnalyzableImportedClasses)) {
     LLVM_DEBUG(llvm::dbgs() << "Property '" << *Property
                             << "' may have unknown uses\n");
     SkipProcessing.insert(Property);
@@ -586,6 +645,28 @@ void LetPropertiesOpt::collectPropertyAccess(SingleValueInstruction *I,
 }
 
 void LetPropertiesOpt::run(SILModuleTransform *T) {
+  // First try to make the initializers of accessed imported classes
+  // analyzable by deserializing their designated initializers. The
+  // deserialized bodies are scanned for assignments by the main collection
+  // loop below like any other function, so let properties of such classes
+  // can be propagated across module boundaries.
+  llvm::SmallSetVector<ClassDecl *, 8> ImportedClasses;
+  for (auto &F : *Module) {
+    for (auto &BB : F) {
+      for (auto &I : BB) {
+        if (auto *REAI = dyn_cast<RefElementAddrInst>(&I)) {
+          auto *Class = REAI->getClassDecl();
+          if (Class->getParentModule() != Module->getSwiftModule())
+            ImportedClasses.insert(Class);
+        }
+      }
+    }
+  }
+  for (auto *Class : ImportedClasses) {
+    if (deserializeClassInitializers(Class))
+      AnalyzableImportedClasses.insert(Class);
+  }
+
   // Collect property access information for the whole module.
   for (auto &F : *Module) {
     // Take into account even those functions that should not be
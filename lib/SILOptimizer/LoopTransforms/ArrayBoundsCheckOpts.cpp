@@ -374,13 +374,15 @@ static bool removeRedundantChecksInBlock(SILBasicBlock &BB, ArraySet &Arrays,
   return Changed;
 }
 
-/// Walk down the dominator tree inside the loop, removing redundant checks.
+/// Walk down the dominator tree, removing redundant checks. If \p Loop is
+/// non-null, the walk stays inside the loop; otherwise the whole function is
+/// processed and \p ABC must have analyzed all blocks of the function.
 static bool removeRedundantChecks(DominanceInfoNode *CurBB,
                                   ABCAnalysis &ABC,
                                   IndexedArraySet &DominatingSafeChecks,
                                   SILLoop *Loop) {
   auto *BB = CurBB->getBlock();
-  if (!Loop->contains(BB))
+  if (Loop && !Loop->contains(BB))
     return false;
   bool Changed = false;
 
@@ -871,8 +873,22 @@ public:
     if (!ArrayIndexStruct)
       return nullptr;
 
-    auto AsArg =
-        dyn_cast<SILArgument>(ArrayIndexStruct->getElements()[0]);
+    SILValue IndexVal = ArrayIndexStruct->getElements()[0];
+
+    // Look through Int <-> Builtin round trips which inlining of closures
+    // leaves behind before sil-combine has a chance to clean them up:
+    //   %1 = struct $Int (%0 : $Builtin.Word)
+    //   ...
+    //   %5 = struct_extract %1 : $Int, #Int._value
+    //   %6 = struct $Int (%5 : $Builtin.Word)
+    while (auto *SEI = dyn_cast<StructExtractInst>(IndexVal)) {
+      auto *SI = dyn_cast<StructInst>(SEI->getOperand());
+      if (!SI || SI->getNumOperands() != 1)
+        break;
+      IndexVal = SI->getElements()[0];
+    }
+
+    auto AsArg = dyn_cast<SILArgument>(IndexVal);
     if (!AsArg)
       return nullptr;
 
@@ -1326,6 +1342,21 @@ public:
     for (auto &BB : *F)
       Changed |= removeRedundantChecksInBlock(BB, ReleaseSafeArrays, RCIA);
 
+    // Remove redundant checks along the dominator tree of the whole function.
+    // This catches dominated checks whose dominating check is in another
+    // block, e.g. after inlining of closures. It is safe to look across block
+    // boundaries here because the analysis covers all blocks: an array is
+    // only considered safe if its size is not changed anywhere in the
+    // function.
+    ABCAnalysis FunctionABC(true, ReleaseSafeArrays, RCIA);
+    for (auto &BB : *F)
+      FunctionABC.analyzeBlock(&BB);
+
+    IndexedArraySet DominatingSafeChecks;
+    Changed |= removeRedundantChecks(DT->getNode(F->getEntryBlock()),
+                                     FunctionABC, DominatingSafeChecks,
+                                     /*Loop=*/nullptr);
+
     if (ShouldReportBoundsChecks) { reportBoundsChecks(F); };
 
     bool ShouldVerify = getOptions().VerifyAll;
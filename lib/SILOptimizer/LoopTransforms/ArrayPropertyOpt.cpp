@@ -25,6 +25,15 @@
 /// Using this property we can hoist the predicate above a region where no such
 /// store can take place.
 ///
+/// Nothing in this transformation is specific to Array: any container struct
+/// whose operations carry the "array.props" semantics annotations and that
+/// honors the stability contract above (the property value only changes when
+/// a new container struct is stored over the variable) gets the same loop
+/// versioning treatment. This covers ContiguousArray, Dictionary and custom
+/// @_semantics-annotated containers alike; only containers without any
+/// reference-counted type parameter are skipped because they can never be
+/// non-native.
+///
 ///  func f(a : A[AClass]) {
 ///     for i in 0..a.count {
 ///       let b = a.props.isNative()
@@ -363,19 +372,23 @@ private:
     return false;
   }
 
-  bool isClassElementTypeArray(SILValue Arr) {
+  /// Check whether the container could be backed by a non-native buffer at
+  /// all. Only containers with at least one reference-counted type parameter
+  /// can be bridged; the array.props calls of a container of trivial elements
+  /// are constant-folded elsewhere so versioning the loop would only add
+  /// code. A non-generic container type that carries array.props semantics
+  /// decides for itself that its calls are worth hoisting.
+  bool mayBeBridgedContainer(SILValue Arr) {
     auto Ty = Arr->getType();
     if (auto BGT = Ty.getAs<BoundGenericStructType>()) {
-      // Check the array element type parameter.
-      bool isClass = false;
+      // Check the container's type parameters.
       for (auto EltTy : BGT->getGenericArgs()) {
-        if (!EltTy->hasReferenceSemantics())
-          return false;
-        isClass = true;
+        if (EltTy->hasReferenceSemantics())
+          return true;
       }
-      return isClass;
+      return false;
     }
-    return false;
+    return Ty.getStructOrBoundGenericStruct() != nullptr;
   }
 
   bool canHoistArrayPropsInst(ArraySemanticsCall Call) {
@@ -386,8 +399,9 @@ private:
 
     SILValue Arr = Call.getSelf();
 
-    // We don't attempt to hoist non-class element type arrays.
-    if (!isClassElementTypeArray(Arr))
+    // We don't attempt to hoist calls on containers that can never be
+    // non-native.
+    if (!mayBeBridgedContainer(Arr))
       return false;
 
     // We can strip the load that might even occur in the loop because we make
@@ -833,6 +833,7 @@ void LoopTreeOptimization::analyzeCurrentLoop(
   SmallVector<StoreInst *, 8> Stores;
   SmallVector<FixLifetimeInst *, 8> FixLifetimes;
   SmallVector<BeginAccessInst *, 8> BeginAccesses;
+  SmallVector<IsUniqueInst *, 8> UniquenessChecks;
   SmallVector<FullApplySite, 8> fullApplies;
 
   for (auto *BB : Loop->getBlocks()) {
@@ -863,6 +864,10 @@ void LoopTreeOptimization::analyzeCurrentLoop(
       case SILInstructionKind::RefElementAddrInst:
         SpecialHoist.push_back(cast<RefElementAddrInst>(&Inst));
         break;
+      case SILInstructionKind::IsUniqueInst:
+        UniquenessChecks.push_back(cast<IsUniqueInst>(&Inst));
+        checkSideEffects(Inst, sideEffects, sideEffectsInBlock);
+        break;
       case swift::SILInstructionKind::CondFailInst:
         // We can (and must) hoist cond_fail instructions if the operand is
         // invariant. We must hoist them so that we preserve memory safety. A
@@ -912,6 +917,34 @@ void LoopTreeOptimization::analyzeCurrentLoop(
     }
   }
 
+  // A uniqueness check, e.g. of a COW buffer mutated in the loop, can be
+  // hoisted if its result cannot change between iterations. That is the
+  // case if nothing in the loop may write to the checked address and
+  // nothing may change the reference count of the checked object: no
+  // side-effect instruction other than raw stores, other uniqueness
+  // checks, exclusivity markers, cond_fails and applies that neither
+  // write nor retain nor release.
+  if (!UniquenessChecks.empty()) {
+    bool refCountsInvariant =
+        std::all_of(sideEffects.begin(), sideEffects.end(),
+                    [&](SILInstruction *I) {
+          if (isa<StoreInst>(I) || isa<IsUniqueInst>(I) ||
+              isa<CondFailInst>(I) || isa<BeginAccessInst>(I) ||
+              isa<EndAccessInst>(I))
+            return true;
+          if (auto *AI = dyn_cast<ApplyInst>(I))
+            return isSafeReadOnlyApply(SEA, AI);
+          return false;
+        });
+    if (refCountsInvariant) {
+      for (auto *UC : UniquenessChecks) {
+        if (!mayWriteTo(AA, sideEffects, UC)) {
+          HoistUp.insert(UC);
+        }
+      }
+    }
+  }
+
   if (!globalInitCalls.empty()) {
     if (!postDomTree) {
       postDomTree = PDA->get(Preheader->getParent());
@@ -14,6 +14,7 @@
 
 #include "swift/SILOptimizer/PassManager/PassManager.h"
 #include "swift/AST/SILOptimizerRequests.h"
+#include "swift/Basic/Statistic.h"
 #include "swift/Demangling/Demangle.h"
 #include "swift/SIL/ApplySite.h"
 #include "swift/SIL/SILFunction.h"
@@ -46,6 +47,14 @@ llvm::cl::opt<bool> SILPrintPassTime(
     "sil-print-pass-time", llvm::cl::init(false),
     llvm::cl::desc("Print the execution time of each SIL pass"));
 
+/// Tooling callback collecting the execution time of each executed transform.
+static std::function<void(SILTransform *, int64_t)> PassExecutionTimeCallback;
+
+void swift::setSILPassExecutionTimeCallback(
+    std::function<void(SILTransform *, int64_t)> callback) {
+  PassExecutionTimeCallback = std::move(callback);
+}
+
 llvm::cl::opt<unsigned> SILNumOptPassesToRun(
     "sil-opt-pass-count", llvm::cl::init(UINT_MAX),
     llvm::cl::desc("Stop optimizing after <N> optimization passes"));
@@ -115,6 +124,13 @@ llvm::cl::opt<bool> SILVerifyWithoutInvalidation(
     "sil-verify-without-invalidation", llvm::cl::init(false),
     llvm::cl::desc("Verify after passes even if the pass has not invalidated"));
 
+llvm::cl::opt<bool> SILVerifyIncrementally(
+    "sil-verify-incrementally", llvm::cl::init(false),
+    llvm::cl::desc("With -sil-verify-all, skip re-verifying the bodies of "
+                   "functions whose structural hash is unchanged since they "
+                   "last verified. Changes which don't affect the body (e.g. "
+                   "linkage) are not covered by the hash"));
+
 llvm::cl::opt<bool> SILDisableSkippingPasses(
     "sil-disable-skipping-passes", llvm::cl::init(false),
     llvm::cl::desc("Do not skip passes even if nothing was changed"));
@@ -391,6 +407,24 @@ bool SILPassManager::isMandatoryFunctionPass(SILFunctionTransform *sft) {
              PassKind::NonStdlibNonTransparentFunctionOwnershipModelEliminator;
 }
 
+/// Computes a structural fingerprint of the body of \p F.
+///
+/// The hash covers the block structure, the instruction kinds and the
+/// identity of all operands. Two identical hashes mean that a pass did not
+/// modify the function, even if it conservatively reported an invalidation.
+static llvm::hash_code computeStructuralHash(SILFunction *F) {
+  llvm::hash_code hash = llvm::hash_value(F->size());
+  for (SILBasicBlock &BB : *F) {
+    hash = llvm::hash_combine(hash, BB.getNumArguments());
+    for (SILInstruction &I : BB) {
+      hash = llvm::hash_combine(hash, unsigned(I.getKind()));
+      for (Operand &Op : I.getAllOperands())
+        hash = llvm::hash_combine(hash, Op.get().getOpaqueValue());
+    }
+  }
+  return hash;
+}
+
 void SILPassManager::runPassOnFunction(unsigned TransIdx, SILFunction *F) {
 
   assert(analysesUnlocked() && "Expected all analyses to be unlocked!");
@@ -428,6 +462,22 @@ void SILPassManager::runPassOnFunction(unsigned TransIdx, SILFunction *F) {
 
   CurrentPassHasInvalidated = false;
 
+  // Fingerprint the body so that we can detect after the run whether a
+  // reported invalidation actually modified the function. The fingerprint
+  // is cached across pass runs; it only has to be recomputed after a pass
+  // which did modify the function.
+  llvm::Optional<llvm::hash_code> HashBeforeRun;
+  CompletedPasses CompletedPassesBeforeRun = completedPasses;
+  if (!SILDisableSkippingPasses) {
+    auto HashIter = StructuralHashes.find(F);
+    if (HashIter != StructuralHashes.end()) {
+      HashBeforeRun = HashIter->second;
+    } else {
+      HashBeforeRun = computeStructuralHash(F);
+      StructuralHashes[F] = *HashBeforeRun;
+    }
+  }
+
   auto MatchFun = [&](const std::string &Str) -> bool {
     return SFT->getTag().find(Str) != StringRef::npos ||
            SFT->getID().find(Str) != StringRef::npos;
@@ -460,7 +510,10 @@ void SILPassManager::runPassOnFunction(unsigned TransIdx, SILFunction *F) {
                        SILForceVerifyAroundPass.end(), MatchFun)) {
     forcePrecomputeAnalyses(F);
   }
-  SFT->run();
+  {
+    FrontendStatsTracer tracer(Mod->getASTContext().Stats, SFT->getID(), F);
+    SFT->run();
+  }
   if (SILForceVerifyAll ||
       SILForceVerifyAroundPass.end() !=
           std::find_if(SILForceVerifyAroundPass.begin(),
@@ -475,6 +528,8 @@ void SILPassManager::runPassOnFunction(unsigned TransIdx, SILFunction *F) {
     llvm::dbgs() << Delta << " (" << SFT->getID() << "," << F->getName()
                  << ")\n";
   }
+  if (PassExecutionTimeCallback)
+    PassExecutionTimeCallback(SFT, Delta);
 
   // If this pass invalidated anything, print and verify.
   if (doPrintAfter(SFT, F, CurrentPassHasInvalidated && SILPrintAll)) {
@@ -486,13 +541,29 @@ void SILPassManager::runPassOnFunction(unsigned TransIdx, SILFunction *F) {
                                      Delta);
 
   // Remember if this pass didn't change anything.
-  if (!CurrentPassHasInvalidated)
-    completedPasses.set((size_t)SFT->getPassKind());
+  // Note: Don't use the completedPasses reference from above. The pass may
+  // have registered new functions in the map, which can reallocate it.
+  if (!CurrentPassHasInvalidated) {
+    CompletedPassesMap[F].set((size_t)SFT->getPassKind());
+  } else if (HashBeforeRun) {
+    // The pass reported an invalidation. If the fingerprint of the body is
+    // unchanged, the invalidation was conservative and we can restore the
+    // completed-passes mask so that the remaining passes of the pipeline
+    // can still be skipped for this function.
+    llvm::hash_code HashAfterRun = computeStructuralHash(F);
+    if (*HashBeforeRun == HashAfterRun) {
+      CompletedPassesBeforeRun.set((size_t)SFT->getPassKind());
+      CompletedPassesMap[F] = CompletedPassesBeforeRun;
+    }
+    StructuralHashes[F] = HashAfterRun;
+  }
 
   if (getOptions().VerifyAll &&
       (CurrentPassHasInvalidated || SILVerifyWithoutInvalidation)) {
     F->verify();
     verifyAnalyses(F);
+    if (SILVerifyIncrementally)
+      VerifiedFunctionHashes[F] = computeStructuralHash(F);
   } else {
     if ((SILVerifyAfterPass.end() != std::find_if(SILVerifyAfterPass.begin(),
                                                   SILVerifyAfterPass.end(),
@@ -508,14 +579,30 @@ void SILPassManager::runPassOnFunction(unsigned TransIdx, SILFunction *F) {
   ++NumPassesRun;
 }
 
+ArrayRef<SILFunction *> SILPassManager::getBottomUpFunctionOrder() {
+  // Reuse the order computed for a previous function-pass segment if no
+  // pass in between reported a change which can affect the call graph.
+  // Functions which are added by deserialization bypass the pass manager's
+  // notifications, so also compare the function count of the module.
+  if (BottomUpOrderCacheValid &&
+      BottomUpOrderFunctionCount == Mod->getFunctionList().size())
+    return BottomUpOrderCache;
+
+  BasicCalleeAnalysis *BCA = getAnalysis<BasicCalleeAnalysis>();
+  BottomUpFunctionOrder BottomUpOrder(*Mod, BCA);
+  auto Functions = BottomUpOrder.getFunctions();
+  BottomUpOrderCache.assign(Functions.begin(), Functions.end());
+  BottomUpOrderFunctionCount = Mod->getFunctionList().size();
+  BottomUpOrderCacheValid = true;
+  return BottomUpOrderCache;
+}
+
 void SILPassManager::
 runFunctionPasses(unsigned FromTransIdx, unsigned ToTransIdx) {
   if (ToTransIdx <= FromTransIdx)
     return;
 
-  BasicCalleeAnalysis *BCA = getAnalysis<BasicCalleeAnalysis>();
-  BottomUpFunctionOrder BottomUpOrder(*Mod, BCA);
-  auto BottomUpFunctions = BottomUpOrder.getFunctions();
+  auto BottomUpFunctions = getBottomUpFunctionOrder();
 
   assert(FunctionWorklist.empty() && "Expected empty function worklist!");
 
@@ -613,7 +700,10 @@ void SILPassManager::runModulePass(unsigned TransIdx) {
   llvm::sys::TimePoint<> StartTime = std::chrono::system_clock::now();
   assert(analysesUnlocked() && "Expected all analyses to be unlocked!");
   Mod->registerDeleteNotificationHandler(SMT);
-  SMT->run();
+  {
+    FrontendStatsTracer tracer(Mod->getASTContext().Stats, SMT->getID());
+    SMT->run();
+  }
   Mod->removeDeleteNotificationHandler(SMT);
   assert(analysesUnlocked() && "Expected all analyses to be unlocked!");
 
@@ -621,6 +711,8 @@ void SILPassManager::runModulePass(unsigned TransIdx) {
   if (SILPrintPassTime) {
     llvm::dbgs() << Delta << " (" << SMT->getID() << ",Module)\n";
   }
+  if (PassExecutionTimeCallback)
+    PassExecutionTimeCallback(SMT, Delta);
 
   // If this pass invalidated anything, print and verify.
   if (doPrintAfter(SMT, nullptr,
@@ -633,7 +725,21 @@ void SILPassManager::runModulePass(unsigned TransIdx) {
 
   if (Options.VerifyAll &&
       (CurrentPassHasInvalidated || !SILVerifyWithoutInvalidation)) {
-    Mod->verify();
+    if (SILVerifyIncrementally) {
+      // Skip the bodies of functions which have not changed since they last
+      // passed the verifier. Module-level structures are always checked.
+      Mod->verify([&](const SILFunction &F) {
+        auto *MutF = const_cast<SILFunction *>(&F);
+        auto Hash = computeStructuralHash(MutF);
+        auto It = VerifiedFunctionHashes.find(MutF);
+        if (It != VerifiedFunctionHashes.end() && It->second == Hash)
+          return false;
+        VerifiedFunctionHashes[MutF] = Hash;
+        return true;
+      });
+    } else {
+      Mod->verify();
+    }
     verifyAnalyses();
   } else {
     if ((SILVerifyAfterPass.end() != std::find_if(SILVerifyAfterPass.begin(),
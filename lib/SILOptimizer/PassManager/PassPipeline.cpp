@@ -684,9 +684,18 @@ static void addLastChanceOptPassPipeline(SILPassPipelinePlan &P) {
   P.addAccessPathVerification();
 #endif
 
+  // Refcounting on objects that never escape their allocating function can
+  // skip the atomic RMW. Run after all RC motion and elimination is done, so
+  // the attribute lands on the operations that actually survive to IRGen.
+  P.addNonAtomicRC();
+
   // Only has an effect if the -assume-single-thread option is specified.
   P.addAssumeSingleThreaded();
 
+  // Annotate statically cold branches so that IRGen emits branch weights
+  // and LLVM lays out the cold paths out of line.
+  P.addColdBlockWeights();
+
   // Only has an effect if opt-remark is enabled.
   P.addOptRemarkGenerator();
 
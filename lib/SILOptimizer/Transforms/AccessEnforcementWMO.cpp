@@ -40,6 +40,12 @@
 /// global variable access that still have not seen any nested conflicts by
 /// giving them static enforcement.
 ///
+/// Externally visible variables normally end the analysis, because other
+/// modules may access them without this pass seeing it. A resilient global or
+/// static variable is the exception: clients can only reach its storage
+/// through accessors defined in this module, so all of its direct accesses are
+/// visible here and it can be optimized like an internal variable.
+///
 /// Warning: This is only sound when unidentified accesses can never alias with
 /// Class/Global access. To enforce this, the SILVerifier calls
 /// identifyFormalAccess() for every access, which asserts that any Unidentified
@@ -55,6 +61,7 @@
 
 #define DEBUG_TYPE "access-enforcement-wmo"
 
+#include "swift/AST/DeclContext.h"
 #include "swift/SIL/DebugUtils.h"
 #include "swift/SIL/MemAccessUtils.h"
 #include "swift/SIL/SILFunction.h"
@@ -95,6 +102,18 @@ getDisjointAccessLocation(AccessedStorageWithBase storageAndBase) {
   llvm_unreachable("unhandled kind");
 }
 
+// Check whether all formal accesses of the given externally visible storage
+// are nonetheless confined to this module. With library evolution enabled, a
+// resilient global or static variable can only be accessed from outside its
+// defining module through its accessors; inlinable functions are emitted
+// against the minimal resilience expansion and also go through the accessors.
+// Every direct access to the storage is therefore visible to this
+// whole-module analysis.
+static bool isEnforcementConfinedToModule(const VarDecl *decl,
+                                          AccessedStorage::Kind storageKind) {
+  return storageKind == AccessedStorage::Global && decl->isResilient();
+}
+
 namespace {
 // Implements an optimization to remove access markers on disjoint memory
 // locations that are never reentrantly accessed. For a given memory location,
@@ -220,9 +239,32 @@ void GlobalAccessRemoval::recordAccess(SILInstruction *beginAccess,
                                        const VarDecl *decl,
                                        AccessedStorage::Kind storageKind,
                                        bool hasNoNestedConflict) {
-  if (!decl || module.isVisibleExternally(decl))
+  if (!decl)
     return;
 
+  if (module.isVisibleExternally(decl)) {
+    if (!isEnforcementConfinedToModule(decl, storageKind))
+      return;
+
+    // Serialized SIL may be inlined into other modules, where its direct
+    // accesses are no longer visible to this analysis. Keep dynamic
+    // enforcement on this location rather than optimizing it. The
+    // [serialized] flag alone is not a reliable indicator here: the
+    // serialized snapshot of the module has already been taken, and the flag
+    // stripped, by the time this pass runs. Ask the AST whether the
+    // function's body is emitted into clients (@inlinable, @_transparent,
+    // @_alwaysEmitIntoClient, and friends).
+    SILFunction *accessFunc = beginAccess->getFunction();
+    bool mayBeInlinedIntoClients = accessFunc->isSerialized();
+    if (!mayBeInlinedIntoClients) {
+      if (auto *funcCtx = accessFunc->getDeclContext())
+        mayBeInlinedIntoClients = funcCtx->getFragileFunctionKind().kind
+                                  != FragileFunctionKind::None;
+    }
+    if (mayBeInlinedIntoClients)
+      hasNoNestedConflict = false;
+  }
+
   LLVM_DEBUG(if (!hasNoNestedConflict) llvm::dbgs()
              << "Nested conflict on " << decl->getName() << " at"
              << *beginAccess << "\n");
@@ -259,7 +301,8 @@ void GlobalAccessRemoval::removeNonreentrantAccess() {
     const VarDecl *decl = declAndInfo.first;
     LLVM_DEBUG(llvm::dbgs() << "Eliminating all formal access on "
                             << decl->getName() << "\n");
-    assert(!module.isVisibleExternally(decl));
+    assert(!module.isVisibleExternally(decl) ||
+           isEnforcementConfinedToModule(decl, info.accessKind));
     (void)decl;
 
     // Non-deterministic iteration, only used to set a flag.
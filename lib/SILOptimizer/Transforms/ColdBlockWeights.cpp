@@ -0,0 +1,86 @@
+//===--- ColdBlockWeights.cpp - Annotate cold branches --------------------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2021 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+//
+// Annotate conditional branches whose targets are statically known to be
+// cold - e.g. slow paths ending in a fatal error, or branches hinted by
+// Builtin.expect - with profile counters. IRGen lowers the counters to
+// branch weight metadata, which lets LLVM lay out cold blocks out of the
+// hot path instead of interleaving error handling with it.
+//
+// Branches that already carry real profile counters are left untouched, so
+// profile data always overrides the static heuristics.
+//
+//===----------------------------------------------------------------------===//
+
+#define DEBUG_TYPE "cold-block-weights"
+
+#include "swift/SIL/SILBuilder.h"
+#include "swift/SIL/SILFunction.h"
+#include "swift/SILOptimizer/Analysis/ColdBlockInfo.h"
+#include "swift/SILOptimizer/Analysis/DominanceAnalysis.h"
+#include "swift/SILOptimizer/PassManager/Passes.h"
+#include "swift/SILOptimizer/PassManager/Transforms.h"
+#include "llvm/Support/Debug.h"
+
+using namespace swift;
+
+namespace {
+
+/// The weights given to the hot and the cold successor of an annotated
+/// branch. The ratio matches what Clang uses for __builtin_expect.
+enum : uint64_t {
+  HotBranchWeight = 2000,
+  ColdBranchWeight = 1
+};
+
+class ColdBlockWeights : public SILFunctionTransform {
+  void run() override {
+    SILFunction *F = getFunction();
+    auto *DA = PM->getAnalysis<DominanceAnalysis>();
+    ColdBlockInfo ColdBlocks(DA);
+
+    bool Changed = false;
+    for (SILBasicBlock &BB : *F) {
+      auto *CBI = dyn_cast<CondBranchInst>(BB.getTerminator());
+      if (!CBI)
+        continue;
+
+      // Don't override real profile data.
+      if (CBI->getTrueBBCount() || CBI->getFalseBBCount())
+        continue;
+
+      bool TrueIsCold = ColdBlocks.isCold(CBI->getTrueBB());
+      bool FalseIsCold = ColdBlocks.isCold(CBI->getFalseBB());
+      if (TrueIsCold == FalseIsCold)
+        continue;
+
+      SILBuilderWithScope Builder(CBI);
+      Builder.createCondBranch(
+          CBI->getLoc(), CBI->getCondition(), CBI->getTrueBB(),
+          CBI->getTrueArgs(), CBI->getFalseBB(), CBI->getFalseArgs(),
+          ProfileCounter(TrueIsCold ? ColdBranchWeight : HotBranchWeight),
+          ProfileCounter(FalseIsCold ? ColdBranchWeight : HotBranchWeight));
+      CBI->eraseFromParent();
+      Changed = true;
+    }
+
+    if (Changed) {
+      invalidateAnalysis(SILAnalysis::InvalidationKind::Instructions);
+    }
+  }
+};
+
+} // end anonymous namespace
+
+SILTransform *swift::createColdBlockWeights() {
+  return new ColdBlockWeights();
+}
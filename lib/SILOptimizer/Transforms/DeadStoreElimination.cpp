@@ -356,6 +356,13 @@ private:
   /// has an upward visible store.
   std::vector<LSLocation> LocationVault;
 
+  /// The number of locations, i.e. a prefix of the LocationVault, the data
+  /// flow actually tracks. For most functions this is all of them. On large
+  /// functions tracking every location is too expensive, so the data flow is
+  /// restricted to as many locations as the budget allows; stores to the
+  /// remaining locations are conservatively considered live.
+  unsigned TrackedLocationNum = 0;
+
   /// Keeps a list of basic blocks that have StoreInsts. If a basic block does
   /// not have StoreInst, we do not actually perform the last iteration where
   /// DSE is actually performed on the basic block.
@@ -445,6 +452,12 @@ private:
   /// Get the bit representing the location in the LocationVault.
   unsigned getLocationBit(const LSLocation &L);
 
+  /// Reorder the LocationVault so that locations used as store destinations
+  /// come first and rebuild the location to bit mapping. When only a prefix
+  /// of the locations can be tracked, this spends the budget on the locations
+  /// whose stores can actually be eliminated.
+  void prioritizeStoredLocations();
+
 public:
   /// Constructor.
   DSEContext(SILFunction *F, SILModule *M, SILPassManager *PM,
@@ -552,6 +565,46 @@ unsigned DSEContext::getLocationBit(const LSLocation &Loc) {
   return Iter->second;
 }
 
+void DSEContext::prioritizeStoredLocations() {
+  // Find the locations that are used as store destinations. Every store
+  // destination with a valid location has been recorded in BaseToLocIndex
+  // during location enumeration.
+  llvm::DenseSet<unsigned> StoredBits;
+  for (auto &B : *F) {
+    for (auto &I : B) {
+      auto *SI = dyn_cast<StoreInst>(&I);
+      if (!SI)
+        continue;
+      auto Iter = BaseToLocIndex.find(SI->getDest());
+      if (Iter == BaseToLocIndex.end())
+        continue;
+      LSLocationList Locs;
+      LSLocation::expand(Iter->second, Mod, TypeExpansionContext(*F), Locs,
+                         TE);
+      for (auto &E : Locs)
+        StoredBits.insert(getLocationBit(E));
+    }
+  }
+
+  // Move the stored-to locations to the front of the vault so that they fall
+  // within the tracked prefix and rebuild the location to bit mapping.
+  std::vector<LSLocation> Reordered;
+  Reordered.reserve(LocationVault.size());
+  for (auto &L : LocationVault) {
+    if (StoredBits.count(getLocationBit(L)))
+      Reordered.push_back(L);
+  }
+  for (auto &L : LocationVault) {
+    if (!StoredBits.count(getLocationBit(L)))
+      Reordered.push_back(L);
+  }
+  LocationVault = std::move(Reordered);
+  LocToBitIndex.clear();
+  for (unsigned i = 0; i < LocationVault.size(); ++i) {
+    LocToBitIndex[LocationVault[i]] = i;
+  }
+}
+
 DSEContext::ProcessKind DSEContext::getProcessFunctionKind(unsigned StoreCount) {
   // Don't optimize function that are marked as 'no.optimize'.
   if (!F->shouldOptimize())
@@ -582,17 +635,26 @@ DSEContext::ProcessKind DSEContext::getProcessFunctionKind(unsigned StoreCount)
     HandledBBs.insert(B);
   }
 
-  // Data flow may take too long to run.
-  if (BBCount * LocationCount > MaxLSLocationBBMultiplicationNone)
-    return ProcessKind::ProcessNone;
+  // Data flow may take too long to run if every location is tracked. Instead
+  // of giving up on the function wholesale, restrict the data flow to as many
+  // locations as the budget allows and give priority to the locations that
+  // are actually stored to. Stores to the remaining locations are simply
+  // never considered dead.
+  TrackedLocationNum = LocationCount;
+  if (BBCount * LocationCount > MaxLSLocationBBMultiplicationNone) {
+    TrackedLocationNum = MaxLSLocationBBMultiplicationNone / BBCount;
+    if (TrackedLocationNum == 0)
+      return ProcessKind::ProcessNone;
+    prioritizeStoredLocations();
+  }
 
   // This function's data flow would converge in 1 iteration.
   if (RunOneIteration)
     return ProcessKind::ProcessPessimistic;
-  
+
   // We run one pessimistic data flow to do dead store elimination on
   // the function.
-  if (BBCount * LocationCount > MaxLSLocationBBMultiplicationPessimistic)
+  if (BBCount * TrackedLocationNum > MaxLSLocationBBMultiplicationPessimistic)
     return ProcessKind::ProcessPessimistic;
 
   return ProcessKind::ProcessOptimistic;
@@ -690,8 +752,8 @@ void DSEContext::processBasicBlockForDSE(SILBasicBlock *BB, bool Optimistic) {
 void BlockState::initStoreSetAtEndOfBlock(DSEContext &Ctx) {
   std::vector<LSLocation> &LocationVault = Ctx.getLocationVault();
   // We set the store bit at the end of the basic block in which a stack
-  // allocated location is deallocated.
-  for (unsigned i = 0; i < LocationVault.size(); ++i) {
+  // allocated location is deallocated. Only tracked locations have a bit.
+  for (unsigned i = 0; i < LocationNum; ++i) {
     // Turn on the store bit at the block which the stack slot is deallocated.
     if (auto *ASI = dyn_cast<AllocStackInst>(LocationVault[i].getBase())) {
       for (auto X : findDeallocStackInst(ASI)) {
@@ -949,8 +1011,11 @@ void DSEContext::processWrite(SILInstruction *I, SILValue Val, SILValue Mem,
   // Are we computing max store set.
   if (isComputeMaxStoreSet(Kind)) {
     for (auto &E : Locs) {
-      // Update the max store set for the basic block.
-      processWriteForMaxStoreSet(S, getLocationBit(E));
+      // Update the max store set for the basic block. Locations beyond the
+      // tracked prefix are outside of the analysis budget.
+      unsigned bit = getLocationBit(E);
+      if (bit < TrackedLocationNum)
+        processWriteForMaxStoreSet(S, bit);
     }
     return;
   }
@@ -959,7 +1024,9 @@ void DSEContext::processWrite(SILInstruction *I, SILValue Val, SILValue Mem,
   if (isBuildingGenKillSet(Kind)) {
     for (auto &E : Locs) {
       // Only building the gen and kill sets here.
-      processWriteForGenKillSet(S, getLocationBit(E));
+      unsigned bit = getLocationBit(E);
+      if (bit < TrackedLocationNum)
+        processWriteForGenKillSet(S, bit);
     }
     // Data flow has not stabilized, do not perform the DSE just yet.
     return;
@@ -970,8 +1037,10 @@ void DSEContext::processWrite(SILInstruction *I, SILValue Val, SILValue Mem,
   unsigned idx = 0;
   for (auto &E : Locs) {
     // This is the last iteration, compute BBWriteSetOut and perform the dead
-    // store elimination.
-    if (processWriteForDSE(S, getLocationBit(E)))
+    // store elimination. A store to an untracked location is conservatively
+    // considered live.
+    unsigned bit = getLocationBit(E);
+    if (bit < TrackedLocationNum && processWriteForDSE(S, bit))
       V.set(idx);
     Dead &= V.test(idx);
     ++idx;
@@ -1207,10 +1276,11 @@ bool DSEContext::run() {
 
   // For all basic blocks in the function, initialize a BB state.
   //
-  // Initialize the BBToLocState mapping.
-  unsigned LocationNum = this->getLocationVault().size();
+  // Initialize the BBToLocState mapping. The bitvectors only cover the
+  // tracked prefix of the LocationVault.
   for (auto &B : *F) {
-    auto *State = new (BPA.Allocate()) BlockState(&B, LocationNum, Optimistic);
+    auto *State =
+        new (BPA.Allocate()) BlockState(&B, TrackedLocationNum, Optimistic);
     BBToLocState[&B] = State;
     State->initStoreSetAtEndOfBlock(*this);
   }
@@ -32,14 +32,20 @@
 
 #define DEBUG_TYPE "eager-specializer"
 
+#include "swift/AST/ASTContext.h"
+#include "swift/AST/ASTDemangler.h"
 #include "swift/AST/GenericEnvironment.h"
 #include "swift/AST/Type.h"
+#include "swift/AST/TypeCheckRequests.h"
 #include "swift/SIL/SILFunction.h"
 #include "swift/SILOptimizer/PassManager/Transforms.h"
 #include "swift/SILOptimizer/Utils/CFGOptUtils.h"
 #include "swift/SILOptimizer/Utils/Generics.h"
 #include "swift/SILOptimizer/Utils/SILOptFunctionBuilder.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/ADT/StringSet.h"
 #include "llvm/Support/Debug.h"
+#include "llvm/Support/MemoryBuffer.h"
 
 using namespace swift;
 
@@ -48,6 +54,153 @@ llvm::cl::opt<bool> EagerSpecializeFlag(
     "enable-eager-specializer", llvm::cl::init(true),
     llvm::cl::desc("Run the eager-specializer pass."));
 
+llvm::cl::opt<std::string> EagerSpecializeManifestFileName(
+    "eager-specialize-manifest", llvm::cl::init(""),
+    llvm::cl::desc("Path to a file listing additional specializations to "
+                   "create: one generic function name per line, followed by "
+                   "one mangled type name per generic parameter."));
+
+//===----------------------------------------------------------------------===//
+//                         Specialization Manifests
+//===----------------------------------------------------------------------===//
+
+namespace {
+
+/// The concrete generic arguments of one specialization requested by an
+/// external manifest, as mangled type names.
+using ManifestSpecialization = SmallVector<std::string, 2>;
+
+/// Maps a function name to the specializations requested for it.
+using SpecializationManifest =
+    llvm::StringMap<std::vector<ManifestSpecialization>>;
+
+} // end anonymous namespace
+
+/// Parse the manifest file passed with -eager-specialize-manifest.
+///
+/// The format is line based. Each non-empty line that does not start with '#'
+/// names a generic function followed by one mangled type name per generic
+/// parameter, separated by whitespace, e.g.
+///
+///   $s4test3fooyxxlF Si
+///
+/// requests foo<Int>. Such manifests are typically generated from production
+/// profiles, so that hot generic instantiations can be specialized without
+/// annotating the source. Returns nullptr if no manifest was given.
+static const SpecializationManifest *getSpecializationManifest() {
+  if (EagerSpecializeManifestFileName.empty())
+    return nullptr;
+
+  static llvm::Optional<SpecializationManifest> Manifest;
+  if (Manifest)
+    return Manifest.getPointer();
+
+  Manifest.emplace();
+  auto FileOrErr = llvm::MemoryBuffer::getFile(EagerSpecializeManifestFileName);
+  if (!FileOrErr) {
+    llvm::errs() << "warning: cannot read specialization manifest '"
+                 << EagerSpecializeManifestFileName
+                 << "': " << FileOrErr.getError().message() << '\n';
+    return Manifest.getPointer();
+  }
+
+  SmallVector<StringRef, 32> Lines;
+  (*FileOrErr)->getBuffer().split(Lines, '\n');
+  for (StringRef Line : Lines) {
+    Line = Line.trim();
+    if (Line.empty() || Line.startswith("#"))
+      continue;
+    SmallVector<StringRef, 4> Tokens;
+    llvm::SplitString(Line, Tokens, " \t");
+    if (Tokens.size() < 2) {
+      llvm::errs() << "warning: ignoring malformed specialization manifest "
+                      "line: " << Line << '\n';
+      continue;
+    }
+    ManifestSpecialization MS;
+    for (StringRef Tok : ArrayRef<StringRef>(Tokens).drop_front())
+      MS.push_back(Tok.str());
+    (*Manifest)[Tokens.front()].push_back(std::move(MS));
+  }
+  return Manifest.getPointer();
+}
+
+/// Create non-exported specialize attributes on \p F for the specializations
+/// the manifest requests for it. The attributes then drive the same
+/// specialization and dispatch machinery as source-level @_specialize.
+static void addManifestSpecializeAttrs(SILFunction &F) {
+  const SpecializationManifest *Manifest = getSpecializationManifest();
+  if (!Manifest)
+    return;
+  auto Entry = Manifest->find(F.getName());
+  if (Entry == Manifest->end())
+    return;
+
+  // The synthesized attributes are consumed below like parsed ones; don't
+  // add them a second time if the pass visits the function again after a
+  // pipeline restart.
+  static llvm::StringSet<> ProcessedFunctions;
+  if (!ProcessedFunctions.insert(F.getName()).second)
+    return;
+
+  auto GenericSig =
+      F.getLoweredFunctionType()->getInvocationGenericSignature();
+  auto &Ctx = F.getModule().getASTContext();
+  auto Params = GenericSig->getGenericParams();
+
+  for (const ManifestSpecialization &MS : Entry->second) {
+    if (MS.size() != Params.size()) {
+      llvm::errs() << "warning: specialization manifest entry for "
+                   << F.getName() << " lists " << MS.size()
+                   << " generic arguments, expected " << Params.size()
+                   << '\n';
+      continue;
+    }
+
+    // Pin every generic parameter to the concrete type from the manifest.
+    SmallVector<Requirement, 2> Requirements;
+    bool Valid = true;
+    for (unsigned i = 0, e = Params.size(); i < e; ++i) {
+      // The manifest carries bare type manglings (e.g. "Si" or "s5Int64V"),
+      // the same form that appears in specialized symbol names; wrap them
+      // into the symbol form the demangler expects.
+      std::string SymbolMangling = ("$s" + StringRef(MS[i]) + "D").str();
+      Type ConcreteTy = Demangle::getTypeForMangling(Ctx, SymbolMangling);
+      if (!ConcreteTy || ConcreteTy->hasTypeParameter() ||
+          ConcreteTy->hasArchetype()) {
+        llvm::errs() << "warning: cannot resolve type '" << MS[i]
+                     << "' in specialization manifest entry for "
+                     << F.getName() << '\n';
+        Valid = false;
+        break;
+      }
+      Requirements.push_back(
+          Requirement(RequirementKind::SameType, Params[i], ConcreteTy));
+    }
+    if (!Valid)
+      continue;
+
+    auto SpecializedSig = evaluateOrDefault(
+        Ctx.evaluator,
+        AbstractGenericSignatureRequest{GenericSig.getPointer(),
+                                        /*addedParameters=*/{},
+                                        std::move(Requirements)},
+        GenericSignature());
+    if (!SpecializedSig) {
+      llvm::errs() << "warning: cannot form a specialized signature for the "
+                      "specialization manifest entry for "
+                   << F.getName() << '\n';
+      continue;
+    }
+
+    F.addSpecializeAttr(SILSpecializeAttr::create(
+        F.getModule(), SpecializedSig, /*exported=*/false,
+        SILSpecializeAttr::SpecializationKind::Full,
+        /*target=*/nullptr, Identifier(),
+        /*spiModule=*/nullptr));
+  }
+}
+
 static void
 cleanupCallArguments(SILBuilder &builder, SILLocation loc,
                      ArrayRef<SILValue> values,
@@ -822,6 +975,11 @@ void EagerSpecializerTransform::run() {
   if (!F.getLoweredFunctionType()->getInvocationGenericSignature())
     return;
 
+  // Synthesize specialize attributes for any specializations an external
+  // manifest requests for this function.
+  if (!onlyCreatePrespecializations)
+    addManifestSpecializeAttrs(F);
+
   // Create a specialized function with ReabstractionInfo for each attribute.
   SmallVector<SILFunction *, 8> SpecializedFuncs;
   SmallVector<ReabstractionInfo, 4> ReInfoVec;
@@ -41,6 +41,16 @@ class GenericSpecializer : public SILFunctionTransform {
     LLVM_DEBUG(llvm::dbgs() << "***** GenericSpecializer on function:"
                             << F.getName() << " *****\n");
 
+    // If profile data shows this function never ran, don't bloat the binary
+    // with specialized clones of its callees; the unspecialized generic
+    // entry points work just as well for cold code.
+    if (auto EntryCount = F.getEntryCount()) {
+      if (EntryCount.getValue() == 0) {
+        LLVM_DEBUG(llvm::dbgs() << "  profiled cold function: skipping\n");
+        return;
+      }
+    }
+
     if (specializeAppliesInFunction(F))
       invalidateAnalysis(SILAnalysis::InvalidationKind::Everything);
   }
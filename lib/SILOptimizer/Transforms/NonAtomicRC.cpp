@@ -0,0 +1,85 @@
+//===--- NonAtomicRC.cpp - Non-atomic refcounting of local objects --------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2021 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+//
+// Converts reference counting operations into non-atomic ones when the
+// referenced object is allocated in the current function and provably never
+// escapes it. Such an object can only be referenced by the current thread, so
+// its reference counts cannot be mutated concurrently and the cheaper
+// non-atomic runtime entry points are safe to use.
+//
+//===----------------------------------------------------------------------===//
+
+#include "swift/SIL/SILFunction.h"
+#include "swift/SIL/SILInstruction.h"
+#include "swift/SILOptimizer/Analysis/EscapeAnalysis.h"
+#include "swift/SILOptimizer/Analysis/RCIdentityAnalysis.h"
+#include "swift/SILOptimizer/PassManager/Passes.h"
+#include "swift/SILOptimizer/PassManager/Transforms.h"
+#include "llvm/ADT/Statistic.h"
+
+#define DEBUG_TYPE "non-atomic-rc"
+
+STATISTIC(NumNonAtomicRC, "Number of refcount instructions made non-atomic");
+
+using namespace swift;
+
+namespace {
+
+class NonAtomicRC : public SILFunctionTransform {
+  /// The entry point to the transformation.
+  void run() override {
+    SILFunction *F = getFunction();
+
+    // Don't optimize functions that are marked with the opt.never attribute.
+    if (!F->shouldOptimize())
+      return;
+
+    auto *EA = PM->getAnalysis<EscapeAnalysis>();
+    auto *RCIA = PM->getAnalysis<RCIdentityAnalysis>()->get(F);
+    auto *ConGraph = EA->getConnectionGraph(F);
+
+    bool Changed = false;
+    for (auto &BB : *F) {
+      for (auto &I : BB) {
+        auto *RCInst = dyn_cast<RefCountingInst>(&I);
+        if (!RCInst || RCInst->isNonAtomic())
+          continue;
+
+        // As in StackPromotion, only trust the escape state of objects
+        // allocated in this function. A non-escaping argument may still be
+        // shared with other threads by the caller.
+        SILValue Root = RCIA->getRCIdentityRoot(RCInst->getOperand(0));
+        auto *ARI = dyn_cast<AllocRefInst>(Root);
+        if (!ARI)
+          continue;
+
+        auto *contentNode = ConGraph->getValueContent(ARI);
+        if (!contentNode || contentNode->escapes())
+          continue;
+
+        LLVM_DEBUG(llvm::dbgs() << "Make non-atomic " << *RCInst);
+        RCInst->setNonAtomic();
+        ++NumNonAtomicRC;
+        Changed = true;
+      }
+    }
+    if (Changed) {
+      invalidateAnalysis(SILAnalysis::InvalidationKind::Instructions);
+    }
+  }
+};
+
+} // end anonymous namespace
+
+SILTransform *swift::createNonAtomicRC() {
+  return new NonAtomicRC();
+}
@@ -15,6 +15,7 @@
 #include "swift/AST/SemanticAttrs.h"
 #include "swift/SIL/MemAccessUtils.h"
 #include "swift/SIL/OptimizationRemark.h"
+#include "swift/SILOptimizer/Analysis/InlineCostAnalysis.h"
 #include "swift/SILOptimizer/Analysis/SideEffectAnalysis.h"
 #include "swift/SILOptimizer/PassManager/Passes.h"
 #include "swift/SILOptimizer/PassManager/Transforms.h"
@@ -67,6 +68,7 @@ class SILPerformanceInliner {
   DominanceAnalysis *DA;
   SILLoopAnalysis *LA;
   SideEffectAnalysis *SEA;
+  InlineCostAnalysis *ICA;
 
   // For keys of SILFunction and SILLoop.
   llvm::DenseMap<SILFunction *, ShortestPathAnalysis *> SPAs;
@@ -183,6 +185,8 @@ class SILPerformanceInliner {
 
   bool decideInColdBlock(FullApplySite AI, SILFunction *Callee);
 
+  int getCappedCalleeCost(SILFunction *Callee, SILFunction *Caller);
+
   void visitColdBlocks(SmallVectorImpl<FullApplySite> &AppliesToInline,
                        SILBasicBlock *root, DominanceInfo *DT);
 
@@ -193,9 +197,10 @@ public:
   SILPerformanceInliner(SILOptFunctionBuilder &FuncBuilder,
 			InlineSelection WhatToInline, DominanceAnalysis *DA,
                         SILLoopAnalysis *LA, SideEffectAnalysis *SEA,
-                        OptimizationMode OptMode, OptRemark::Emitter &ORE)
+                        InlineCostAnalysis *ICA, OptimizationMode OptMode,
+                        OptRemark::Emitter &ORE)
       : FuncBuilder(FuncBuilder), WhatToInline(WhatToInline), DA(DA), LA(LA),
-	SEA(SEA), CBI(DA), ORE(ORE), OptMode(OptMode) {}
+	SEA(SEA), ICA(ICA), CBI(DA), ORE(ORE), OptMode(OptMode) {}
 
   bool inlineCallsIntoFunction(SILFunction *F);
 };
@@ -679,19 +684,43 @@ bool SILPerformanceInliner::decideInColdBlock(FullApplySite AI,
     return true;
   }
 
-  int CalleeCost = 0;
+  int CalleeCost = getCappedCalleeCost(Callee, AI.getFunction());
+  if (CalleeCost > TrivialFunctionThreshold)
+    return false;
+
+  LLVM_DEBUG(dumpCaller(AI.getFunction());
+             llvm::dbgs() << "    cold decision {" << CalleeCost << "} "
+                          << Callee->getName() << '\n');
+  return true;
+}
+
+/// Return the cost of \p Callee's body, capped at
+/// TrivialFunctionThreshold + 1.
+///
+/// The cost summary is cached by InlineCostAnalysis, so a callee is only
+/// scanned once until its body changes, no matter how many callers and
+/// inlining rounds consider it. The analysis is not consulted when the callee
+/// is \p Caller itself, because the caller is modified by every performed
+/// inline while its analysis entry is only invalidated when this pass
+/// finishes.
+int SILPerformanceInliner::getCappedCalleeCost(SILFunction *Callee,
+                                               SILFunction *Caller) {
+  if (Callee != Caller) {
+    return std::min(ICA->get(Callee)->getFullCost(),
+                    int(TrivialFunctionThreshold) + 1);
+  }
 
+  int CalleeCost = 0;
   for (SILBasicBlock &Block : *Callee) {
     for (SILInstruction &I : Block) {
       CalleeCost += int(instructionInlineCost(I));
       if (CalleeCost > TrivialFunctionThreshold)
-        return false;
+        break;
     }
+    if (CalleeCost > TrivialFunctionThreshold)
+      break;
   }
-  LLVM_DEBUG(dumpCaller(AI.getFunction());
-             llvm::dbgs() << "    cold decision {" << CalleeCost << "} "
-                          << Callee->getName() << '\n');
-  return true;
+  return CalleeCost;
 }
 
 /// Record additional weight increases.
@@ -807,6 +836,19 @@ void SILPerformanceInliner::collectAppliesToInline(
   DominanceInfo *DT = DA->get(Caller);
   SILLoopInfo *LI = LA->get(Caller);
 
+  // If profile data shows the caller never ran, treat the whole function like
+  // a cold block: only trivial, transparent and always-inline callees get
+  // inlined. There is no time to win here, only code size to lose.
+  if (auto EntryCount = Caller->getEntryCount()) {
+    if (EntryCount.getValue() == 0) {
+      LLVM_DEBUG(dumpCaller(Caller);
+                 llvm::dbgs() << "profiled cold caller: inline only "
+                                 "trivial callees\n");
+      visitColdBlocks(Applies, &Caller->front(), DT);
+      return;
+    }
+  }
+
   llvm::DenseMap<FullApplySite, int> WeightCorrections;
 
   // Compute the shortest-path analysis for the caller.
@@ -1043,6 +1085,7 @@ public:
     DominanceAnalysis *DA = PM->getAnalysis<DominanceAnalysis>();
     SILLoopAnalysis *LA = PM->getAnalysis<SILLoopAnalysis>();
     SideEffectAnalysis *SEA = PM->getAnalysis<SideEffectAnalysis>();
+    InlineCostAnalysis *ICA = PM->getAnalysis<InlineCostAnalysis>();
     OptRemark::Emitter ORE(DEBUG_TYPE, *getFunction());
 
     if (getOptions().InlineThreshold == 0) {
@@ -1053,7 +1096,7 @@ public:
 
     SILOptFunctionBuilder FuncBuilder(*this);
     SILPerformanceInliner Inliner(FuncBuilder, WhatToInline, DA, LA, SEA,
-				  OptMode, ORE);
+				  ICA, OptMode, ORE);
 
     assert(getFunction()->isDefinition() &&
            "Expected only functions with bodies!");
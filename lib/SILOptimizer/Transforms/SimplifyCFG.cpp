@@ -176,8 +176,10 @@ private:
 
   bool simplifyBlocks();
   bool canonicalizeSwitchEnums();
-  bool simplifyThreadedTerminators();
-  bool dominatorBasedSimplifications(SILFunction &Fn, DominanceInfo *DT);
+  bool simplifyThreadedTerminators(
+      SmallVectorImpl<DominanceInfo::UpdateType> *DTUpdates = nullptr);
+  bool dominatorBasedSimplifications(SILFunction &Fn, DominanceInfo *DT,
+                                     bool &ThreadedEdges);
   bool dominatorBasedSimplify(DominanceAnalysis *DA);
   bool threadEdge(const ThreadInfo &ti);
 
@@ -567,8 +569,13 @@ static bool tryDominatorBasedSimplifications(
 
 /// Propagate values of branched upon values along the outgoing edges down the
 /// dominator tree.
+///
+/// \p ThreadedEdges is set to true if any edge was jump threaded, i.e. if the
+/// CFG was changed by cloning blocks. Plain value replacements leave the CFG
+/// (and thereby the dominator tree) intact.
 bool SimplifyCFG::dominatorBasedSimplifications(SILFunction &Fn,
-                                                DominanceInfo *DT) {
+                                                DominanceInfo *DT,
+                                                bool &ThreadedEdges) {
   bool Changed = false;
   // Collect jump threadable edges and propagate outgoing edge values of
   // conditional branches/switches.
@@ -588,6 +595,7 @@ bool SimplifyCFG::dominatorBasedSimplifications(SILFunction &Fn,
   for (auto &ThreadInfo : JumpThreadableEdges) {
     if (threadEdge(ThreadInfo)) {
       Changed = true;
+      ThreadedEdges = true;
     }
   }
 
@@ -595,7 +603,12 @@ bool SimplifyCFG::dominatorBasedSimplifications(SILFunction &Fn,
 }
 
 /// Simplify terminators that could have been simplified by threading.
-bool SimplifyCFG::simplifyThreadedTerminators() {
+///
+/// If \p DTUpdates is non-null, the CFG edges deleted by folding terminators
+/// are recorded so the caller can update the dominator tree incrementally
+/// instead of recomputing it.
+bool SimplifyCFG::simplifyThreadedTerminators(
+    SmallVectorImpl<DominanceInfo::UpdateType> *DTUpdates) {
   bool HaveChangedCFG = false;
   for (auto &BB : Fn) {
     auto *Term = BB.getTerminator();
@@ -604,6 +617,14 @@ bool SimplifyCFG::simplifyThreadedTerminators() {
       if (auto *EI = dyn_cast<EnumInst>(SEI->getOperand())) {
         LLVM_DEBUG(llvm::dbgs() << "simplify threaded " << *SEI);
         auto *LiveBlock = SEI->getCaseDestination(EI->getElement());
+        if (DTUpdates) {
+          // All edges to the non-taken successors are deleted.
+          SmallPtrSet<SILBasicBlock *, 4> DeadBlocks;
+          for (auto &Succ : SEI->getSuccessors())
+            if (Succ.getBB() != LiveBlock &&
+                DeadBlocks.insert(Succ.getBB()).second)
+              DTUpdates->push_back({DominanceInfo::Delete, &BB, Succ.getBB()});
+        }
         if (EI->hasOperand() && !LiveBlock->args_empty())
           SILBuilderWithScope(SEI)
               .createBranch(SEI->getLoc(), LiveBlock, EI->getOperand());
@@ -627,6 +648,9 @@ bool SimplifyCFG::simplifyThreadedTerminators() {
         bool isFalse = !IL->getValue();
         auto LiveArgs = isFalse ? FalseArgs : TrueArgs;
         auto *LiveBlock = isFalse ? FalseSide : TrueSide;
+        auto *DeadBlock = isFalse ? TrueSide : FalseSide;
+        if (DTUpdates && DeadBlock != LiveBlock)
+          DTUpdates->push_back({DominanceInfo::Delete, &BB, DeadBlock});
         SILBuilderWithScope(CondBr)
             .createBranch(CondBr->getLoc(), LiveBlock, LiveArgs);
         CondBr->eraseFromParent();
@@ -685,14 +709,24 @@ bool SimplifyCFG::dominatorBasedSimplify(DominanceAnalysis *DA) {
       DT->verify();
 
     // Jump thread.
-    if (dominatorBasedSimplifications(Fn, DT)) {
+    bool ThreadedEdges = false;
+    if (dominatorBasedSimplifications(Fn, DT, ThreadedEdges)) {
       DominanceInfo *InvalidDT = DT;
       DT = nullptr;
       HasChangedInCurrentIter = true;
-      // Simplify terminators.
-      simplifyThreadedTerminators();
+      // Simplify terminators. If no edges were jump threaded the CFG was only
+      // changed by folding terminators, and the deleted edges allow us to
+      // update the dominator tree incrementally instead of recomputing it.
+      SmallVector<DominanceInfo::UpdateType, 16> DTUpdates;
+      simplifyThreadedTerminators(ThreadedEdges ? nullptr : &DTUpdates);
       DT = InvalidDT;
-      DT->recalculate(Fn);
+      if (ThreadedEdges) {
+        // Jump threading clones blocks and folds away parts of both copies;
+        // reconstructing the update sequence for that is not worth it.
+        DT->recalculate(Fn);
+      } else if (!DTUpdates.empty()) {
+        DT->applyUpdates(DTUpdates);
+      }
     }
 
     Changed |= HasChangedInCurrentIter;
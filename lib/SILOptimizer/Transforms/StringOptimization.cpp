@@ -37,6 +37,7 @@ namespace {
 ///   * Replaces x.append(y) with x = y if x is empty.
 ///   * Removes x.append("")
 ///   * Replaces x.append(y) with x = x + y if x and y are constant strings.
+///   * Replaces x == y with a constant if x and y are constant strings.
 ///   * Replaces _typeName(T.self) with a constant string if T is statically
 ///     known.
 ///
@@ -91,6 +92,7 @@ private:
   bool optimizeStringAppend(ApplyInst *appendCall,
                             llvm::DenseMap<SILValue, SILValue> &storedStrings);
   bool optimizeStringConcat(ApplyInst *concatCall);
+  bool optimizeStringComparison(ApplyInst *equalsCall);
   bool optimizeTypeName(ApplyInst *typeNameCall);
 
   static ApplyInst *isSemanticCall(SILInstruction *inst, StringRef attr,
@@ -150,6 +152,12 @@ bool StringOptimization::optimizeBlock(SILBasicBlock &block) {
         continue;
       }
     }
+    if (ApplyInst *equals = isSemanticCall(inst, semantics::STRING_EQUALS, 3)) {
+      if (optimizeStringComparison(equals)) {
+        changed = true;
+        continue;
+      }
+    }
     if (ApplyInst *typeName = isSemanticCall(inst, semantics::TYPENAME, 2)) {
       if (optimizeTypeName(typeName)) {
         changed = true;
@@ -247,6 +255,39 @@ bool StringOptimization::optimizeStringConcat(ApplyInst *concatCall) {
   return false;
 }
 
+/// Replace String.== with a constant if both operands are constant.
+bool StringOptimization::optimizeStringComparison(ApplyInst *equalsCall) {
+  StringInfo lhsString = getStringInfo(equalsCall->getArgument(0));
+  StringInfo rhsString = getStringInfo(equalsCall->getArgument(1));
+  if (!lhsString.isConstant() || !rhsString.isConstant())
+    return false;
+
+  ASTContext &ctxt = equalsCall->getFunction()->getModule().getASTContext();
+
+  bool equal = (lhsString.str == rhsString.str);
+  if (!equal) {
+    // Strings with the same UTF8 representation always compare equal, but
+    // strings with different representations may still be canonically
+    // equivalent (e.g. a composed and a decomposed "é"). ASCII strings are
+    // trivially in canonical form, so only for them a byte comparison is
+    // exact.
+    if (!ctxt.isASCIIString(lhsString.str) ||
+        !ctxt.isASCIIString(rhsString.str))
+      return false;
+  }
+
+  SILBuilder builder(equalsCall);
+  SILLocation loc = equalsCall->getLoc();
+  auto *intLiteral = builder.createIntegerLiteral(loc,
+                       SILType::getBuiltinIntegerType(1, ctxt),
+                       intmax_t(equal));
+  auto *boolStruct = builder.createStruct(loc, equalsCall->getType(),
+                                          {intLiteral});
+  equalsCall->replaceAllUsesWith(boolStruct);
+  equalsCall->eraseFromParent();
+  return true;
+}
+
 /// Checks if the demangling tree contains any node which prevents constant
 /// folding of the type name.
 static bool containsProblematicNode(Demangle::Node *node, bool qualified) {
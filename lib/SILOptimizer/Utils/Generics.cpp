@@ -1846,6 +1846,12 @@ GenericFuncSpecializer::GenericFuncSpecializer(
 
   assert((GenericFunc->isDefinition() || ReInfo.isPrespecialized()) &&
          "Expected definition or pre-specialized entry-point to specialize!");
+}
+
+StringRef GenericFuncSpecializer::getClonedName() {
+  if (!ClonedName.empty())
+    return ClonedName;
+
   auto FnTy = ReInfo.getSpecializedType();
 
   if (ReInfo.isPartialSpecialization()) {
@@ -1863,13 +1869,33 @@ GenericFuncSpecializer::GenericFuncSpecializer(
     }
   }
   LLVM_DEBUG(llvm::dbgs() << "    Specialized function " << ClonedName << '\n');
+  return ClonedName;
+}
+
+/// Pack the properties of \p ReInfo which influence the specialization's
+/// mangled name into the flags word for the module's specialization registry.
+static unsigned getSpecializationFlags(const ReabstractionInfo &ReInfo) {
+  return unsigned(ReInfo.isSerialized()) |
+         unsigned(ReInfo.isPartialSpecialization()) << 2 |
+         unsigned(ReInfo.isPrespecialized()) << 3 |
+         unsigned(ReInfo.needAlternativeMangling()) << 4;
 }
 
 /// Return an existing specialization if one exists.
 SILFunction *GenericFuncSpecializer::lookupSpecialization() {
-  if (SILFunction *SpecializedF = M.lookUpFunction(ClonedName)) {
+  unsigned Flags = getSpecializationFlags(ReInfo);
+  SILFunction *SpecializedF = M.lookUpSpecialization(GenericFunc, ParamSubs,
+                                                     Flags);
+  if (!SpecializedF) {
+    // Fall back to a name-based lookup, e.g. for specializations which were
+    // deserialized rather than created by this optimizer run.
+    SpecializedF = M.lookUpFunction(getClonedName());
+    if (SpecializedF)
+      M.registerSpecialization(GenericFunc, ParamSubs, Flags, SpecializedF);
+  }
+  if (SpecializedF) {
     if (ReInfo.getSpecializedType() != SpecializedF->getLoweredFunctionType()) {
-      llvm::dbgs() << "Looking for a function: " << ClonedName << "\n"
+      llvm::dbgs() << "Looking for a function: " << getClonedName() << "\n"
                    << "Expected type: " << ReInfo.getSpecializedType() << "\n"
                    << "Found    type: "
                    << SpecializedF->getLoweredFunctionType() << "\n";
@@ -1878,11 +1904,11 @@ SILFunction *GenericFuncSpecializer::lookupSpecialization() {
            == SpecializedF->getLoweredFunctionType() &&
            "Previously specialized function does not match expected type.");
     LLVM_DEBUG(llvm::dbgs() << "Found an existing specialization for: "
-                            << ClonedName << "\n");
+                            << SpecializedF->getName() << "\n");
     return SpecializedF;
   }
   LLVM_DEBUG(llvm::dbgs() << "Could not find an existing specialization for: "
-                          << ClonedName << "\n");
+                          << getClonedName() << "\n");
   return nullptr;
 }
 
@@ -1901,7 +1927,7 @@ GenericFuncSpecializer::tryCreateSpecialization(bool forcePrespecialization) {
     return nullptr;
 
   LLVM_DEBUG(llvm::dbgs() << "Creating a specialization: "
-                          << ClonedName << "\n");
+                          << getClonedName() << "\n");
 
   ReInfo.verify();
 
@@ -1911,7 +1937,9 @@ GenericFuncSpecializer::tryCreateSpecialization(bool forcePrespecialization) {
       // Use these substitutions inside the new specialized function being
       // created.
       ReInfo.getClonerParamSubstitutionMap(),
-      ClonedName);
+      getClonedName());
+  M.registerSpecialization(GenericFunc, ParamSubs,
+                           getSpecializationFlags(ReInfo), SpecializedF);
   assert((SpecializedF->getLoweredFunctionType()->isPolymorphic() &&
           SpecializedF->getGenericEnvironment()) ||
          (!SpecializedF->getLoweredFunctionType()->isPolymorphic() &&
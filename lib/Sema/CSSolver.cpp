@@ -14,6 +14,7 @@
 //
 //===----------------------------------------------------------------------===//
 #include "CSStep.h"
+#include "SolutionCache.h"
 #include "TypeCheckType.h"
 #include "TypeChecker.h"
 #include "swift/AST/ParameterList.h"
@@ -1166,6 +1167,13 @@ Optional<std::vector<Solution>> ConstraintSystem::solve(
     Options |= ConstraintSystemFlags::DebugConstraints;
   }
 
+  // If a persistent solution cache is enabled, compute the key for this
+  // target so successful outcomes can be checked and recorded below.
+  auto *solutionCache = SolutionCache::getIfEnabled(getASTContext());
+  Optional<Fingerprint> solutionCacheKey;
+  if (solutionCache)
+    solutionCacheKey = SolutionCache::getKeyForTarget(target, getASTContext());
+
   /// Dump solutions for debugging purposes.
   auto dumpSolutions = [&](const SolutionResult &result) {
     // Debug-print the set of solutions.
@@ -1197,6 +1205,9 @@ Optional<std::vector<Solution>> ConstraintSystem::solve(
       dumpSolutions(solution);
       std::vector<Solution> result;
       result.push_back(std::move(solution).takeSolution());
+      if (solutionCache && solutionCacheKey)
+        solutionCache->noteSolved(*solutionCacheKey, result.size(),
+                                  getASTContext().Stats);
       return std::move(result);
     }
 
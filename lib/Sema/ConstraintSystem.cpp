@@ -34,12 +34,54 @@
 #include "llvm/ADT/SmallString.h"
 #include "llvm/Support/Compiler.h"
 #include "llvm/Support/Format.h"
+#include "llvm/Support/Mutex.h"
 
 using namespace swift;
 using namespace constraints;
 
 #define DEBUG_TYPE "ConstraintSystem"
 
+namespace {
+/// A pool of slab allocators recycled between expression type checks.
+///
+/// Tearing down a constraint system resets its allocator's bump pointer
+/// and parks the allocator here instead of returning its initial slab to
+/// malloc, so the next constraint system starts with a warm slab. This
+/// keeps teardown between expressions to a pointer reset in the common
+/// case of expression-dense files.
+class SolverAllocatorPool {
+  llvm::sys::Mutex mutex;
+  SmallVector<llvm::BumpPtrAllocator, 4> allocators;
+
+  /// An upper bound on the number of pooled allocators, so a spike of
+  /// concurrent solvers does not pin slabs for the rest of the process.
+  static const unsigned MaxPooledAllocators = 8;
+
+public:
+  llvm::BumpPtrAllocator take() {
+    llvm::sys::ScopedLock lock(mutex);
+    if (allocators.empty())
+      return llvm::BumpPtrAllocator();
+    llvm::BumpPtrAllocator result = std::move(allocators.back());
+    allocators.pop_back();
+    return result;
+  }
+
+  void recycle(llvm::BumpPtrAllocator &&allocator) {
+    // Drop all but the initial slab before pooling.
+    allocator.Reset();
+    llvm::sys::ScopedLock lock(mutex);
+    if (allocators.size() < MaxPooledAllocators)
+      allocators.push_back(std::move(allocator));
+  }
+};
+} // end anonymous namespace
+
+static SolverAllocatorPool &getSolverAllocatorPool() {
+  static SolverAllocatorPool pool;
+  return pool;
+}
+
 ExpressionTimer::ExpressionTimer(Expr *E, ConstraintSystem &CS)
   : E(E),
       Context(CS.getASTContext()),
@@ -74,6 +116,7 @@ ExpressionTimer::~ExpressionTimer() {
 ConstraintSystem::ConstraintSystem(DeclContext *dc,
                                    ConstraintSystemOptions options)
   : Context(dc->getASTContext()), DC(dc), Options(options),
+    Allocator(getSolverAllocatorPool().take()),
     Arena(dc->getASTContext(), Allocator),
     CG(*new ConstraintGraph(*this))
 {
@@ -88,6 +131,10 @@ ConstraintSystem::ConstraintSystem(DeclContext *dc,
 
 ConstraintSystem::~ConstraintSystem() {
   delete &CG;
+
+  // Recycle the slabs this system allocated for the next solver instead
+  // of freeing them. Nothing refers to arena memory beyond this point.
+  getSolverAllocatorPool().recycle(std::move(Allocator));
 }
 
 void ConstraintSystem::incrementScopeCounter() {
@@ -2885,6 +2932,12 @@ Type Solution::simplifyType(Type type) const {
   if (!(type->hasTypeVariable() || type->hasHole()))
     return type;
 
+  // The type variable bindings are fixed at this point, so the result of
+  // simplifying a given type never changes.
+  auto known = SimplifiedTypes.find(type.getPointer());
+  if (known != SimplifiedTypes.end())
+    return known->second;
+
   // Map type variables to fixed types from bindings.
   auto &cs = getConstraintSystem();
   auto resolvedType = cs.simplifyTypeImpl(
@@ -2893,16 +2946,18 @@ Type Solution::simplifyType(Type type) const {
   // Holes shouldn't be reachable through a solution, they are only
   // useful to determine what went wrong exactly.
   if (resolvedType->hasHole()) {
-    return resolvedType.transform([&](Type type) {
+    resolvedType = resolvedType.transform([&](Type type) {
       return type->isHole() ? Type(cs.getASTContext().TheUnresolvedType) : type;
     });
   }
 
+  SimplifiedTypes.insert({type.getPointer(), resolvedType});
   return resolvedType;
 }
 
 size_t Solution::getTotalMemory() const {
   return sizeof(*this) + typeBindings.getMemorySize() +
+         SimplifiedTypes.getMemorySize() +
          overloadChoices.getMemorySize() +
          ConstraintRestrictions.getMemorySize() +
          llvm::capacity_in_bytes(Fixes) + DisjunctionChoices.getMemorySize() +
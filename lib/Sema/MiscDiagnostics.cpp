@@ -4360,13 +4360,30 @@ static void diagnoseDeprecatedWritableKeyPath(const Expr *E,
   const_cast<Expr *>(E)->walk(Walker);
 }
 
-static void maybeDiagnoseCallToKeyValueObserveMethod(const Expr *E,
-                                                     const DeclContext *DC) {
-  class KVOObserveCallWalker : public ASTWalker {
+/// Diagnose expression patterns that are each found by scanning for a single
+/// kind of node: calls to Foundation's observe(_:options:changeHandler:) with
+/// a key path to a property that is not '@objc dynamic', explicit uses of a
+/// lazy variable's storage, and comparisons with '.nan'.
+///
+/// These checks used to be separate walkers with identical traversal
+/// behavior; they share one walk over the expression so the tree is not
+/// traversed once per check. Each check still stops descending past a node
+/// it has inspected, without hiding that subtree from the other checks.
+static void diagnoseExprPatterns(const Expr *E, const DeclContext *DC) {
+  class ExprPatternWalker : public ASTWalker {
     const ASTContext &C;
+    const DeclContext *DC;
+
+    /// The roots of subtrees the corresponding checks are currently
+    /// skipping, or null if a check is active. As separate walkers, each
+    /// check stopped descending past a node it inspected.
+    Expr *KVOSkipRoot = nullptr;
+    Expr *LazyStorageSkipRoot = nullptr;
+    Expr *NaNSkipRoot = nullptr;
 
   public:
-    KVOObserveCallWalker(ASTContext &ctx) : C(ctx) {}
+    ExprPatternWalker(const DeclContext *dc)
+        : C(dc->getASTContext()), DC(dc) {}
 
     void maybeDiagnoseCallExpr(CallExpr *expr) {
       auto fn = expr->getCalledValue();
@@ -4399,32 +4416,6 @@ static void maybeDiagnoseCallToKeyValueObserveMethod(const Expr *E,
           .highlight(lastComponent.getLoc());
     }
 
-    std::pair<bool, Expr *> walkToExprPre(Expr *E) override {
-      if (!E || isa<ErrorExpr>(E) || !E->getType())
-        return {false, E};
-
-      if (auto *CE = dyn_cast<CallExpr>(E)) {
-        maybeDiagnoseCallExpr(CE);
-        return {false, E};
-      }
-
-      return {true, E};
-    }
-  };
-
-  KVOObserveCallWalker Walker(DC->getASTContext());
-  const_cast<Expr *>(E)->walk(Walker);
-}
-
-static void diagnoseExplicitUseOfLazyVariableStorage(const Expr *E,
-                                                     const DeclContext *DC) {
-
-  class ExplicitLazyVarStorageAccessFinder : public ASTWalker {
-    const ASTContext &C;
-
-  public:
-    ExplicitLazyVarStorageAccessFinder(ASTContext &ctx) : C(ctx) {}
-
     void tryDiagnoseExplicitLazyStorageVariableUse(MemberRefExpr *MRE) {
       if (MRE->isImplicit()) {
         return;
@@ -4446,32 +4437,6 @@ static void diagnoseExplicitUseOfLazyVariableStorage(const Expr *E,
       }
     }
 
-    std::pair<bool, Expr *> walkToExprPre(Expr *E) override {
-      if (!E || isa<ErrorExpr>(E) || !E->getType())
-        return {false, E};
-
-      if (auto *MRE = dyn_cast<MemberRefExpr>(E)) {
-        tryDiagnoseExplicitLazyStorageVariableUse(MRE);
-        return {false, E};
-      }
-
-      return {true, E};
-    }
-  };
-
-  ExplicitLazyVarStorageAccessFinder Walker(DC->getASTContext());
-  const_cast<Expr *>(E)->walk(Walker);
-}
-
-static void diagnoseComparisonWithNaN(const Expr *E, const DeclContext *DC) {
-  class ComparisonWithNaNFinder : public ASTWalker {
-    const ASTContext &C;
-    const DeclContext *DC;
-
-  public:
-    ComparisonWithNaNFinder(const DeclContext *dc)
-        : C(dc->getASTContext()), DC(dc) {}
-
     void tryDiagnoseComparisonWithNaN(BinaryExpr *BE) {
       ValueDecl *comparisonDecl = nullptr;
 
@@ -4575,16 +4540,38 @@ static void diagnoseComparisonWithNaN(const Expr *E, const DeclContext *DC) {
       if (!E || isa<ErrorExpr>(E) || !E->getType())
         return {false, E};
 
-      if (auto *BE = dyn_cast<BinaryExpr>(E)) {
-        tryDiagnoseComparisonWithNaN(BE);
-        return {false, E};
+      if (auto *CE = dyn_cast<CallExpr>(E)) {
+        if (!KVOSkipRoot) {
+          maybeDiagnoseCallExpr(CE);
+          KVOSkipRoot = E;
+        }
+      } else if (auto *MRE = dyn_cast<MemberRefExpr>(E)) {
+        if (!LazyStorageSkipRoot) {
+          tryDiagnoseExplicitLazyStorageVariableUse(MRE);
+          LazyStorageSkipRoot = E;
+        }
+      } else if (auto *BE = dyn_cast<BinaryExpr>(E)) {
+        if (!NaNSkipRoot) {
+          tryDiagnoseComparisonWithNaN(BE);
+          NaNSkipRoot = E;
+        }
       }
 
       return {true, E};
     }
+
+    Expr *walkToExprPost(Expr *E) override {
+      if (E == KVOSkipRoot)
+        KVOSkipRoot = nullptr;
+      if (E == LazyStorageSkipRoot)
+        LazyStorageSkipRoot = nullptr;
+      if (E == NaNSkipRoot)
+        NaNSkipRoot = nullptr;
+      return E;
+    }
   };
 
-  ComparisonWithNaNFinder Walker(DC);
+  ExprPatternWalker Walker(DC);
   const_cast<Expr *>(E)->walk(Walker);
 }
 
@@ -4602,9 +4589,7 @@ void swift::performSyntacticExprDiagnostics(const Expr *E,
   diagRecursivePropertyAccess(E, DC);
   diagnoseImplicitSelfUseInClosure(E, DC);
   diagnoseUnintendedOptionalBehavior(E, DC);
-  maybeDiagnoseCallToKeyValueObserveMethod(E, DC);
-  diagnoseExplicitUseOfLazyVariableStorage(E, DC);
-  diagnoseComparisonWithNaN(E, DC);
+  diagnoseExprPatterns(E, DC);
   if (!ctx.isSwiftVersionAtLeast(5))
     diagnoseDeprecatedWritableKeyPath(E, DC);
   if (!ctx.LangOpts.DisableAvailabilityChecking)
@@ -0,0 +1,122 @@
+//===--- SolutionCache.cpp - Persistent solution cache --------------------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2020 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+#include "SolutionCache.h"
+#include "swift/AST/ASTContext.h"
+#include "swift/Basic/SourceManager.h"
+#include "swift/Basic/Statistic.h"
+#include "swift/Parse/Lexer.h"
+#include "swift/Sema/ConstraintSystem.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MD5.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/raw_ostream.h"
+
+using namespace swift;
+using namespace constraints;
+
+SolutionCache::SolutionCache(StringRef path) : path(path.str()) {
+  load();
+}
+
+void SolutionCache::load() {
+  auto buffer = llvm::MemoryBuffer::getFile(path);
+  if (!buffer)
+    return;
+
+  // Each line is "<fingerprint> <number-of-solutions>".
+  StringRef contents = buffer.get()->getBuffer();
+  while (!contents.empty()) {
+    StringRef line;
+    std::tie(line, contents) = contents.split('\n');
+    StringRef key, value;
+    std::tie(key, value) = line.split(' ');
+    unsigned numSolutions;
+    if (key.size() != Fingerprint::DIGEST_LENGTH ||
+        value.getAsInteger(/*radix*/ 10, numSolutions))
+      continue;
+    entries[key] = numSolutions;
+  }
+}
+
+SolutionCache::~SolutionCache() {
+  if (!dirty)
+    return;
+
+  std::error_code error;
+  llvm::raw_fd_ostream out(path, error, llvm::sys::fs::F_Text);
+  if (error)
+    return;
+  for (const auto &entry : entries)
+    out << entry.getKey() << ' ' << entry.getValue() << '\n';
+}
+
+SolutionCache *SolutionCache::getIfEnabled(ASTContext &ctx) {
+  const auto &path = ctx.TypeCheckerOpts.SolutionCachePath;
+  if (path.empty())
+    return nullptr;
+
+  // The cache is shared by every ASTContext in the process that names the
+  // same path; in practice a frontend job only ever names one.
+  static std::unique_ptr<SolutionCache> sharedCache;
+  if (!sharedCache || sharedCache->path != path)
+    sharedCache.reset(new SolutionCache(path));
+  return sharedCache.get();
+}
+
+Optional<Fingerprint>
+SolutionCache::getKeyForTarget(const SolutionApplicationTarget &target,
+                               ASTContext &ctx) {
+  auto *expr = target.getAsExpr();
+  if (!expr)
+    return None;
+
+  auto range = target.getSourceRange();
+  if (range.isInvalid())
+    return None;
+
+  auto charRange =
+      Lexer::getCharSourceRangeFromSourceRange(ctx.SourceMgr, range);
+  llvm::MD5 hash;
+  hash.update(ctx.SourceMgr.extractText(charRange));
+
+  // Mix in the contextual type, which changes the solution space even when
+  // the expression text is unchanged.
+  if (auto contextualType = target.getExprContextualType()) {
+    // Separate the expression text from the type with a byte that cannot
+    // occur in either. Note that a string literal would be a no-op here:
+    // the implicit StringRef conversion stops at the NUL.
+    hash.update(llvm::StringRef("\0", 1));
+    hash.update(contextualType.getString());
+  }
+
+  llvm::MD5::MD5Result result;
+  hash.final(result);
+  return Fingerprint(std::move(result));
+}
+
+void SolutionCache::noteSolved(const Fingerprint &key, unsigned numSolutions,
+                               UnifiedStatsReporter *stats) {
+  llvm::sys::ScopedLock lock(mutex);
+  auto rawKey = key.getRawValue();
+  auto known = entries.find(rawKey);
+  if (known != entries.end() && known->second == numSolutions) {
+    if (stats)
+      ++stats->getFrontendCounters().NumSolutionCacheHits;
+    return;
+  }
+
+  entries[rawKey] = numSolutions;
+  dirty = true;
+  if (stats)
+    ++stats->getFrontendCounters().NumSolutionCacheMisses;
+}
@@ -0,0 +1,83 @@
+//===--- SolutionCache.h - Persistent solution cache ------------*- C++ -*-===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2020 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+//
+// This file defines an experimental, persistent cache of constraint solver
+// results keyed by expression fingerprints. The cache currently operates in
+// shadow mode: hit entries are validated against freshly computed solutions
+// and surfaced through statistics, but solving is not yet skipped. Replaying
+// a recorded Solution requires stable cross-invocation declaration identity
+// and will build on this keying and storage layer.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef SWIFT_SEMA_SOLUTIONCACHE_H
+#define SWIFT_SEMA_SOLUTIONCACHE_H
+
+#include "swift/Basic/Fingerprint.h"
+#include "swift/Basic/LLVM.h"
+#include "llvm/ADT/Optional.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/Support/Mutex.h"
+
+namespace swift {
+
+class ASTContext;
+class UnifiedStatsReporter;
+
+namespace constraints {
+
+class ConstraintSystem;
+class SolutionApplicationTarget;
+
+/// An on-disk cache of constraint solving outcomes, keyed by a fingerprint
+/// of the expression text and its contextual type.
+class SolutionCache {
+  /// The path of the backing file.
+  std::string path;
+
+  /// Guards \c entries; solving may run on multiple threads.
+  llvm::sys::Mutex mutex;
+
+  /// Maps expression fingerprints (as raw hex strings) to a digest of the
+  /// recorded outcome (currently the number of solutions produced).
+  llvm::StringMap<unsigned> entries;
+
+  /// Whether entries have been added since the cache was loaded.
+  bool dirty = false;
+
+  explicit SolutionCache(StringRef path);
+
+  void load();
+
+public:
+  ~SolutionCache();
+
+  /// Retrieve the process-wide solution cache, or \c nullptr if
+  /// \c -experimental-solution-cache-path was not given.
+  static SolutionCache *getIfEnabled(ASTContext &ctx);
+
+  /// Compute the cache key for the given solution target, or \c None if the
+  /// target is not cacheable (e.g. it has no source text).
+  static Optional<Fingerprint>
+  getKeyForTarget(const SolutionApplicationTarget &target, ASTContext &ctx);
+
+  /// Record that the expression with the given key produced \p numSolutions
+  /// solutions, counting a cache hit if a matching entry was already
+  /// present.
+  void noteSolved(const Fingerprint &key, unsigned numSolutions,
+                  UnifiedStatsReporter *stats);
+};
+
+} // end namespace constraints
+} // end namespace swift
+
+#endif // SWIFT_SEMA_SOLUTIONCACHE_H
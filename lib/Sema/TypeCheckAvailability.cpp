@@ -32,6 +32,7 @@
 #include "swift/Parse/Lexer.h"
 #include "swift/Parse/Parser.h"
 #include "swift/Sema/IDETypeChecking.h"
+#include "swift/Subsystems.h"
 #include "llvm/ADT/MapVector.h"
 #include "llvm/ADT/StringSwitch.h"
 #include "llvm/Support/SaveAndRestore.h"
@@ -847,33 +848,59 @@ private:
   
 } // end anonymous namespace
 
-void TypeChecker::buildTypeRefinementContextHierarchy(SourceFile &SF) {
+/// Create the root type refinement context for the given source file, if it
+/// does not exist yet. The root context reflects the fact that all parts of
+/// the source file are guaranteed to be executing on at least the minimum
+/// platform version.
+static TypeRefinementContext *getOrCreateRootTRC(SourceFile &SF) {
   TypeRefinementContext *RootTRC = SF.getTypeRefinementContext();
-  ASTContext &Context = SF.getASTContext();
-
   if (!RootTRC) {
-    // The root type refinement context reflects the fact that all parts of
-    // the source file are guaranteed to be executing on at least the minimum
-    // platform version.
+    ASTContext &Context = SF.getASTContext();
     auto MinPlatformReq = AvailabilityContext::forDeploymentTarget(Context);
     RootTRC = TypeRefinementContext::createRoot(&SF, MinPlatformReq);
     SF.setTypeRefinementContext(RootTRC);
   }
 
-  // Build refinement contexts, if necessary, for all declarations starting
-  // with StartElem.
+  return RootTRC;
+}
+
+void TypeChecker::buildTypeRefinementContextHierarchy(SourceFile &SF) {
+  TypeRefinementContext *RootTRC = getOrCreateRootTRC(SF);
+  ASTContext &Context = SF.getASTContext();
+
+  // Build refinement contexts for all declarations that do not have them yet.
   TypeRefinementContextBuilder Builder(RootTRC, Context);
   for (auto D : SF.getTopLevelDecls()) {
+    if (SF.hasBuiltTypeRefinementContext(D))
+      continue;
     Builder.build(D);
+    SF.setBuiltTypeRefinementContext(D);
   }
 }
 
+void swift::buildTypeRefinementContexts(SourceFile &SF) {
+  TypeChecker::buildTypeRefinementContextHierarchy(SF);
+}
+
 TypeRefinementContext *
-TypeChecker::getOrBuildTypeRefinementContext(SourceFile *SF) {
-  TypeRefinementContext *TRC = SF->getTypeRefinementContext();
-  if (!TRC) {
-    buildTypeRefinementContextHierarchy(*SF);
-    TRC = SF->getTypeRefinementContext();
+TypeChecker::getOrBuildTypeRefinementContext(SourceFile *SF, SourceLoc Loc) {
+  TypeRefinementContext *TRC = getOrCreateRootTRC(*SF);
+
+  // Most source files contain no availability-sensitive constructs at all,
+  // so refinement contexts are built lazily: the subtree for a top-level
+  // declaration is added on the first availability query inside it. Queries
+  // outside of any top-level declaration are answered by the root context.
+  ASTContext &Context = SF->getASTContext();
+  for (auto D : SF->getTopLevelDecls()) {
+    if (SF->hasBuiltTypeRefinementContext(D))
+      continue;
+    SourceRange Range = D->getSourceRangeIncludingAttrs();
+    if (Range.isInvalid() ||
+        !Context.SourceMgr.rangeContainsTokenLoc(Range, Loc))
+      continue;
+    TypeRefinementContextBuilder(TRC, Context).build(D);
+    SF->setBuiltTypeRefinementContext(D);
+    break;
   }
 
   return TRC;
@@ -924,7 +951,7 @@ TypeChecker::overApproximateAvailabilityAtLocation(SourceLoc loc,
   }
 
   if (SF && loc.isValid()) {
-    TypeRefinementContext *rootTRC = getOrBuildTypeRefinementContext(SF);
+    TypeRefinementContext *rootTRC = getOrBuildTypeRefinementContext(SF, loc);
     TypeRefinementContext *TRC =
         rootTRC->findMostRefinedSubContext(loc, Context.SourceMgr);
     OverApproximateContext.constrainWith(TRC->getAvailabilityInfo());
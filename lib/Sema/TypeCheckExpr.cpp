@@ -415,6 +415,64 @@ namespace {
                != Associativity::Right;
     }
   };
+
+  /// Caches operator-name-to-precedence-group resolutions while folding a
+  /// single sequence expression. Long operator chains repeat the same few
+  /// operators, and the name lookup behind
+  /// lookupPrecedenceGroupForInfixOperator is otherwise redone for every
+  /// operator occurrence. Together with the associativity cache on
+  /// ASTContext this makes folding free of repeated name lookups.
+  class PrecedenceGroupLookupCache {
+    DeclContext *DC;
+    llvm::SmallDenseMap<Identifier, PrecedenceGroupDecl *, 8> Groups;
+
+  public:
+    explicit PrecedenceGroupLookupCache(DeclContext *DC) : DC(DC) {}
+
+    PrecedenceGroupDecl *lookup(Expr *E) {
+      Identifier name = getCacheKey(E);
+      if (!name.empty()) {
+        auto known = Groups.find(name);
+        if (known != Groups.end())
+          return known->second;
+      }
+      auto *group = TypeChecker::lookupPrecedenceGroupForInfixOperator(DC, E);
+      // Only cache successful resolutions, so that failures are still
+      // diagnosed at every use.
+      if (group && !name.empty())
+        Groups[name] = group;
+      return group;
+    }
+
+  private:
+    /// Return the name whose lookup determines the precedence group of \p E,
+    /// or an empty identifier if \p E does not resolve through name lookup.
+    /// Operator names consist of operator characters, so they cannot collide
+    /// with the builtin precedence group names used for the fixed-precedence
+    /// expression kinds.
+    Identifier getCacheKey(Expr *E) {
+      auto &ctx = DC->getASTContext();
+      if (isa<IfExpr>(E))
+        return ctx.Id_TernaryPrecedence;
+      if (isa<AssignExpr>(E))
+        return ctx.Id_AssignmentPrecedence;
+      if (isa<ExplicitCastExpr>(E))
+        return ctx.Id_CastingPrecedence;
+      if (isa<ArrowExpr>(E))
+        return ctx.Id_FunctionArrowPrecedence;
+      if (auto *DRE = dyn_cast<DeclRefExpr>(E))
+        return DRE->getDecl()->getBaseIdentifier();
+      if (auto *OO = dyn_cast<OverloadedDeclRefExpr>(E))
+        return OO->getDecls()[0]->getBaseIdentifier();
+      if (auto *MRE = dyn_cast<MemberRefExpr>(E))
+        return MRE->getDecl().getDecl()->getBaseIdentifier();
+      if (auto *binaryExpr = dyn_cast<BinaryExpr>(E))
+        return getCacheKey(binaryExpr->getFn());
+      if (auto *DSCE = dyn_cast<DotSyntaxCallExpr>(E))
+        return getCacheKey(DSCE->getFn());
+      return Identifier();
+    }
+  };
 } // end anonymous namespace
 
 /// foldSequence - Take a sequence of expressions and fold a prefix of
@@ -422,7 +480,8 @@ namespace {
 static Expr *foldSequence(DeclContext *DC,
                           Expr *LHS,
                           ArrayRef<Expr*> &S,
-                          PrecedenceBound precedenceBound) {
+                          PrecedenceBound precedenceBound,
+                          PrecedenceGroupLookupCache &groupLookup) {
   // Invariant: S is even-sized.
   // Invariant: All elements at even indices are operator references.
   assert(!S.empty());
@@ -440,7 +499,7 @@ static Expr *foldSequence(DeclContext *DC,
     Expr *op = S[0];
 
     // If the operator's precedence is lower than the minimum, stop here.
-    auto opPrecedence = TypeChecker::lookupPrecedenceGroupForInfixOperator(DC, op);
+    auto opPrecedence = groupLookup.lookup(op);
     if (!precedenceBound.shouldConsider(opPrecedence))
       return {nullptr, nullptr};
     return {op, opPrecedence};
@@ -472,7 +531,7 @@ static Expr *foldSequence(DeclContext *DC,
     }
     
     // Pull out the next binary operator.
-    Op op2{ S[0], TypeChecker::lookupPrecedenceGroupForInfixOperator(DC, S[0]) };
+    Op op2{ S[0], groupLookup.lookup(S[0]) };
 
     // If the second operator's precedence is lower than the
     // precedence bound, break out of the loop.
@@ -505,7 +564,8 @@ static Expr *foldSequence(DeclContext *DC,
     if (associativity == Associativity::Right &&
         op1.precedence != op2.precedence) {
       RHS = foldSequence(DC, RHS, S,
-                         PrecedenceBound(op1.precedence, /*strict*/ true));
+                         PrecedenceBound(op1.precedence, /*strict*/ true),
+                         groupLookup);
       continue;
     }
 
@@ -513,14 +573,15 @@ static Expr *foldSequence(DeclContext *DC,
     // starting from this point, then immediately folding the LHS and RHS.
     if (associativity == Associativity::Right) {
       RHS = foldSequence(DC, RHS, S,
-                         PrecedenceBound(op1.precedence, /*strict*/ false));
+                         PrecedenceBound(op1.precedence, /*strict*/ false),
+                         groupLookup);
       LHS = makeBinOp(Ctx, op1.op, LHS, RHS, op1.precedence, S.empty());
 
       // If we've drained the entire sequence, we're done.
       if (S.empty()) return LHS;
 
       // Otherwise, start all over with our new LHS.
-      return foldSequence(DC, LHS, S, precedenceBound);
+      return foldSequence(DC, LHS, S, precedenceBound, groupLookup);
     }
 
     // If we ended up here, it's because we're either:
@@ -550,7 +611,7 @@ static Expr *foldSequence(DeclContext *DC,
     
     // Recover by arbitrarily binding the first two.
     LHS = makeBinOp(Ctx, op1.op, LHS, RHS, op1.precedence, S.empty());
-    return foldSequence(DC, LHS, S, precedenceBound);
+    return foldSequence(DC, LHS, S, precedenceBound, groupLookup);
   }
 
   // Fold LHS and RHS together and declare completion.
@@ -703,7 +764,8 @@ Expr *TypeChecker::foldSequence(SequenceExpr *expr, DeclContext *dc) {
   Expr *LHS = Elts[0];
   Elts = Elts.slice(1);
 
-  Expr *Result = ::foldSequence(dc, LHS, Elts, PrecedenceBound());
+  PrecedenceGroupLookupCache groupLookup(dc);
+  Expr *Result = ::foldSequence(dc, LHS, Elts, PrecedenceBound(), groupLookup);
   assert(Elts.empty());
 
   return Result;
@@ -518,7 +518,21 @@ unsigned TypeChecker::getCallEditDistance(DeclNameRef writtenName,
     return UnreasonableCallEditDistance;
   }
 
-  unsigned distance = writtenBase.edit_distance(correctedBase, maxEditDistance);
+  // The edit distance can never be smaller than the difference in length
+  // between the two names, so most candidates in a large scope can be ruled
+  // out here without running the quadratic distance computation at all.
+  unsigned minPossibleDistance =
+      writtenBase.size() < correctedBase.size()
+          ? correctedBase.size() - writtenBase.size()
+          : writtenBase.size() - correctedBase.size();
+  if (minPossibleDistance >= maxEditDistance ||
+      minPossibleDistance > (correctedBase.size() + 2) / 3) {
+    return UnreasonableCallEditDistance;
+  }
+
+  unsigned distance =
+    writtenBase.edit_distance(correctedBase, /*AllowReplacements=*/true,
+                              maxEditDistance);
 
   // Bound the distance to UnreasonableCallEditDistance.
   if (distance >= maxEditDistance ||
@@ -563,6 +577,14 @@ void TypeChecker::performTypoCorrection(DeclContext *DC, DeclRefKind refKind,
 
   // Fill in a collection of the most reasonable entries.
   TopCollection<unsigned, ValueDecl *> entries(maxResults);
+
+  // Overloads and members mean the same base name is seen many times while
+  // walking a large scope. The maximum interesting distance only shrinks as
+  // better candidates are found, so a distance computed for an earlier
+  // occurrence of a name is still valid for later ones; memoize distances
+  // so each unique name is measured at most once.
+  llvm::DenseMap<DeclBaseName, unsigned> distances;
+
   auto consumer = makeDeclConsumer([&](ValueDecl *decl,
                                        DeclVisibilityKind reason) {
     // Never match an operator with an identifier or vice-versa; this is
@@ -572,14 +594,20 @@ void TypeChecker::performTypoCorrection(DeclContext *DC, DeclRefKind refKind,
 
     const auto candidateName = decl->getName();
 
-    // Don't waste time computing edit distances that are more than
-    // the worst in our collection.
-    unsigned maxDistance =
-      entries.getMinUninterestingScore(UnreasonableCallEditDistance);
-
-    unsigned distance =
-      getCallEditDistance(corrections.WrittenName, candidateName,
-                          maxDistance);
+    unsigned distance;
+    auto known = distances.find(candidateName.getBaseName());
+    if (known != distances.end()) {
+      distance = known->second;
+    } else {
+      // Don't waste time computing edit distances that are more than
+      // the worst in our collection.
+      unsigned maxDistance =
+        entries.getMinUninterestingScore(UnreasonableCallEditDistance);
+
+      distance = getCallEditDistance(corrections.WrittenName, candidateName,
+                                     maxDistance);
+      distances[candidateName.getBaseName()] = distance;
+    }
 
     // Ignore values that are further than a reasonable distance.
     if (distance >= UnreasonableCallEditDistance)
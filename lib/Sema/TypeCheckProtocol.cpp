@@ -55,6 +55,11 @@
 #define DEBUG_TYPE "Protocol conformance checking"
 #include "llvm/Support/Debug.h"
 
+STATISTIC(NumRequirementMatchCacheHits,
+          "# of requirement matches reused from the cache");
+STATISTIC(NumRequirementMatchCacheMisses,
+          "# of requirement matches computed and cached");
+
 using namespace swift;
 
 namespace {
@@ -751,27 +756,6 @@ swift::matchWitness(
   return result;
 }
 
-/// Checks \p reqEnvCache for a requirement environment appropriate for
-/// \p reqSig and \p covariantSelf. If one isn't there, it gets created from
-/// the rest of the parameters.
-///
-/// Note that this means RequirementEnvironmentCaches must not be shared across
-/// multiple protocols or conformances.
-static const RequirementEnvironment &getOrCreateRequirementEnvironment(
-    WitnessChecker::RequirementEnvironmentCache &reqEnvCache,
-    DeclContext *dc, GenericSignature reqSig, ProtocolDecl *proto,
-    ClassDecl *covariantSelf, ProtocolConformance *conformance) {
-  WitnessChecker::RequirementEnvironmentCacheKey cacheKey(reqSig.getPointer(),
-                                                          covariantSelf);
-  auto cacheIter = reqEnvCache.find(cacheKey);
-  if (cacheIter == reqEnvCache.end()) {
-    RequirementEnvironment reqEnv(dc, reqSig, proto, covariantSelf,
-                                  conformance);
-    cacheIter = reqEnvCache.insert({cacheKey, std::move(reqEnv)}).first;
-  }
-  return cacheIter->getSecond();
-}
-
 static Optional<RequirementMatch> findMissingGenericRequirementForSolutionFix(
     constraints::Solution &solution, constraints::ConstraintFix *fix,
     ValueDecl *witness, ProtocolConformance *conformance,
@@ -853,8 +837,7 @@ static Optional<RequirementMatch> findMissingGenericRequirementForSolutionFix(
 }
 
 RequirementMatch
-swift::matchWitness(WitnessChecker::RequirementEnvironmentCache &reqEnvCache,
-                    ProtocolDecl *proto, ProtocolConformance *conformance,
+swift::matchWitness(ProtocolDecl *proto, ProtocolConformance *conformance,
                     DeclContext *dc, ValueDecl *req, ValueDecl *witness) {
   using namespace constraints;
 
@@ -930,8 +913,8 @@ swift::matchWitness(WitnessChecker::RequirementEnvironmentCache &reqEnvCache,
   }
 
   const RequirementEnvironment &reqEnvironment =
-      getOrCreateRequirementEnvironment(reqEnvCache, dc, reqSig, proto,
-                                        covariantSelf, conformance);
+      dc->getASTContext().getOrCreateRequirementEnvironment(
+          dc, reqSig, proto, covariantSelf, conformance);
 
   // Set up the constraint system for matching.
   auto setup = [&]() -> std::tuple<Optional<RequirementMatch>, Type, Type> {
@@ -1209,6 +1192,23 @@ WitnessChecker::lookupValueWitnesses(ValueDecl *req, bool *ignoringNames) {
   return witnesses;
 }
 
+RequirementMatch
+WitnessChecker::matchWitnessCached(ValueDecl *requirement,
+                                   NormalProtocolConformance *conformance,
+                                   ValueDecl *witness) {
+  auto cached = MatchCache.find({requirement, witness});
+  if (cached != MatchCache.end()) {
+    ++NumRequirementMatchCacheHits;
+    return cached->second;
+  }
+
+  ++NumRequirementMatchCacheMisses;
+  auto match = matchWitness(Proto, conformance, DC,
+                            requirement, witness);
+  MatchCache.insert({{requirement, witness}, match});
+  return match;
+}
+
 bool WitnessChecker::findBestWitness(
                                ValueDecl *requirement,
                                bool *ignoringNames,
@@ -1271,8 +1271,7 @@ bool WitnessChecker::findBestWitness(
         continue;
       }
 
-      auto match = matchWitness(ReqEnvironmentCache, Proto, conformance,
-                                DC, requirement, witness);
+      auto match = matchWitnessCached(requirement, conformance, witness);
       if (match.isViable()) {
         ++numViable;
         bestIdx = matches.size();
@@ -1296,7 +1295,7 @@ bool WitnessChecker::findBestWitness(
     if (conformance && !conformance->isInvalid()) {
       if (auto *SF = DC->getParentSourceFile()) {
         if (SF->Kind == SourceFileKind::Interface) {
-          auto match = matchWitness(ReqEnvironmentCache, Proto,
+          auto match = matchWitness(Proto,
                                     conformance, DC, requirement, requirement);
           assert(match.isViable());
           numViable = 1;
@@ -4027,7 +4026,7 @@ ResolveWitnessResult ConformanceChecker::resolveWitnessViaDerivation(
     return ResolveWitnessResult::ExplicitFailed;
 
   // Try to match the derived requirement.
-  auto match = matchWitness(ReqEnvironmentCache, Proto, Conformance, DC,
+  auto match = matchWitness(Proto, Conformance, DC,
                             requirement, derived);
   if (match.isViable()) {
     recordWitness(requirement, match);
@@ -5237,9 +5236,8 @@ static void diagnosePotentialWitness(NormalProtocolConformance *conformance,
                     req->getName(), proto->getName());
 
   // Describe why the witness didn't satisfy the requirement.
-  WitnessChecker::RequirementEnvironmentCache oneUseCache;
   auto dc = conformance->getDeclContext();
-  auto match = matchWitness(oneUseCache, conformance->getProtocol(),
+  auto match = matchWitness(conformance->getProtocol(),
                             conformance, dc, req, witness);
   if (match.Kind == MatchKind::ExactMatch &&
       req->isObjC() && !witness->isObjC()) {
@@ -5821,7 +5819,6 @@ swift::findWitnessedObjCRequirements(const ValueDecl *witness,
     }
   }
 
-  WitnessChecker::RequirementEnvironmentCache reqEnvCache;
   ASTContext &ctx = nominal->getASTContext();
   for (auto proto : nominal->getAllProtocols()) {
     // We only care about Objective-C protocols.
@@ -5875,7 +5872,7 @@ swift::findWitnessedObjCRequirements(const ValueDecl *witness,
         if (accessorKind)
           witnessToMatch = cast<AccessorDecl>(witness)->getStorage();
 
-        if (matchWitness(reqEnvCache, proto, *conformance,
+        if (matchWitness(proto, *conformance,
                          witnessToMatch->getDeclContext(), req,
                          const_cast<ValueDecl *>(witnessToMatch))
               .Kind == MatchKind::ExactMatch) {
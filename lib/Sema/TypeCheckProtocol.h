@@ -555,12 +555,6 @@ struct RequirementMatch {
 struct RequirementCheck;
 
 class WitnessChecker {
-public:
-  using RequirementEnvironmentCacheKey =
-      std::pair<const GenericSignatureImpl *, const ClassDecl *>;
-  using RequirementEnvironmentCache =
-      llvm::DenseMap<RequirementEnvironmentCacheKey, RequirementEnvironment>;
-
 protected:
   ASTContext &Context;
   ProtocolDecl *Proto;
@@ -574,7 +568,13 @@ protected:
   // @_implements(Protocol, DeclName)
   llvm::DenseMap<DeclName, llvm::TinyPtrVector<ValueDecl *>> ImplementsTable;
 
-  RequirementEnvironmentCache ReqEnvironmentCache;
+  /// Caches the result of matching a requirement against a witness, so that
+  /// repeated resolution passes over the same conformance don't rank the
+  /// same (requirement, witness) pair again. The match result is expressed
+  /// in terms of this conformance's archetypes, so the cache must not be
+  /// shared across conformances.
+  llvm::DenseMap<std::pair<ValueDecl *, ValueDecl *>, RequirementMatch>
+      MatchCache;
 
   Optional<std::pair<AccessScope, bool>> RequiredAccessScopeAndUsableFromInline;
 
@@ -604,6 +604,12 @@ protected:
                                              SmallVector<ValueDecl *, 4>
                                              &witnesses);
 
+  /// Match the given requirement against the given witness, consulting and
+  /// populating \c MatchCache.
+  RequirementMatch matchWitnessCached(ValueDecl *requirement,
+                                      NormalProtocolConformance *conformance,
+                                      ValueDecl *witness);
+
   bool findBestWitness(ValueDecl *requirement,
                        bool *ignoringNames,
                        NormalProtocolConformance *conformance,
@@ -893,6 +899,21 @@ class AssociatedTypeInference {
   Optional<TypeWitnessConflict> typeWitnessConflict;
   unsigned numTypeWitnessesBeforeConflict = 0;
 
+  /// The associated type members of the protocol, cached by findSolutions()
+  /// for encoding solver states.
+  llvm::TinyPtrVector<AssociatedTypeDecl *> assocTypeMembers;
+
+  /// Solver states that findSolutionsRec() has fully explored, keyed by a
+  /// hash of the encoded state. Re-visiting such a state cannot produce any
+  /// new solutions, so the whole subtree is pruned.
+  llvm::DenseMap<uint64_t, llvm::SmallVector<llvm::SmallVector<const void *, 8>, 2>>
+      exploredSolverStates;
+
+  /// Counters for the current findSolutions() search, reported by
+  /// -debug-time-associated-type-inference.
+  unsigned numSolverStatesExplored = 0;
+  unsigned numSolverStatesPruned = 0;
+
 public:
   AssociatedTypeInference(ASTContext &ctx,
                           NormalProtocolConformance *conformance);
@@ -977,6 +998,15 @@ private:
                  ArrayRef<AssociatedTypeDecl *> unresolvedAssocTypes,
                  SmallVectorImpl<InferredTypeWitnessesSolution> &solutions);
 
+  /// Encode the solver state at the given requirement depth -- the tentative
+  /// type witness bindings, together with whether each binding came from an
+  /// associated type default -- as a flat key for duplicate-state pruning.
+  void encodeCurrentSolverState(
+         unsigned reqDepth,
+         const SmallVectorImpl<std::pair<ValueDecl *, ValueDecl *>>
+           &valueWitnesses,
+         SmallVectorImpl<const void *> &key);
+
   /// Explore the solution space to find both viable and non-viable solutions.
   void findSolutionsRec(
          ArrayRef<AssociatedTypeDecl *> unresolvedAssocTypes,
@@ -1049,8 +1079,7 @@ RequirementMatch matchWitness(
                    > finalize);
 
 RequirementMatch
-matchWitness(WitnessChecker::RequirementEnvironmentCache &reqEnvCache,
-             ProtocolDecl *proto, ProtocolConformance *conformance,
+matchWitness(ProtocolDecl *proto, ProtocolConformance *conformance,
              DeclContext *dc, ValueDecl *req, ValueDecl *witness);
 
 /// If the given type is a direct reference to an associated type of
@@ -27,6 +27,8 @@
 #include "swift/ClangImporter/ClangModule.h"
 #include "llvm/ADT/Statistic.h"
 #include "llvm/ADT/TinyPtrVector.h"
+#include "llvm/Support/Format.h"
+#include "llvm/Support/Timer.h"
 
 #define DEBUG_TYPE "Associated type inference"
 #include "llvm/Support/Debug.h"
@@ -38,6 +40,8 @@ STATISTIC(NumConstrainedExtensionChecks,
           "# of constrained extension checks");
 STATISTIC(NumConstrainedExtensionChecksFailed,
           "# of constrained extension checks failed");
+STATISTIC(NumDuplicateSolverStatesPruned,
+          "# of duplicate solver states pruned");
 STATISTIC(NumDuplicateSolutionStates,
           "# of duplicate solution states ");
 
@@ -1222,12 +1226,40 @@ AssociatedTypeDecl *AssociatedTypeInference::completeSolution(
 void AssociatedTypeInference::findSolutions(
                    ArrayRef<AssociatedTypeDecl *> unresolvedAssocTypes,
                    SmallVectorImpl<InferredTypeWitnessesSolution> &solutions) {
+  assocTypeMembers = proto->getAssociatedTypeMembers();
+  exploredSolverStates.clear();
+  numSolverStatesExplored = 0;
+  numSolverStatesPruned = 0;
+
   SmallVector<InferredTypeWitnessesSolution, 4> nonViableSolutions;
   SmallVector<std::pair<ValueDecl *, ValueDecl *>, 4> valueWitnesses;
   findSolutionsRec(unresolvedAssocTypes, solutions, nonViableSolutions,
                    valueWitnesses, 0, 0, 0);
 }
 
+void AssociatedTypeInference::encodeCurrentSolverState(
+       unsigned reqDepth,
+       const SmallVectorImpl<std::pair<ValueDecl *, ValueDecl *>>
+         &valueWitnesses,
+       SmallVectorImpl<const void *> &key) {
+  key.push_back((const void *)(uintptr_t)reqDepth);
+  for (auto *assocType : assocTypeMembers) {
+    auto known = typeWitnesses.begin(assocType);
+    if (known == typeWitnesses.end())
+      continue;
+
+    // Record the binding, canonicalized so that sugared spellings of the
+    // same type witness land on the same state.
+    key.push_back(assocType);
+    key.push_back(known->first->getCanonicalType().getPointer());
+
+    // Whether the binding came from an associated type default matters:
+    // defaulted bindings are never overwritten during conflict resolution.
+    auto *witness = valueWitnesses[known->second].second;
+    key.push_back((const void *)(uintptr_t)(witness && isa<TypeDecl>(witness)));
+  }
+}
+
 void AssociatedTypeInference::findSolutionsRec(
           ArrayRef<AssociatedTypeDecl *> unresolvedAssocTypes,
           SmallVectorImpl<InferredTypeWitnessesSolution> &solutions,
@@ -1318,6 +1350,27 @@ void AssociatedTypeInference::findSolutionsRec(
     return;
   }
 
+  // If we've already fully explored an identical solver state, every
+  // solution reachable from here was recorded back then and would only be
+  // discarded as a duplicate, so prune the whole subtree.
+  SmallVector<const void *, 8> stateKey;
+  encodeCurrentSolverState(reqDepth, valueWitnesses, stateKey);
+  uint64_t stateHash =
+      llvm::hash_combine_range(stateKey.begin(), stateKey.end());
+  // Stay clear of the DenseMap sentinel keys.
+  if (stateHash >= ~(uint64_t)1)
+    stateHash = 0;
+  {
+    auto knownStates = exploredSolverStates.find(stateHash);
+    if (knownStates != exploredSolverStates.end() &&
+        llvm::is_contained(knownStates->second, stateKey)) {
+      ++NumDuplicateSolverStatesPruned;
+      ++numSolverStatesPruned;
+      return;
+    }
+  }
+  ++numSolverStatesExplored;
+
   // Iterate over the potential witnesses for this requirement,
   // looking for solutions involving each one.
   const auto &inferredReq = inferred[reqDepth];
@@ -1428,6 +1481,15 @@ void AssociatedTypeInference::findSolutionsRec(
                      valueWitnesses, numTypeWitnesses,
                      numValueWitnessesInProtocolExtensions, reqDepth + 1);
   }
+
+  // Remember this state, but only if exploring it left the tentative
+  // bindings untouched: conflict resolution can rewrite bindings introduced
+  // at outer requirement depths in place, and replaying a subtree that did
+  // so would not be side-effect free.
+  SmallVector<const void *, 8> stateAfter;
+  encodeCurrentSolverState(reqDepth, valueWitnesses, stateAfter);
+  if (stateAfter == stateKey)
+    exploredSolverStates[stateHash].push_back(std::move(stateKey));
 }
 
 static Comparison compareDeclsForInference(DeclContext *DC, ValueDecl *decl1,
@@ -1947,6 +2009,10 @@ auto AssociatedTypeInference::solve(ConformanceChecker &checker)
   if (unresolvedAssocTypes.empty())
     return result;
 
+  llvm::TimeRecord startTime;
+  if (ctx.TypeCheckerOpts.DebugTimeAssociatedTypeInference)
+    startTime = llvm::TimeRecord::getCurrentTime();
+
   // Infer potential type witnesses from value witnesses.
   inferred = inferTypeWitnessesViaValueWitnesses(checker,
                                                  unresolvedAssocTypes);
@@ -1957,6 +2023,24 @@ auto AssociatedTypeInference::solve(ConformanceChecker &checker)
   SmallVector<InferredTypeWitnessesSolution, 4> solutions;
   findSolutions(unresolvedAssocTypes.getArrayRef(), solutions);
 
+  if (ctx.TypeCheckerOpts.DebugTimeAssociatedTypeInference) {
+    llvm::TimeRecord endTime = llvm::TimeRecord::getCurrentTime(false);
+    auto elapsed = endTime.getProcessTime() - startTime.getProcessTime();
+
+    unsigned numCandidates = 0;
+    for (const auto &inferredReq : inferred)
+      numCandidates += inferredReq.second.size();
+
+    llvm::errs() << llvm::format("%0.2f", elapsed * 1000) << "ms\t";
+    conformance->getLoc().print(llvm::errs(), ctx.SourceMgr);
+    llvm::errs() << "\tassociated type inference for " << adoptee
+                 << ": " << proto->getName()
+                 << " (" << unresolvedAssocTypes.size() << " unresolved, "
+                 << numCandidates << " candidates, "
+                 << numSolverStatesExplored << " states explored, "
+                 << numSolverStatesPruned << " pruned)\n";
+  }
+
   // Go make sure that type declarations that would act as witnesses
   // did not get injected while we were performing checks above. This
   // can happen when two associated types in different protocols have
@@ -484,6 +484,19 @@ static bool typeCheckConditionForStatement(LabeledConditionalStmt *stmt,
               }
       }
 
+      // The refinement context builder is what computes the version range
+      // this query tests at run time and diagnoses queries that are useless
+      // in their enclosing scope. Contexts are built lazily, per top-level
+      // declaration, when availability of a reference is checked; a body
+      // whose references are all unconditionally available never triggers
+      // that, so force the build here. SILGen requires every query to carry
+      // a non-empty range.
+      if (!Context.LangOpts.DisableAvailabilityChecking) {
+        if (auto *SF = dc->getParentSourceFile())
+          TypeChecker::getOrBuildTypeRefinementContext(SF,
+                                                       info->getStartLoc());
+      }
+
       continue;
     }
 
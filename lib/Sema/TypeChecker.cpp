@@ -300,11 +300,8 @@ TypeCheckSourceFileRequest::evaluate(Evaluator &eval, SourceFile *SF) const {
     FrontendStatsTracer tracer(Ctx.Stats,
                                "Type checking and Semantic analysis");
 
-    if (!Ctx.LangOpts.DisableAvailabilityChecking) {
-      // Build the type refinement hierarchy for the primary
-      // file before type checking.
-      TypeChecker::buildTypeRefinementContextHierarchy(*SF);
-    }
+    // The type refinement context hierarchy for the file is built lazily,
+    // per top-level declaration, on the first availability query inside it.
 
     // Type check the top-level elements of the source file.
     for (auto D : SF->getTopLevelDecls()) {
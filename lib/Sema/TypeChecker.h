@@ -984,13 +984,16 @@ AvailabilityContext overApproximateAvailabilityAtLocation(
     SourceLoc loc, const DeclContext *DC,
     const TypeRefinementContext **MostRefined = nullptr);
 
-/// Walk the AST to build the hierarchy of TypeRefinementContexts
+/// Walk the AST to build the hierarchy of TypeRefinementContexts for the
+/// entire source file. Subtrees that have already been built lazily are
+/// not rebuilt.
 void buildTypeRefinementContextHierarchy(SourceFile &SF);
 
-/// Build the hierarchy of TypeRefinementContexts for the entire
-/// source file, if it has not already been built. Returns the root
-/// TypeRefinementContext for the source file.
-TypeRefinementContext *getOrBuildTypeRefinementContext(SourceFile *SF);
+/// Build enough of the TypeRefinementContext hierarchy to answer
+/// availability queries at the given location, if it has not already been
+/// built. Returns the root TypeRefinementContext for the source file.
+TypeRefinementContext *getOrBuildTypeRefinementContext(SourceFile *SF,
+                                                       SourceLoc Loc);
 
 /// Returns a diagnostic indicating why the declaration cannot be annotated
 /// with an @available() attribute indicating it is potentially unavailable
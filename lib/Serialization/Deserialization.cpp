@@ -44,12 +44,18 @@
 STATISTIC(NumDeclsLoaded, "# of decls deserialized");
 STATISTIC(NumMemberListsLoaded,
           "# of nominals/extensions whose members were loaded");
+STATISTIC(NumMemberListMembersLoaded,
+          "# of member decls loaded together with their container");
 STATISTIC(NumNormalProtocolConformancesLoaded,
           "# of normal protocol conformances deserialized");
 STATISTIC(NumNormalProtocolConformancesCompleted,
           "# of normal protocol conformances completed");
 STATISTIC(NumNestedTypeShortcuts,
           "# of nested types resolved without full lookup");
+STATISTIC(NumXRefsResolved,
+          "# of cross-references resolved by replaying name lookup");
+STATISTIC(NumXRefPathPieces,
+          "# of path pieces processed while resolving cross-references");
 
 using namespace swift;
 using namespace swift::serialization;
@@ -1266,6 +1272,11 @@ ModuleFile::resolveCrossReference(ModuleID MID, uint32_t pathLen) {
   assert(baseModule && "missing dependency");
   PrettyXRefTrace pathTrace(*baseModule);
 
+  ++NumXRefsResolved;
+  ++NumXRefPathPieces;
+  if (auto *Stats = getContext().Stats)
+    ++Stats->getFrontendCounters().NumXRefsDeserialized;
+
   llvm::BitstreamEntry entry =
       fatalIfUnexpected(DeclTypeCursor.advance(AF_DontPopBlockAtEnd));
   if (entry.Kind != llvm::BitstreamEntry::Record)
@@ -1469,6 +1480,7 @@ ModuleFile::resolveCrossReference(ModuleID MID, uint32_t pathLen) {
 
   // For remaining path pieces, filter or drill down into the results we have.
   while (--pathLen) {
+    ++NumXRefPathPieces;
     llvm::BitstreamEntry entry =
         fatalIfUnexpected(DeclTypeCursor.advance(AF_DontPopBlockAtEnd));
     if (entry.Kind != llvm::BitstreamEntry::Record)
@@ -5956,6 +5968,23 @@ Decl *handleErrorAndSupplyMissingMember(ASTContext &context, Decl *container,
   return handleErrorAndSupplyMissingMiscMember(std::move(error));
 }
 
+/// Touch one byte per page over a bit range of \p cursor's underlying buffer
+/// so that a file-backed buffer is read ahead in one sequential pass rather
+/// than demand-faulted page by page during decoding.
+static void prefetchBitstreamRange(llvm::BitstreamCursor &cursor,
+                                   uint64_t startBit, uint64_t endBit) {
+  ArrayRef<uint8_t> bytes = cursor.getBitcodeBytes();
+  const uint64_t pageSize = 4096;
+  uint64_t start = std::min<uint64_t>(startBit / 8, bytes.size());
+  // The length of the record at \p endBit isn't known yet; include one extra
+  // page of slack for its tail.
+  uint64_t end = std::min<uint64_t>(endBit / 8 + pageSize, bytes.size());
+  volatile uint8_t sink = 0;
+  for (uint64_t i = start; i < end; i += pageSize)
+    sink += bytes[i];
+  (void)sink;
+}
+
 void ModuleFile::loadAllMembers(Decl *container, uint64_t contextData) {
   PrettyStackTraceDecl trace("loading members for", container);
   ++NumMemberListsLoaded;
@@ -5985,6 +6014,23 @@ void ModuleFile::loadAllMembers(Decl *container, uint64_t contextData) {
   if (rawMemberIDs.empty())
     return;
 
+  // The serializer assigns a container's members consecutive IDs and writes
+  // their records contiguously after the container, so compute the range of
+  // records still to be decoded and warm it up front.
+  uint64_t firstMemberBit = ~uint64_t(0), lastMemberBit = 0;
+  for (DeclID rawID : rawMemberIDs) {
+    if (rawID == 0 || rawID > Decls.size())
+      continue;
+    auto &slot = Decls[rawID - 1];
+    if (slot.isComplete())
+      continue;
+    uint64_t bit = slot;
+    firstMemberBit = std::min(firstMemberBit, bit);
+    lastMemberBit = std::max(lastMemberBit, bit);
+  }
+  if (firstMemberBit <= lastMemberBit)
+    prefetchBitstreamRange(DeclTypeCursor, firstMemberBit, lastMemberBit);
+
   SmallVector<Decl *, 16> members;
   members.reserve(rawMemberIDs.size());
   for (DeclID rawID : rawMemberIDs) {
@@ -6003,6 +6049,8 @@ void ModuleFile::loadAllMembers(Decl *container, uint64_t contextData) {
     }
   }
 
+  NumMemberListMembersLoaded += members.size();
+
   for (auto member : members)
     IDC->addMember(member);
 
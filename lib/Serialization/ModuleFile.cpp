@@ -27,11 +27,19 @@
 #include "swift/Basic/Range.h"
 #include "swift/ClangImporter/ClangImporter.h"
 #include "swift/Serialization/SerializedModuleLoader.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/ADT/StringExtras.h"
 #include "llvm/Support/Chrono.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/OnDiskHashTable.h"
 
+#define DEBUG_TYPE "Serialization"
+
+STATISTIC(NumNamedLazyMemberLoads,
+          "# of per-name lazy member lookups");
+STATISTIC(NumNamedLazyMembersLoaded,
+          "# of member decls loaded via per-name lazy lookup");
+
 using namespace swift;
 using namespace swift::serialization;
 using namespace llvm::support;
@@ -674,14 +682,27 @@ ModuleFile::loadNamedMembers(const IterableDeclContext *IDC, DeclBaseName N,
   PrettyStackTraceDecl trace("loading members for", IDC->getDecl());
 
   assert(IDC->wasDeserialized());
-  assert(Core->DeclMemberNames);
+
+  ++NumNamedLazyMemberLoads;
 
   TinyPtrVector<ValueDecl *> results;
-  auto i = Core->DeclMemberNames->find(N);
-  if (i == Core->DeclMemberNames->end())
+  auto cachedOffset = DeclMemberNameOffsetCache.find(N);
+  if (cachedOffset == DeclMemberNameOffsetCache.end()) {
+    auto *declMemberNames = Core->getDeclMemberNamesTable();
+    assert(declMemberNames && "missing or malformed DECL_MEMBER_NAMES table");
+    if (!declMemberNames)
+      return results;
+    Optional<uint64_t> offset;
+    auto i = declMemberNames->find(N);
+    if (i != declMemberNames->end())
+      offset = *i;
+    cachedOffset =
+        DeclMemberNameOffsetCache.insert({N, offset}).first;
+  }
+  if (!cachedOffset->second)
     return results;
 
-  BitOffset subTableOffset = *i;
+  BitOffset subTableOffset = *cachedOffset->second;
   std::unique_ptr<SerializedDeclMembersTable> &subTable =
     DeclMembersTables[subTableOffset];
   if (!subTable) {
@@ -719,6 +740,7 @@ ModuleFile::loadNamedMembers(const IterableDeclContext *IDC, DeclBaseName N,
       }
     }
   }
+  NumNamedLazyMembersLoaded += results.size();
   return results;
 }
 
@@ -1036,10 +1058,30 @@ Result.X.Column = ReadNext();
 
 const static StringRef Separator = "/";
 
+ModuleFileSharedCore::GroupNameTable *ModuleFile::getGroupNameTable() const {
+  if (GroupNamesMap)
+    return GroupNamesMap.get();
+  StringRef BlobData = Core->GroupNamesData;
+  if (BlobData.empty())
+    return nullptr;
+  auto pMap = std::make_unique<llvm::DenseMap<unsigned, StringRef>>();
+  auto Data = reinterpret_cast<const uint8_t *>(BlobData.data());
+  unsigned GroupCount = endian::readNext<uint32_t, little, unaligned>(Data);
+  for (unsigned I = 0; I < GroupCount; ++I) {
+    auto RawSize = endian::readNext<uint32_t, little, unaligned>(Data);
+    auto RawText = StringRef(reinterpret_cast<const char *>(Data), RawSize);
+    Data += RawSize;
+    (*pMap)[I] = RawText;
+  }
+  GroupNamesMap = std::move(pMap);
+  return GroupNamesMap.get();
+}
+
 Optional<StringRef> ModuleFile::getGroupNameById(unsigned Id) const {
-  if (!Core->GroupNamesMap)
+  auto *GroupNames = getGroupNameTable();
+  if (!GroupNames)
     return None;
-  const auto &GroupNamesMap = *Core->GroupNamesMap;
+  const auto &GroupNamesMap = *GroupNames;
   auto it = GroupNamesMap.find(Id);
   if (it == GroupNamesMap.end())
     return None;
@@ -1052,9 +1094,10 @@ Optional<StringRef> ModuleFile::getGroupNameById(unsigned Id) const {
 }
 
 Optional<StringRef> ModuleFile::getSourceFileNameById(unsigned Id) const {
-  if (!Core->GroupNamesMap)
+  auto *GroupNames = getGroupNameTable();
+  if (!GroupNames)
     return None;
-  const auto &GroupNamesMap = *Core->GroupNamesMap;
+  const auto &GroupNamesMap = *GroupNames;
   auto it = GroupNamesMap.find(Id);
   if (it == GroupNamesMap.end())
     return None;
@@ -1096,9 +1139,10 @@ ModuleFile::getSourceOrderForDecl(const Decl *D) const {
 }
 
 void ModuleFile::collectAllGroups(std::vector<StringRef> &Names) const {
-  if (!Core->GroupNamesMap)
+  auto *GroupNames = getGroupNameTable();
+  if (!GroupNames)
     return;
-  for (auto It = Core->GroupNamesMap->begin(); It != Core->GroupNamesMap->end();
+  for (auto It = GroupNames->begin(); It != GroupNames->end();
        ++It) {
     StringRef FullGroupName = It->getSecond();
     if (FullGroupName.empty())
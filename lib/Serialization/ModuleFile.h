@@ -286,6 +286,13 @@ private:
   llvm::DenseMap<uint32_t,
            std::unique_ptr<SerializedDeclMembersTable>> DeclMembersTables;
 
+  /// Memoized lookups into the DECL_MEMBER_NAMES on-disk hash table, mapping
+  /// a member base name to the offset of its members subtable, or \c None if
+  /// the name occurs nowhere in this module. Named lazy member loading asks
+  /// about the same names once per nominal and extension, so this avoids
+  /// re-hashing and re-probing the on-disk table for every context.
+  llvm::DenseMap<DeclBaseName, Optional<uint64_t>> DeclMemberNameOffsetCache;
+
   llvm::DenseMap<const ValueDecl *, Identifier> PrivateDiscriminatorsByValue;
   llvm::DenseMap<const ValueDecl *, StringRef> FilenamesForPrivateValues;
 
@@ -296,6 +303,14 @@ private:
       std::unique_ptr<ModuleFileSharedCore::DeserializedCommentInfo>>
       CommentsCache;
 
+  /// Maps group IDs to group names, decoded from the core's GROUP_NAMES blob
+  /// on the first group-name query.
+  mutable std::unique_ptr<ModuleFileSharedCore::GroupNameTable> GroupNamesMap;
+
+  /// Returns the table of group names, decoding it on first use, or nullptr
+  /// if the module has no group information.
+  ModuleFileSharedCore::GroupNameTable *getGroupNameTable() const;
+
   struct ModuleBits {
     /// Whether or not ImportDecls is valid.
     unsigned ComputedImportDecls : 1;
@@ -15,6 +15,7 @@
 #include "BCReadingExtras.h"
 #include "DeserializationErrors.h"
 #include "swift/Strings.h"
+#include "llvm/Support/Compression.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/OnDiskHashTable.h"
 
@@ -510,7 +511,18 @@ std::unique_ptr<ModuleFileSharedCore::SerializedDeclMemberNamesTable>
 ModuleFileSharedCore::readDeclMemberNamesTable(ArrayRef<uint64_t> fields,
                                      StringRef blobData) const {
   uint32_t tableOffset;
-  index_block::DeclMemberNamesLayout::readRecord(fields, tableOffset);
+  uint32_t uncompressedSize;
+  index_block::DeclMemberNamesLayout::readRecord(fields, tableOffset,
+                                                 uncompressedSize);
+
+  if (uncompressedSize != 0) {
+    // Defer inflating the blob until the table is first used.
+    CompressedDeclMemberNames.Blob = blobData;
+    CompressedDeclMemberNames.TableOffset = tableOffset;
+    CompressedDeclMemberNames.UncompressedSize = uncompressedSize;
+    return nullptr;
+  }
+
   auto base = reinterpret_cast<const uint8_t *>(blobData.data());
 
   using OwnedTable = std::unique_ptr<SerializedDeclMemberNamesTable>;
@@ -518,6 +530,27 @@ ModuleFileSharedCore::readDeclMemberNamesTable(ArrayRef<uint64_t> fields,
       base + sizeof(uint32_t), base));
 }
 
+const ModuleFileSharedCore::SerializedDeclMemberNamesTable *
+ModuleFileSharedCore::getDeclMemberNamesTable() const {
+  auto &compressed = CompressedDeclMemberNames;
+  llvm::sys::SmartScopedLock<true> lock(compressed.Mutex);
+  if (!DeclMemberNames && compressed.UncompressedSize != 0) {
+    if (llvm::Error E = llvm::zlib::uncompress(compressed.Blob,
+                                               compressed.Scratch,
+                                               compressed.UncompressedSize)) {
+      // The blob is malformed; treat the table as absent rather than
+      // crashing. Callers already handle modules without member name tables.
+      llvm::consumeError(std::move(E));
+      compressed.UncompressedSize = 0;
+      return nullptr;
+    }
+    auto base = reinterpret_cast<const uint8_t *>(compressed.Scratch.data());
+    DeclMemberNames.reset(SerializedDeclMemberNamesTable::Create(
+        base + compressed.TableOffset, base + sizeof(uint32_t), base));
+  }
+  return DeclMemberNames.get();
+}
+
 std::unique_ptr<ModuleFileSharedCore::SerializedDeclMembersTable>
 ModuleFileSharedCore::readDeclMembersTable(ArrayRef<uint64_t> fields,
                                      StringRef blobData) const {
@@ -748,21 +781,6 @@ ModuleFileSharedCore::readDeclCommentTable(ArrayRef<uint64_t> fields,
                                        base + sizeof(uint32_t), base));
 }
 
-std::unique_ptr<ModuleFileSharedCore::GroupNameTable>
-ModuleFileSharedCore::readGroupTable(ArrayRef<uint64_t> Fields,
-                                     StringRef BlobData) const {
-  auto pMap = std::make_unique<llvm::DenseMap<unsigned, StringRef>>();
-  auto Data = reinterpret_cast<const uint8_t *>(BlobData.data());
-  unsigned GroupCount = endian::readNext<uint32_t, little, unaligned>(Data);
-  for (unsigned I = 0; I < GroupCount; ++I) {
-    auto RawSize = endian::readNext<uint32_t, little, unaligned>(Data);
-    auto RawText = StringRef(reinterpret_cast<const char *>(Data), RawSize);
-    Data += RawSize;
-    (*pMap)[I] = RawText;
-  }
-  return std::unique_ptr<ModuleFileSharedCore::GroupNameTable>(pMap.release());
-}
-
 bool ModuleFileSharedCore::readCommentBlock(llvm::BitstreamCursor &cursor) {
   if (llvm::Error Err = cursor.EnterSubBlock(COMMENT_BLOCK_ID)) {
     // FIXME this drops the error on the floor.
@@ -810,7 +828,7 @@ bool ModuleFileSharedCore::readCommentBlock(llvm::BitstreamCursor &cursor) {
         DeclCommentTable = readDeclCommentTable(scratch, blobData);
         break;
       case comment_block::GROUP_NAMES:
-        GroupNamesMap = readGroupTable(scratch, blobData);
+        GroupNamesData = blobData;
         break;
       default:
         // Unknown index kind, which this version of the compiler won't use.
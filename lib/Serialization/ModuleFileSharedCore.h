@@ -17,7 +17,9 @@
 #include "swift/AST/LinkLibrary.h"
 #include "swift/AST/Module.h"
 #include "swift/Serialization/Validation.h"
+#include "llvm/ADT/SmallVector.h"
 #include "llvm/Bitstream/BitstreamReader.h"
+#include "llvm/Support/Mutex.h"
 
 namespace llvm {
   template <typename Info> class OnDiskIterableChainedHashTable;
@@ -253,7 +255,26 @@ private:
   std::unique_ptr<SerializedLocalDeclTable> LocalTypeDecls;
   std::unique_ptr<SerializedOpaqueReturnTypeDeclTable> OpaqueReturnTypeDecls;
   std::unique_ptr<SerializedNestedTypeDeclsTable> NestedTypeDecls;
-  std::unique_ptr<SerializedDeclMemberNamesTable> DeclMemberNames;
+  mutable std::unique_ptr<SerializedDeclMemberNamesTable> DeclMemberNames;
+
+  /// State for a compressed DECL_MEMBER_NAMES record. The blob is inflated
+  /// and turned into \c DeclMemberNames the first time
+  /// getDeclMemberNamesTable() is called, so modules whose members are never
+  /// looked up by name don't pay for decompression.
+  struct CompressedDeclMemberNamesInfo {
+    /// The deflated table blob, pointing into the module's input buffer.
+    StringRef Blob;
+    /// Offset of the hash table within the inflated blob.
+    uint32_t TableOffset = 0;
+    /// Size of the inflated blob; 0 if the record was not compressed.
+    uint32_t UncompressedSize = 0;
+    /// Storage for the inflated blob.
+    llvm::SmallVector<char, 0> Scratch;
+    /// Guards lazy inflation; the shared core may be referenced from several
+    /// ASTContexts.
+    llvm::sys::SmartMutex<true> Mutex;
+  };
+  mutable CompressedDeclMemberNamesInfo CompressedDeclMemberNames;
   std::unique_ptr<SerializedDeclFingerprintsTable> DeclFingerprints;
 
   class ObjCMethodTableInfo;
@@ -272,7 +293,10 @@ private:
 
   using GroupNameTable = const llvm::DenseMap<unsigned, StringRef>;
 
-  std::unique_ptr<GroupNameTable> GroupNamesMap;
+  /// The raw GROUP_NAMES blob from the comment block. It is decoded lazily
+  /// by \c ModuleFile on the first group-name query; most module loads never
+  /// ask for group names.
+  StringRef GroupNamesData;
   std::unique_ptr<SerializedDeclCommentTable> DeclCommentTable;
 
   class DeclUSRTableInfo;
@@ -397,9 +421,20 @@ private:
 
   /// Read an on-disk local decl-name hash table stored in
   /// index_block::DeclMemberNamesLayout format.
+  ///
+  /// If the record is compressed, this stashes the blob in
+  /// \c CompressedDeclMemberNames and returns null; the table is then built
+  /// lazily by getDeclMemberNamesTable().
   std::unique_ptr<SerializedDeclMemberNamesTable>
   readDeclMemberNamesTable(ArrayRef<uint64_t> fields, StringRef blobData) const;
 
+  /// Returns the table of member names for lazy member loading, inflating a
+  /// compressed DECL_MEMBER_NAMES record on first use.
+  ///
+  /// Returns null if the module has no such table, or if the compressed blob
+  /// is malformed.
+  const SerializedDeclMemberNamesTable *getDeclMemberNamesTable() const;
+
   /// Read an on-disk local decl-members hash table stored in
   /// index_block::DeclMembersLayout format.
   std::unique_ptr<SerializedDeclMembersTable>
@@ -427,9 +462,6 @@ private:
   std::unique_ptr<SerializedDeclCommentTable>
   readDeclCommentTable(ArrayRef<uint64_t> fields, StringRef blobData) const;
 
-  std::unique_ptr<GroupNameTable>
-  readGroupTable(ArrayRef<uint64_t> fields, StringRef blobData) const;
-
   /// Reads the comment block, which contains USR to comment mappings.
   ///
   /// Returns false if there was an error.
@@ -56,7 +56,7 @@ const uint16_t SWIFTMODULE_VERSION_MAJOR = 0;
 /// describe what change you made. The content of this comment isn't important;
 /// it just ensures a conflict if two people change the module format.
 /// Don't worry about adhering to the 80-column limit for this line.
-const uint16_t SWIFTMODULE_VERSION_MINOR = 589; // cache prespecialization decls.
+const uint16_t SWIFTMODULE_VERSION_MINOR = 590; // compressed decl member names table
 
 /// A standard hash seed used for all string hashes in a serialized module.
 ///
@@ -2062,6 +2062,7 @@ namespace index_block {
   using DeclMemberNamesLayout = BCRecordLayout<
     DECL_MEMBER_NAMES, // record ID
     BCVBR<16>,  // table offset within the blob (see below)
+    BCVBR<32>,  // uncompressed size of the blob, or 0 if it is not compressed
     BCBlob  // map from member DeclBaseNames to offsets of DECL_MEMBERS records
   >;
 
@@ -55,6 +55,7 @@
 #include "llvm/Support/Allocator.h"
 #include "llvm/Support/Chrono.h"
 #include "llvm/Support/Compiler.h"
+#include "llvm/Support/Compression.h"
 #include "llvm/Support/DJB.h"
 #include "llvm/Support/EndianStream.h"
 #include "llvm/Support/FileSystem.h"
@@ -4847,7 +4848,23 @@ writeDeclMemberNamesTable(const index_block::DeclMemberNamesLayout &declNames,
     tableOffset = generator.Emit(blobStream);
   }
 
-  declNames.emit(scratch, tableOffset, hashTableBlob);
+  // Large tables deflate well and are only touched when members are looked up
+  // by name; keep small ones uncompressed so readers don't pay an inflation
+  // step for little gain.
+  uint32_t uncompressedSize = 0;
+  llvm::SmallString<4096> compressedBlob;
+  if (llvm::zlib::isAvailable() && hashTableBlob.size() >= 1024) {
+    if (llvm::Error E = llvm::zlib::compress(hashTableBlob.str(),
+                                             compressedBlob))
+      llvm::consumeError(std::move(E));
+    else
+      uncompressedSize = hashTableBlob.size();
+  }
+
+  if (uncompressedSize != 0)
+    declNames.emit(scratch, tableOffset, uncompressedSize, compressedBlob);
+  else
+    declNames.emit(scratch, tableOffset, 0, hashTableBlob);
 }
 
 static void
@@ -5396,6 +5413,16 @@ void Serializer::writeToStream(
     const SILModule *SILMod,
     const SerializationOptions &options,
     const fine_grained_dependencies::SourceFileDepGraph *DepGraph) {
+  SmallVector<char, 0> buffer =
+      serializeToBuffer(DC, SILMod, options, DepGraph);
+  os.write(buffer.data(), buffer.size());
+  os.flush();
+}
+
+SmallVector<char, 0> Serializer::serializeToBuffer(
+    ModuleOrSourceFile DC, const SILModule *SILMod,
+    const SerializationOptions &options,
+    const fine_grained_dependencies::SourceFileDepGraph *DepGraph) {
   Serializer S{SWIFTMODULE_SIGNATURE, DC};
 
   // FIXME: This is only really needed for debugging. We don't actually use it.
@@ -5413,7 +5440,7 @@ void Serializer::writeToStream(
     }
   }
 
-  S.writeToStream(os);
+  return std::move(S.Buffer);
 }
 
 void swift::serializeToBuffers(
@@ -5427,14 +5454,13 @@ void swift::serializeToBuffers(
   {
     FrontendStatsTracer tracer(getContext(DC).Stats,
                                "Serialization, swiftmodule, to buffer");
-    llvm::SmallString<1024> buf;
-    llvm::raw_svector_ostream stream(buf);
-    Serializer::writeToStream(stream, DC, M, options,
-                              /*dependency info*/ nullptr);
+    SmallVector<char, 0> buf =
+        Serializer::serializeToBuffer(DC, M, options,
+                                      /*dependency info*/ nullptr);
     bool hadError = withOutputFile(getContext(DC).Diags,
                                    options.OutputPath,
                                    [&](raw_ostream &out) {
-      out << stream.str();
+      out.write(buf.data(), buf.size());
       return false;
     });
     if (hadError)
@@ -416,6 +416,14 @@ public:
                 const SerializationOptions &options,
                 const fine_grained_dependencies::SourceFileDepGraph *DepGraph);
 
+  /// Serialize a module and hand the serializer's bitstream buffer to the
+  /// caller, avoiding a copy of the whole module contents.
+  static SmallVector<char, 0>
+  serializeToBuffer(ModuleOrSourceFile DC, const SILModule *M,
+                    const SerializationOptions &options,
+                    const fine_grained_dependencies::SourceFileDepGraph
+                        *DepGraph);
+
   /// Records the use of the given Type.
   ///
   /// The Type will be scheduled for serialization if necessary.
@@ -39,6 +39,7 @@
 #include "llvm/Support/EndianStream.h"
 #include "llvm/Support/OnDiskHashTable.h"
 
+#include <map>
 #include <type_traits>
 
 using namespace swift;
@@ -157,6 +158,12 @@ namespace {
     /// The current function ID.
     uint32_t /*DeclID*/ NextFuncID = 1;
 
+    /// Maps the operands of an already-emitted declaration-only SILFunction
+    /// record to its bit offset. Function records don't carry the function
+    /// name (names live in the index tables), so identical declarations can
+    /// all point at a single record.
+    std::map<std::vector<uint64_t>, BitOffset> FuncDeclRecordOffsets;
+
     /// Maps class name to a VTable ID.
     Table VTableList;
     /// Holds the list of VTables.
@@ -439,6 +446,32 @@ void SILSerializer::writeSILFunction(const SILFunction &F, bool DeclOnly) {
   }
   ENCODE_VER_TUPLE(available, available)
 
+  // A declaration-only record's operands fully determine its bytes, so
+  // functions whose declarations match can share one record and differ only
+  // in the index tables. Large modules reference many external accessors and
+  // thunks with identical types and flags, which all collapse this way.
+  if (NoBody) {
+    std::vector<uint64_t> declKey = {
+        toStableSILLinkage(Linkage),
+        (unsigned)F.isTransparent(), (unsigned)F.isSerialized(),
+        (unsigned)F.isThunk(), (unsigned)F.isWithoutActuallyEscapingThunk(),
+        (unsigned)F.getSpecialPurpose(), (unsigned)F.getInlineStrategy(),
+        (unsigned)F.getOptimizationMode(), (unsigned)F.getClassSubclassScope(),
+        (unsigned)F.hasCReferences(), (unsigned)F.getEffectsKind(),
+        (unsigned)numSpecAttrs, (unsigned)F.hasOwnership(),
+        F.isAlwaysWeakImported(), LIST_VER_TUPLE_PIECES(available),
+        (unsigned)F.isDynamicallyReplaceable(), (unsigned)F.isExactSelfClass(),
+        FnID, replacedFunctionID, genericSigID, clangNodeOwnerID};
+    declKey.insert(declKey.end(), SemanticsIDs.begin(), SemanticsIDs.end());
+
+    auto inserted = FuncDeclRecordOffsets.insert({std::move(declKey),
+                                                  Funcs.back()});
+    if (!inserted.second) {
+      Funcs.back() = inserted.first->second;
+      return;
+    }
+  }
+
   SILFunctionLayout::emitRecord(
       Out, ScratchRecord, abbrCode, toStableSILLinkage(Linkage),
       (unsigned)F.isTransparent(), (unsigned)F.isSerialized(),
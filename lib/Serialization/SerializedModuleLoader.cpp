@@ -266,7 +266,9 @@ std::error_code SerializedModuleLoaderBase::openModuleDocFileIfPresent(
   ModuleDocPath{BaseName.getName(file_types::TY_SwiftModuleDocFile)};
 
   llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> ModuleDocOrErr =
-    FS.getBufferForFile(ModuleDocPath);
+    FS.getBufferForFile(ModuleDocPath,
+                        /*FileSize=*/-1,
+                        /*RequiresNullTerminator=*/false);
   if (ModuleDocOrErr) {
     *ModuleDocBuffer = std::move(*ModuleDocOrErr);
   } else if (ModuleDocOrErr.getError() !=
@@ -306,12 +308,17 @@ SerializedModuleLoaderBase::openModuleSourceInfoFileIfPresent(
 
   // Try to open the module source info file from the "Project" directory.
   llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>>
-  ModuleSourceInfoOrErr = FS.getBufferForFile(PathWithProjectDir);
+  ModuleSourceInfoOrErr = FS.getBufferForFile(PathWithProjectDir,
+                                              /*FileSize=*/-1,
+                                              /*RequiresNullTerminator=*/false);
 
   // If it does not exist, try to open the module source info file adjacent to
   // the .swiftmodule file.
   if (ModuleSourceInfoOrErr.getError() == std::errc::no_such_file_or_directory)
-    ModuleSourceInfoOrErr = FS.getBufferForFile(PathWithoutProjectDir);
+    ModuleSourceInfoOrErr =
+        FS.getBufferForFile(PathWithoutProjectDir,
+                            /*FileSize=*/-1,
+                            /*RequiresNullTerminator=*/false);
 
   // If we ended up with a different file system error, return it.
   if (ModuleSourceInfoOrErr)
@@ -363,11 +370,16 @@ std::error_code SerializedModuleLoaderBase::openModuleFile(
   // the surface look like memory corruption.
   //
   // rdar://63755989
+  // Bitcode does not need a null terminator. Not requiring one lets the
+  // buffer be mmapped regardless of the file's size, so concurrent frontend
+  // jobs deserializing the same stdlib and SDK modules share one copy of
+  // the bytes through the page cache instead of each reading them onto the
+  // heap.
   bool enableVolatileModules = Ctx.LangOpts.EnableVolatileModules;
   llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> ModuleOrErr =
       FS.getBufferForFile(ModulePath,
                           /*FileSize=*/-1,
-                          /*RequiresNullTerminator=*/true,
+                          /*RequiresNullTerminator=*/false,
                           /*IsVolatile=*/enableVolatileModules);
   if (!ModuleOrErr)
     return ModuleOrErr.getError();
@@ -514,6 +526,38 @@ std::string SerializedModuleBaseName::getName(file_types::ID fileTy) const {
   return std::string(result.str());
 }
 
+bool SerializedModuleLoaderBase::searchPathMightContainModule(
+    StringRef searchPath, StringRef moduleName) {
+  auto cached = SearchPathModuleNamesCache.find(searchPath);
+  if (cached == SearchPathModuleNamesCache.end()) {
+    Optional<llvm::StringSet<>> names;
+    names.emplace();
+
+    auto &fs = *Ctx.SourceMgr.getFileSystem();
+    std::error_code errorCode;
+    for (auto entry = fs.dir_begin(searchPath, errorCode);
+         !errorCode && entry != llvm::vfs::directory_iterator();
+         entry.increment(errorCode)) {
+      StringRef entryName = llvm::sys::path::filename(entry->path());
+      names->insert(
+          entryName.take_until([](char c) { return c == '.'; }).lower());
+    }
+
+    // A missing directory trivially contains no modules, but any other
+    // failure--including one partway through iteration--leaves the listing
+    // unknown, so record that and let candidates be probed directly.
+    if (errorCode && errorCode != std::errc::no_such_file_or_directory)
+      names = None;
+
+    cached = SearchPathModuleNamesCache.insert({searchPath, std::move(names)})
+                 .first;
+  }
+
+  if (!cached->second.hasValue())
+    return true;
+  return cached->second->count(moduleName.lower());
+}
+
 bool
 SerializedModuleLoaderBase::findModule(ImportPath::Element moduleID,
            SmallVectorImpl<char> *moduleInterfacePath,
@@ -591,6 +635,12 @@ SerializedModuleLoaderBase::findModule(ImportPath::Element moduleID,
         case SearchPathKind::RuntimeLibrary: {
           isFramework = false;
 
+          // Every candidate layout in this directory starts with
+          // "ModuleName.", so a cached listing can rule the whole directory
+          // out without any per-extension stats.
+          if (!searchPathMightContainModule(path, moduleName))
+            return None;
+
           // On Apple platforms, we can assume that the runtime libraries use
           // target-specifi module files wihtin a `.swiftmodule` directory.
           // This was not always true on non-Apple platforms, and in order to
@@ -625,6 +675,10 @@ SerializedModuleLoaderBase::findModule(ImportPath::Element moduleID,
         }
         case SearchPathKind::Framework: {
           isFramework = true;
+
+          if (!searchPathMightContainModule(path, moduleName))
+            return None;
+
           llvm::sys::path::append(currPath, moduleName + ".framework");
 
           // Check if the framework directory exists.
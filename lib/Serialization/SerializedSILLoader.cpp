@@ -15,6 +15,7 @@
 #include "DeserializeSIL.h"
 #include "ModuleFile.h"
 #include "swift/Serialization/SerializedModuleLoader.h"
+#include "swift/Basic/Range.h"
 #include "swift/SIL/SILModule.h"
 #include "swift/AST/ASTMangler.h"
 #include "llvm/Support/Debug.h"
@@ -44,15 +45,31 @@ SerializedSILLoader::~SerializedSILLoader() {}
 
 SILFunction *SerializedSILLoader::lookupSILFunction(SILFunction *Callee,
                                                     bool onlyUpdateLinkage) {
+  // If we already know which section holds this function's definition,
+  // go straight there instead of probing every loaded module.
+  auto known = FuncOwningSection.find(Callee->getName());
+  if (known != FuncOwningSection.end()) {
+    auto &Des = LoadedSILSections[known->second];
+    if (auto Func = Des->lookupSILFunction(Callee, onlyUpdateLinkage)) {
+      LLVM_DEBUG(llvm::dbgs() << "Deserialized " << Func->getName() << " from "
+                 << Des->getModuleIdentifier().str() << "\n");
+      if (!Func->empty())
+        return Func;
+    }
+  }
+
   // It is possible that one module has a declaration of a SILFunction, while
   // another has the full definition.
   SILFunction *retVal = nullptr;
-  for (auto &Des : LoadedSILSections) {
+  for (unsigned i : indices(LoadedSILSections)) {
+    auto &Des = LoadedSILSections[i];
     if (auto Func = Des->lookupSILFunction(Callee, onlyUpdateLinkage)) {
       LLVM_DEBUG(llvm::dbgs() << "Deserialized " << Func->getName() << " from "
                  << Des->getModuleIdentifier().str() << "\n");
-      if (!Func->empty())
+      if (!Func->empty()) {
+        FuncOwningSection[Func->getName()] = i;
         return Func;
+      }
       retVal = Func;
     }
   }
@@ -147,9 +164,11 @@ SerializedSILLoader::lookupDifferentiabilityWitness(
 void SerializedSILLoader::invalidateCaches() {
   for (auto &Des : LoadedSILSections)
     Des->invalidateFunctionCache();
+  FuncOwningSection.clear();
 }
 
 bool SerializedSILLoader::invalidateFunction(SILFunction *F) {
+  FuncOwningSection.erase(F->getName());
   for (auto &Des : LoadedSILSections)
     if (Des->invalidateFunction(F))
       return true;
@@ -197,7 +197,11 @@ void Symbol::serializeDocComment(llvm::json::OStream &OS) const {
   }
 
   OS.attributeObject("docComment", [&](){
-    auto LL = Graph->Ctx.getLineList(RC);
+    // The line list is only needed while this symbol's docComment object is
+    // being emitted; keep its copies in a local context so that serializing
+    // a large module doesn't accumulate every doc comment in memory.
+    markup::MarkupContext MarkupCtx;
+    auto LL = MarkupCtx.getLineList(RC);
     StringRef FirstNonBlankLine;
     for (const auto &Line : LL.getLines()) {
       if (!Line.Text.empty()) {
@@ -0,0 +1,66 @@
+//===--- SyntaxArena.cpp - Syntax Tree Memory Allocation ------------------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2018 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+#include "swift/Syntax/SyntaxArena.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/Support/ManagedStatic.h"
+#include "llvm/Support/Mutex.h"
+
+using namespace swift;
+using namespace swift::syntax;
+
+namespace {
+
+/// A pool of retired arenas whose slabs can be reused for the next syntax
+/// tree. The arenas in the pool have a reference count of zero and are
+/// already reset.
+struct ArenaPool {
+  llvm::sys::Mutex PoolMutex;
+  llvm::SmallVector<SyntaxArena *, 4> Arenas;
+
+  ~ArenaPool() {
+    for (SyntaxArena *arena : Arenas)
+      delete arena;
+  }
+};
+
+/// The maximum number of arenas kept for reuse. Concurrent SourceKit
+/// requests rarely build more trees than this at once.
+const unsigned MaxPooledArenas = 4;
+
+llvm::ManagedStatic<ArenaPool> Pool;
+
+} // end anonymous namespace
+
+llvm::IntrusiveRefCntPtr<SyntaxArena> SyntaxArena::make() {
+  {
+    llvm::sys::ScopedLock lock(Pool->PoolMutex);
+    if (!Pool->Arenas.empty())
+      return llvm::IntrusiveRefCntPtr<SyntaxArena>(Pool->Arenas.pop_back_val());
+  }
+  return llvm::IntrusiveRefCntPtr<SyntaxArena>(new SyntaxArena());
+}
+
+void SyntaxArena::recycle(SyntaxArena *arena) {
+  // All nodes allocated in the arena released their references, so the whole
+  // tree dies with this one reset. Reset() keeps the largest slab around for
+  // the next tree.
+  arena->Allocator.Reset();
+  {
+    llvm::sys::ScopedLock lock(Pool->PoolMutex);
+    if (Pool->Arenas.size() < MaxPooledArenas) {
+      Pool->Arenas.push_back(arena);
+      return;
+    }
+  }
+  delete arena;
+}
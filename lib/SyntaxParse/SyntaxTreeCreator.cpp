@@ -40,6 +40,8 @@ SyntaxTreeCreator::SyntaxTreeCreator(SourceManager &SM, unsigned bufferID,
                                      RC<syntax::SyntaxArena> arena)
     : SM(SM), BufferID(bufferID),
       Arena(std::move(arena)),
+      SourceText(OwnedString::makeRefCounted(
+          SM.getEntireTextForBuffer(bufferID))),
       SyntaxCache(syntaxCache),
       TokenCache(new RawSyntaxTokenCache()) {
 }
@@ -126,12 +128,14 @@ SyntaxTreeCreator::recordToken(tok tokenKind,
   SourceLoc trailingTriviaLoc = tokLoc.getAdvancedLoc(tokLength);
   Trivia syntaxLeadingTrivia =
     ParsedTriviaPiece::convertToSyntaxTrivia(leadingTriviaPieces,
-                                             leadingTriviaLoc, SM, BufferID);
+                                             leadingTriviaLoc, SM, BufferID,
+                                             SourceText);
   Trivia syntaxTrailingTrivia =
     ParsedTriviaPiece::convertToSyntaxTrivia(trailingTriviaPieces,
-                                             trailingTriviaLoc, SM, BufferID);
-  StringRef tokenText = SM.extractText(tokRange, BufferID);
-  auto ownedText = OwnedString::makeRefCounted(tokenText);
+                                             trailingTriviaLoc, SM, BufferID,
+                                             SourceText);
+  size_t tokOffset = SM.getLocOffsetInBuffer(tokLoc, BufferID);
+  auto ownedText = SourceText.slice(tokOffset, tokLength);
   auto raw = TokenCache->getToken(Arena, tokenKind, ownedText,
                     syntaxLeadingTrivia.Pieces, syntaxTrailingTrivia.Pieces);
   OpaqueSyntaxNode opaqueN = raw.get();
@@ -141,7 +145,8 @@ SyntaxTreeCreator::recordToken(tok tokenKind,
 
 OpaqueSyntaxNode
 SyntaxTreeCreator::recordMissingToken(tok kind, SourceLoc loc) {
-  auto ownedText = OwnedString::makeRefCounted(getTokenText(kind));
+  // The text of a missing token is a compile-time constant.
+  auto ownedText = OwnedString::makeUnowned(getTokenText(kind));
   auto raw = RawSyntax::missing(kind, ownedText, Arena);
   OpaqueSyntaxNode opaqueN = raw.get();
   raw.resetWithoutRelease();
@@ -1236,12 +1236,9 @@ TBDFile GenerateTBDRequest::evaluate(Evaluator &evaluator,
   }
 
   llvm::MachO::TargetList targets{target};
-  auto addSymbol = [&](StringRef symbol, SymbolKind kind, SymbolSource source) {
-    file.addSymbol(kind, symbol, targets);
-  };
-
-  TBDGenVisitor visitor(desc, addSymbol);
-  visitor.visit(desc);
+  auto symbols = llvm::cantFail(evaluator(TBDSymbolListRequest{desc}));
+  for (const TBDSymbol &sym : symbols.get())
+    file.addSymbol(sym.kind, sym.name, targets);
   return file;
 }
 
@@ -1249,13 +1246,10 @@ std::vector<std::string>
 PublicSymbolsRequest::evaluate(Evaluator &evaluator,
                                TBDGenDescriptor desc) const {
   std::vector<std::string> symbols;
-  auto addSymbol = [&](StringRef symbol, SymbolKind kind, SymbolSource source) {
-    if (kind == SymbolKind::GlobalSymbol)
-      symbols.push_back(symbol.str());
-  };
-
-  TBDGenVisitor visitor(desc, addSymbol);
-  visitor.visit(desc);
+  auto list = llvm::cantFail(evaluator(TBDSymbolListRequest{desc}));
+  for (const TBDSymbol &sym : list.get())
+    if (sym.kind == SymbolKind::GlobalSymbol)
+      symbols.push_back(sym.name);
   return symbols;
 }
 
@@ -1272,18 +1266,36 @@ void swift::writeTBDFile(ModuleDecl *M, llvm::raw_ostream &os,
                  "YAML writing should be error-free");
 }
 
-SymbolSourceMap SymbolSourceMapRequest::evaluate(Evaluator &evaluator,
-                                                 TBDGenDescriptor desc) const {
-  using Map = SymbolSourceMap::Storage;
-  Map symbolSources;
+TBDSymbolList TBDSymbolListRequest::evaluate(Evaluator &evaluator,
+                                             TBDGenDescriptor desc) const {
+  using List = TBDSymbolList::Storage;
+  List symbols;
 
   auto addSymbol = [&](StringRef symbol, SymbolKind kind, SymbolSource source) {
-    symbolSources.insert({symbol, source});
+    symbols.push_back({symbol.str(), kind, source});
   };
 
   TBDGenVisitor visitor(desc, addSymbol);
   visitor.visit(desc);
 
+  // FIXME: Once the evaluator supports returning a reference to a cached value
+  // in storage, this won't be necessary.
+  auto &ctx = desc.getParentModule()->getASTContext();
+  auto *memory = ctx.Allocate<List>();
+  *memory = std::move(symbols);
+  ctx.addCleanup([memory](){ memory->~List(); });
+  return TBDSymbolList(memory);
+}
+
+SymbolSourceMap SymbolSourceMapRequest::evaluate(Evaluator &evaluator,
+                                                 TBDGenDescriptor desc) const {
+  using Map = SymbolSourceMap::Storage;
+  Map symbolSources;
+
+  auto list = llvm::cantFail(evaluator(TBDSymbolListRequest{desc}));
+  for (const TBDSymbol &sym : list.get())
+    symbolSources.insert({sym.name, sym.source});
+
   // FIXME: Once the evaluator supports returning a reference to a cached value
   // in storage, this won't be necessary.
   auto &ctx = desc.getParentModule()->getASTContext();
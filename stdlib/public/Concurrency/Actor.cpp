@@ -17,11 +17,13 @@
 
 #include "swift/Runtime/Concurrency.h"
 
+#include "swift/Basic/Lazy.h"
 #include "swift/Runtime/Atomic.h"
 #include "swift/Runtime/Mutex.h"
 #include "swift/Runtime/ThreadLocal.h"
 #include "swift/ABI/Actor.h"
 #include "llvm/ADT/PointerIntPair.h"
+#include <stdlib.h>
 
 using namespace swift;
 
@@ -31,6 +33,22 @@ static bool shouldYieldThread() {
   return false;
 }
 
+/// The maximum number of jobs that a thread will run for default
+/// actors before it reschedules the remainder of an actor's queue as a
+/// new processing job, or 0 (the default) if drains are unbounded.
+///
+/// Without a bound, a flooded actor monopolizes its thread until its
+/// queue is empty; latency-sensitive programs can cap the drain with
+/// the SWIFT_ACTOR_DRAIN_QUANTUM environment variable.
+static uint32_t defaultActorDrainQuantum() {
+  static uint32_t quantum = SWIFT_LAZY_CONSTANT([]() -> uint32_t {
+    if (const char *value = getenv("SWIFT_ACTOR_DRAIN_QUANTUM"))
+      return strtoul(value, nullptr, 0);
+    return 0;
+  }());
+  return quantum;
+}
+
 /*****************************************************************************/
 /*********************** DEFAULT ACTOR IMPLEMENTATION ************************/
 /*****************************************************************************/
@@ -1041,6 +1059,9 @@ static void processDefaultActor(DefaultActorImpl *currentActor,
   // Register that we're processing a default actor in this frame.
   DefaultActorProcessingFrame frame(currentActor, ShadowExistingFrame);
 
+  // The number of jobs this thread may still run, or 0 if unbounded.
+  uint32_t remainingQuantum = defaultActorDrainQuantum();
+
   bool threadIsRunningActor = false;
   while (true) {
     assert(currentActor);
@@ -1072,6 +1093,12 @@ static void processDefaultActor(DefaultActorImpl *currentActor,
 
     // Otherwise, we know that we're running the actor on this thread.
     threadIsRunningActor = true;
+
+    // If that job exhausted this thread's drain quantum, stop claiming
+    // jobs; giving up the actor below reschedules the remainder of its
+    // queue as a new processing job.
+    if (remainingQuantum != 0 && --remainingQuantum == 0)
+      break;
   }
 
   frame.exit();
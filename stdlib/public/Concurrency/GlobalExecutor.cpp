@@ -54,8 +54,12 @@
 ///===----------------------------------------------------------------------===///
 
 #include "swift/Runtime/Concurrency.h"
+#include "swift/Runtime/Mutex.h"
 #include "TaskPrivate.h"
 
+#include <chrono>
+#include <thread>
+
 #include <dispatch/dispatch.h>
 
 using namespace swift;
@@ -63,37 +67,133 @@ using namespace swift;
 SWIFT_CC(swift)
 void (*swift::swift_task_enqueueGlobal_hook)(Job *job) = nullptr;
 
+SWIFT_CC(swift)
+void (*swift::swift_task_enqueueGlobalWithDelay_hook)(unsigned long long delay,
+                                                      Job *job) = nullptr;
+
+/// The granularity at which delayed jobs are tracked. Delays are rounded
+/// up to the next tick boundary, so a job never runs before its deadline
+/// but may run up to one tick late.
+static const uint64_t DelayedJobTickNanoseconds = 1000000;
+
+/// The current time, in ticks of the delayed-job clock.
+static uint64_t delayedJobCurrentTick() {
+  auto now = std::chrono::steady_clock::now().time_since_epoch();
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(now).count() /
+         DelayedJobTickNanoseconds;
+}
+
+/// Compute the absolute deadline tick for a delay in nanoseconds from now.
+///
+/// Deadline ticks are stored in a pointer-sized scheduler slot; at
+/// millisecond granularity that covers about 49 days of uptime even on
+/// 32-bit targets.
+static uintptr_t delayedJobDeadlineTick(unsigned long long delay) {
+  auto now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                 std::chrono::steady_clock::now().time_since_epoch())
+                 .count();
+  return uintptr_t((now + delay + DelayedJobTickNanoseconds - 1) /
+                   DelayedJobTickNanoseconds);
+}
+
+/// Get the deadline-tick storage slot of a delayed job.
+static uintptr_t &delayedJobDeadline(Job *job) {
+  return reinterpret_cast<uintptr_t &>(job->SchedulerPrivate[1]);
+}
+
 #if SWIFT_CONCURRENCY_COOPERATIVE_GLOBAL_EXECUTOR
-static Job *JobQueue = nullptr;
+
+/// A FIFO list of jobs of one priority level in the cooperative global
+/// queue. Keeping one list per level with a tail pointer makes enqueuing
+/// O(1) instead of a scan over every queued job.
+struct JobQueueBucket {
+  JobPriority Priority;
+  Job *Head;
+  Job *Tail;
+};
+
+/// The buckets of the cooperative global queue, in decreasing order of
+/// priority.
+static JobQueueBucket JobQueueBuckets[] = {
+  {JobPriority::UserInteractive, nullptr, nullptr},
+  {JobPriority::UserInitiated,   nullptr, nullptr},
+  {JobPriority::Default,         nullptr, nullptr},
+  {JobPriority::Utility,         nullptr, nullptr},
+  {JobPriority::Background,      nullptr, nullptr},
+  {JobPriority::Unspecified,     nullptr, nullptr},
+};
 
 /// Get the next-in-queue storage slot.
 static Job *&nextInQueue(Job *cur) {
   return reinterpret_cast<Job*&>(cur->SchedulerPrivate);
 }
 
+/// Find the bucket responsible for jobs of the given priority. Jobs with a
+/// priority between two standard levels are grouped with the next lower
+/// level.
+static JobQueueBucket &bucketForPriority(JobPriority priority) {
+  for (auto &bucket : JobQueueBuckets) {
+    if (size_t(priority) >= size_t(bucket.Priority))
+      return bucket;
+  }
+  // Unreachable: every priority is >= Unspecified.
+  return JobQueueBuckets[sizeof(JobQueueBuckets) /
+                         sizeof(JobQueueBuckets[0]) - 1];
+}
+
 /// Insert a job into the cooperative global queue.
 static void insertIntoJobQueue(Job *newJob) {
-  Job **position = &JobQueue;
-  while (auto cur = *position) {
-    // If we find a job with lower priority, insert here.
-    if (cur->getPriority() < newJob->getPriority()) {
-      nextInQueue(newJob) = cur;
-      *position = newJob;
-      return;
-    }
+  auto &bucket = bucketForPriority(newJob->getPriority());
+  nextInQueue(newJob) = nullptr;
+  if (bucket.Tail) {
+    nextInQueue(bucket.Tail) = newJob;
+  } else {
+    bucket.Head = newJob;
+  }
+  bucket.Tail = newJob;
+}
+
+/// Delayed jobs whose deadline has not arrived yet, sorted by deadline
+/// and linked through the same next-in-queue slot as the ready queue.
+static Job *DelayedJobQueue = nullptr;
 
-    // Otherwise, keep advancing through the queue.
+/// Insert a job into the cooperative delayed-job queue.
+static void insertDelayedJob(Job *newJob, uintptr_t deadlineTick) {
+  delayedJobDeadline(newJob) = deadlineTick;
+  Job **position = &DelayedJobQueue;
+  while (auto cur = *position) {
+    if (deadlineTick < delayedJobDeadline(cur))
+      break;
     position = &nextInQueue(cur);
   }
-  nextInQueue(newJob) = nullptr;
+  nextInQueue(newJob) = *position;
   *position = newJob;
 }
 
+/// Move every delayed job whose deadline has arrived over to the ready
+/// queue.
+static void recognizeReadyDelayedJobs() {
+  if (!DelayedJobQueue)
+    return;
+  auto nowTick = delayedJobCurrentTick();
+  while (auto job = DelayedJobQueue) {
+    if (delayedJobDeadline(job) > nowTick)
+      break;
+    DelayedJobQueue = nextInQueue(job);
+    insertIntoJobQueue(job);
+  }
+}
+
 /// Claim the next job from the cooperative global queue.
 static Job *claimNextFromJobQueue() {
-  if (auto job = JobQueue) {
-    JobQueue = nextInQueue(job);
-    return job;
+  recognizeReadyDelayedJobs();
+  for (auto &bucket : JobQueueBuckets) {
+    if (auto job = bucket.Head) {
+      bucket.Head = nextInQueue(job);
+      if (!bucket.Head)
+        bucket.Tail = nullptr;
+      return job;
+    }
   }
   return nullptr;
 }
@@ -102,7 +202,19 @@ void swift::donateThreadToGlobalExecutorUntil(bool (*condition)(void *),
                                               void *conditionContext) {
   while (!condition(conditionContext)) {
     auto job = claimNextFromJobQueue();
-    if (!job) return;
+    if (!job) {
+      // If all that is left is delayed work, sleep until the nearest
+      // deadline comes around and look again.
+      if (auto delayedJob = DelayedJobQueue) {
+        auto nowTick = delayedJobCurrentTick();
+        auto deadlineTick = delayedJobDeadline(delayedJob);
+        if (deadlineTick > nowTick)
+          std::this_thread::sleep_for(std::chrono::nanoseconds(
+              (deadlineTick - nowTick) * DelayedJobTickNanoseconds));
+        continue;
+      }
+      return;
+    }
     job->run(ExecutorRef::generic());
   }
 }
@@ -114,6 +226,132 @@ static void __swift_run_job(void *_job) {
   Job *job = (Job*) _job;
   job->run(ExecutorRef::generic());
 }
+
+/// Delayed jobs are coalesced into the tick buckets of a timing wheel
+/// with a single OS timer armed for the nearest tick, instead of handing
+/// each job its own timer. Jobs whose deadline lies beyond one full
+/// rotation simply stay in their bucket until the wheel comes around to
+/// their tick again.
+static const size_t DelayedJobWheelSize = 256;
+
+/// Guards all of the wheel state below.
+static StaticMutex DelayedJobLock;
+
+/// The wheel buckets. Jobs are linked through SchedulerPrivate[0] and
+/// store their absolute deadline tick in SchedulerPrivate[1].
+static Job *DelayedJobWheel[DelayedJobWheelSize];
+
+/// The number of jobs currently waiting in the wheel.
+static size_t DelayedJobCount = 0;
+
+/// The last tick whose bucket has been drained.
+static uint64_t DelayedJobProcessedTick = 0;
+
+/// The tick the timer is currently armed for, or 0 if it is not armed.
+static uint64_t DelayedJobArmedTick = 0;
+
+/// The single OS timer serving the whole wheel, created on first use.
+static dispatch_source_t DelayedJobTimer = nullptr;
+
+/// Get the next-in-bucket storage slot.
+static Job *&delayedJobNext(Job *job) {
+  return reinterpret_cast<Job *&>(job->SchedulerPrivate[0]);
+}
+
+static void fireDelayedJobs(void *);
+
+/// Arm the wheel's timer for the given tick unless it is already armed
+/// for an earlier one. Must be called with DelayedJobLock held.
+static void armDelayedJobTimer(uint64_t tick) {
+  if (!DelayedJobTimer) {
+    DelayedJobTimer = dispatch_source_create(
+        DISPATCH_SOURCE_TYPE_TIMER, 0, 0,
+        dispatch_get_global_queue(QOS_CLASS_DEFAULT, 0));
+    dispatch_source_set_event_handler_f(DelayedJobTimer, &fireDelayedJobs);
+    dispatch_resume(DelayedJobTimer);
+  }
+  if (DelayedJobArmedTick != 0 && DelayedJobArmedTick <= tick)
+    return;
+  DelayedJobArmedTick = tick;
+
+  uint64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                     std::chrono::steady_clock::now().time_since_epoch())
+                     .count();
+  uint64_t deadline = tick * DelayedJobTickNanoseconds;
+  uint64_t delta = deadline > now ? deadline - now : 0;
+  dispatch_source_set_timer(DelayedJobTimer,
+                            dispatch_time(DISPATCH_TIME_NOW, delta),
+                            DISPATCH_TIME_FOREVER, DelayedJobTickNanoseconds);
+}
+
+/// The timer callback: move every job whose deadline has arrived over to
+/// the global queue and re-arm the timer for the nearest remaining tick.
+static void fireDelayedJobs(void *) {
+  Job *readyJobs = nullptr;
+
+  DelayedJobLock.withLock([&] {
+    uint64_t nowTick = delayedJobCurrentTick();
+    DelayedJobArmedTick = 0;
+
+    // Drain the buckets the wheel has passed over since the last firing.
+    // One full rotation visits every bucket, so never walk further than
+    // that.
+    uint64_t span = nowTick - DelayedJobProcessedTick;
+    if (span > DelayedJobWheelSize)
+      span = DelayedJobWheelSize;
+    for (uint64_t i = 1; i <= span && DelayedJobCount > 0; ++i) {
+      Job **link = &DelayedJobWheel[(DelayedJobProcessedTick + i) %
+                                    DelayedJobWheelSize];
+      while (Job *job = *link) {
+        if (delayedJobDeadline(job) <= nowTick) {
+          *link = delayedJobNext(job);
+          delayedJobNext(job) = readyJobs;
+          readyJobs = job;
+          --DelayedJobCount;
+        } else {
+          // This job's deadline is a later rotation of the same bucket.
+          link = &delayedJobNext(job);
+        }
+      }
+    }
+    DelayedJobProcessedTick = nowTick;
+
+    // Re-arm for the nearest remaining deadline, if any.
+    if (DelayedJobCount > 0) {
+      uint64_t nearest = UINT64_MAX;
+      for (size_t b = 0; b < DelayedJobWheelSize; ++b)
+        for (Job *job = DelayedJobWheel[b]; job; job = delayedJobNext(job))
+          if (delayedJobDeadline(job) < nearest)
+            nearest = delayedJobDeadline(job);
+      armDelayedJobTimer(nearest);
+    }
+  });
+
+  while (Job *job = readyJobs) {
+    readyJobs = delayedJobNext(job);
+    swift_task_enqueueGlobal(job);
+  }
+}
+
+/// Insert a job into the timing wheel and make sure the timer will fire
+/// for its tick.
+static void insertDelayedJob(Job *job, uintptr_t deadlineTick) {
+  delayedJobDeadline(job) = deadlineTick;
+
+  DelayedJobLock.withLock([&] {
+    // Keep the wheel's cursor behind the new deadline so its bucket is
+    // visited on the next firing.
+    if (DelayedJobCount == 0 || deadlineTick <= DelayedJobProcessedTick)
+      DelayedJobProcessedTick = deadlineTick - 1;
+
+    auto &bucket = DelayedJobWheel[deadlineTick % DelayedJobWheelSize];
+    delayedJobNext(job) = bucket;
+    bucket = job;
+    ++DelayedJobCount;
+
+    armDelayedJobTimer(deadlineTick);
+  });
+}
 #endif
 
 void swift::swift_task_enqueueGlobal(Job *job) {
@@ -167,3 +405,17 @@ void swift::swift_task_enqueueGlobal(Job *job) {
   dispatch_async_f(queue, dispatchContext, dispatchFunction);
 #endif
 }
+
+void swift::swift_task_enqueueGlobalWithDelay(unsigned long long delay,
+                                              Job *job) {
+  assert(job && "no job provided");
+
+  // If the hook is defined, use it.
+  if (swift_task_enqueueGlobalWithDelay_hook)
+    return swift_task_enqueueGlobalWithDelay_hook(delay, job);
+
+  if (delay == 0)
+    return swift_task_enqueueGlobal(job);
+
+  insertDelayedJob(job, delayedJobDeadlineTick(delay));
+}
@@ -163,6 +163,108 @@ void AsyncTask::completeFuture(AsyncContext *context, ExecutorRef executor) {
   }
 }
 
+namespace {
+
+/// Header preceding every task allocation, recording the size the storage
+/// was allocated with so a destroyed task can be returned to its bin.
+struct alignas(MaximumAlignment) TaskAllocationPrefix {
+  size_t allocationSize;
+};
+
+/// A per-thread cache of recently destroyed task allocations, binned by
+/// allocation size. Tasks are created and destroyed at a high rate but in
+/// a small number of sizes, so in steady state creation can recycle a
+/// recently freed block instead of calling malloc.
+class TaskAllocationPool {
+  /// Allocation sizes are rounded up to multiples of BinGranularity;
+  /// anything larger than the largest bin goes straight to malloc/free.
+  static const size_t BinGranularity = 64;
+  static const size_t NumBins = 32;
+
+  /// Bound on the cached blocks per bin, which caps the memory an idle
+  /// thread can hold on to.
+  static const size_t MaxCachedPerBin = 32;
+
+  struct FreeNode {
+    FreeNode *Next;
+  };
+
+  FreeNode *Bins[NumBins] = {};
+  size_t Counts[NumBins] = {};
+
+public:
+  /// Round a size up to its bin's allocation size, or return 0 if the
+  /// size is too large to be cached.
+  static size_t binnedSize(size_t size) {
+    size_t bin = (size + BinGranularity - 1) / BinGranularity;
+    return bin <= NumBins ? bin * BinGranularity : 0;
+  }
+
+  /// Take a block of the given binned size out of the pool, if one is
+  /// cached.
+  void *allocate(size_t binned) {
+    size_t bin = binned / BinGranularity - 1;
+    if (auto node = Bins[bin]) {
+      Bins[bin] = node->Next;
+      --Counts[bin];
+      return node;
+    }
+    return nullptr;
+  }
+
+  /// Return a block of the given binned size to the pool. Returns false
+  /// if the bin is full and the block should be freed instead.
+  bool deallocate(void *ptr, size_t binned) {
+    size_t bin = binned / BinGranularity - 1;
+    if (Counts[bin] >= MaxCachedPerBin)
+      return false;
+    auto node = reinterpret_cast<FreeNode *>(ptr);
+    node->Next = Bins[bin];
+    Bins[bin] = node;
+    ++Counts[bin];
+    return true;
+  }
+
+  ~TaskAllocationPool() {
+    for (auto *bin : Bins) {
+      while (auto node = bin) {
+        bin = node->Next;
+        free(node);
+      }
+    }
+  }
+};
+
+} // end anonymous namespace
+
+/// The task allocation pool of the current thread. Blocks may be freed on
+/// a different thread than they were allocated on; the pools are just
+/// independent caches, so that is fine.
+static thread_local TaskAllocationPool TaskPool;
+
+/// Allocate backing storage for a task of the given total size.
+static void *allocateTaskStorage(size_t amount) {
+  size_t binned = TaskAllocationPool::binnedSize(
+      amount + sizeof(TaskAllocationPrefix));
+  void *allocation = nullptr;
+  if (binned)
+    allocation = TaskPool.allocate(binned);
+  if (!allocation)
+    allocation = malloc(binned ? binned
+                               : amount + sizeof(TaskAllocationPrefix));
+  auto prefix = new (allocation) TaskAllocationPrefix{binned};
+  return prefix + 1;
+}
+
+/// Release backing storage previously returned by allocateTaskStorage.
+static void deallocateTaskStorage(void *storage) {
+  auto prefix = reinterpret_cast<TaskAllocationPrefix *>(storage) - 1;
+  size_t binned = prefix->allocationSize;
+  if (binned && TaskPool.deallocate(prefix, binned))
+    return;
+  free(prefix);
+}
+
 SWIFT_CC(swift)
 static void destroyTask(SWIFT_CONTEXT HeapObject *obj) {
   auto task = static_cast<AsyncTask*>(obj);
@@ -178,7 +280,7 @@ static void destroyTask(SWIFT_CONTEXT HeapObject *obj) {
   // the task-local allocator.  There's actually nothing else to clean up
   // here.
 
-  free(task);
+  deallocateTaskStorage(task);
 }
 
 /// Heap metadata for an asynchronous task.
@@ -266,7 +368,7 @@ AsyncTaskAndContext swift::swift_task_create_future_f(
 
   assert(amountToAllocate % MaximumAlignment == 0);
 
-  void *allocation = malloc(amountToAllocate);
+  void *allocation = allocateTaskStorage(amountToAllocate);
 
   AsyncContext *initialContext =
     reinterpret_cast<AsyncContext*>(
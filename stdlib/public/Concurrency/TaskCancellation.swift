@@ -25,9 +25,7 @@ extension Task {
   /// - SeeAlso: `checkCancellation()`
   /* @instantaneous */
   public static func isCancelled() async -> Bool {
-    // let task = __getTask() // TODO: pending internal API to get tasks
-    // task.isCancelled || task.deadline.isOverdue
-    fatalError("\(#function) not implemented yet.")
+    isTaskCancelled(Builtin.getCurrentAsyncTask())
   }
 
   /// Check if the task is cancelled and throw an `CancellationError` if it was.
@@ -198,3 +196,6 @@ extension Task {
     
   }
 }
+
+@_silgen_name("swift_task_isCancelled")
+func isTaskCancelled(_ task: Builtin.NativeObject) -> Bool
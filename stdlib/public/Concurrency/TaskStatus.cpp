@@ -16,8 +16,10 @@
 //===----------------------------------------------------------------------===//
 
 #include "swift/Runtime/Concurrency.h"
+#include "swift/Runtime/HeapObject.h"
 #include "swift/Runtime/Mutex.h"
 #include "swift/ABI/TaskStatus.h"
+#include "llvm/ADT/SmallVector.h"
 #include <atomic>
 
 using namespace swift;
@@ -396,18 +398,35 @@ bool swift::swift_task_removeStatusRecord(AsyncTask *task,
 /****************************** CANCELLATION ******************************/
 /**************************************************************************/
 
+/// Collect the children of the given record, retaining each one so that
+/// it remains valid after the status record lock is released.
+///
+/// Child tasks are deliberately not cancelled or escalated while this
+/// task's status records are locked: doing either takes the child's own
+/// status record lock, and recursing with the parent's lock held
+/// serializes a broadcast over an entire task tree behind the outermost
+/// task's lock. Instead, the broadcasting thread gathers the children
+/// here and visits them after unlocking, so at most one task's records
+/// are frozen at a time.
+static void collectChildren(ChildTaskStatusRecord *record,
+                            llvm::SmallVectorImpl<AsyncTask *> &children) {
+  for (AsyncTask *child: record->children()) {
+    swift_retain(child);
+    children.push_back(child);
+  }
+}
+
 /// Perform any cancellation actions required by the given record.
-static void performCancellationAction(TaskStatusRecord *record) {
+static void performCancellationAction(TaskStatusRecord *record,
+                       llvm::SmallVectorImpl<AsyncTask *> &childrenToCancel) {
   switch (record->getKind()) {
   // Deadlines don't require any special support.
   case TaskStatusRecordKind::Deadline:
     return;
 
-  // Child tasks need to be recursively cancelled.
+  // Child tasks need to be cancelled as well, after the lock is dropped.
   case TaskStatusRecordKind::ChildTask: {
-    auto childRecord = cast<ChildTaskStatusRecord>(record);
-    for (AsyncTask *child: childRecord->children())
-      swift_task_cancel(child);
+    collectChildren(cast<ChildTaskStatusRecord>(record), childrenToCancel);
     return;
   }
 
@@ -433,10 +452,20 @@ static void performCancellationAction(TaskStatusRecord *record) {
   // FIXME: allow dynamic extension/correction?
 }
 
+bool swift::swift_task_isCancelled(AsyncTask *task) {
+  // The cancelled bit is published before any cancellation actions run,
+  // when the cancelling thread installs its lock record, so this never
+  // waits on a broadcast in progress. No data is read on the basis of
+  // the flag, so a relaxed load suffices.
+  return task->isCancelled();
+}
+
 void swift::swift_task_cancel(AsyncTask *task) {
   Optional<StatusRecordLockRecord> recordLockRecord;
 
-  // Acquire the status record lock.
+  // Acquire the status record lock. This also publishes the cancelled
+  // bit, so wait-free readers observe the cancellation immediately,
+  // before the broadcast below.
   auto oldStatus = acquireStatusRecordLock(task, recordLockRecord,
                                            /*forCancellation*/ true);
   assert(!oldStatus.isLocked());
@@ -450,9 +479,10 @@ void swift::swift_task_cancel(AsyncTask *task) {
   // locking thread.
 
   // Carry out the cancellation operations associated with all
-  // the active records.
+  // the active records, deferring child tasks until after unlock.
+  llvm::SmallVector<AsyncTask *, 8> childrenToCancel;
   for (auto cur: oldStatus.records()) {
-    performCancellationAction(cur);
+    performCancellationAction(cur, childrenToCancel);
   }
 
   // Release the status record lock, being sure to flag that
@@ -461,6 +491,15 @@ void swift::swift_task_cancel(AsyncTask *task) {
                                    /*cancelled*/ true,
                                    /*locked*/ false);
   releaseStatusRecordLock(task, cancelledStatus, recordLockRecord);
+
+  // Cancel the children now that this task's records are unlocked, so
+  // that the broadcast freezes at most one task's records at a time.
+  // A child may have completed in the meantime; it is kept alive by the
+  // retain taken under the lock, and cancelling it is then a no-op.
+  for (auto *child: childrenToCancel) {
+    swift_task_cancel(child);
+    swift_release(child);
+  }
 }
 
 /**************************************************************************/
@@ -469,17 +508,16 @@ void swift::swift_task_cancel(AsyncTask *task) {
 
 /// Perform any escalation actions required by the given record.
 static void performEscalationAction(TaskStatusRecord *record,
-                                    JobPriority newPriority) {
+                                    JobPriority newPriority,
+                     llvm::SmallVectorImpl<AsyncTask *> &childrenToEscalate) {
   switch (record->getKind()) {
   // Deadlines don't require any special support.
   case TaskStatusRecordKind::Deadline:
     return;
 
-  // Child tasks need to be recursively escalated.
+  // Child tasks need to be escalated as well, after the lock is dropped.
   case TaskStatusRecordKind::ChildTask: {
-    auto childRecord = cast<ChildTaskStatusRecord>(record);
-    for (AsyncTask *child: childRecord->children())
-      swift_task_escalate(child, newPriority);
+    collectChildren(cast<ChildTaskStatusRecord>(record), childrenToEscalate);
     return;
   }
 
@@ -524,6 +562,7 @@ swift::swift_task_escalate(AsyncTask *task, JobPriority newPriority) {
 
   // Now that we have the task's status lock, check again that the
   // priority is still too low.
+  llvm::SmallVector<AsyncTask *, 8> childrenToEscalate;
   auto priorityToReturn = task->Flags.getPriority();
   if (priorityToReturn < newPriority) {
     // Change the priority.
@@ -534,15 +573,25 @@ swift::swift_task_escalate(AsyncTask *task, JobPriority newPriority) {
     // currently running.  This probably requires the task to be enqueued
     // on a standard executor.
 
-    // Perform escalation operations for all the status records.
+    // Perform escalation operations for all the status records,
+    // deferring child tasks until after unlock.
     for (auto cur: oldStatus.records()) {
-      performEscalationAction(cur, newPriority);
+      performEscalationAction(cur, newPriority, childrenToEscalate);
     }
   }
 
   // Release the status record lock, restoring the old status.
   releaseStatusRecordLock(task, oldStatus, recordLockRecord);
 
+  // Escalate the children now that this task's records are unlocked, so
+  // that the broadcast freezes at most one task's records at a time.
+  // Escalation is idempotent, and a child that has completed in the
+  // meantime is kept alive by the retain taken under the lock.
+  for (auto *child: childrenToEscalate) {
+    swift_task_escalate(child, newPriority);
+    swift_release(child);
+  }
+
   return priorityToReturn;
 }
 
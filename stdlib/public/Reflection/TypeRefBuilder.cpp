@@ -82,13 +82,42 @@ valid_type_ref:
 /// Load and normalize a mangled name so it can be matched with string equality.
 std::string
 TypeRefBuilder::normalizeReflectionName(RemoteRef<char> reflectionName) {
+  // Try the cache. Lookups that scan entire sections normalize the same
+  // names repeatedly, and normalization demangles the name each time.
+  auto remoteAddr = reflectionName.getAddressData();
+  auto Found = NormalizedReflectionNameCache.find(remoteAddr);
+  if (Found != NormalizedReflectionNameCache.end())
+    return Found->second;
+
+  std::string Normalized;
   // Remangle the reflection name to resolve symbolic references.
   if (auto node = demangleTypeRef(reflectionName)) {
-    return mangleNode(node);
+    Normalized = mangleNode(node);
+  } else {
+    // Fall back to the raw string.
+    Normalized = getTypeRefString(reflectionName).str();
   }
 
-  // Fall back to the raw string.
-  return getTypeRefString(reflectionName).str();
+  NormalizedReflectionNameCache.insert({remoteAddr, Normalized});
+  return Normalized;
+}
+
+const TypeRef *TypeRefBuilder::decodeTypeRef(RemoteRef<char> mangledName) {
+  // Try the cache. Debugger sessions resolve the same types over and over
+  // as they step, and the section data backing a mangled name never changes
+  // once its image has been registered.
+  auto remoteAddr = mangledName.getAddressData();
+  auto Found = DecodedTypeRefCache.find(remoteAddr);
+  if (Found != DecodedTypeRefCache.end())
+    return Found->second;
+
+  auto Demangled = demangleTypeRef(mangledName);
+  auto TR = swift::Demangle::decodeMangledType(*this, Demangled).getType();
+  // Only successful decodes are cached; failures keep rerunning so callers
+  // that report decoding errors still see them.
+  if (TR)
+    DecodedTypeRefCache.insert({remoteAddr, TR});
+  return TR;
 }
 
 /// Determine whether the given reflection protocol name matches.
@@ -134,9 +163,7 @@ lookupTypeWitness(const std::string &MangledTypeName,
 
         auto SubstitutedTypeName = readTypeRef(AssocTy,
                                                AssocTy->SubstitutedTypeName);
-        auto Demangled = demangleTypeRef(SubstitutedTypeName);
-        auto *TypeWitness =
-            swift::Demangle::decodeMangledType(*this, Demangled).getType();
+        auto *TypeWitness = decodeTypeRef(SubstitutedTypeName);
 
         AssociatedTypeCache.insert(std::make_pair(key, TypeWitness));
         return TypeWitness;
@@ -154,9 +181,7 @@ const TypeRef *TypeRefBuilder::lookupSuperclass(const TypeRef *TR) {
   if (!FD->hasSuperclass())
     return nullptr;
 
-  auto Demangled = demangleTypeRef(readTypeRef(FD, FD->Superclass));
-  auto Unsubstituted =
-      swift::Demangle::decodeMangledType(*this, Demangled).getType();
+  auto Unsubstituted = decodeTypeRef(readTypeRef(FD, FD->Superclass));
   if (!Unsubstituted)
     return nullptr;
 
@@ -181,10 +206,12 @@ TypeRefBuilder::getFieldTypeInfo(const TypeRef *TR) {
   if (Found != FieldTypeInfoCache.end())
     return Found->second;
 
-  // On failure, fill out the cache with everything we know about.
-  std::vector<std::pair<std::string, const TypeRef *>> Fields;
-  for (auto &Info : ReflectionInfos) {
-    for (auto FD : Info.Field) {
+  // On failure, index the field descriptors of any reflection info we haven't
+  // seen yet. Once every image has been indexed, a cache miss is definitive
+  // and we don't rescan anything.
+  for (size_t i = FirstUnprocessedFieldInfoIndex,
+              e = ReflectionInfos.size(); i != e; ++i) {
+    for (auto FD : ReflectionInfos[i].Field) {
       if (!FD->hasMangledTypeName())
         continue;
       auto CandidateMangledName = readTypeRef(FD, FD->MangledTypeName);
@@ -193,6 +220,7 @@ TypeRefBuilder::getFieldTypeInfo(const TypeRef *TR) {
       Dem.clear();
     }
   }
+  FirstUnprocessedFieldInfoIndex = ReflectionInfos.size();
 
   // We've filled the cache with everything we know about now. Try the cache again.
   Found = FieldTypeInfoCache.find(MangledName);
@@ -226,9 +254,8 @@ bool TypeRefBuilder::getFieldTypeRefs(
       continue;
     }
 
-    auto Demangled = demangleTypeRef(readTypeRef(Field,Field->MangledTypeName));
     auto Unsubstituted =
-        swift::Demangle::decodeMangledType(*this, Demangled).getType();
+        decodeTypeRef(readTypeRef(Field, Field->MangledTypeName));
     if (!Unsubstituted)
       return false;
 
@@ -256,8 +283,16 @@ TypeRefBuilder::getBuiltinTypeInfo(const TypeRef *TR) {
   else
     return nullptr;
 
-  for (auto Info : ReflectionInfos) {
-    for (auto BuiltinTypeDescriptor : Info.Builtin) {
+  // Try the cache.
+  auto Found = BuiltinTypeInfoCache.find(MangledName);
+  if (Found != BuiltinTypeInfoCache.end())
+    return Found->second;
+
+  // On failure, index the builtin descriptors of any reflection info we
+  // haven't seen yet.
+  for (size_t i = FirstUnprocessedBuiltinInfoIndex,
+              e = ReflectionInfos.size(); i != e; ++i) {
+    for (auto BuiltinTypeDescriptor : ReflectionInfos[i].Builtin) {
       if (BuiltinTypeDescriptor->Stride <= 0)
         continue;
       if (!BuiltinTypeDescriptor->hasMangledTypeName())
@@ -272,24 +307,43 @@ TypeRefBuilder::getBuiltinTypeInfo(const TypeRef *TR) {
 
       auto CandidateMangledName =
         readTypeRef(BuiltinTypeDescriptor, BuiltinTypeDescriptor->TypeName);
-      if (!reflectionNameMatches(CandidateMangledName, MangledName))
-        continue;
-      return BuiltinTypeDescriptor;
+      auto NormalizedName = normalizeReflectionName(CandidateMangledName);
+      // Keep the first descriptor seen for a name, matching the order the
+      // linear scan used to visit them in.
+      BuiltinTypeInfoCache.insert({NormalizedName, BuiltinTypeDescriptor});
+      Dem.clear();
     }
   }
+  FirstUnprocessedBuiltinInfoIndex = ReflectionInfos.size();
+
+  // Try the cache again.
+  Found = BuiltinTypeInfoCache.find(MangledName);
+  if (Found != BuiltinTypeInfoCache.end())
+    return Found->second;
 
   return nullptr;
 }
 
 RemoteRef<CaptureDescriptor>
 TypeRefBuilder::getCaptureDescriptor(uint64_t RemoteAddress) {
-  for (auto Info : ReflectionInfos) {
-    for (auto CD : Info.Capture) {
-      if (RemoteAddress == CD.getAddressData()) {
-        return CD;
-      }
-    }
+  // Try the cache.
+  auto Found = CaptureDescriptorCache.find(RemoteAddress);
+  if (Found != CaptureDescriptorCache.end())
+    return Found->second;
+
+  // On failure, index the capture descriptors of any reflection info we
+  // haven't seen yet.
+  for (size_t i = FirstUnprocessedCaptureInfoIndex,
+              e = ReflectionInfos.size(); i != e; ++i) {
+    for (auto CD : ReflectionInfos[i].Capture)
+      CaptureDescriptorCache.insert({CD.getAddressData(), CD});
   }
+  FirstUnprocessedCaptureInfoIndex = ReflectionInfos.size();
+
+  // Try the cache again.
+  Found = CaptureDescriptorCache.find(RemoteAddress);
+  if (Found != CaptureDescriptorCache.end())
+    return Found->second;
 
   return nullptr;
 }
@@ -304,9 +358,7 @@ TypeRefBuilder::getClosureContextInfo(RemoteRef<CaptureDescriptor> CD) {
     auto CR = CD.getField(*i);
     
     if (CR->hasMangledTypeName()) {
-      auto MangledName = readTypeRef(CR, CR->MangledTypeName);
-      auto DemangleTree = demangleTypeRef(MangledName);
-      TR = swift::Demangle::decodeMangledType(*this, DemangleTree).getType();
+      TR = decodeTypeRef(readTypeRef(CR, CR->MangledTypeName));
     }
     Info.CaptureTypes.push_back(TR);
   }
@@ -316,9 +368,7 @@ TypeRefBuilder::getClosureContextInfo(RemoteRef<CaptureDescriptor> CD) {
     auto MSR = CD.getField(*i);
     
     if (MSR->hasMangledTypeName()) {
-      auto MangledName = readTypeRef(MSR, MSR->MangledTypeName);
-      auto DemangleTree = demangleTypeRef(MangledName);
-      TR = swift::Demangle::decodeMangledType(*this, DemangleTree).getType();
+      TR = decodeTypeRef(readTypeRef(MSR, MSR->MangledTypeName));
     }
 
     const MetadataSource *MS = nullptr;
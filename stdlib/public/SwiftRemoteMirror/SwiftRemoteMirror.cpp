@@ -38,13 +38,14 @@ using NativeReflectionContext = swift::reflection::ReflectionContext<Runtime>;
 
 struct SwiftReflectionContext {
   NativeReflectionContext *nativeContext;
+  std::shared_ptr<CMemoryReader> reader;
   std::vector<std::function<void()>> freeFuncs;
   std::vector<std::tuple<swift_addr_t, swift_addr_t>> dataSegments;
   std::string lastString;
 
-  SwiftReflectionContext(MemoryReaderImpl impl) {
-    auto Reader = std::make_shared<CMemoryReader>(impl);
-    nativeContext = new NativeReflectionContext(Reader);
+  SwiftReflectionContext(MemoryReaderImpl impl)
+      : reader(std::make_shared<CMemoryReader>(impl)) {
+    nativeContext = new NativeReflectionContext(reader);
   }
   
   ~SwiftReflectionContext() {
@@ -161,6 +162,11 @@ void swift_reflection_destroyReflectionContext(SwiftReflectionContextRef Context
   delete ContextRef;
 }
 
+void swift_reflection_setCacheRemoteReads(SwiftReflectionContextRef ContextRef,
+                                          int EnableCaching) {
+  ContextRef->reader->setCacheRemoteReads(EnableCaching != 0);
+}
+
 template<typename Iterator>
 ReflectionSection<Iterator> sectionFromInfo(const swift_reflection_info_t &Info,
                               const swift_reflection_section_pair_t &Section) {
@@ -146,6 +146,25 @@ public struct AnyHashable {
   ///
   /// - Parameter base: A hashable value to wrap.
   public init<H: Hashable>(_ base: H) {
+    // Fast paths for the most common concrete key types. These are structs,
+    // so they have no `Hashable` base type to upcast to, and they don't
+    // provide a custom `AnyHashable` representation, so constructing their
+    // default representation directly is equivalent to the general path
+    // below while skipping two runtime calls per value. The boxes fit in
+    // the existential's inline buffer, so no allocation happens either.
+    if H.self == String.self {
+      self.init(_box: _ConcreteHashableBox(unsafeBitCast(base, to: String.self)))
+      return
+    }
+    if H.self == Int.self {
+      self.init(_box: _ConcreteHashableBox(unsafeBitCast(base, to: Int.self)))
+      return
+    }
+    if H.self == Double.self {
+      self.init(_box: _ConcreteHashableBox(unsafeBitCast(base, to: Double.self)))
+      return
+    }
+
     if let custom =
       (base as? _HasCustomAnyHashableRepresentation)?._toCustomAnyHashable() {
       self = custom
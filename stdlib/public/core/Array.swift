@@ -1890,8 +1890,11 @@ extension Array {
   public static func _bridgeFromObjectiveCAdoptingNativeStorageOf(
     _ source: AnyObject
   ) -> Array? {
-    // If source is deferred, we indirect to get its native storage
-    let maybeNative = (source as? __SwiftDeferredNSArray)?._nativeStorage ?? source
+    // If source is deferred or eagerly bridged a small array, we indirect
+    // to get its native storage
+    let maybeNative = (source as? __SwiftDeferredNSArray)?._nativeStorage
+      ?? (source as? __SwiftSmallNSArray)?._nativeStorage
+      ?? source
 
     return (maybeNative as? _ContiguousArrayStorage<Element>).map {
       Array(_ContiguousArrayBuffer($0))
@@ -792,6 +792,20 @@ internal struct _ContiguousArrayBuffer<Element>: _ArrayBufferProtocol {
     if _isBridgedVerbatimToObjectiveC(Element.self) {
       return _storage
     }
+    // Tiny arrays are overwhelmingly likely to have every element accessed,
+    // so deferring the bridge buys nothing; bridge them eagerly into a
+    // single inline-storage instance instead of paying for the deferred
+    // wrapper plus a bridging buffer on first access.
+    let count = self.count
+    if count <= __SwiftSmallNSArray._capacity {
+      let base = firstElementAddress
+      return __SwiftSmallNSArray(
+        _count: count,
+        _element0: count > 0 ? _bridgeAnythingToObjectiveC(base[0]) : nil,
+        _element1: count > 1 ? _bridgeAnythingToObjectiveC(base[1]) : nil,
+        _element2: count > 2 ? _bridgeAnythingToObjectiveC(base[2]) : nil,
+        _nativeStorage: _storage)
+    }
     return __SwiftDeferredNSArray(_nativeStorage: _storage)
   }
 #endif
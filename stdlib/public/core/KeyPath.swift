@@ -124,12 +124,95 @@ public class AnyKeyPath: Hashable, _AppendKeyPath {
   public var _kvcKeyPathString: String? {
     @_semantics("keypath.kvcKeyPathString")
     get {
+      guard getOffsetFromStorage() == nil,
+            getClassOffsetFromStorage() == nil else { return nil }
       guard let ptr = _kvcKeyPathStringPtr else { return nil }
 
       return String(validatingUTF8: ptr)
     }
   }
-  
+
+  // A pure stored-property key path reduces to a single byte offset from the
+  // root, which we cache in the spare KVC string field so that projections
+  // can apply it directly instead of walking the components. The offset is
+  // encoded as the two's-complement negation of (offset + 1): those bit
+  // patterns occupy the very top of the address space, which no supported
+  // platform maps, so they can never collide with a real string pointer. On
+  // 32-bit platforms only the topmost page is reliably unmapped, which bounds
+  // the offsets we can cache there.
+  internal static var _maximumCacheableOffset: Int {
+    return MemoryLayout<Int>.size == 8 ? (1 << 40) : 4094
+  }
+
+  final internal func assignOffsetToStorage(offset: Int) {
+    guard _kvcKeyPathStringPtr == nil,
+          offset >= 0, offset <= AnyKeyPath._maximumCacheableOffset else {
+      return
+    }
+    _kvcKeyPathStringPtr =
+      UnsafePointer<CChar>(bitPattern: 0 &- UInt(bitPattern: offset + 1))
+  }
+
+  final internal func getOffsetFromStorage() -> Int? {
+    guard let ptr = _kvcKeyPathStringPtr else { return nil }
+    let value = 0 &- UInt(bitPattern: ptr)
+    guard value >= 1,
+          value <= UInt(bitPattern: AnyKeyPath._maximumCacheableOffset) + 1
+    else {
+      return nil
+    }
+    return Int(bitPattern: value - 1)
+  }
+
+  // A key path consisting of a single stored class-property component also
+  // reduces to one byte offset, this time relative to the object base rather
+  // than the root value. It is distinguished from a struct offset by an extra
+  // flag bit, and only cached on 64-bit platforms, where the tag space is
+  // large enough.
+  internal static var _classOffsetFlag: UInt {
+    return UInt(1) &<< (UInt.bitWidth - 2)
+  }
+
+  final internal func assignClassOffsetToStorage(offset: Int) {
+    guard MemoryLayout<Int>.size == 8,
+          _kvcKeyPathStringPtr == nil,
+          offset >= 0, offset <= AnyKeyPath._maximumCacheableOffset else {
+      return
+    }
+    let value = UInt(bitPattern: offset + 1) | AnyKeyPath._classOffsetFlag
+    _kvcKeyPathStringPtr = UnsafePointer<CChar>(bitPattern: 0 &- value)
+  }
+
+  final internal func getClassOffsetFromStorage() -> Int? {
+    guard MemoryLayout<Int>.size == 8,
+          let ptr = _kvcKeyPathStringPtr else { return nil }
+    let value = 0 &- UInt(bitPattern: ptr)
+    guard value & AnyKeyPath._classOffsetFlag != 0 else { return nil }
+    let offset = value & ~AnyKeyPath._classOffsetFlag
+    guard offset >= 1,
+          offset <= UInt(bitPattern: AnyKeyPath._maximumCacheableOffset) + 1
+    else {
+      return nil
+    }
+    return Int(bitPattern: offset - 1)
+  }
+
+  // The offset of a key path that is a single stored class-property
+  // component, or nil if the key path has any other shape. Deeper stored
+  // chains are not flattened, because exclusivity checks are performed on the
+  // outermost property's address.
+  internal var _singleClassStoredOffset: Int? {
+    return withBuffer {
+      var buffer = $0
+      if buffer.data.isEmpty { return nil }
+      let (rawComponent, optNextType) = buffer.next()
+      guard optNextType == nil,
+            rawComponent.header.kind == .class else { return nil }
+      return rawComponent._structOrClassOffset
+    }
+  }
+
+
   // MARK: Implementation details
   
   // Prevent normal initialization. We use tail allocation via
@@ -238,6 +321,28 @@ public class KeyPath<Root, Value>: PartialKeyPath<Root> {
   
   @usableFromInline
   internal final func _projectReadOnly(from root: Root) -> Value {
+    // One-offset fast path: a pure stored-property key path is just a load
+    // from a fixed offset within the root value.
+    if let offset = getOffsetFromStorage() {
+      return withUnsafeBytes(of: root) {
+        $0.load(fromByteOffset: offset, as: Value.self)
+      }
+    }
+
+    // Likewise for a single stored class-property component, with the offset
+    // taken relative to the object. The instantaneous read access mirrors the
+    // check the interpreted walk below would perform on the same address.
+    if let offset = getClassOffsetFromStorage() {
+      let baseObj = unsafeBitCast(root, to: AnyObject.self)
+      let basePtr = UnsafeRawPointer(Builtin.bridgeToRawPointer(baseObj))
+      defer { _fixLifetime(baseObj) }
+
+      let offsetAddress = basePtr.advanced(by: offset)
+      Builtin.performInstantaneousReadAccess(offsetAddress._rawValue,
+        Value.self)
+      return offsetAddress.assumingMemoryBound(to: Value.self).pointee
+    }
+
     // TODO: For perf, we could use a local growable buffer instead of Any
     var curBase: Any = root
     return withBuffer {
@@ -294,6 +399,16 @@ public class WritableKeyPath<Root, Value>: KeyPath<Root, Value> {
   @usableFromInline
   internal func _projectMutableAddress(from base: UnsafePointer<Root>)
       -> (pointer: UnsafeMutablePointer<Value>, owner: AnyObject?) {
+    // One-offset fast path: a pure stored-property key path projects to a
+    // fixed offset within the in-place root value, with no owner to keep
+    // alive beyond the enclosing formal access.
+    if let offset = getOffsetFromStorage() {
+      let p = UnsafeRawPointer(base).advanced(by: offset)
+      return (pointer: UnsafeMutablePointer(
+                mutating: p.assumingMemoryBound(to: Value.self)),
+              owner: nil)
+    }
+
     var p = UnsafeRawPointer(base)
     var type: Any.Type = Root.self
     var keepAlive: AnyObject?
@@ -352,6 +467,21 @@ public class ReferenceWritableKeyPath<
   @usableFromInline
   internal final func _projectMutableAddress(from origBase: Root)
       -> (pointer: UnsafeMutablePointer<Value>, owner: AnyObject?) {
+    // One-offset fast path for a single stored class-property component. The
+    // ClassHolder keeps the object alive and holds the same 'modify' access
+    // the interpreted walk below would begin on this address.
+    if let offset = getClassOffsetFromStorage() {
+      let object = unsafeBitCast(origBase, to: AnyObject.self)
+      let offsetAddress = UnsafeRawPointer(Builtin.bridgeToRawPointer(object))
+            .advanced(by: offset)
+      let holder = ClassHolder<Value>._create(previous: nil, instance: object,
+                                              accessingAddress: offsetAddress,
+                                              type: Value.self)
+      let typedPointer = offsetAddress.assumingMemoryBound(to: Value.self)
+      return (pointer: UnsafeMutablePointer(mutating: typedPointer),
+              owner: holder)
+    }
+
     var keepAlive: AnyObject?
     let address: UnsafeMutablePointer<Value> = withBuffer {
       var buffer = $0
@@ -2284,7 +2414,11 @@ internal func _appendingKeyPaths<
       // KVC-compatible.
       let appendedKVCLength: Int, rootKVCLength: Int, leafKVCLength: Int
 
-      if let rootPtr = root._kvcKeyPathStringPtr,
+      if root.getOffsetFromStorage() == nil,
+         leaf.getOffsetFromStorage() == nil,
+         root.getClassOffsetFromStorage() == nil,
+         leaf.getClassOffsetFromStorage() == nil,
+         let rootPtr = root._kvcKeyPathStringPtr,
          let leafPtr = leaf._kvcKeyPathStringPtr {
         rootKVCLength = Int(_swift_stdlib_strlen(rootPtr))
         leafKVCLength = Int(_swift_stdlib_strlen(leafPtr))
@@ -2396,6 +2530,10 @@ internal func _appendingKeyPaths<
           UnsafePointer(kvcStringBuffer.assumingMemoryBound(to: CChar.self))
         kvcStringBuffer.advanced(by: rootKVCLength + leafKVCLength + 1)
           .storeBytes(of: 0 /* '\0' */, as: CChar.self)
+      } else if let resultOffset = result._storedInlineOffset {
+        // The result of appending two pure stored-property key paths is
+        // itself a single offset; cache it for direct projection.
+        result.assignOffsetToStorage(offset: resultOffset)
       }
       return unsafeDowncast(result, to: Result.self)
     }
@@ -2495,6 +2633,13 @@ public func _swift_getKeyPath(pattern: UnsafeMutableRawPointer,
   if kvcStringOffset == 0 {
     // Null pointer.
     instance._kvcKeyPathStringPtr = nil
+    // Cache a pure stored-property path as a single byte offset, so that
+    // projections can apply it directly instead of walking the components.
+    if let offset = instance._storedInlineOffset {
+      instance.assignOffsetToStorage(offset: offset)
+    } else if let offset = instance._singleClassStoredOffset {
+      instance.assignClassOffsetToStorage(offset: offset)
+    }
   } else {
     let kvcStringPtr = _resolveRelativeAddress(kvcStringBase, kvcStringOffset)
     instance._kvcKeyPathStringPtr =
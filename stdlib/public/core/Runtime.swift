@@ -366,6 +366,44 @@ internal func _float64ToString(
   return (buffer, length)
 }
 
+@_silgen_name("swift_float64ToStringBatch")
+internal func _float64ToStringBatchImpl(
+  _ buffer: UnsafeMutablePointer<UTF8.CodeUnit>,
+  _ bufferLength: UInt,
+  _ values: UnsafePointer<Float64>,
+  _ count: UInt,
+  _ lengths: UnsafeMutablePointer<Int>
+) -> UInt64
+
+/// Formats a batch of `Double` values as shortest-round-trip decimal
+/// strings, packed back to back into `utf8Buffer` with no separators.
+///
+/// On return, `lengths[i]` holds the UTF-8 length of the `i`th string;
+/// the `i`th string starts at the sum of the first `i` lengths. Formatting
+/// stops early if `utf8Buffer` runs out of space; the result is the number
+/// of values actually formatted. `lengths` must hold at least as many
+/// elements as `values`.
+///
+/// SPI for high-volume formatting; equivalent to, but substantially
+/// cheaper than, interpolating each value into a `String`.
+public func _float64ToStringBatch(
+  _ values: UnsafeBufferPointer<Float64>,
+  into utf8Buffer: UnsafeMutableBufferPointer<UTF8.CodeUnit>,
+  lengths: UnsafeMutableBufferPointer<Int>
+) -> Int {
+  _precondition(lengths.count >= values.count,
+    "Insufficient space for the formatted lengths")
+  let count = values.count
+  guard let valuesPtr = values.baseAddress,
+        let bufferPtr = utf8Buffer.baseAddress,
+        let lengthsPtr = lengths.baseAddress else {
+    return 0
+  }
+  return Int(truncatingIfNeeded: _float64ToStringBatchImpl(
+      bufferPtr, UInt(utf8Buffer.count),
+      valuesPtr, UInt(count), lengthsPtr))
+}
+
 
 #if !(os(Windows) || os(Android)) && (arch(i386) || arch(x86_64))
 
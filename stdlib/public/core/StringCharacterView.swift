@@ -48,6 +48,22 @@ extension String: BidirectionalCollection {
   /// The number of characters in a string.
   @inline(__always)
   public var count: Int {
+    if _fastPath(_guts.isFastUTF8 && _guts.isASCII) {
+      // In an all-ASCII string every byte is a grapheme cluster of its own,
+      // except that a CR immediately followed by a LF forms one cluster.
+      // This simple byte scan vectorizes well, unlike the generic
+      // character-by-character walk.
+      return _guts.withFastUTF8 { utf8 in
+        var count = utf8.count
+        let ptr = utf8.baseAddress._unsafelyUnwrappedUnchecked
+        var i = 1
+        while i < utf8.count {
+          if ptr[i] == 0x0A && ptr[i &- 1] == 0x0D { count &-= 1 }
+          i &+= 1
+        }
+        return count
+      }
+    }
     return distance(from: startIndex, to: endIndex)
   }
 
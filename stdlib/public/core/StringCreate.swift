@@ -17,8 +17,6 @@ internal func _allASCII(_ input: UnsafeBufferPointer<UInt8>) -> Bool {
 
   // NOTE: Avoiding for-in syntax to avoid bounds checks
   //
-  // TODO(String performance): SIMD-ize
-  //
   let ptr = input.baseAddress._unsafelyUnwrappedUnchecked
   var i = 0
 
@@ -34,6 +32,18 @@ internal func _allASCII(_ input: UnsafeBufferPointer<UInt8>) -> Bool {
     i &+= 1
   }
 
+  // Process four words per iteration, combining them with bitwise OR before
+  // testing the high bits. The independent loads and the OR reduction allow
+  // the optimizer to vectorize this loop.
+  while (i &+ 4 &* stride) <= count {
+    let base = UnsafePointer<UInt>(
+      bitPattern: address &+ i
+    )._unsafelyUnwrappedUnchecked
+    let combined = base[0] | base[1] | base[2] | base[3]
+    guard combined & wordASCIIMask == 0 else { return false }
+    i &+= 4 &* stride
+  }
+
   while (i &+ stride) <= count {
     let word: UInt = UnsafePointer(
       bitPattern: address &+ i
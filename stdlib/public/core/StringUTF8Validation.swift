@@ -31,16 +31,47 @@ extension UTF8ValidationResult: Equatable {}
 
 private struct UTF8ValidationError: Error {}
 
+/// Advance \p pos over a run of ASCII bytes, word-at-a-time once the
+/// position is word-aligned. This mirrors the scanning loops of `_allASCII`.
+@inline(__always)
+private func _skipASCIIRun(
+  _ ptr: UnsafePointer<UInt8>, _ pos: inout Int, _ count: Int
+) {
+  let stride = MemoryLayout<UInt>.stride
+  let address = Int(bitPattern: ptr)
+  let wordASCIIMask = UInt(truncatingIfNeeded: 0x8080_8080_8080_8080 as UInt64)
+
+  while (address &+ pos) % stride != 0 {
+    guard pos < count, ptr[pos] & 0x80 == 0 else { return }
+    pos &+= 1
+  }
+  while (pos &+ stride) <= count {
+    let word: UInt = UnsafePointer<UInt>(
+      bitPattern: address &+ pos
+    )._unsafelyUnwrappedUnchecked.pointee
+    guard word & wordASCIIMask == 0 else { return }
+    pos &+= stride
+  }
+}
+
 internal func validateUTF8(_ buf: UnsafeBufferPointer<UInt8>) -> UTF8ValidationResult {
   if _allASCII(buf) {
     return .success(UTF8ExtraInfo(isASCII: true))
   }
 
-  var iter = buf.makeIterator()
+  let ptr = buf.baseAddress._unsafelyUnwrappedUnchecked
+  let count = buf.count
+  var pos = buf.startIndex
   var lastValidIndex = buf.startIndex
 
+  @inline(__always) func nextByte() throws -> UInt8 {
+    guard pos < count else { throw UTF8ValidationError() }
+    let cu = ptr[pos]
+    pos &+= 1
+    return cu
+  }
   @inline(__always) func guaranteeIn(_ f: (UInt8) -> Bool) throws {
-    guard let cu = iter.next() else { throw UTF8ValidationError() }
+    let cu = try nextByte()
     guard f(cu) else { throw UTF8ValidationError() }
   }
   @inline(__always) func guaranteeContinuation() throws {
@@ -102,8 +133,19 @@ internal func validateUTF8(_ buf: UnsafeBufferPointer<UInt8>) -> UTF8ValidationR
 
   do {
     var isASCII = true
-    while let cu = iter.next() {
-      if UTF8.isASCII(cu) { lastValidIndex &+= 1; continue }
+    while pos < count {
+      let cu = ptr[pos]
+      pos &+= 1
+      if UTF8.isASCII(cu) {
+        lastValidIndex &+= 1
+        // Mixed content usually has long stretches of ASCII between
+        // multi-byte sequences; skip over them in bulk instead of
+        // revalidating byte by byte.
+        let runStart = pos
+        _skipASCIIRun(ptr, &pos, count)
+        lastValidIndex &+= pos &- runStart
+        continue
+      }
       isASCII = false
       if _slowPath(!_isUTF8MultiByteLeading(cu)) {
         throw UTF8ValidationError()
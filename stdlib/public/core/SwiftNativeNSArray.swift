@@ -322,6 +322,70 @@ extension __SwiftNativeNSArrayWithContiguousStorage {
   }
 }
 
+/// An `NSArray` holding at most three eagerly bridged elements inline.
+///
+/// Deferred bridging pays for two allocations by the time an element is
+/// accessed: the `__SwiftDeferredNSArray` wrapper and the heap buffer of
+/// bridged objects. For the tiny arrays that dominate down-calls into
+/// Objective-C, that overhead exceeds the cost of bridging the elements
+/// up front, so `_asCocoaArray` bridges them eagerly into a single
+/// instance of this class instead.
+@_fixed_layout
+@usableFromInline
+@objc internal final class __SwiftSmallNSArray
+  : __SwiftNativeNSArrayWithContiguousStorage {
+
+  /// The maximum number of elements an instance can hold.
+  @nonobjc
+  internal static var _capacity: Int { return 3 }
+
+  // These stored properties must stay first and in declaration order:
+  // `withUnsafeBufferOfObjects` addresses them as a contiguous buffer
+  // of `_count` objects starting at offset zero.
+  @nonobjc internal let _element0: AnyObject?
+  @nonobjc internal let _element1: AnyObject?
+  @nonobjc internal let _element2: AnyObject?
+
+  /// The native storage the elements were bridged from, retained so
+  /// `_bridgeFromObjectiveCAdoptingNativeStorageOf` can recover it on
+  /// the way back into Swift without copying.
+  @usableFromInline
+  @nonobjc
+  internal let _nativeStorage: __ContiguousArrayStorageBase
+
+  @nonobjc internal let _count: Int
+
+  @nonobjc
+  internal init(
+    _count: Int,
+    _element0: AnyObject?,
+    _element1: AnyObject?,
+    _element2: AnyObject?,
+    _nativeStorage: __ContiguousArrayStorageBase
+  ) {
+    _internalInvariant(_count <= __SwiftSmallNSArray._capacity)
+    self._element0 = _element0
+    self._element1 = _element1
+    self._element2 = _element2
+    self._nativeStorage = _nativeStorage
+    self._count = _count
+  }
+
+  internal override func withUnsafeBufferOfObjects<R>(
+    _ body: (UnsafeBufferPointer<AnyObject>) throws -> R
+  ) rethrows -> R {
+    defer { _fixLifetime(self) }
+    let objects = _getUnsafePointerToStoredProperties(self)
+      .assumingMemoryBound(to: AnyObject.self)
+    return try body(UnsafeBufferPointer(start: objects, count: _count))
+  }
+
+  @objc
+  internal override var count: Int {
+    return _count
+  }
+}
+
 /// An `NSArray` whose contiguous storage is created and filled, upon
 /// first access, by bridging the elements of a Swift `Array`.
 ///
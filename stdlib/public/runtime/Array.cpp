@@ -22,12 +22,27 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include "Private.h"
 #include "swift/Runtime/Config.h"
 #include "swift/Runtime/HeapObject.h"
 #include "swift/Runtime/Metadata.h"
 
 using namespace swift;
 
+/// True if the array's element type is a single Swift-native class reference,
+/// in which case copy and destroy operations reduce to bulk pointer copies
+/// plus swift_retain/swift_release on each element.
+static bool isNativeClassReferenceArray(const Metadata *self) {
+  if (self->getKind() != MetadataKind::Class)
+    return false;
+#if SWIFT_OBJC_INTEROP
+  return usesNativeSwiftReferenceCounting(
+      static_cast<const ClassMetadata *>(self));
+#else
+  return true;
+#endif
+}
+
 namespace {
 enum class ArrayCopy : unsigned {
   NoAlias = 0,
@@ -108,6 +123,34 @@ static void array_copy_operation(OpaqueValue *dest, OpaqueValue *src,
     }
   }
 
+  // Fast path for arrays of native class references: bulk-copy the
+  // references and adjust reference counts in a tight loop, instead of
+  // making an indirect value-witness call per element. Retains of the source
+  // happen before releases of the destination so that references shared by
+  // both arrays can't be deallocated in between.
+  if (isNativeClassReferenceArray(self)) {
+    auto **destRefs = reinterpret_cast<HeapObject **>(dest);
+    auto **srcRefs = reinterpret_cast<HeapObject **>(src);
+    if (destOp == ArrayDest::Init && srcOp == ArraySource::Copy) {
+      // Init with copy never aliases.
+      memcpy(dest, src, stride * count);
+      for (size_t i = 0; i < count; ++i)
+        swift_retain(destRefs[i]);
+      return;
+    }
+    if (destOp == ArrayDest::Assign && copyKind == ArrayCopy::NoAlias) {
+      if (srcOp == ArraySource::Copy) {
+        for (size_t i = 0; i < count; ++i)
+          swift_retain(srcRefs[i]);
+      }
+      for (size_t i = 0; i < count; ++i)
+        swift_release(destRefs[i]);
+      memcpy(dest, src, stride * count);
+      return;
+    }
+    // Aliasing assign-with-copy variants fall through to the generic loop.
+  }
+
   // Call the witness to do the copy.
   if (copyKind == ArrayCopy::NoAlias || copyKind == ArrayCopy::FrontToBack) {
     auto copy = get_witness_function<destOp, srcOp>(wtable);
@@ -201,6 +244,15 @@ void swift_arrayDestroy(OpaqueValue *begin, size_t count, const Metadata *self)
   if (wtable->isPOD())
     return;
 
+  // Release native class references directly rather than making an indirect
+  // value-witness call per element.
+  if (isNativeClassReferenceArray(self)) {
+    auto **refs = reinterpret_cast<HeapObject **>(begin);
+    for (size_t i = 0; i < count; ++i)
+      swift_release(refs[i]);
+    return;
+  }
+
   auto stride = wtable->getStride();
   for (size_t i = 0; i < count; ++i) {
     auto offset = i * stride;
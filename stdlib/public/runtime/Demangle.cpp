@@ -12,9 +12,11 @@
 
 #include "Private.h"
 #include "swift/ABI/TypeIdentity.h"
+#include "swift/Basic/Lazy.h"
 #include "swift/Basic/Range.h"
 #include "swift/Reflection/TypeRef.h"
 #include "swift/Runtime/Metadata.h"
+#include "swift/Runtime/Mutex.h"
 #include "swift/Runtime/Portability.h"
 #include "swift/Strings.h"
 
@@ -638,6 +640,22 @@ swift::_swift_buildDemanglingForMetadata(const Metadata *type,
   return nullptr;
 }
 
+namespace {
+/// A demangling context shared by all swift_demangle() calls, protected by a
+/// lock. It keeps an LRU cache of results and reuses the demangler's node
+/// arena across calls.
+struct CachingDemangleContext {
+  Mutex Lock;
+  Demangle::Context Context;
+  Demangle::DemangleOptions Options;
+
+  CachingDemangleContext() {
+    Options.DisplayDebuggerGeneratedModule = false;
+    Context.enableDemanglingCache();
+  }
+};
+} // end anonymous namespace
+
 // NB: This function is not used directly in the Swift codebase, but is
 // exported for Xcode support and is used by the sanitizers. Please coordinate
 // before changing.
@@ -658,13 +676,18 @@ char *swift_demangle(const char *mangledName,
   if (!Demangle::isSwiftSymbol(mangledName))
     return nullptr; // Not a mangled name
 
-  // Demangle the name.
-  auto options = Demangle::DemangleOptions();
-  options.DisplayDebuggerGeneratedModule = false;
-  auto result =
-      Demangle::demangleSymbolAsString(mangledName,
-                                       mangledNameLength,
-                                       options);
+  // Clients like crash reporters call this with the same symbols over and
+  // over, so demangle through a persistent context with a bounded cache of
+  // results instead of reparsing every time.
+  static Lazy<CachingDemangleContext> DemangleContext;
+  auto &cachingContext = DemangleContext.get();
+  std::string result;
+  {
+    Mutex::ScopedLock guard(cachingContext.Lock);
+    result = cachingContext.Context.demangleSymbolAsString(
+        llvm::StringRef(mangledName, mangledNameLength),
+        cachingContext.Options);
+  }
 
   // If the output buffer is not provided, malloc memory ourselves.
   if (outputBuffer == nullptr || *outputBufferSize == 0) {
@@ -1226,32 +1226,126 @@ tryCastToFunction(
 /************************** Existential Destination ***************************/
 /******************************************************************************/
 
+#if __has_feature(cxx_thread_local)
+namespace {
+/// A small per-thread memo of recent successful existential conformance
+/// checks. Serialization-style code repeats the same as?-cast in a tight
+/// loop, and each check otherwise re-queries the global conformance cache
+/// once per protocol. Only successes are stored: a witness table, once
+/// found, stays valid, whereas a failure can be invalidated by loading an
+/// image that registers new conformances.
+struct ExistentialCastCache {
+  static const uintptr_t NumEntries = 8; // direct-mapped, power of two
+  static const size_t MaxWitnessTables = 4;
+
+  struct Entry {
+    const Metadata *Type;
+    const ExistentialTypeMetadata *ExistentialType;
+    /// Whether the conformance checks succeeded. Failures are memoized too:
+    /// code that probes optional conformances repeats the same failing cast
+    /// per object. A negative entry is only valid for the conformance
+    /// registration generation it was computed in, since loading a new
+    /// image can add the missing conformance.
+    bool Succeeded;
+    size_t NegativeGeneration;
+    const WitnessTable *WitnessTables[MaxWitnessTables];
+  };
+  Entry Entries[NumEntries];
+
+  Entry &getEntry(const Metadata *type,
+                  const ExistentialTypeMetadata *existentialType) {
+    auto hash = (reinterpret_cast<uintptr_t>(type) >> 4) ^
+                (reinterpret_cast<uintptr_t>(existentialType) >> 4);
+    return Entries[hash & (NumEntries - 1)];
+  }
+};
+} // end anonymous namespace
+
+static thread_local ExistentialCastCache ExistentialCasts;
+#endif
+
 /// Check whether a type conforms to the given protocols, filling in a
 /// list of conformances.
 static bool _conformsToProtocols(const OpaqueValue *value,
                                  const Metadata *type,
                                  const ExistentialTypeMetadata *existentialType,
                                  const WitnessTable **conformances) {
-  if (auto *superclass = existentialType->getSuperclassConstraint()) {
-    if (!swift_dynamicCastMetatype(type, superclass))
-      return false;
+  auto protocols = existentialType->getProtocols();
+
+#if __has_feature(cxx_thread_local)
+  // The memo only applies when the outcome depends on the types alone, i.e.
+  // when no protocol requires the per-instance Objective-C check.
+  bool memoizable = conformances != nullptr &&
+                    protocols.size() <= ExistentialCastCache::MaxWitnessTables;
+  if (memoizable) {
+    for (auto protocol : protocols) {
+      if (!protocol.needsWitnessTable()) {
+        memoizable = false;
+        break;
+      }
+    }
   }
-
-  if (existentialType->isClassBounded()) {
-    if (!Metadata::isAnyKindOfClass(type->getKind()))
-      return false;
+  size_t negativeGeneration = 0;
+  if (memoizable) {
+    auto &entry = ExistentialCasts.getEntry(type, existentialType);
+    if (entry.Type == type && entry.ExistentialType == existentialType) {
+      if (entry.Succeeded) {
+        for (size_t i = 0, e = protocols.size(); i != e; ++i)
+          conformances[i] = entry.WitnessTables[i];
+        return true;
+      }
+      if (entry.NegativeGeneration ==
+          swift::_getConformanceRegistrationGeneration())
+        return false;
+    }
+    // Capture the generation before running the checks, so a registration
+    // that races with them invalidates whatever we record.
+    negativeGeneration = swift::_getConformanceRegistrationGeneration();
   }
+#endif
 
-  for (auto protocol : existentialType->getProtocols()) {
-    if (!swift::_conformsToProtocol(value, type, protocol, conformances))
-      return false;
-    if (conformances != nullptr && protocol.needsWitnessTable()) {
-      assert(*conformances != nullptr);
-      ++conformances;
+  auto checkConformances = [&]() -> bool {
+    if (auto *superclass = existentialType->getSuperclassConstraint()) {
+      if (!swift_dynamicCastMetatype(type, superclass))
+        return false;
+    }
+
+    if (existentialType->isClassBounded()) {
+      if (!Metadata::isAnyKindOfClass(type->getKind()))
+        return false;
+    }
+
+    const WitnessTable **nextConformance = conformances;
+    for (auto protocol : protocols) {
+      if (!swift::_conformsToProtocol(value, type, protocol, nextConformance))
+        return false;
+      if (nextConformance != nullptr && protocol.needsWitnessTable()) {
+        assert(*nextConformance != nullptr);
+        ++nextConformance;
+      }
+    }
+
+    return true;
+  };
+
+  bool succeeded = checkConformances();
+
+#if __has_feature(cxx_thread_local)
+  if (memoizable) {
+    auto &entry = ExistentialCasts.getEntry(type, existentialType);
+    entry.Type = type;
+    entry.ExistentialType = existentialType;
+    entry.Succeeded = succeeded;
+    if (succeeded) {
+      for (size_t i = 0, e = protocols.size(); i != e; ++i)
+        entry.WitnessTables[i] = conformances[i];
+    } else {
+      entry.NegativeGeneration = negativeGeneration;
     }
   }
+#endif
 
-  return true;
+  return succeeded;
 }
 
 // Cast to unconstrained `Any`
@@ -26,6 +26,7 @@
 #include "../SwiftShims/Visibility.h"
 #include "ThreadLocalStorage.h"
 #include "swift/Basic/Lazy.h"
+#include "swift/Runtime/ThreadLocal.h"
 #include "swift/Runtime/Config.h"
 #include "swift/Runtime/Debug.h"
 #include "swift/Runtime/Metadata.h"
@@ -281,7 +282,11 @@ static SwiftTLSContext &getTLSContext() {
 #elif __has_feature(cxx_thread_local)
 // Second choice is direct language support for thread-locals.
 
-static thread_local SwiftTLSContext TLSContext;
+// On ELF platforms, ask for the initial-exec TLS model so that fetching
+// the context in swift_beginAccess is a direct TP-relative load rather
+// than a call through __tls_get_addr.
+static thread_local SWIFT_RUNTIME_ATTRIBUTE_TLS_INITIAL_EXEC
+    SwiftTLSContext TLSContext;
 
 static SwiftTLSContext &getTLSContext() {
   return TLSContext;
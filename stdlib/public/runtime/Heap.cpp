@@ -18,12 +18,16 @@
 #include "swift/Runtime/Heap.h"
 #include "Private.h"
 #include "swift/Runtime/Debug.h"
+#include "swift/Runtime/EnvironmentVariables.h"
 #include "../SwiftShims/RuntimeShims.h"
 #include <algorithm>
+#include <atomic>
 #include <stdlib.h>
 #if defined(__APPLE__)
 #include "swift/Basic/Lazy.h"
 #include <malloc/malloc.h>
+#elif defined(__linux__) || defined(_WIN32)
+#include <malloc.h>
 #endif
 
 using namespace swift;
@@ -68,6 +72,172 @@ static inline malloc_zone_t *DEFAULT_ZONE() {
 }
 #endif
 
+// The per-thread small-allocation cache requires C++ thread-locals (the
+// magazines must be flushed when a thread exits) and a way to query the
+// usable size of a malloc'd block.
+#if __has_feature(cxx_thread_local) && \
+    (defined(__APPLE__) || defined(__linux__) || defined(_WIN32))
+#define SWIFT_HAVE_SMALL_ALLOCATION_CACHE 1
+#endif
+
+#ifdef SWIFT_HAVE_SMALL_ALLOCATION_CACHE
+
+static inline void *systemAlloc(size_t size) {
+#if defined(__APPLE__)
+  return malloc_zone_malloc(DEFAULT_ZONE(), size);
+#else
+  return malloc(size);
+#endif
+}
+
+static inline void systemFree(void *ptr) {
+#if defined(__APPLE__)
+  malloc_zone_free(DEFAULT_ZONE(), ptr);
+#else
+  free(ptr);
+#endif
+}
+
+static inline size_t systemUsableSize(void *ptr) {
+#if defined(__APPLE__)
+  return malloc_size(ptr);
+#elif defined(_WIN32)
+  return _msize(ptr);
+#else
+  return malloc_usable_size(ptr);
+#endif
+}
+
+/// Aggregate counters, fed from the per-thread counts below. See
+/// swift_getSmallAllocationCacheCounters.
+static std::atomic<size_t> SmallAllocationCacheHits(0);
+static std::atomic<size_t> SmallAllocationCacheMisses(0);
+
+namespace {
+
+/// An optional per-thread cache of small heap allocations, enabled with
+/// SWIFT_ENABLE_SMALL_ALLOCATION_CACHE.
+///
+/// Allocation-heavy workloads spend a significant fraction of class
+/// instantiation inside malloc, mostly contending on the shared state
+/// behind the 16-256 byte size classes that a typical object header plus
+/// a few fields lands in. Deallocated blocks parked in a per-thread
+/// magazine can be handed back to the next allocation of the same class
+/// without touching the system allocator or any shared state.
+struct SmallAllocationCache {
+  /// Size class i serves requests of i*Granule+1 through (i+1)*Granule
+  /// bytes. Cached blocks always have at least the full class size usable,
+  /// so a block parked by any request in a class can serve every other.
+  static const size_t Granule = 16;
+  static const size_t MaxSize = 256;
+  static const size_t NumClasses = MaxSize / Granule;
+
+  /// Cap on the blocks parked per class, bounding a thread's worst-case
+  /// cache footprint to NumClasses * MaxBlocks * average class size
+  /// (a little under 300 KB).
+  static const size_t MaxBlocks = 64;
+
+  /// How many hits and misses to accumulate locally before folding them
+  /// into the global counters.
+  static const size_t CounterFlushThreshold = 1024;
+
+  /// Heads of singly-linked free lists, threaded through the first word
+  /// of each parked block.
+  void *blocks[NumClasses] = {};
+  size_t depths[NumClasses] = {};
+  size_t hits = 0;
+  size_t misses = 0;
+
+  static size_t classIndex(size_t size) { return (size - 1) / Granule; }
+  static size_t classSize(size_t index) { return (index + 1) * Granule; }
+
+  /// Allocate a block for a request of `size` bytes, either from the
+  /// magazine or from the system allocator. Returns nullptr only if the
+  /// system allocator does.
+  void *allocate(size_t size) {
+    size_t index = classIndex(size);
+    if (void *block = blocks[index]) {
+      blocks[index] = *reinterpret_cast<void **>(block);
+      --depths[index];
+      bumpCounter(hits);
+      return block;
+    }
+    bumpCounter(misses);
+    // Allocate the full class size so the block can later serve any
+    // request in the same class.
+    return systemAlloc(classSize(index));
+  }
+
+  /// Try to park a block that was allocated for a request of `size`
+  /// bytes. Returns false if the caller must free the block instead:
+  /// either the magazine is full, or the block is too small to serve the
+  /// whole class (it came from malloc before the cache was involved, for
+  /// example via Objective-C instance allocation).
+  bool deallocate(void *ptr, size_t size) {
+    size_t index = classIndex(size);
+    if (depths[index] >= MaxBlocks ||
+        systemUsableSize(ptr) < classSize(index))
+      return false;
+    *reinterpret_cast<void **>(ptr) = blocks[index];
+    blocks[index] = ptr;
+    ++depths[index];
+    return true;
+  }
+
+  void bumpCounter(size_t &counter) {
+    ++counter;
+    if (hits + misses >= CounterFlushThreshold)
+      flushCounters();
+  }
+
+  void flushCounters() {
+    SmallAllocationCacheHits.fetch_add(hits, std::memory_order_relaxed);
+    SmallAllocationCacheMisses.fetch_add(misses, std::memory_order_relaxed);
+    hits = 0;
+    misses = 0;
+  }
+
+  ~SmallAllocationCache() {
+    // Thread-local destructors of other objects may still allocate after
+    // this runs; leave the magazines empty so any such stragglers simply
+    // miss into the system allocator.
+    for (size_t index = 0; index < NumClasses; ++index) {
+      void *block = blocks[index];
+      while (block) {
+        void *next = *reinterpret_cast<void **>(block);
+        systemFree(block);
+        block = next;
+      }
+      blocks[index] = nullptr;
+      depths[index] = 0;
+    }
+    flushCounters();
+  }
+};
+
+} // end anonymous namespace
+
+static thread_local SmallAllocationCache SmallAllocations;
+
+static inline bool smallAllocationCacheApplies(size_t size) {
+  // The subtraction deliberately wraps for size 0, excluding it.
+  return size - 1 < SmallAllocationCache::MaxSize &&
+         runtime::environment::SWIFT_ENABLE_SMALL_ALLOCATION_CACHE();
+}
+
+#endif // SWIFT_HAVE_SMALL_ALLOCATION_CACHE
+
+void swift_getSmallAllocationCacheCounters(size_t *outHits,
+                                           size_t *outMisses) {
+#ifdef SWIFT_HAVE_SMALL_ALLOCATION_CACHE
+  *outHits = SmallAllocationCacheHits.load(std::memory_order_relaxed);
+  *outMisses = SmallAllocationCacheMisses.load(std::memory_order_relaxed);
+#else
+  *outHits = 0;
+  *outMisses = 0;
+#endif
+}
+
 // When alignMask == ~(size_t(0)), allocation uses the "default"
 // _swift_MinAllocationAlignment. This is different than calling swift_slowAlloc
 // with `alignMask == _swift_MinAllocationAlignment - 1` because it forces
@@ -88,6 +258,13 @@ void *swift::swift_slowAlloc(size_t size, size_t alignMask) {
   void *p;
   // This check also forces "default" alignment to use AlignedAlloc.
   if (alignMask <= MALLOC_ALIGN_MASK) {
+#ifdef SWIFT_HAVE_SMALL_ALLOCATION_CACHE
+    if (smallAllocationCacheApplies(size)) {
+      p = SmallAllocations.allocate(size);
+      if (!p) swift::crash("Could not allocate memory.");
+      return p;
+    }
+#endif
 #if defined(__APPLE__)
     p = malloc_zone_malloc(DEFAULT_ZONE(), size);
 #else
@@ -121,6 +298,11 @@ void *swift::swift_slowAlloc(size_t size, size_t alignMask) {
 //   consistent with allocation with the same alignment.
 void swift::swift_slowDealloc(void *ptr, size_t bytes, size_t alignMask) {
   if (alignMask <= MALLOC_ALIGN_MASK) {
+#ifdef SWIFT_HAVE_SMALL_ALLOCATION_CACHE
+    if (smallAllocationCacheApplies(bytes) &&
+        SmallAllocations.deallocate(ptr, bytes))
+      return;
+#endif
 #if defined(__APPLE__)
     malloc_zone_free(DEFAULT_ZONE(), ptr);
 #else
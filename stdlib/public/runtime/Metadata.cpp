@@ -346,8 +346,19 @@ namespace {
     uint16_t NumKeyParameters;
     uint16_t NumWitnessTables;
 
+    /// A small direct-mapped cache of recently returned entries, indexed
+    /// by key hash. Cache entries are never deallocated, so loading a slot
+    /// and comparing keys is safe without reader registration; a stale or
+    /// colliding slot is simply a miss. This gives the hot hit path of
+    /// swift_getGenericMetadata a wait-free lookup with no lock and no
+    /// atomic read-modify-write. Allocated lazily off to the side because
+    /// this class must fit in the instantiation cache's private data.
+    static const size_t NumFastSlots = 8;
+    std::atomic<GenericCacheEntry *> *FastSlots;
+
     GenericMetadataCache(const TargetGenericContext<InProcess> &genericContext)
-        : NumKeyParameters(0), NumWitnessTables(0) {
+        : NumKeyParameters(0), NumWitnessTables(0),
+          FastSlots(new std::atomic<GenericCacheEntry *>[NumFastSlots]()) {
       // Count up the # of key parameters and # of witness tables.
 
       // Find key generic parameters.
@@ -782,8 +793,25 @@ _swift_getGenericMetadata(MetadataRequest request, const void *const *arguments,
          cache.NumKeyParameters + cache.NumWitnessTables);
   auto key = MetadataCacheKey(cache.NumKeyParameters, cache.NumWitnessTables,
                               arguments);
+
+  // Wait-free fast path: check the direct-mapped slot for this key's hash.
+  // A hit on complete metadata takes one acquire load and a key comparison,
+  // with no lock and no atomic read-modify-write.
+  auto &fastSlot =
+      cache.FastSlots[key.hash() % GenericMetadataCache::NumFastSlots];
+  if (auto *entry = fastSlot.load(std::memory_order_acquire)) {
+    if (entry->matchesKey(key)) {
+      if (auto response = entry->tryGetCompleteResponse())
+        return *response;
+    }
+  }
+
   auto result = cache.getOrInsert(key, request, description, arguments);
 
+  // Publish the entry for subsequent lookups. Racing stores just leave a
+  // different recently-used entry in the slot.
+  fastSlot.store(result.first, std::memory_order_release);
+
   return result.second;
 }
 
@@ -889,6 +889,18 @@ public:
     return { asImpl().getValue(), trackingInfo.getAccomplishedRequestState() };
   }
 
+  /// If this entry's metadata is already complete, return a response for
+  /// it; otherwise return None. This never blocks and performs no atomic
+  /// read-modify-write, so it is suitable for wait-free fast paths that
+  /// hold a pointer to a (never-deallocated) cache entry.
+  llvm::Optional<Status> tryGetCompleteResponse() {
+    auto trackingInfo =
+      PrivateMetadataTrackingInfo(TrackingInfo.load(std::memory_order_acquire));
+    if (!trackingInfo.isComplete())
+      return llvm::None;
+    return Status{asImpl().getValue(), MetadataState::Complete};
+  }
+
   /// The expected return type of allocate.
   struct AllocationResult {
     Metadata *Value;
@@ -36,6 +36,7 @@
 #include "CompatibilityOverride.h"
 #include "ImageInspection.h"
 #include <functional>
+#include <unordered_map>
 #include <vector>
 #include <list>
 
@@ -243,23 +244,52 @@ namespace {
   };
 } // end anonymous namespace
 
+/// Set once TypeMetadataRecords below has been constructed, so that
+/// invalidation requests arriving before that don't touch the
+/// uninitialized state.
+static std::atomic<bool> TypeMetadataRecordsReady{false};
+
 struct TypeMetadataPrivateState {
   ConcurrentReadableHashMap<NominalTypeDescriptorCacheEntry> NominalCache;
   ConcurrentReadableArray<TypeMetadataSection> SectionsToScan;
-  
+
+  /// A lazily built index from a type's name to the type metadata records
+  /// whose descriptors carry that name. Building it costs one pass over all
+  /// records; afterwards a by-name lookup only structurally matches the
+  /// records sharing the leaf name instead of demangling candidates from
+  /// every loaded image. Records whose name cannot be determined up front
+  /// land in UnindexedRecords and are always scanned. Registering new
+  /// sections invalidates the index via the section count.
+  Mutex NameIndexLock;
+  size_t NameIndexSectionCount = 0;
+  std::unordered_map<std::string, std::vector<const TypeMetadataRecord *>>
+      NameIndex;
+  std::vector<const TypeMetadataRecord *> UnindexedRecords;
+
   TypeMetadataPrivateState() {
     initializeTypeMetadataRecordLookup();
+    TypeMetadataRecordsReady.store(true, std::memory_order_release);
   }
 
 };
 
 static Lazy<TypeMetadataPrivateState> TypeMetadataRecords;
 
+void swift::_invalidateNominalTypeDescriptorNegativeCache() {
+  if (!TypeMetadataRecordsReady.load(std::memory_order_acquire))
+    return;
+  TypeMetadataRecords.unsafeGetAlreadyInitialized().NominalCache.clear();
+}
+
 static void
 _registerTypeMetadataRecords(TypeMetadataPrivateState &T,
                              const TypeMetadataRecord *begin,
                              const TypeMetadataRecord *end) {
   T.SectionsToScan.push_back(TypeMetadataSection{begin, end});
+
+  // Blow away the nominal type descriptor cache to get rid of any negative
+  // entries that may now be obsolete.
+  T.NominalCache.clear();
 }
 
 void swift::addImageTypeMetadataRecordBlockCallbackUnsafe(
@@ -641,10 +671,108 @@ swift::_contextDescriptorMatchesMangling(const ContextDescriptor *context,
   return true;
 }
 
+/// Extract the leaf name that a context descriptor must carry in order to
+/// match \p node, or an empty string if no such name can be determined and
+/// all records have to be considered.
+///
+/// The name returned here mirrors the leaf comparison performed by
+/// _contextDescriptorMatchesMangling: the innermost context is matched
+/// against the identifier of the innermost node, so records whose
+/// descriptors carry a different name can never match.
+static StringRef _getLeafNameForPrefilter(Demangle::NodePointer node) {
+  if (node->getKind() == Demangle::Node::Kind::Type)
+    node = node->getChild(0);
+
+  switch (node->getKind()) {
+  case Demangle::Node::Kind::Structure:
+  case Demangle::Node::Kind::Enum:
+  case Demangle::Node::Kind::Class:
+  case Demangle::Node::Kind::Protocol:
+  case Demangle::Node::Kind::OtherNominalType:
+  case Demangle::Node::Kind::TypeAlias:
+    break;
+  default:
+    return StringRef();
+  }
+
+  if (node->getNumChildren() < 2)
+    return StringRef();
+
+  auto nameNode = node->getChild(1);
+  if (nameNode->getKind() == Demangle::Node::Kind::RelatedEntityDeclName) {
+    if (nameNode->getNumChildren() < 2)
+      return StringRef();
+    nameNode = nameNode->getChild(1);
+  }
+  if (nameNode->getKind() != Demangle::Node::Kind::Identifier ||
+      !nameNode->hasText())
+    return StringRef();
+  return nameNode->getText();
+}
+
+/// Get the name under which a type metadata record is indexed, or an empty
+/// string if the record has to be scanned for every lookup.
+static StringRef _getRecordIndexName(const TypeMetadataRecord &record) {
+  auto context = record.getContextDescriptor();
+  if (!context)
+    return StringRef();
+  if (auto typeContext = llvm::dyn_cast<TypeContextDescriptor>(context))
+    return ParsedTypeIdentity::parse(typeContext).getABIName();
+  if (auto protocol = llvm::dyn_cast<ProtocolDescriptor>(context))
+    return StringRef(protocol->Name.get());
+  return StringRef();
+}
+
 // returns the nominal type descriptor for the type named by typeName
 static const ContextDescriptor *
 _searchTypeMetadataRecords(TypeMetadataPrivateState &T,
                            Demangle::NodePointer node) {
+  auto leafName = _getLeafNameForPrefilter(node);
+  if (!leafName.empty()) {
+    // Collect the candidate records under the lock, but run the structural
+    // match outside of it: matching an extension context re-enters
+    // _findContextDescriptor, which may land back here.
+    std::vector<const TypeMetadataRecord *> candidates;
+    {
+      ScopedLock guard(T.NameIndexLock);
+      auto snapshot = T.SectionsToScan.snapshot();
+
+      // (Re)build the index if sections were added since the last build.
+      if (T.NameIndexSectionCount != snapshot.count()) {
+        T.NameIndex.clear();
+        T.UnindexedRecords.clear();
+        for (auto &section : snapshot) {
+          for (const auto &record : section) {
+            auto name = _getRecordIndexName(record);
+            if (name.empty()) {
+              if (record.getContextDescriptor())
+                T.UnindexedRecords.push_back(&record);
+              continue;
+            }
+            T.NameIndex[name.str()].push_back(&record);
+          }
+        }
+        T.NameIndexSectionCount = snapshot.count();
+      }
+
+      auto found = T.NameIndex.find(leafName.str());
+      if (found != T.NameIndex.end())
+        candidates.insert(candidates.end(), found->second.begin(),
+                          found->second.end());
+      candidates.insert(candidates.end(), T.UnindexedRecords.begin(),
+                        T.UnindexedRecords.end());
+    }
+
+    for (const auto *record : candidates) {
+      if (auto context = record->getContextDescriptor()) {
+        if (_contextDescriptorMatchesMangling(context, node)) {
+          return context;
+        }
+      }
+    }
+    return nullptr;
+  }
+
   for (auto &section : T.SectionsToScan.snapshot()) {
     for (const auto &record : section) {
       if (auto context = record.getContextDescriptor()) {
@@ -721,30 +849,46 @@ _findContextDescriptor(Demangle::NodePointer node,
     Demangle::mangleNode(node, ExpandResolvedSymbolicReferences(Dem), Dem);
 
   // Look for an existing entry.
-  // Find the bucket for the metadata entry.
+  // Find the bucket for the metadata entry. Failed lookups are cached with
+  // a null descriptor; the cache is cleared whenever new sections are
+  // registered, so a cached failure is always still authoritative.
   {
     auto snapshot = T.NominalCache.snapshot();
     if (auto Value = snapshot.find(mangledName))
       return Value->getDescription();
   }
 
-  // Check type metadata records		   
+  // Snapshot the section count before scanning, so that a section
+  // registered mid-scan prevents caching a stale failure below.
+  size_t sectionsCount = T.SectionsToScan.snapshot().count();
+
+  // Check type metadata records
   // Scan any newly loaded images for context descriptors, then try the context
   foundContext = _searchTypeMetadataRecords(T, node);
-  
-  // Check protocol conformances table. Note that this has no support for		
+
+  // Check protocol conformances table. Note that this has no support for
   // resolving generic types yet.
   if (!foundContext)
     foundContext = _searchConformancesByMangledTypeName(node);
-  
-  if (foundContext)
-    T.NominalCache.getOrInsert(mangledName, [&](NominalTypeDescriptorCacheEntry
-                                                    *entry,
-                                                bool created) {
-      if (created)
-        new (entry) NominalTypeDescriptorCacheEntry{mangledName, foundContext};
+
+  T.NominalCache.getOrInsert(mangledName, [&](NominalTypeDescriptorCacheEntry
+                                                  *entry,
+                                              bool created) {
+    if (!created)
       return true;
-    });
+
+    // Only cache failure if no new sections were registered while we were
+    // scanning; new sections could contain the descriptor we missed. If a
+    // registration races with this insert, the registering thread's clear()
+    // serializes against the writer lock we hold and discards the entry
+    // right away.
+    if (foundContext == nullptr &&
+        T.SectionsToScan.snapshot().count() != sectionsCount)
+      return false; // abandon the new entry
+
+    new (entry) NominalTypeDescriptorCacheEntry{mangledName, foundContext};
+    return true;
+  });
 
   return foundContext;
 }
@@ -26,6 +26,12 @@
 #include <errno.h>
 #include <stdlib.h>
 
+#if HAS_FUTEX_LOCK
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <atomic>
+#endif
+
 using namespace swift;
 
 #define reportError(PThreadFunction)                                           \
@@ -137,6 +143,88 @@ bool MutexPlatformHelper::try_lock(os_unfair_lock &lock) {
 
 #endif
 
+#if HAS_FUTEX_LOCK
+
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t),
+              "atomic word must be the same size as the lock word");
+
+/// The number of times to spin on the lock word before sleeping in the
+/// kernel. The runtime's critical sections (metadata cache lookups,
+/// conformance checks, side table accesses) are short, so a waiter
+/// usually sees the lock released while still spinning.
+static const unsigned FutexSpinLimit = 40;
+
+static std::atomic<uint32_t> &futexWord(FutexLockHandle &lock) {
+  return reinterpret_cast<std::atomic<uint32_t> &>(lock.Word);
+}
+
+static void futexWait(FutexLockHandle &lock, uint32_t expected) {
+  (void)syscall(SYS_futex, &lock.Word, FUTEX_WAIT_PRIVATE, expected,
+                nullptr, nullptr, 0);
+}
+
+static void futexWake(FutexLockHandle &lock) {
+  (void)syscall(SYS_futex, &lock.Word, FUTEX_WAKE_PRIVATE, 1,
+                nullptr, nullptr, 0);
+}
+
+/// Tell the processor we're in a spin-wait loop, where supported.
+static inline void spinLoopHint() {
+#if defined(__x86_64__) || defined(__i386__)
+  __asm__ __volatile__("pause");
+#elif defined(__aarch64__) || defined(__arm__)
+  __asm__ __volatile__("yield");
+#endif
+}
+
+void MutexPlatformHelper::init(FutexLockHandle &lock, bool checked) {
+  (void)checked; // Futex locks don't support error checking.
+  lock.Word = 0;
+}
+
+void MutexPlatformHelper::destroy(FutexLockHandle &lock) {}
+
+void MutexPlatformHelper::lock(FutexLockHandle &lock) {
+  auto &word = futexWord(lock);
+
+  // Uncontended fast path.
+  uint32_t expected = 0;
+  if (word.compare_exchange_strong(expected, 1, std::memory_order_acquire,
+                                   std::memory_order_relaxed))
+    return;
+
+  // Spin for a short while in case the holder is about to release.
+  for (unsigned i = 0; i != FutexSpinLimit; ++i) {
+    spinLoopHint();
+    if (word.load(std::memory_order_relaxed) == 0) {
+      expected = 0;
+      if (word.compare_exchange_strong(expected, 1, std::memory_order_acquire,
+                                       std::memory_order_relaxed))
+        return;
+    }
+  }
+
+  // Slow path: mark the lock contended and sleep until it is released.
+  while (word.exchange(2, std::memory_order_acquire) != 0)
+    futexWait(lock, 2);
+}
+
+void MutexPlatformHelper::unlock(FutexLockHandle &lock) {
+  auto &word = futexWord(lock);
+  // If anyone might be sleeping on the word, wake one waiter up.
+  if (word.exchange(0, std::memory_order_release) == 2)
+    futexWake(lock);
+}
+
+bool MutexPlatformHelper::try_lock(FutexLockHandle &lock) {
+  auto &word = futexWord(lock);
+  uint32_t expected = 0;
+  return word.compare_exchange_strong(expected, 1, std::memory_order_acquire,
+                                      std::memory_order_relaxed);
+}
+
+#endif
+
 void ReadWriteLockPlatformHelper::init(pthread_rwlock_t &rwlock) {
   reportError(pthread_rwlock_init(&rwlock, nullptr));
 }
@@ -268,6 +268,19 @@ public:
   const ContextDescriptor *
   _searchConformancesByMangledTypeName(Demangle::NodePointer node);
 
+  /// Invalidate negative entries in the by-name context descriptor cache.
+  /// Called when protocol conformance sections are registered, since a
+  /// conformance record can make a type findable by name that previously
+  /// was not.
+  void _invalidateNominalTypeDescriptorNegativeCache();
+
+  /// A monotonically increasing count of protocol conformance record
+  /// registrations. Caches of negative conformance results record the
+  /// generation they were computed in and treat entries from earlier
+  /// generations as stale, since a newly loaded image can add the missing
+  /// conformance.
+  size_t _getConformanceRegistrationGeneration();
+
   Demangle::NodePointer _swift_buildDemanglingForMetadata(const Metadata *type,
                                                       Demangle::Demangler &Dem);
 
@@ -25,7 +25,10 @@
 #include "CompatibilityOverride.h"
 #include "ImageInspection.h"
 #include "Private.h"
+#include "swift/Runtime/Mutex.h"
 
+#include <atomic>
+#include <unordered_map>
 #include <vector>
 
 using namespace swift;
@@ -241,6 +244,18 @@ struct ConformanceState {
   ConcurrentReadableArray<ConformanceSection> SectionsToScan;
   bool scanSectionsBackwards;
 
+  /// A lazily built index from a protocol descriptor to the conformance
+  /// records for that protocol across every scanned section. Building it
+  /// costs one pass over all records; afterwards a cache miss for a
+  /// (type, protocol) pair only visits the records of that protocol
+  /// instead of rescanning every loaded image. Registering new sections
+  /// invalidates the index via the section count.
+  Mutex ProtocolIndexLock;
+  size_t ProtocolIndexSectionCount = 0;
+  std::unordered_map<const ProtocolDescriptor *,
+                     std::vector<const ProtocolConformanceDescriptor *>>
+      ProtocolIndex;
+
   ConformanceState() {
     scanSectionsBackwards =
         runtime::bincompat::workaroundProtocolConformanceReverseIteration();
@@ -301,6 +316,13 @@ void ConformanceState::verify() const {
 
 static Lazy<ConformanceState> Conformances;
 
+/// See _getConformanceRegistrationGeneration() in Private.h.
+static std::atomic<size_t> ConformanceRegistrationGeneration{0};
+
+size_t swift::_getConformanceRegistrationGeneration() {
+  return ConformanceRegistrationGeneration.load(std::memory_order_acquire);
+}
+
 const void * const swift::_swift_debug_protocolConformanceStatePointer =
   &Conformances;
 
@@ -313,6 +335,13 @@ _registerProtocolConformances(ConformanceState &C,
   // Blow away the conformances cache to get rid of any negative entries that
   // may now be obsolete.
   C.Cache.clear();
+
+  // Conformance records can make types findable by name, so cached by-name
+  // lookup failures may be obsolete as well.
+  _invalidateNominalTypeDescriptorNegativeCache();
+
+  // Invalidate generation-checked caches of negative conformance results.
+  ConformanceRegistrationGeneration.fetch_add(1, std::memory_order_release);
 }
 
 void swift::addImageProtocolConformanceBlockCallbackUnsafe(
@@ -469,34 +498,45 @@ swift_conformsToProtocolImpl(const Metadata *const type,
   if (found.first)
     return found.second;
 
-  // Scan conformance records.
-  auto processSection = [&](const ConformanceSection &section) {
-    // Eagerly pull records for nondependent witnesses into our cache.
-    for (const auto &record : section) {
-      auto &descriptor = *record.get();
-
-      // We only care about conformances for this protocol.
-      if (descriptor.getProtocol() != protocol)
-        continue;
-
-      // If there's a matching type, record the positive result and return it.
-      // The matching type is exact, so they can't go stale, and we should
-      // always cache them.
-      ConformanceCandidate candidate(descriptor);
-      if (auto *matchingType = candidate.getMatchingType(type)) {
-        auto witness = descriptor.getWitnessTable(matchingType);
-        C.cacheResult(matchingType, protocol, witness, /*always cache*/ 0);
+  // Find the conformance records for this protocol, building or refreshing
+  // the per-protocol index if sections have been registered since it was
+  // last built.
+  auto snapshot = C.SectionsToScan.snapshot();
+  std::vector<const ProtocolConformanceDescriptor *> records;
+  {
+    ScopedLock guard(C.ProtocolIndexLock);
+    if (C.ProtocolIndexSectionCount != snapshot.count()) {
+      C.ProtocolIndex.clear();
+      auto indexSection = [&](const ConformanceSection &section) {
+        for (const auto &record : section) {
+          auto &descriptor = *record.get();
+          C.ProtocolIndex[descriptor.getProtocol()].push_back(&descriptor);
+        }
+      };
+      if (C.scanSectionsBackwards) {
+        for (auto &section : llvm::reverse(snapshot))
+          indexSection(section);
+      } else {
+        for (auto &section : snapshot)
+          indexSection(section);
       }
+      C.ProtocolIndexSectionCount = snapshot.count();
     }
-  };
+    auto known = C.ProtocolIndex.find(protocol);
+    if (known != C.ProtocolIndex.end())
+      records = known->second;
+  }
 
-  auto snapshot = C.SectionsToScan.snapshot();
-  if (C.scanSectionsBackwards) {
-    for (auto &section : llvm::reverse(snapshot))
-      processSection(section);
-  } else {
-    for (auto &section : snapshot)
-      processSection(section);
+  // Eagerly pull records for nondependent witnesses into our cache.
+  for (auto *descriptor : records) {
+    // If there's a matching type, record the positive result and return it.
+    // The matching type is exact, so they can't go stale, and we should
+    // always cache them.
+    ConformanceCandidate candidate(*descriptor);
+    if (auto *matchingType = candidate.getMatchingType(type)) {
+      auto witness = descriptor->getWitnessTable(matchingType);
+      C.cacheResult(matchingType, protocol, witness, /*always cache*/ 0);
+    }
   }
 
   // Try the search again to look for the most specific cached conformance.
@@ -19,6 +19,7 @@
 #include "swift/Runtime/Enum.h"
 #include "swift/Basic/Unreachable.h"
 #include "swift/Demangling/Demangle.h"
+#include "swift/Runtime/Concurrent.h"
 #include "swift/Runtime/Debug.h"
 #include "swift/Runtime/Portability.h"
 #include "Private.h"
@@ -371,9 +372,71 @@ missing_reflection_metadata_warning(const char *fmt, ...) {
   warningv(0, fmt, args);
 }
 
+namespace {
+  /// Cache of field information derived from field descriptors, keyed by
+  /// type metadata and field index. Deriving a field's type runs the
+  /// demangler and metadata instantiation; mirroring the same types
+  /// repeatedly (debugging, serialization fallbacks) would otherwise redo
+  /// that work on every Mirror(reflecting:) call.
+  struct FieldCacheKey {
+    const Metadata *Type;
+    unsigned Index;
+
+    FieldCacheKey(const Metadata *type, unsigned index)
+        : Type(type), Index(index) {
+      assert(type);
+    }
+
+    friend llvm::hash_code hash_value(const FieldCacheKey &key) {
+      return llvm::hash_combine(key.Type, key.Index);
+    }
+  };
+
+  struct FieldCacheEntry {
+  private:
+    FieldCacheKey Key;
+    /// The name data points into the field descriptor, which lives as long
+    /// as its image.
+    const char *NameData;
+    size_t NameLength;
+    FieldType Field;
+
+  public:
+    FieldCacheEntry(FieldCacheKey key, StringRef name, FieldType field)
+        : Key(key), NameData(name.data()), NameLength(name.size()),
+          Field(field) {}
+
+    bool matchesKey(const FieldCacheKey &key) const {
+      return Key.Type == key.Type && Key.Index == key.Index;
+    }
+
+    friend llvm::hash_code hash_value(const FieldCacheEntry &entry) {
+      return hash_value(entry.Key);
+    }
+
+    template <class... Args>
+    static size_t getExtraAllocationSize(Args &&... ignored) {
+      return 0;
+    }
+
+    StringRef getName() const { return StringRef(NameData, NameLength); }
+    FieldType getField() const { return Field; }
+  };
+} // end anonymous namespace
+
+static Lazy<ConcurrentReadableHashMap<FieldCacheEntry>> FieldCache;
+
 static std::pair<StringRef /*name*/, FieldType /*fieldInfo*/>
 getFieldAt(const Metadata *base, unsigned index) {
   using namespace reflection;
+
+  auto &cache = FieldCache.get();
+  FieldCacheKey key(base, index);
+  {
+    auto snapshot = cache.snapshot();
+    if (auto *entry = snapshot.find(key))
+      return {entry->getName(), entry->getField()};
+  }
   
   // If we failed to find the field descriptor metadata for the type, fall
   // back to returning an empty tuple as a standin.
@@ -399,9 +462,20 @@ getFieldAt(const Metadata *base, unsigned index) {
   // Bounds are always valid as the offset is constant.
   auto name = field.getFieldName();
 
+  auto cacheAndReturn =
+      [&](StringRef name, FieldType fieldType) -> std::pair<StringRef, FieldType> {
+    cache.getOrInsert(key, [&](FieldCacheEntry *entry, bool created) {
+      if (created)
+        new (entry) FieldCacheEntry(key, name, fieldType);
+      return true;
+    });
+    return {name, fieldType};
+  };
+
   // Enum cases don't always have types.
   if (!field.hasMangledTypeName())
-    return {name, FieldType::untypedEnumCase(field.isIndirectCase())};
+    return cacheAndReturn(name,
+                          FieldType::untypedEnumCase(field.isIndirectCase()));
 
   auto typeName = field.getMangledTypeName();
 
@@ -439,7 +513,14 @@ getFieldAt(const Metadata *base, unsigned index) {
   fieldType.setIndirect(field.isIndirectCase());
   fieldType.setReferenceOwnership(typeInfo.getReferenceOwnership());
   fieldType.setIsVar(field.isVar());
-  return {name, fieldType};
+
+  // Don't cache failed demanglings: loading another image can register the
+  // metadata needed to resolve the field's type, and the stand-in should
+  // not outlive that.
+  if (result.isError())
+    return {name, fieldType};
+
+  return cacheAndReturn(name, fieldType);
 }
 
 // Implementation for structs.
@@ -44,6 +44,8 @@ struct RuntimeFunctionCountersState {
 static bool UpdatePerObjectRuntimeFunctionCounters = false;
 /// If set, per object runtime function counters should be tracked.
 static bool UpdateGlobalRuntimeFunctionCounters = false;
+/// If set, per thread runtime function counters should be tracked.
+static bool UpdatePerThreadRuntimeFunctionCounters = false;
 /// TODO: Add support for enabling/disabling counters on a per object basis?
 
 /// Global set of counters tracking the total number of runtime invocations.
@@ -61,6 +63,79 @@ struct RuntimeObjectCacheSentinel {
 };
 static Lazy<RuntimeObjectCacheSentinel> RuntimeObjectStateCache;
 
+#if __has_feature(cxx_thread_local)
+
+/// A per-thread page of counters. Each page is only ever written by its
+/// owning thread, so updates need neither locks nor atomics. The pages of all
+/// live threads form a linked list rooted in the registry below.
+struct RuntimeFunctionCountersPage {
+  RuntimeFunctionCountersState State;
+  RuntimeFunctionCountersPage *Next = nullptr;
+};
+
+/// The registry of all live per-thread counter pages together with the
+/// accumulated totals of threads that have already exited. Its lock is only
+/// taken when a thread starts or exits and when a snapshot is requested,
+/// never on the counter update path.
+struct RuntimeFunctionCountersPageRegistry {
+  RuntimeFunctionCountersPage *Pages = nullptr;
+  RuntimeFunctionCountersState RetiredState;
+  StaticReadWriteLock Lock;
+};
+static Lazy<RuntimeFunctionCountersPageRegistry>
+    PerThreadFunctionCountersRegistry;
+
+/// Registers this thread's counter page on construction. On thread exit the
+/// page is folded into the retired totals and unlinked, so its counts are
+/// not lost and snapshots stop reading the dying page.
+struct RuntimeFunctionCountersPageHolder {
+  RuntimeFunctionCountersPage Page;
+  RuntimeFunctionCountersPageHolder() {
+    auto &theRegistry = PerThreadFunctionCountersRegistry.get();
+    StaticScopedWriteLock lock(theRegistry.Lock);
+    Page.Next = theRegistry.Pages;
+    theRegistry.Pages = &Page;
+  }
+  ~RuntimeFunctionCountersPageHolder() {
+    auto &theRegistry = PerThreadFunctionCountersRegistry.get();
+    StaticScopedWriteLock lock(theRegistry.Lock);
+/// Fold this thread's counters into the retired totals.
+#define FUNCTION_TO_TRACK(RT_FUNCTION)                                         \
+  theRegistry.RetiredState.SWIFT_RT_FUNCTION_INVOCATION_COUNTER_NAME(          \
+      RT_FUNCTION) +=                                                          \
+      Page.State.SWIFT_RT_FUNCTION_INVOCATION_COUNTER_NAME(RT_FUNCTION);
+#include "RuntimeInvocationsTracking.def"
+    for (auto **prev = &theRegistry.Pages; *prev; prev = &(*prev)->Next) {
+      if (*prev == &Page) {
+        *prev = Page.Next;
+        break;
+      }
+    }
+  }
+};
+
+/// Return the counter page of the current thread, registering it on first
+/// use.
+static RuntimeFunctionCountersState *getPerThreadRuntimeFunctionCounters() {
+  static thread_local RuntimeFunctionCountersPageHolder Holder;
+  return &Holder.Page.State;
+}
+
+/// Update this thread's counter page. This is the only work performed on the
+/// hot path in the per-thread mode.
+#define SWIFT_RT_UPDATE_PER_THREAD_COUNTER(RT_FUNCTION)                        \
+  if (UpdatePerThreadRuntimeFunctionCounters) {                                \
+    getPerThreadRuntimeFunctionCounters()                                      \
+        ->SWIFT_RT_FUNCTION_INVOCATION_COUNTER_NAME(RT_FUNCTION)++;            \
+  }
+
+#else
+
+/// Without C++ thread-local storage the per-thread mode is unavailable.
+#define SWIFT_RT_UPDATE_PER_THREAD_COUNTER(RT_FUNCTION)
+
+#endif
+
 static const char *RuntimeFunctionNames[] {
 /// Define names of runtime functions.
 #define FUNCTION_TO_TRACK(RT_FUNCTION) #RT_FUNCTION,
@@ -99,6 +174,8 @@ static uint16_t RuntimeFunctionCountersOffsets[] = {
 /// TODO: Perform atomic increments?
 #define FUNCTION_TO_TRACK(RT_FUNCTION)                                         \
   void SWIFT_RT_TRACK_INVOCATION_NAME(RT_FUNCTION)(HeapObject * object) {      \
+    /* Update per thread counters. */                                          \
+    SWIFT_RT_UPDATE_PER_THREAD_COUNTER(RT_FUNCTION)                            \
     /* Update global counters. */                                              \
     if (UpdateGlobalRuntimeFunctionCounters) {                                 \
       StaticScopedWriteLock lock(RuntimeGlobalFunctionCountersState.Lock);     \
@@ -152,6 +229,29 @@ void _swift_getGlobalRuntimeFunctionCounters(
   *result = RuntimeGlobalFunctionCountersState.State;
 }
 
+/// Get a snapshot of the per-thread runtime function counters, summed over
+/// all live threads and all threads that have already exited. The pages of
+/// other threads are read without synchronizing with their updates, so a
+/// snapshot taken while threads are running may lag behind by a few events.
+/// It is exact once all writers are quiescent.
+void _swift_getPerThreadAggregatedRuntimeFunctionCounters(
+    RuntimeFunctionCountersState *result) {
+#if __has_feature(cxx_thread_local)
+  auto &theRegistry = PerThreadFunctionCountersRegistry.get();
+  StaticScopedReadLock lock(theRegistry.Lock);
+  *result = theRegistry.RetiredState;
+  for (auto *page = theRegistry.Pages; page; page = page->Next) {
+/// Define how to accumulate the counter for a given runtime function.
+#define FUNCTION_TO_TRACK(RT_FUNCTION)                                         \
+  result->SWIFT_RT_FUNCTION_INVOCATION_COUNTER_NAME(RT_FUNCTION) +=            \
+      page->State.SWIFT_RT_FUNCTION_INVOCATION_COUNTER_NAME(RT_FUNCTION);
+#include "RuntimeInvocationsTracking.def"
+  }
+#else
+  *result = RuntimeFunctionCountersState();
+#endif
+}
+
 /// Set the global runtime state of function pointers from a provided state.
 void _swift_setGlobalRuntimeFunctionCounters(
     RuntimeFunctionCountersState *state) {
@@ -216,6 +316,19 @@ int _swift_setPerObjectRuntimeFunctionCountersMode(int mode) {
   return oldMode;
 }
 
+/// Set mode for per thread runtime function counters.
+/// Return the old value of this flag, or -1 if the per-thread mode is not
+/// supported on this platform.
+int _swift_setPerThreadRuntimeFunctionCountersMode(int mode) {
+#if __has_feature(cxx_thread_local)
+  int oldMode = UpdatePerThreadRuntimeFunctionCounters;
+  UpdatePerThreadRuntimeFunctionCounters = mode ? 1 : 0;
+  return oldMode;
+#else
+  return -1;
+#endif
+}
+
 /// Add the ability to call custom handlers when a counter
 /// is being updated. The handler should take the object and may be
 /// the name of the runtime function as parameters. And this handler
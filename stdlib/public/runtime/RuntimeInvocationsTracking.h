@@ -70,6 +70,14 @@ _swift_getObjectRuntimeFunctionCounters(HeapObject *object,
 SWIFT_RUNTIME_EXPORT void _swift_getGlobalRuntimeFunctionCounters(
     swift::RuntimeFunctionCountersState *result);
 
+/// Get a snapshot of the per-thread runtime function counters, summed over
+/// all live threads and all threads that have already exited, and store it
+/// into the result. Unlike the global counters, the per-thread counters are
+/// updated without taking any locks, so this is cheap enough to keep enabled
+/// and poll continuously in production.
+SWIFT_RUNTIME_EXPORT void _swift_getPerThreadAggregatedRuntimeFunctionCounters(
+    swift::RuntimeFunctionCountersState *result);
+
 /// Return the names of the runtime functions being tracked.
 /// Their order is the same as the order of the counters in the
 /// RuntimeObjectState structure.
@@ -95,6 +103,14 @@ _swift_setPerObjectRuntimeFunctionCountersMode(int mode);
 /// Return the old value of this flag.
 SWIFT_RUNTIME_EXPORT int _swift_setGlobalRuntimeFunctionCountersMode(int mode);
 
+/// Set mode for per thread runtime function counters. In this mode each
+/// thread updates its own page of counters without locks or atomics; the
+/// pages are aggregated on demand by
+/// _swift_getPerThreadAggregatedRuntimeFunctionCounters.
+/// Return the old value of this flag, or -1 if the per-thread mode is not
+/// supported on this platform.
+SWIFT_RUNTIME_EXPORT int _swift_setPerThreadRuntimeFunctionCountersMode(int mode);
+
 /// Set the global runtime state of function pointers from a provided state.
 SWIFT_RUNTIME_EXPORT void _swift_setGlobalRuntimeFunctionCounters(
     swift::RuntimeFunctionCountersState *state);
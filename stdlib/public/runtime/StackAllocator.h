@@ -15,6 +15,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "swift/Runtime/Debug.h"
+#include "swift/Runtime/ThreadLocal.h"
 #include "llvm/Support/Alignment.h"
 #include <cstddef>
 
@@ -57,6 +58,20 @@ private:
   /// Used for unit testing.
   int32_t numAllocatedSlabs = 0;
 
+  /// The maximum number of unused slabs cached per thread for reuse.
+  static constexpr int maxPooledSlabs = 8;
+
+  /// A per-thread cache of deallocated slabs, linked through their \c next
+  /// fields. Short-lived allocators of the same instantiation (e.g. one per
+  /// task) constantly retire and re-create slabs of the default capacity;
+  /// pooling them makes steady-state slab allocation malloc-free. Only slabs
+  /// of exactly \c SlabCapacity are pooled.
+#if SWIFT_RUNTIME_SUPPORTS_THREAD_LOCAL
+  static SWIFT_RUNTIME_ATTRIBUTE_THREAD_LOCAL ThreadLocal<Slab *> slabPool;
+#else
+  static ThreadLocal<Slab *> slabPool;
+#endif
+
   /// True if the first slab is pre-allocated.
   bool firstSlabIsPreallocated;
 
@@ -189,6 +204,33 @@ private:
     }
   };
 
+  /// Try to pop a cached slab from the per-thread pool.
+  static Slab *popSlabFromPool() {
+    Slab *slab = slabPool.get();
+    if (slab) {
+      slabPool.set(slab->next);
+      slab->next = nullptr;
+    }
+    return slab;
+  }
+
+  /// Try to return \p slab to the per-thread pool.
+  ///
+  /// Returns false if the slab cannot be pooled and must be freed instead.
+  static bool pushSlabToPool(Slab *slab) {
+    if (slab->capacity != SlabCapacity)
+      return false;
+    int numPooled = 0;
+    for (Slab *cur = slabPool.get(); cur; cur = cur->next)
+      ++numPooled;
+    if (numPooled >= maxPooledSlabs)
+      return false;
+    slab->currentOffset = 0;
+    slab->next = slabPool.get();
+    slabPool.set(slab);
+    return true;
+  }
+
   // Return a slab which is suitable to allocate \p size memory.
   Slab *getSlabForAllocation(size_t size) {
     Slab *slab = (lastAllocation ? lastAllocation->slab : firstSlab);
@@ -214,8 +256,13 @@ private:
     }
     size_t capacity = std::max(SlabCapacity,
                                Allocation::includingHeader(size));
-    void *slabBuffer = malloc(Slab::includingHeader(capacity));
-    Slab *newSlab = new (slabBuffer) Slab(capacity);
+    Slab *newSlab = nullptr;
+    if (capacity == SlabCapacity)
+      newSlab = popSlabFromPool();
+    if (!newSlab) {
+      void *slabBuffer = malloc(Slab::includingHeader(capacity));
+      newSlab = new (slabBuffer) Slab(capacity);
+    }
     if (slab)
       slab->next = newSlab;
     else
@@ -232,7 +279,8 @@ private:
     while (slab) {
       Slab *next = slab->next;
       freedCapacity += slab->capacity;
-      free(slab);
+      if (!pushSlabToPool(slab))
+        free(slab);
       numAllocatedSlabs--;
       slab = next;
     }
@@ -288,5 +336,12 @@ public:
   int getNumAllocatedSlabs() { return numAllocatedSlabs; }
 };
 
+template <size_t SlabCapacity>
+#if SWIFT_RUNTIME_SUPPORTS_THREAD_LOCAL
+SWIFT_RUNTIME_ATTRIBUTE_THREAD_LOCAL
+#endif
+ThreadLocal<typename StackAllocator<SlabCapacity>::Slab *>
+    StackAllocator<SlabCapacity>::slabPool;
+
 } // namespace swift
 
@@ -1328,6 +1328,27 @@ size_t swift_format_double(double d, char *dest, size_t length)
                  digits, digitCount, decimalExponent);
     }
 }
+
+size_t swift_format_double_batch(const double *values, size_t count,
+                                 char *dest, size_t length,
+                                 size_t *lengths)
+{
+    // Formatting each value is a single call with no per-value setup to
+    // repeat, so a plain loop keeps the digit-generation tables hot in
+    // cache and amortizes the call overhead that dominates when callers
+    // format values one at a time through the Swift entry points.
+    size_t used = 0;
+    for (size_t i = 0; i < count; i++) {
+        size_t len = swift_format_double(values[i], dest + used,
+                                         length - used);
+        if (len == 0) {
+            return i;
+        }
+        lengths[i] = len;
+        used += len;
+    }
+    return count;
+}
 #endif
 
 #if SWIFT_DTOA_FLOAT80_SUPPORT
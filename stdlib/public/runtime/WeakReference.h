@@ -58,6 +58,12 @@ namespace swift {
 //  * concurrent writes to the weak variable other than zeroing
 //  * concurrent destruction of the weak variable
 //
+// Reading a native weak reference is lock-free: a reader at worst
+// retries a compare-and-swap on the side table entry's reference counts.
+// Side table entries are reclaimed through the weak reference count they
+// carry rather than by scanning weak variables, so readers never block
+// on reclamation either.
+//
 // Writing a weak reference must be thread-safe with respect to:
 //  * concurrent weak reference zeroing due to deallocation of the
 //    pointed-to object
@@ -269,6 +269,14 @@ uint64_t swift_float64ToString(char *Buffer, size_t BufferLength,
   return swift_format_double(Value, Buffer, BufferLength);
 }
 
+SWIFT_CC(swift) SWIFT_RUNTIME_STDLIB_API
+uint64_t swift_float64ToStringBatch(char *Buffer, size_t BufferLength,
+                                    const double *Values, size_t Count,
+                                    size_t *Lengths) {
+  return swift_format_double_batch(Values, Count, Buffer, BufferLength,
+                                   Lengths);
+}
+
 SWIFT_CC(swift) SWIFT_RUNTIME_STDLIB_API
 uint64_t swift_float80ToString(char *Buffer, size_t BufferLength,
                                long double Value, bool Debug) {
@@ -0,0 +1,53 @@
+// RUN: %empty-directory(%t)
+// RUN: %target-build-swift -Xfrontend -enable-experimental-concurrency %import-libdispatch %s -o %t/main
+// RUN: %target-codesign %t/main
+// RUN: env %env-SWIFT_ACTOR_DRAIN_QUANTUM=1 %target-run %t/main | %FileCheck %s
+
+// REQUIRES: executable_test
+// REQUIRES: concurrency
+// REQUIRES: libdispatch
+
+// With a drain quantum of one job, an actor's queue is rescheduled after
+// every message, so this exercises the reschedule-and-reclaim path for
+// each of the sends below. The results must be identical to an
+// unbounded drain.
+
+actor class Accumulator {
+  private var total = 0
+  private var messages = 0
+
+  func add(_ value: Int) {
+    total += value
+    messages += 1
+  }
+
+  func report() -> (total: Int, messages: Int) {
+    return (total, messages)
+  }
+}
+
+func flood(_ accumulator: Accumulator, workers: Int, sends: Int) async {
+  var handles: [Task.Handle<Void>] = []
+  for _ in 0..<workers {
+    handles.append(
+      Task.runDetached {
+        for value in 1...sends {
+          await accumulator.add(value)
+        }
+      }
+    )
+  }
+  for handle in handles {
+    await try! handle.get()
+  }
+}
+
+runAsyncAndBlock {
+  let accumulator = Accumulator()
+  await flood(accumulator, workers: 8, sends: 250)
+  let (total, messages) = await accumulator.report()
+  // Each worker sends 1 + 2 + ... + 250 = 31375.
+  print("total: \(total), messages: \(messages)")
+}
+
+// CHECK: total: 251000, messages: 2000
@@ -0,0 +1,2 @@
+// RUN: %target-swiftc_driver -### -suppress-duplicate-diagnostics %s 2>&1 | %FileCheck %s
+// CHECK: -suppress-duplicate-diagnostics
@@ -10,3 +10,8 @@
 
 // CHECK_EVOLUTION: -typecheck-module-from-interface
 // CHECK_NO_EVOLUTION-NOT: -typecheck-module-from-interface
+
+// Whole-module builds have no merge-module step; verification hangs off the
+// single compile job instead.
+// RUN: %swiftc_driver -driver-print-jobs -driver-skip-execution -whole-module-optimization -emit-module -module-name foo -emit-module-interface %t/file-01.swift %t/file-02.swift %t/file-03.swift -verify-emitted-module-interface -enable-library-evolution >%t/wmo.txt
+// RUN: %FileCheck %s --check-prefix=CHECK_EVOLUTION <%t/wmo.txt
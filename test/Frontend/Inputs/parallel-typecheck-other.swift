@@ -0,0 +1,8 @@
+struct Counter {
+  var value: Int = 0
+
+  // References a function from the other file of the job.
+  mutating func increment() {
+    value += limit()
+  }
+}
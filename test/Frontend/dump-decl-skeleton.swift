@@ -0,0 +1,48 @@
+// RUN: %target-swift-frontend -dump-decl-skeleton %s | %FileCheck %s
+
+// The skeleton is produced without type checking or import resolution, so
+// unresolvable imports and references are fine here.
+
+import Foundation
+import A.B.C
+
+// CHECK: import Foundation
+// CHECK-NEXT: import A
+
+let x = 1, y = 2
+var (a, b) = (1, 2)
+
+// CHECK-NEXT: provides x
+// CHECK-NEXT: provides y
+// CHECK-NEXT: provides a
+// CHECK-NEXT: provides b
+
+func foo(_ n: Int) -> Int { return n }
+
+// CHECK-NEXT: provides foo(_:)
+
+struct S {}
+class C {}
+enum E {}
+protocol P {}
+typealias T = Int
+
+// CHECK-NEXT: provides S
+// CHECK-NEXT: provides C
+// CHECK-NEXT: provides E
+// CHECK-NEXT: provides P
+// CHECK-NEXT: provides T
+
+extension S {
+  func bar() {}
+}
+
+// CHECK-NEXT: extends S
+
+precedencegroup MyPrecedence {
+  associativity: left
+}
+infix operator +++ : MyPrecedence
+
+// CHECK-NEXT: provides MyPrecedence
+// CHECK-NEXT: provides +++
@@ -0,0 +1,15 @@
+// RUN: %target-swift-frontend -typecheck -enable-experimental-parallel-type-checking -module-name ParallelTest %s %S/Inputs/parallel-typecheck-other.swift
+
+// Type check two files on worker threads. The files reference each other's
+// declarations, so the worker threads evaluate overlapping requests through
+// the shared evaluator.
+
+func limit() -> Int {
+  return 1
+}
+
+func useCounter() -> Int {
+  var c = Counter()
+  c.increment()
+  return c.value
+}
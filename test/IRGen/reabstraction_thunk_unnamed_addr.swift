@@ -0,0 +1,12 @@
+// RUN: %target-swift-frontend -emit-ir %s | %FileCheck %s
+
+// Reabstraction thunks are identified by their mangled name only; check that
+// they are emitted unnamed_addr so identical thunks can be folded.
+
+func generic<T>(_ f: (T) -> T) {}
+
+public func test() {
+  generic { (x: Int) in x }
+}
+
+// CHECK: define linkonce_odr hidden swiftcc {{.*}}@"$s{{.*}}TR"({{.*}}) unnamed_addr
@@ -0,0 +1,30 @@
+// REQUIRES: shell
+// Also uses awk:
+// XFAIL OS=windows
+
+// The type-annotation resolution cache must not hide referenced names from a
+// later primary in batch mode: the second primary to resolve an identical
+// annotation hits the cache, skipping the name-lookup requests whose sinks
+// would have recorded the names, so the cache replays them itself.
+//
+// RUN: %empty-directory(%t)
+//
+// The shared non-primary file has two members with the same written
+// annotation. Each primary forces the interface of a different member, so
+// the second resolution of the annotation hits the cache.
+//
+// RUN: echo 'struct InterestingType {}; struct Holder { var a: InterestingType; var b: InterestingType }' > %t/other.swift
+// RUN: echo 'func f1(_ h: Holder) { _ = h.a }' > %t/1.swift
+// RUN: echo 'func f2(_ h: Holder) { _ = h.b }' > %t/2.swift
+//
+// RUN: %target-swift-frontend -typecheck -primary-file %t/1.swift -primary-file %t/2.swift %t/other.swift -module-name main -emit-reference-dependencies-path %t/1.swiftdeps -emit-reference-dependencies-path %t/2.swiftdeps
+//
+// RUN: %S/../../Inputs/process_fine_grained_swiftdeps.sh %swift-dependency-tool %t/1.swiftdeps %t/1-processed.swiftdeps
+// RUN: %S/../../Inputs/process_fine_grained_swiftdeps.sh %swift-dependency-tool %t/2.swiftdeps %t/2-processed.swiftdeps
+//
+// Both primaries must carry the referenced-name edge for the annotation.
+//
+// RUN: %FileCheck %s < %t/1-processed.swiftdeps
+// RUN: %FileCheck %s < %t/2-processed.swiftdeps
+
+// CHECK: topLevel interface  '' InterestingType false
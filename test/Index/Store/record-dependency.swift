@@ -2,7 +2,7 @@
 // RUN: %target-swift-frontend -index-store-path %t/idx -o %t/file.o -typecheck %s
 // RUN: c-index-test core -print-unit %t/idx | %FileCheck %s
 // CHECK: DEPEND START
-// CHECK: Record | user | {{.*}}record-dependency.swift | record-dependency.swift-
+// CHECK: Record | user | {{.*}}record-dependency.swift | record-
 // CHECK: DEPEND END
 
 // RUN: echo 'func bar() {}' > %t/s2.swift
@@ -10,11 +10,11 @@
 // RUN: c-index-test core -print-unit %t/idx2 | %FileCheck %s -check-prefix=TWO_RECORDS
 // TWO_RECORDS: file.o-
 // TWO_RECORDS: DEPEND START
-// TWO_RECORDS: Record | user | {{.*}}record-dependency.swift | record-dependency.swift-
+// TWO_RECORDS: Record | user | {{.*}}record-dependency.swift | record-
 // TWO_RECORDS: DEPEND END
 // TWO_RECORDS: s2.o-
 // TWO_RECORDS: DEPEND START
-// TWO_RECORDS: Record | user | {{.*}}s2.swift | s2.swift-
+// TWO_RECORDS: Record | user | {{.*}}s2.swift | record-
 // TWO_RECORDS: DEPEND END
 
 func foo() {}
@@ -2,7 +2,7 @@
 // RUN: echo "func foo() {}" > %t/theinput.swift
 
 // RUN: %target-swift-frontend -index-store-path %t/idx -typecheck %t/theinput.swift -o %t/s.o
-// RUN: ls %t/idx/*/records/* | grep "theinput.swift" | count 1
+// RUN: ls %t/idx/*/records/* | count 1
 // RUN: cp -r %t/idx %t/idx-orig
 
 // RUN: touch %t/theinput.swift
@@ -18,5 +18,14 @@
 // RUN: echo 'func goo() {}' >> %t/theinput.swift
 // RUN: %target-swift-frontend -index-store-path %t/idx -typecheck %t/theinput.swift -o %t/s.o
 // RUN: not diff -r -u %t/idx/*/records %t/idx-orig/*/records
-// RUN: ls %t/idx/*/records/* | grep "theinput.swift" | count 2
+// RUN: ls %t/idx/*/records/* | count 2
 // Changed!  Wrote a new record.
+
+// Identical file contents produce a single shared record, since records are
+// named by the hash of their contents.
+// RUN: %empty-directory(%t/dedup)
+// RUN: echo "func foo() {}" > %t/dedup/a.swift
+// RUN: cp %t/dedup/a.swift %t/dedup/b.swift
+// RUN: %target-swift-frontend -index-store-path %t/dedup/idx -typecheck %t/dedup/a.swift -module-name M -o %t/dedup/a.o
+// RUN: %target-swift-frontend -index-store-path %t/dedup/idx -typecheck %t/dedup/b.swift -module-name M -o %t/dedup/b.o
+// RUN: ls %t/dedup/idx/*/records/* | count 1
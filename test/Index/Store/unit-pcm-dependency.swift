@@ -54,7 +54,7 @@ func test() {
 // FILE1: Unit | user | ClangModuleB | {{.*}}ClangModuleB-{{[A-Z0-9]*}}.pcm | ClangModuleB-{{[A-Z0-9]*}}.pcm-
 // FILE1: Unit | user | ClangModuleC | {{.*}}ClangModuleC-{{[A-Z0-9]*}}.pcm | ClangModuleC-{{[A-Z0-9]*}}.pcm-
 // FILE1-NOT: Unit |{{.*}}ClangModuleA
-// FILE1: Record | user | {{.*}}unit-pcm-dependency.swift | unit-pcm-dependency.swift-
+// FILE1: Record | user | {{.*}}unit-pcm-dependency.swift | record-
 // FILE1-NOT: Unit |{{.*}}ClangModuleA
 // FILE1: DEPEND END (4)
 
@@ -72,7 +72,7 @@ func test() {
 // FILE2-NOT: Unit |{{.*}}ClangModuleB
 // FILE2-NOT: Record
 // FILE2: Unit | user | ClangModuleA | {{.*}}ClangModuleA-{{[A-Z0-9]*}}.pcm | ClangModuleA-{{[A-Z0-9]*}}.pcm-
-// FILE2: Record | user | {{.*}}s2.swift | s2.swift-
+// FILE2: Record | user | {{.*}}s2.swift | record-
 // FILE2-NOT: Unit |{{.*}}ClangModuleB
 // FILE2-NOT: Record
 // FILE2: DEPEND END
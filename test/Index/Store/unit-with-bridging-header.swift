@@ -32,7 +32,7 @@
 // PCH-UNIT: DEPEND START
 // PCH-UNIT: Unit | system | {{.*}}Swift.swiftmodule
 // PCH-UNIT: Unit | user | {{.*}}bridge-head.pch | bridge-head.pch-
-// PCH-UNIT: Record | user | {{.*}}unit-with-bridging-header.swift | unit-with-bridging-header.swift-
+// PCH-UNIT: Record | user | {{.*}}unit-with-bridging-header.swift | record-
 // PCH-UNIT: DEPEND END (3)
 
 // TEXTUAL-UNIT: s1.o-
@@ -40,7 +40,7 @@
 // TEXTUAL-UNIT: has-main: 1
 // TEXTUAL-UNIT: DEPEND START
 // TEXTUAL-UNIT: Unit | system | {{.*}}Swift.swiftmodule
-// TEXTUAL-UNIT: Record | user | {{.*}}unit-with-bridging-header.swift | unit-with-bridging-header.swift-
+// TEXTUAL-UNIT: Record | user | {{.*}}unit-with-bridging-header.swift | record-
 // TEXTUAL-UNIT: DEPEND END (2)
 
 func test() {}
@@ -0,0 +1,64 @@
+; RUN: %swift-llvm-opt -swift-merge-functions -swiftmergefunc-threshold=4 %s | %FileCheck %s
+
+@g1 = external global i32
+@g2 = external global i32
+
+; Merging linkonce_odr functions must produce a linkonce_odr merged function
+; with a deterministic name, so that the copies independently created in other
+; IRGen output partitions collapse into one at link time.
+
+; CHECK-LABEL: define linkonce_odr i32 @odr_func1(i32 %x, i32 %y)
+; CHECK: %1 = tail call i32 @odr_func1Tm[[HASH:[0-9A-F]+]](i32 %x, i32 %y, i32* @g1)
+; CHECK: ret i32 %1
+define linkonce_odr i32 @odr_func1(i32 %x, i32 %y) {
+  %sum = add i32 %x, %y
+  %sum2 = add i32 %sum, %y
+  %l = load i32, i32* @g1, align 4
+  %sum3 = add i32 %sum2, %y
+  ret i32 %sum3
+}
+
+; CHECK-LABEL: define linkonce_odr i32 @odr_func2(i32 %x, i32 %y)
+; CHECK: %1 = tail call i32 @odr_func1Tm[[HASH]](i32 %x, i32 %y, i32* @g2)
+; CHECK: ret i32 %1
+define linkonce_odr i32 @odr_func2(i32 %x, i32 %y) {
+  %sum = add i32 %x, %y
+  %sum2 = add i32 %sum, %y
+  %l = load i32, i32* @g2, align 4
+  %sum3 = add i32 %sum2, %y
+  ret i32 %sum3
+}
+
+; CHECK-LABEL: define linkonce_odr hidden i32 @odr_func1Tm[[HASH]](i32 %0, i32 %1, i32* %2)
+; CHECK: %l = load i32, i32* %2
+; CHECK: ret
+
+; Merged functions reusing the body of a private function must stay internal:
+; the body is not ODR-unique, so no other partition is guaranteed to create an
+; equivalent merged function under the same name.
+
+; CHECK-LABEL: define internal i32 @internal_func1Tm(i32 %0, i32 %1, i32* %2)
+; CHECK: %l = load i32, i32* %2
+; CHECK: ret
+define internal i32 @internal_func1(i32 %x, i32 %y) {
+  %sum = add i32 %x, %y
+  %sum2 = add i32 %sum, %y
+  %l = load i32, i32* @g1, align 4
+  %sum3 = add i32 %sum2, %y
+  ret i32 %sum3
+}
+
+define internal i32 @internal_func2(i32 %x, i32 %y) {
+  %sum = add i32 %x, %y
+  %sum2 = add i32 %sum, %y
+  %l = load i32, i32* @g2, align 4
+  %sum3 = add i32 %sum2, %y
+  ret i32 %sum3
+}
+
+define i32 @call_internal(i32 %x, i32 %y) {
+  %r1 = call i32 @internal_func1(i32 %x, i32 %y)
+  %r2 = call i32 @internal_func2(i32 %x, i32 %y)
+  %sum = add i32 %r1, %r2
+  ret i32 %sum
+}
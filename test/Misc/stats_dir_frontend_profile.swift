@@ -0,0 +1,13 @@
+// RUN: %empty-directory(%t)
+// RUN: %target-swift-frontend -c -o %t/out.o -stats-output-dir %t -profile-frontend %s
+// RUN: ls %t/profile-*.collapsed
+
+// The sampling profiler is signal-timer based.
+// UNSUPPORTED: OS=windows-msvc
+
+// The invocation is usually too short for the 1kHz sampler to fire, so only
+// check that the collapsed-stack profile is written next to the stats output.
+
+public func foo() {
+  print("hello")
+}
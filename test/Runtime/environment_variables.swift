@@ -16,6 +16,7 @@
 // CHECK-DAG:    bool SWIFT_DETERMINISTIC_HASHING [default: false] - Disable randomized hash seeding.
 // CHECK-DAG:    bool SWIFT_ENABLE_MANGLED_NAME_VERIFICATION [default: false] - Enable verification that metadata can roundtrip through a mangled name each time metadata is instantiated.
 // CHECK-DAG:    bool SWIFT_DEBUG_ENABLE_MALLOC_SCRIBBLE [default: false] - Scribble on runtime allocations such as metadata allocations.
+// CHECK-DAG:    bool SWIFT_ENABLE_SMALL_ALLOCATION_CACHE [default: false] - Cache small heap allocations in per-thread magazines instead of returning them to malloc, trading memory for reduced allocator contention.
 
 print("Hello, world")
 // CHECK: Hello, world
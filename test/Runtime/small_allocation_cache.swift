@@ -0,0 +1,47 @@
+// RUN: %empty-directory(%t)
+// RUN: %target-build-swift %s -o %t/main
+// RUN: %target-codesign %t/main
+// RUN: env %env-SWIFT_ENABLE_SMALL_ALLOCATION_CACHE=YES %target-run %t/main | %FileCheck %s
+
+// REQUIRES: executable_test
+// UNSUPPORTED: use_os_stdlib
+
+// Exercise heavy allocation churn in the size classes served by the
+// per-thread small-allocation cache, including reuse across differently
+// sized requests in the same class and requests past the cached range.
+
+class Small {
+  var a = 0
+}
+
+class Medium {
+  var a = 0, b = 0, c = 0, d = 0
+  var e = 0, f = 0, g = 0, h = 0
+}
+
+final class Chunky {
+  var words = [Int](repeating: 0, count: 64)
+}
+
+var sum = 0
+for round in 0..<1_000 {
+  var kept: [AnyObject] = []
+  for i in 0..<32 {
+    let small = Small()
+    small.a = i
+    sum += small.a
+    if i % 4 == 0 {
+      kept.append(small)
+    }
+    let medium = Medium()
+    medium.h = round
+    sum += medium.h
+  }
+  kept.removeAll()
+  let chunky = Chunky()
+  chunky.words[63] = round
+  sum += chunky.words[63]
+}
+
+// CHECK: sum: 16979500
+print("sum: \(sum)")
@@ -89,3 +89,15 @@ func testUnreachablePlatformAvailableGuard() {
 
   doThing() // no-warning
 }
+
+// A query in a body that references nothing availability-sensitive must still
+// have its version range computed for SILGen.
+// CHECK-LABEL: sil hidden [ossa] @$s4main18testEmptyQueryBodyyyF
+// CHECK: [[MAJOR:%.*]] = integer_literal $Builtin.Word, 10
+// CHECK: [[MINOR:%.*]] = integer_literal $Builtin.Word, 52
+// CHECK: [[PATCH:%.*]] = integer_literal $Builtin.Word, 0
+// CHECK: function_ref @$ss26_stdlib_isOSVersionAtLeastyBi1_Bw_BwBwtF
+func testEmptyQueryBody() {
+  if #available(OSX 10.52, *) {
+  }
+}
@@ -0,0 +1,33 @@
+// RUN: %target-swift-emit-silgen -O %s | %FileCheck %s
+// RUN: %target-swift-frontend -emit-sil -O %s -o /dev/null -verify
+
+// When optimizing, literals of the compiler-known integer and bool types are
+// emitted in already-folded form, without applying the literal initializer.
+
+// CHECK-LABEL: sil hidden [ossa] @$s15literal_folding10intLiteralSiyF
+// CHECK-NOT: apply
+// CHECK: [[LIT:%[0-9]+]] = integer_literal $Builtin.Int{{32|64}}, 42
+// CHECK: [[RES:%[0-9]+]] = struct $Int ([[LIT]] : $Builtin.Int{{32|64}})
+// CHECK: return [[RES]]
+func intLiteral() -> Int {
+  return 42
+}
+
+// CHECK-LABEL: sil hidden [ossa] @$s15literal_folding11boolLiteralSbyF
+// CHECK-NOT: apply
+// CHECK: [[LIT:%[0-9]+]] = integer_literal $Builtin.Int1, -1
+// CHECK: [[RES:%[0-9]+]] = struct $Bool ([[LIT]] : $Builtin.Int1)
+// CHECK: return [[RES]]
+func boolLiteral() -> Bool {
+  return true
+}
+
+// A value that does not fit the target width keeps the initializer call so
+// that constant folding diagnoses the overflow.
+
+// CHECK-LABEL: sil hidden [ossa] @$s15literal_folding15overflowLiteral{{.*}}F
+// CHECK: integer_literal $Builtin.IntLiteral, 300
+// CHECK: apply
+func overflowLiteral() -> Int8 {
+  return 300 // expected-error {{integer literal '300' overflows when stored into 'Int8'}}
+}
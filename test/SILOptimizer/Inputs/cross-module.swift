@@ -256,6 +256,11 @@ public func useClassKeypath<T>(_ t: T) -> Int {
   return c[keyPath: getClassKeypath(t)]
 }
 
+@inline(never)
+public func callNonescapingClosure(_ c: (Int) -> Int) -> Int {
+  return c(14)
+}
+
 @inline(never)
 func unrelated<U>(_ u: U) {
   print(u)
@@ -0,0 +1,16 @@
+public final class Config {
+  public let version: Int32
+
+  @inlinable
+  public init() {
+    self.version = 27
+  }
+}
+
+public final class OpaqueConfig {
+  public let version: Int32
+
+  public init() {
+    self.version = 29
+  }
+}
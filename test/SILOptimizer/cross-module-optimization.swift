@@ -113,6 +113,9 @@ func testClosures() {
   // CHECK-OUTPUT: 24
   // CHECK-SIL-DAG: sil shared_external {{.*}} @$s4Test18genericClosure_genyxxlF
   print(genericClosure_gen(24))
+  // CHECK-OUTPUT: 28
+  // CHECK-SIL-DAG: sil shared {{.*}}callNonescapingClosure{{.*}}Tf1
+  print(callNonescapingClosure { $0 * 2 })
 }
 
 func testKeypath() {
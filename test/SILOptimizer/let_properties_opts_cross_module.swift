@@ -0,0 +1,30 @@
+// RUN: %empty-directory(%t)
+// RUN: %target-swift-frontend -emit-module -parse-as-library -O -module-name TestModule -emit-module-path %t/TestModule.swiftmodule %S/Inputs/let_properties_opts_cross_module.swift
+// RUN: %target-swift-frontend -module-name main -I %t %s -O -emit-sil | %FileCheck %s
+
+// Test propagation of let properties of classes defined in another module.
+// This is possible if all designated initializers of the class were
+// serialized, because then all assignments to a let property can be analyzed.
+
+import TestModule
+
+// Config.init is @inlinable, so the constant assigned to Config.version is
+// known and the load can be folded.
+
+// CHECK-LABEL: sil @$s4main10testConfig{{[_0-9a-zA-Z]*}}F :
+// CHECK-NOT: ref_element_addr
+// CHECK: integer_literal $Builtin.Int32, 27
+// CHECK: return
+public func testConfig(_ c: Config) -> Int32 {
+  return c.version
+}
+
+// OpaqueConfig.init is not serialized, so the value of OpaqueConfig.version
+// is unknown in this module and the load must stay.
+
+// CHECK-LABEL: sil @$s4main16testOpaqueConfig{{[_0-9a-zA-Z]*}}F :
+// CHECK: ref_element_addr %0 : $OpaqueConfig, #OpaqueConfig.version
+// CHECK: return
+public func testOpaqueConfig(_ c: OpaqueConfig) -> Int32 {
+  return c.version
+}
@@ -0,0 +1,56 @@
+// RUN: %target-swift-frontend  -primary-file %s -O -sil-verify-all -Xllvm -sil-disable-pass=FunctionSignatureOpts -module-name=test -emit-sil | %FileCheck %s
+
+// Also do an end-to-end test to check all components, including IRGen.
+// RUN: %empty-directory(%t)
+// RUN: %target-build-swift -O -Xllvm -sil-disable-pass=FunctionSignatureOpts -module-name=test %s -o %t/a.out
+// RUN: %target-run %t/a.out | %FileCheck %s -check-prefix=CHECK-OUTPUT
+// REQUIRES: executable_test,swift_stdlib_no_asserts,optimized_stdlib
+// REQUIRES: CPU=arm64 || CPU=x86_64
+
+// Check if the optimizer is able to convert literals containing C-like enums
+// to statically initialized arrays.
+
+public enum Direction {
+  case north, south, east, west
+}
+
+public struct Step {
+  let dir: Direction
+  let count: Int
+}
+
+// CHECK-LABEL: outlined variable #0 of enumLookup(_:)
+// CHECK-NEXT:  sil_global private @{{.*}}enumLookup{{.*}} = {
+// CHECK-DAG:     enum $Direction, #Direction.north!enumelt
+// CHECK-DAG:     enum $Direction, #Direction.west!enumelt
+// CHECK:         object {{.*}} ({{[^,]*}}, [tail_elems] {{[^,]*}}, {{[^,]*}}, {{[^,]*}})
+// CHECK-NEXT:  }
+
+// CHECK-LABEL: outlined variable #0 of returnSteps()
+// CHECK-NEXT:  sil_global private @{{.*}}returnSteps{{.*}} = {
+// CHECK-DAG:     enum $Direction, #Direction.south!enumelt
+// CHECK:         object {{.*}} ({{[^,]*}}, [tail_elems] {{[^,]*}})
+// CHECK-NEXT:  }
+
+// CHECK-LABEL: sil {{.*}}enumLookup{{.*}} : $@convention(thin) (Int) -> Direction {
+// CHECK:   global_value @{{.*}}enumLookup{{.*}}
+// CHECK:   return
+@inline(never)
+public func enumLookup(_ i: Int) -> Direction {
+  let table: [Direction] = [.north, .south, .east, .west]
+  return table[i]
+}
+
+// CHECK-LABEL: sil {{.*}}returnSteps{{.*}} : $@convention(thin) () -> @owned Array<Step> {
+// CHECK:   global_value @{{.*}}returnSteps{{.*}}
+// CHECK:   return
+@inline(never)
+public func returnSteps() -> [Step] {
+  return [Step(dir: .north, count: 1), Step(dir: .south, count: 2)]
+}
+
+// CHECK-OUTPUT: east
+print(enumLookup(2))
+
+// CHECK-OUTPUT: 2
+print(returnSteps()[1].count)
@@ -58,6 +58,32 @@ public func testFoldConcat() -> String {
   return "a" + "b" + "c"
 }
 
+// CHECK-LABEL: sil [noinline] @$s4test0A12FoldEqualitySbyF
+// CHECK-NOT: apply
+// CHECK: } // end sil function '$s4test0A12FoldEqualitySbyF'
+@inline(never)
+public func testFoldEquality() -> Bool {
+  return "a" + "b" == "ab"
+}
+
+// CHECK-LABEL: sil [noinline] @$s4test0A14FoldInequalitySbyF
+// CHECK-NOT: apply
+// CHECK: } // end sil function '$s4test0A14FoldInequalitySbyF'
+@inline(never)
+public func testFoldInequality() -> Bool {
+  return "a" + "b" == "abc"
+}
+
+// CHECK-LABEL: sil [noinline] @$s4test0A18NonAsciiComparisonSbyF
+// CHECK: apply
+// CHECK: } // end sil function '$s4test0A18NonAsciiComparisonSbyF'
+@inline(never)
+public func testNonAsciiComparison() -> Bool {
+  // Both operands are canonically equivalent, but have different UTF8
+  // representations. This must not be folded to false.
+  return "caf\u{E9}" == "cafe\u{301}"
+}
+
 // CHECK-LABEL: sil [noinline] @$s4test0A19UnqualifiedTypeNameSSyF 
 // CHECK-NOT: apply
 // CHECK-NOT: bb1
@@ -130,6 +156,15 @@ printEmbeeded(testFoldStaticLet())
 // CHECK-OUTPUT: <abc>
 printEmbeeded(testFoldConcat())
 
+// CHECK-OUTPUT: true
+print(testFoldEquality())
+
+// CHECK-OUTPUT: false
+print(testFoldInequality())
+
+// CHECK-OUTPUT: true
+print(testNonAsciiComparison())
+
 // CHECK-OUTPUT: <Inner>
 printEmbeeded(testUnqualifiedTypeName())
 
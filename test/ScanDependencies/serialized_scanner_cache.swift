@@ -0,0 +1,28 @@
+// RUN: %empty-directory(%t)
+// RUN: mkdir -p %t/clang-module-cache
+
+// Run the scanner once, serializing its state.
+// RUN: %target-swift-frontend -scan-dependencies -module-cache-path %t/clang-module-cache %s -o %t/deps_initial.json -I %S/Inputs/CHeaders -I %S/Inputs/Swift -swift-version 4 -serialize-dependency-scan-cache -dependency-scan-cache-path %t/cache.moddepcache
+
+// Check the contents of the serialized cache.
+// RUN: %FileCheck %s -check-prefix CHECK-CACHE < %t/cache.moddepcache
+
+// Run the scanner again, this time warming it from the serialized state, and
+// ensure the output matches the cold scan's.
+// RUN: %target-swift-frontend -scan-dependencies -module-cache-path %t/clang-module-cache %s -o %t/deps.json -I %S/Inputs/CHeaders -I %S/Inputs/Swift -swift-version 4 -load-dependency-scan-cache -dependency-scan-cache-path %t/cache.moddepcache
+// RUN: diff %t/deps_initial.json %t/deps.json
+
+// REQUIRES: executable_test
+// REQUIRES: objc_interop
+
+import C
+import E
+import G
+
+// CHECK-CACHE: scanTimestamp:
+// CHECK-CACHE: modules:
+// CHECK-CACHE-DAG: name: E
+// CHECK-CACHE-DAG: kind: swiftTextual
+// CHECK-CACHE-DAG: name: G
+// CHECK-CACHE-DAG: name: C
+// CHECK-CACHE-DAG: kind: clang
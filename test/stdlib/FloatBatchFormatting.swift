@@ -0,0 +1,60 @@
+// RUN: %target-run-simple-swift
+// REQUIRES: executable_test
+
+import StdlibUnittest
+
+let FloatBatchFormattingTests = TestSuite("FloatBatchFormatting")
+
+/// Format `values` through the batch SPI and split the packed buffer back
+/// into one string per value.
+func batchFormat(_ values: [Double]) -> [String] {
+  let utf8Buffer = UnsafeMutableBufferPointer<UInt8>.allocate(
+    capacity: values.count * 32)
+  defer { utf8Buffer.deallocate() }
+  let lengths = UnsafeMutableBufferPointer<Int>.allocate(
+    capacity: values.count)
+  defer { lengths.deallocate() }
+
+  let formatted = values.withUnsafeBufferPointer {
+    _float64ToStringBatch($0, into: utf8Buffer, lengths: lengths)
+  }
+  expectEqual(values.count, formatted)
+
+  var result: [String] = []
+  var offset = 0
+  for i in 0..<formatted {
+    let slice = UnsafeBufferPointer(
+      rebasing: utf8Buffer[offset..<(offset + lengths[i])])
+    result.append(String(decoding: slice, as: UTF8.self))
+    offset += lengths[i]
+  }
+  return result
+}
+
+FloatBatchFormattingTests.test("matchesDescription") {
+  let values: [Double] = [
+    0.0, -0.0, 1.0, -1.0, 0.1, 1e100, -1e-100, 42.5,
+    .pi, .infinity, -.infinity,
+    .leastNonzeroMagnitude, .greatestFiniteMagnitude,
+  ]
+  expectEqual(values.map { "\($0)" }, batchFormat(values))
+}
+
+FloatBatchFormattingTests.test("stopsWhenBufferIsFull") {
+  let values: [Double] = [1.5, 2.5, 3.5]
+  let utf8Buffer = UnsafeMutableBufferPointer<UInt8>.allocate(capacity: 7)
+  defer { utf8Buffer.deallocate() }
+  let lengths = UnsafeMutableBufferPointer<Int>.allocate(
+    capacity: values.count)
+  defer { lengths.deallocate() }
+
+  // "1.5" and "2.5" fit (six characters plus a terminator); "3.5" does not.
+  let formatted = values.withUnsafeBufferPointer {
+    _float64ToStringBatch($0, into: utf8Buffer, lengths: lengths)
+  }
+  expectEqual(2, formatted)
+  expectEqual(3, lengths[0])
+  expectEqual(3, lengths[1])
+}
+
+runAllTests()
@@ -50,7 +50,8 @@ func isCocoaNSDictionary(_ d: NSDictionary) -> Bool {
 
 func isNativeNSArray(_ d: NSArray) -> Bool {
   let className: NSString = NSStringFromClass(type(of: d)) as NSString
-  return ["__SwiftDeferredNSArray", "_ContiguousArray", "_EmptyArray"].contains {
+  return ["__SwiftDeferredNSArray", "__SwiftSmallNSArray", "_ContiguousArray",
+          "_EmptyArray"].contains {
     className.range(of: $0).length > 0
   }
 }
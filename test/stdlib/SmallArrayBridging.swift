@@ -0,0 +1,47 @@
+// RUN: %target-run-simple-swift
+// REQUIRES: executable_test
+
+// REQUIRES: objc_interop
+
+import StdlibUnittest
+import Foundation
+
+var SmallArrayBridging = TestSuite("SmallArrayBridging")
+
+SmallArrayBridging.test("smallArraysBridgeEagerly") {
+  for source in [[], [10], [10, 20], [10, 20, 30]] as [[Int]] {
+    let bridged = source._bridgeToObjectiveC() as! NSArray
+    expectEqual(source.count, bridged.count)
+    for i in 0..<source.count {
+      expectEqual(source[i], bridged.object(at: i) as! Int)
+    }
+    expectEqual(source, Array(bridged) as! [Int])
+  }
+}
+
+SmallArrayBridging.test("largeArraysStillBridgeDeferred") {
+  let source = [10, 20, 30, 40]
+  let bridged = source._bridgeToObjectiveC() as! NSArray
+  expectEqual(source.count, bridged.count)
+  expectEqual(source, Array(bridged) as! [Int])
+}
+
+SmallArrayBridging.test("roundTripRecoversNativeStorage") {
+  let source = ["a", "b", "c"]
+  let bridged = source._bridgeToObjectiveC()
+  let roundTripped = [String]._bridgeFromObjectiveCAdoptingNativeStorageOf(
+    bridged)
+  expectNotNil(roundTripped)
+  expectEqual(source, roundTripped!)
+}
+
+SmallArrayBridging.test("fastEnumeration") {
+  let bridged = ["x", "y"]._bridgeToObjectiveC() as! NSArray
+  var seen: [String] = []
+  for element in bridged {
+    seen.append(element as! String)
+  }
+  expectEqual(["x", "y"], seen)
+}
+
+runAllTests()
@@ -258,6 +258,11 @@ class ASTProducer : public ThreadSafeRefCountedBase<ASTProducer> {
   std::vector<QueuedConsumer> QueuedConsumers;
   llvm::sys::Mutex Mtx;
 
+  /// Serializes AST builds for this producer. With separate interactive and
+  /// background build queues, requests for the same invocation may otherwise
+  /// race to build the same AST on both queues.
+  llvm::sys::Mutex BuildMtx;
+
 public:
   explicit ASTProducer(SwiftInvocationRef InvokRef)
     : InvokRef(std::move(InvokRef)) {}
@@ -272,6 +277,7 @@ public:
       std::shared_ptr<SwiftASTManager> Mgr,
       llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> fileSystem,
       ArrayRef<ImmutableTextSnapshotRef> Snapshots,
+      SwiftASTManager::ASTPriority Priority,
       std::function<void(ASTUnitRef Unit, StringRef Error)> Receiver);
   bool shouldRebuild(SwiftASTManager::Implementation &MgrImpl,
                      llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> fileSystem,
@@ -363,6 +369,11 @@ struct SwiftASTManager::Implementation {
 
   WorkQueue ASTBuildQueue{ WorkQueue::Dequeuing::Serial,
                            "sourcekit.swift.ASTBuilding" };
+  /// Services editor-interactive requests so that they are not queued behind
+  /// slow batch work (e.g. indexing, doc-info) on \c ASTBuildQueue.
+  WorkQueue InteractiveASTBuildQueue{
+      WorkQueue::Dequeuing::Serial, "sourcekit.swift.ASTBuilding.Interactive",
+      WorkQueue::Priority::High };
 
   ASTProducerRef getASTProducer(SwiftInvocationRef InvokRef);
   FileContent
@@ -498,7 +509,7 @@ void SwiftASTManager::processASTAsync(
     SwiftInvocationRef InvokRef, SwiftASTConsumerRef ASTConsumer,
     const void *OncePerASTToken,
     llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> fileSystem,
-    ArrayRef<ImmutableTextSnapshotRef> Snapshots) {
+    ASTPriority Priority, ArrayRef<ImmutableTextSnapshotRef> Snapshots) {
   assert(fileSystem);
   ASTProducerRef Producer = Impl.getASTProducer(InvokRef);
 
@@ -530,7 +541,7 @@ void SwiftASTManager::processASTAsync(
     }
   };
 
-  Producer->getASTUnitAsync(shared_from_this(), fileSystem, Snapshots,
+  Producer->getASTUnitAsync(shared_from_this(), fileSystem, Snapshots, Priority,
                             std::move(handleAST));
 }
 
@@ -612,13 +623,18 @@ void ASTProducer::getASTUnitAsync(
     std::shared_ptr<SwiftASTManager> Mgr,
     llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> fileSystem,
     ArrayRef<ImmutableTextSnapshotRef> Snaps,
+    SwiftASTManager::ASTPriority Priority,
     std::function<void(ASTUnitRef Unit, StringRef Error)> Receiver) {
 
   ASTProducerRef ThisProducer = this;
   SmallVector<ImmutableTextSnapshotRef, 4> Snapshots;
   Snapshots.append(Snaps.begin(), Snaps.end());
 
-  Mgr->Impl.ASTBuildQueue.dispatch(
+  WorkQueue &BuildQueue =
+      Priority == SwiftASTManager::ASTPriority::Interactive
+          ? Mgr->Impl.InteractiveASTBuildQueue
+          : Mgr->Impl.ASTBuildQueue;
+  BuildQueue.dispatch(
       [ThisProducer, Mgr, fileSystem, Snapshots, Receiver] {
         std::string Error;
         ASTUnitRef Unit = ThisProducer->getASTUnitImpl(Mgr->Impl, fileSystem,
@@ -632,6 +648,9 @@ ASTUnitRef ASTProducer::getASTUnitImpl(
     SwiftASTManager::Implementation &MgrImpl,
     llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> fileSystem,
     ArrayRef<ImmutableTextSnapshotRef> Snapshots, std::string &Error) {
+  // The interactive and background build queues may request the same AST
+  // concurrently; build it only once.
+  llvm::sys::ScopedLock BuildL(BuildMtx);
   if (!AST || shouldRebuild(MgrImpl, fileSystem, Snapshots)) {
     bool IsRebuild = AST != nullptr;
     const InvocationOptions &Opts = InvokRef->Impl.Opts;
@@ -89,6 +89,19 @@ typedef std::shared_ptr<SwiftASTConsumer> SwiftASTConsumerRef;
 
 class SwiftASTManager : public std::enable_shared_from_this<SwiftASTManager> {
 public:
+  /// Scheduling class for an AST request.
+  ///
+  /// Interactive requests are serviced on a separate, higher-priority build
+  /// queue so that they are not queued behind slow batch work such as
+  /// indexing or doc-info. An in-flight batch build is not interrupted; the
+  /// two classes simply build concurrently.
+  enum class ASTPriority {
+    /// Editor-interactive requests (cursor-info, related-idents, etc.).
+    Interactive,
+    /// Batch requests (indexing, doc-info) and anything latency-tolerant.
+    Background,
+  };
+
   explicit SwiftASTManager(std::shared_ptr<SwiftEditorDocumentFileMap>,
                            std::shared_ptr<GlobalConfig> Config,
                            std::shared_ptr<SwiftStatistics> Stats,
@@ -111,10 +124,13 @@ public:
   /// \param OncePerASTToken if non-null, a previous query with the same value
   /// token, that is enqueued waiting to be executed on the same AST, will be
   /// cancelled.
+  /// \param Priority determines which build queue services the request; see
+  /// \c ASTPriority.
   void
   processASTAsync(SwiftInvocationRef Invok, SwiftASTConsumerRef ASTConsumer,
                   const void *OncePerASTToken,
                   llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> fileSystem,
+                  ASTPriority Priority = ASTPriority::Background,
                   ArrayRef<ImmutableTextSnapshotRef> Snapshots =
                       ArrayRef<ImmutableTextSnapshotRef>());
 
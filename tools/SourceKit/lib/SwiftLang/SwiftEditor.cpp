@@ -694,7 +694,7 @@ public:
     DiagConsumer.setInputBufferIDs(BufferID);
 
     if (CompInv.getLangOptions().BuildSyntaxTree) {
-      RC<SyntaxArena> syntaxArena{new syntax::SyntaxArena()};
+      RC<SyntaxArena> syntaxArena = syntax::SyntaxArena::make();
       SynTreeCreator = std::make_shared<SyntaxTreeCreator>(
           SM, BufferID, CompInv.getMainFileSyntaxParsingCache(), syntaxArena);
     }
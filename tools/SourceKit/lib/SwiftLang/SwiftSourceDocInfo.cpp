@@ -1482,8 +1482,9 @@ static void resolveCursor(
   const void *Once = nullptr;
   if (CancelOnSubsequentRequest)
     Once = Actionables ? &OncePerASTTokenWithActionables : &OncePerASTToken;
-  Lang.getASTManager()->processASTAsync(Invok, std::move(Consumer), Once,
-                                        fileSystem);
+  Lang.getASTManager()->processASTAsync(
+      Invok, std::move(Consumer), Once, fileSystem,
+      SwiftASTManager::ASTPriority::Interactive);
 }
 
 static void resolveName(SwiftLangSupport &Lang, StringRef InputFile,
@@ -1581,8 +1582,9 @@ static void resolveName(SwiftLangSupport &Lang, StringRef InputFile,
   auto Consumer = std::make_shared<NameInfoConsumer>(
     InputFile, Offset, Lang, Invok, TryExistingAST, Input, Receiver);
 
-  Lang.getASTManager()->processASTAsync(Invok, std::move(Consumer), nullptr,
-                                        llvm::vfs::getRealFileSystem());
+  Lang.getASTManager()->processASTAsync(
+      Invok, std::move(Consumer), nullptr, llvm::vfs::getRealFileSystem(),
+      SwiftASTManager::ASTPriority::Interactive);
 }
 
 static void resolveRange(SwiftLangSupport &Lang,
@@ -1670,8 +1672,9 @@ static void resolveRange(SwiftLangSupport &Lang,
   /// don't use 'OncePerASTToken'.
   static const char OncePerASTToken = 0;
   const void *Once = CancelOnSubsequentRequest ? &OncePerASTToken : nullptr;
-  Lang.getASTManager()->processASTAsync(Invok, std::move(Consumer), Once,
-                                        llvm::vfs::getRealFileSystem());
+  Lang.getASTManager()->processASTAsync(
+      Invok, std::move(Consumer), Once, llvm::vfs::getRealFileSystem(),
+      SwiftASTManager::ASTPriority::Interactive);
 }
 
 void SwiftLangSupport::getCursorInfo(
@@ -1917,8 +1920,9 @@ static void resolveCursorFromUSR(
   /// don't use 'OncePerASTToken'.
   static const char OncePerASTToken = 0;
   const void *Once = CancelOnSubsequentRequest ? &OncePerASTToken : nullptr;
-  Lang.getASTManager()->processASTAsync(Invok, std::move(Consumer), Once,
-                                        fileSystem);
+  Lang.getASTManager()->processASTAsync(
+      Invok, std::move(Consumer), Once, fileSystem,
+      SwiftASTManager::ASTPriority::Interactive);
 }
 
 void SwiftLangSupport::getCursorInfoFromUSR(
@@ -2164,7 +2168,8 @@ void SwiftLangSupport::findRelatedIdentifiersInFile(
   static const char OncePerASTToken = 0;
   const void *Once = CancelOnSubsequentRequest ? &OncePerASTToken : nullptr;
   ASTMgr->processASTAsync(Invok, std::move(Consumer), Once,
-                          llvm::vfs::getRealFileSystem());
+                          llvm::vfs::getRealFileSystem(),
+                          SwiftASTManager::ASTPriority::Interactive);
 }
 
 //===----------------------------------------------------------------------===//
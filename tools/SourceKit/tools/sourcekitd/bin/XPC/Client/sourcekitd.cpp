@@ -415,9 +415,13 @@ static void updateSemanticEditorDelay() {
   gPrevCrashTime = CurrTime;
 
   auto Diff = duration_cast<seconds>(CurrTime - PrevTime);
+  if (Diff.count() > 30) {
+    // Treat this as more likely unrelated to the previous crash; let the
+    // restored service resume semantic functionality immediately instead of
+    // penalizing a one-off crash with a sema-disabled window.
+    return;
+  }
   size_t Delay = Diff.count()*2 + 1;
-  if (Diff.count() > 30)
-    Delay = 0; // Treat this as more likely unrelated to the previous crash.
   Delay = std::min(std::max(Delay, MinDelaySeconds), MaxDelaySeconds);
 
   LOG_WARN_FUNC("disabling semantic editor for " << Delay << " seconds");
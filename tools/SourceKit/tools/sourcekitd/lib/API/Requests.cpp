@@ -2852,7 +2852,17 @@ void serializeSyntaxTreeAsByteTree(
   auto StartClock = clock();
   // Serialize the syntax tree as a ByteTree
   auto Stream = swift::ExponentialGrowthAppendingBinaryByteStream();
-  Stream.reserve(32 * 1024);
+  // The ByteTree encoding of a tree is roughly an order of magnitude larger
+  // than the source it was parsed from, since every token pays a few field
+  // headers on top of its text and trivia. When transferring the full tree,
+  // sizing the stream from the source length up front spares it from being
+  // copied through a series of exponential regrowths; 32KB covers typical
+  // incremental trees, where reused nodes are omitted.
+  size_t ReserveSize = 32 * 1024;
+  if (ReusedNodeIds.empty())
+    ReserveSize = std::max(ReserveSize,
+                           SyntaxTree.getRaw()->getTextLength() * 16);
+  Stream.reserve(ReserveSize);
   std::map<void *, void *> UserInfo;
   UserInfo[swift::byteTree::UserInfoKeyReusedNodeIds] = &ReusedNodeIds;
   swift::byteTree::ByteTreeWriter::write(Stream,
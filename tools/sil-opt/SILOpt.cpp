@@ -27,20 +27,25 @@
 #include "swift/SILOptimizer/Analysis/Analysis.h"
 #include "swift/SILOptimizer/PassManager/Passes.h"
 #include "swift/SILOptimizer/PassManager/PassManager.h"
+#include "swift/SILOptimizer/PassManager/Transforms.h"
 #include "swift/Serialization/SerializedModuleLoader.h"
 #include "swift/Serialization/SerializedSILLoader.h"
 #include "swift/Serialization/SerializationOptions.h"
 #include "swift/IRGen/IRGenPublic.h"
 #include "swift/IRGen/IRGenSILPasses.h"
+#include "llvm/ADT/MapVector.h"
 #include "llvm/ADT/Statistic.h"
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/FileSystem.h"
+#include "llvm/Support/FormatVariadic.h"
+#include "llvm/Support/JSON.h"
 #include "llvm/Support/ManagedStatic.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/Signals.h"
 #include "llvm/Support/TargetSelect.h"
 #include "llvm/Support/YAMLTraits.h"
+#include <algorithm>
 #include <cstdio>
 using namespace swift;
 
@@ -299,6 +304,36 @@ static llvm::cl::opt<bool>
                        llvm::cl::desc("Ignore [always_inline] attribute."),
                        llvm::cl::init(false));
 
+static llvm::cl::opt<std::string> ExternalPassPipelineFilename(
+    "external-pass-pipeline-filename",
+    llvm::cl::desc("Use an external pass pipeline description in yaml format "
+                   "(e.g. as emitted by sil-passpipeline-dumper) instead of "
+                   "the passes selected on the command line"),
+    llvm::cl::value_desc("filename"));
+
+static llvm::cl::opt<unsigned> BenchmarkIterations(
+    "benchmark-iterations", llvm::cl::init(0),
+    llvm::cl::desc("Run the selected pipeline over freshly lowered copies of "
+                   "the input the given number of times and report per-pass "
+                   "execution times as JSON instead of emitting SIL "
+                   "(0 = disabled)"));
+
+static llvm::cl::opt<unsigned> BenchmarkWarmup(
+    "benchmark-warmup", llvm::cl::init(1),
+    llvm::cl::desc("Number of unmeasured warmup runs before benchmarking"));
+
+static llvm::cl::opt<std::string> BenchmarkComparePipeline(
+    "benchmark-compare-pipeline",
+    llvm::cl::desc("Additionally benchmark the pass pipeline described in the "
+                   "given yaml file and report per-pass deltas against the "
+                   "primary pipeline"),
+    llvm::cl::value_desc("filename"));
+
+static llvm::cl::opt<std::string> BenchmarkOutput(
+    "benchmark-output", llvm::cl::init("-"),
+    llvm::cl::desc("Output file for the benchmark JSON report"),
+    llvm::cl::value_desc("filename"));
+
 static void runCommandLineSelectedPasses(SILModule *Module,
                                          irgen::IRGenModule *IRGenMod) {
   auto &opts = Module->getOptions();
@@ -310,6 +345,174 @@ static void runCommandLineSelectedPasses(SILModule *Module,
     Module->verify();
 }
 
+/// Run the passes selected by the command line options over \p SILMod: the
+/// pipeline description in \p pipelineFile if it is non-empty, one of the
+/// predefined optimization groups, or the individually selected passes.
+static void runSelectedPasses(SILModule *SILMod,
+                              CompilerInvocation &Invocation,
+                              StringRef pipelineFile) {
+  if (!pipelineFile.empty()) {
+    runSILOptimizationPassesWithFileSpecification(*SILMod, pipelineFile);
+    return;
+  }
+
+  switch (OptimizationGroup) {
+  case OptGroup::Diagnostics:
+    runSILDiagnosticPasses(*SILMod);
+    break;
+  case OptGroup::Performance:
+    runSILOptimizationPasses(*SILMod);
+    break;
+  case OptGroup::Lowering:
+    runSILLoweringPasses(*SILMod);
+    break;
+  case OptGroup::OnonePerformance:
+    runSILPassesForOnone(*SILMod);
+    break;
+  case OptGroup::Unknown: {
+    auto T = irgen::createIRGenModule(
+        SILMod, Invocation.getOutputFilenameForAtMostOnePrimary(),
+        Invocation.getMainInputFilenameForDebugInfoForAtMostOnePrimary(), "");
+    runCommandLineSelectedPasses(SILMod, T.second);
+    irgen::deleteIRGenModule(T);
+    break;
+  }
+  }
+}
+
+namespace {
+
+/// Execution times collected while benchmarking one pipeline specification:
+/// for every pass ID, the summed time of its runs within each measured
+/// iteration, in nanoseconds.
+struct PipelineTimings {
+  llvm::MapVector<StringRef, std::vector<int64_t>> passTimes;
+  std::vector<int64_t> iterationTotals;
+};
+
+} // end anonymous namespace
+
+/// Return the median of \p values (the upper median for even counts).
+static int64_t median(std::vector<int64_t> values) {
+  assert(!values.empty() && "no samples measured");
+  std::sort(values.begin(), values.end());
+  return values[values.size() / 2];
+}
+
+/// Lower a fresh copy of the input and run the pipeline selected by
+/// \p pipelineFile (or the command line) over it, repeated for the requested
+/// warmup and measurement iterations, collecting per-pass execution times.
+static PipelineTimings benchmarkPipeline(CompilerInstance &CI,
+                                         CompilerInvocation &Invocation,
+                                         StringRef pipelineFile) {
+  PipelineTimings timings;
+  auto *mod = CI.getMainModule();
+  for (unsigned i = 0, e = BenchmarkWarmup + BenchmarkIterations; i != e;
+       ++i) {
+    // Both the AST lowering and SIL parsing requests are uncached, so every
+    // round trips through the same input and yields an identical fresh
+    // module for the pipeline to consume.
+    std::unique_ptr<SILModule> SILMod;
+    if (PerformWMO) {
+      SILMod = performASTLowering(mod, CI.getSILTypes(), CI.getSILOptions());
+    } else {
+      SILMod = performASTLowering(*mod->getFiles()[0], CI.getSILTypes(),
+                                  CI.getSILOptions());
+    }
+    SILMod->setSerializeSILAction([]{});
+
+    bool measured = i >= BenchmarkWarmup;
+    if (measured) {
+      unsigned iteration = i - BenchmarkWarmup;
+      setSILPassExecutionTimeCallback(
+          [&timings, iteration](SILTransform *transform,
+                                int64_t nanoseconds) {
+            auto &samples = timings.passTimes[transform->getID()];
+            samples.resize(BenchmarkIterations, 0);
+            samples[iteration] += nanoseconds;
+          });
+    }
+    llvm::sys::TimePoint<> startTime = std::chrono::system_clock::now();
+    runSelectedPasses(SILMod.get(), Invocation, pipelineFile);
+    if (measured) {
+      timings.iterationTotals.push_back(
+          (std::chrono::system_clock::now() - startTime).count());
+      setSILPassExecutionTimeCallback(nullptr);
+    }
+  }
+  return timings;
+}
+
+/// Serialize the timing report for one benchmarked pipeline.
+static llvm::json::Object reportTimings(const PipelineTimings &timings) {
+  llvm::json::Array passes;
+  for (const auto &entry : timings.passTimes) {
+    const std::vector<int64_t> &samples = entry.second;
+    llvm::json::Object pass;
+    pass["pass"] = entry.first;
+    pass["median-ns"] = median(samples);
+    pass["min-ns"] = *std::min_element(samples.begin(), samples.end());
+    pass["max-ns"] = *std::max_element(samples.begin(), samples.end());
+    passes.push_back(std::move(pass));
+  }
+  llvm::json::Object report;
+  report["passes"] = std::move(passes);
+  report["median-total-ns"] = median(timings.iterationTotals);
+  return report;
+}
+
+/// Report the per-pass median deltas of \p candidate against \p baseline,
+/// for the passes appearing in both pipelines.
+static llvm::json::Array diffTimings(const PipelineTimings &baseline,
+                                     const PipelineTimings &candidate) {
+  llvm::json::Array deltas;
+  for (const auto &entry : candidate.passTimes) {
+    auto base = baseline.passTimes.find(entry.first);
+    if (base == baseline.passTimes.end())
+      continue;
+    int64_t baselineMedian = median(base->second);
+    int64_t candidateMedian = median(entry.second);
+    llvm::json::Object delta;
+    delta["pass"] = entry.first;
+    delta["baseline-median-ns"] = baselineMedian;
+    delta["candidate-median-ns"] = candidateMedian;
+    delta["delta-pct"] = baselineMedian
+        ? 100.0 * double(candidateMedian - baselineMedian) / baselineMedian
+        : 0.0;
+    deltas.push_back(std::move(delta));
+  }
+  return deltas;
+}
+
+/// Implements -benchmark-iterations: benchmark the selected pipeline, and
+/// with -benchmark-compare-pipeline a second pipeline description, then
+/// write the JSON report. Returns true on error.
+static bool benchmarkSelectedPasses(CompilerInstance &CI,
+                                    CompilerInvocation &Invocation) {
+  llvm::json::Object report;
+  report["iterations"] = int64_t(unsigned(BenchmarkIterations));
+  report["warmup"] = int64_t(unsigned(BenchmarkWarmup));
+  PipelineTimings baseline =
+      benchmarkPipeline(CI, Invocation, ExternalPassPipelineFilename);
+  report["baseline"] = reportTimings(baseline);
+  if (!BenchmarkComparePipeline.empty()) {
+    PipelineTimings candidate =
+        benchmarkPipeline(CI, Invocation, BenchmarkComparePipeline);
+    report["candidate"] = reportTimings(candidate);
+    report["deltas"] = diffTimings(baseline, candidate);
+  }
+
+  std::error_code EC;
+  llvm::raw_fd_ostream OS(BenchmarkOutput, EC, llvm::sys::fs::F_None);
+  if (EC) {
+    llvm::errs() << "while opening '" << BenchmarkOutput
+                 << "': " << EC.message() << '\n';
+    return true;
+  }
+  OS << llvm::formatv("{0:2}", llvm::json::Value(std::move(report))) << '\n';
+  return false;
+}
+
 // This function isn't referenced outside its translation unit, but it
 // can't use the "static" keyword because its address is used for
 // getMainExecutable (since some platforms don't support taking the
@@ -513,29 +716,16 @@ int main(int argc, char **argv) {
     SILMod->installSILRemarkStreamer();
   }
 
-  switch (OptimizationGroup) {
-  case OptGroup::Diagnostics:
-    runSILDiagnosticPasses(*SILMod.get());
-    break;
-  case OptGroup::Performance:
-    runSILOptimizationPasses(*SILMod.get());
-    break;
-  case OptGroup::Lowering:
-    runSILLoweringPasses(*SILMod.get());
-    break;
-  case OptGroup::OnonePerformance:
-    runSILPassesForOnone(*SILMod.get());
-    break;
-  case OptGroup::Unknown: {
-    auto T = irgen::createIRGenModule(
-        SILMod.get(), Invocation.getOutputFilenameForAtMostOnePrimary(),
-        Invocation.getMainInputFilenameForDebugInfoForAtMostOnePrimary(), "");
-    runCommandLineSelectedPasses(SILMod.get(), T.second);
-    irgen::deleteIRGenModule(T);
-    break;
-  }
+  if (BenchmarkIterations > 0) {
+    // Benchmark mode runs the pipeline over fresh copies of the input and
+    // reports timings instead of emitting the transformed SIL.
+    bool benchmarkError = benchmarkSelectedPasses(CI, Invocation);
+    return finishDiagProcessing(benchmarkError ||
+                                CI.getASTContext().hadError());
   }
 
+  runSelectedPasses(SILMod.get(), Invocation, ExternalPassPipelineFilename);
+
   if (EmitSIB) {
     llvm::SmallString<128> OutputFile;
     if (OutputFilename.size()) {
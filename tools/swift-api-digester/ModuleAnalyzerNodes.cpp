@@ -1,3 +1,4 @@
+#include "llvm/ADT/Hashing.h"
 #include "llvm/ADT/STLExtras.h"
 #include "swift/SIL/SILDeclRef.h"
 #include <ModuleAnalyzerNodes.h>
@@ -250,6 +251,7 @@ uint8_t SDKNode::getJsonFormatVersion() const {
 void SDKNode::addChild(SDKNode *Child) {
   Child->Parent = this;
   Children.push_back(Child);
+  invalidateContentHash();
   if (auto *Root = dyn_cast<SDKNodeRoot>(this)) {
     struct DeclCollector: public SDKNodeVisitor {
       SDKNodeRoot &Root;
@@ -269,6 +271,7 @@ NodePtr SDKNode::childAt(unsigned I) const {
 
 void SDKNode::removeChild(NodePtr C) {
   Children.erase(std::find(Children.begin(), Children.end(), C));
+  invalidateContentHash();
 }
 
 void SDKNode::annotate(NodeAnnotation Anno, StringRef Comment) {
@@ -494,16 +497,19 @@ SDKNodeDecl *SDKNodeType::getClosestParentDecl() const {
 void SDKNodeDeclType::addConformance(SDKNode *Conf) {
   cast<SDKNodeConformance>(Conf)->TypeDecl = this;
   Conformances.push_back(Conf);
+  invalidateContentHash();
 }
 
 void SDKNodeDeclSubscript::addAccessor(SDKNode *AC) {
   cast<SDKNodeDeclAccessor>(AC)->Owner = this;
   Accessors.push_back(AC);
+  invalidateContentHash();
 }
 
 void SDKNodeDeclVar::addAccessor(SDKNode *AC) {
   cast<SDKNodeDeclAccessor>(AC)->Owner = this;
   Accessors.push_back(AC);
+  invalidateContentHash();
 }
 
 SDKNodeType *SDKNodeTypeWitness::getUnderlyingType() const {
@@ -804,7 +810,121 @@ static bool hasSameParameterFlags(const SDKNodeType *Left, const SDKNodeType *Ri
   return true;
 }
 
+void SDKNode::invalidateContentHash() {
+  for (SDKNode *N = this; N; N = N->getParent()) {
+    N->ContentHashComputed = false;
+    N->ContentHash = None;
+  }
+}
+
+/// Combine the hashes of a node set that is compared order-insensitively
+/// (accessors, conformances), or return None if any member is unhashable.
+static Optional<uint64_t> hashNodeSet(ArrayRef<SDKNode*> Nodes) {
+  uint64_t Sum = 0;
+  for (auto *N : Nodes) {
+    auto H = N->getContentHash();
+    if (!H.hasValue())
+      return None;
+    Sum += *H;
+  }
+  return Sum;
+}
+
+Optional<uint64_t> SDKNode::getContentHash() const {
+  if (ContentHashComputed)
+    return ContentHash;
+  ContentHashComputed = true;
+  ContentHash = None;
+
+  // In source-compat mode two types can compare equal under different
+  // printed names, and aliases compare through their underlying type,
+  // possibly against non-alias nodes. Neither can be hashed faithfully, so
+  // the fast path stays disabled for them.
+  if (!Ctx.checkingABI() || isa<SDKNodeTypeAlias>(this))
+    return ContentHash;
+
+  llvm::hash_code Code =
+      llvm::hash_combine(unsigned(getKind()), getPrintedName());
+
+  if (auto *T = dyn_cast<SDKNodeType>(this)) {
+    // Attributes are compared as sets; hash them in sorted order.
+    std::set<TypeAttrKind> Attrs(T->getTypeAttributes().begin(),
+                                 T->getTypeAttributes().end());
+    for (auto Attr : Attrs)
+      Code = llvm::hash_combine(Code, unsigned(Attr));
+    Code = llvm::hash_combine(Code, T->hasDefaultArgument(),
+                              T->getParamValueOwnership());
+  }
+  if (auto *D = dyn_cast<SDKNodeDecl>(this)) {
+    std::set<DeclAttrKind> Attrs(D->getDeclAttributes().begin(),
+                                 D->getDeclAttributes().end());
+    for (auto Attr : Attrs)
+      Code = llvm::hash_combine(Code, unsigned(Attr));
+    Code = llvm::hash_combine(
+        Code, D->isStatic(), unsigned(D->getReferenceOwnership()),
+        D->getGenericSignature(), D->isOpen(), D->isInternal(),
+        D->getObjCName(),
+        D->hasFixedBinaryOrder() ? int(D->getFixedBinaryOrder()) : -1);
+  }
+  if (auto *F = dyn_cast<SDKNodeDeclFunction>(this))
+    Code = llvm::hash_combine(Code, F->getSelfAccessKind());
+  // Throwing and witness-table-entry state is only compared for functions
+  // and constructors, not for the other abstract-function kinds.
+  if (getKind() == SDKNodeKind::DeclFunction ||
+      getKind() == SDKNodeKind::DeclConstructor) {
+    auto *AF = getAs<SDKNodeDeclAbstractFunc>();
+    Code = llvm::hash_combine(Code, AF->isThrowing(),
+                              AF->reqNewWitnessTableEntry());
+  }
+  if (auto *AC = dyn_cast<SDKNodeDeclAccessor>(this))
+    Code = llvm::hash_combine(Code, unsigned(AC->getAccessorKind()));
+  if (auto *V = dyn_cast<SDKNodeDeclVar>(this)) {
+    auto Acc = hashNodeSet(V->getAllAccessors());
+    if (!Acc.hasValue())
+      return ContentHash;
+    Code = llvm::hash_combine(Code, V->hasStorage(), *Acc);
+  }
+  if (auto *S = dyn_cast<SDKNodeDeclSubscript>(this)) {
+    auto Acc = hashNodeSet(S->getAllAccessors());
+    if (!Acc.hasValue())
+      return ContentHash;
+    Code = llvm::hash_combine(Code, *Acc);
+  }
+  if (auto *DT = dyn_cast<SDKNodeDeclType>(this)) {
+    auto Confs = hashNodeSet(DT->getConformances());
+    if (!Confs.hasValue())
+      return ContentHash;
+    Code = llvm::hash_combine(Code, *Confs, DT->getSuperClassName(),
+                              unsigned(DT->getDeclKind()));
+  }
+
+  // Children are compared in order. Type nodes are an exception: in ABI mode
+  // two types with the same printed name compare equal without looking at
+  // their children, so including children in their hash could wrongly
+  // separate equal nodes.
+  if (!isa<SDKNodeType>(this)) {
+    for (auto *Child : Children) {
+      auto H = Child->getContentHash();
+      if (!H.hasValue())
+        return ContentHash;
+      Code = llvm::hash_combine(Code, *H);
+    }
+  }
+
+  ContentHash = uint64_t(Code);
+  return ContentHash;
+}
+
 static bool isSDKNodeEqual(SDKContext &Ctx, const SDKNode &L, const SDKNode &R) {
+  // Different content hashes prove the two subtrees differ, without walking
+  // them. Matching or missing hashes fall through to the full comparison.
+  {
+    auto LH = L.getContentHash();
+    auto RH = R.getContentHash();
+    if (LH.hasValue() && RH.hasValue() && *LH != *RH)
+      return false;
+  }
+
   auto *LeftAlias = dyn_cast<SDKNodeTypeAlias>(&L);
   auto *RightAlias = dyn_cast<SDKNodeTypeAlias>(&R);
   if (LeftAlias || RightAlias) {
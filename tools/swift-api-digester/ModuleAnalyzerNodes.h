@@ -269,6 +269,11 @@ protected:
   std::set<NodeAnnotation> Annotations;
   std::map<NodeAnnotation, StringRef> AnnotateComments;
   NodePtr Parent = nullptr;
+  /// Lazily computed structural hash over the content the equality check
+  /// compares, including children. None when the node cannot be hashed
+  /// faithfully; see getContentHash().
+  mutable Optional<uint64_t> ContentHash;
+  mutable bool ContentHashComputed = false;
 protected:
   SDKNode(SDKNodeInitInfo Info, SDKNodeKind Kind);
   virtual ~SDKNode() = default;
@@ -279,6 +284,17 @@ public:
 
   bool operator==(const SDKNode &Other) const;
   bool operator!=(const SDKNode &Other) const { return !((*this) == Other); }
+
+  /// Return a structural hash covering everything the equality check
+  /// compares in ABI mode, or None when the node cannot be hashed faithfully
+  /// (type aliases compare through their underlying type, and source-compat
+  /// mode tolerates printed-name differences). Two nodes that compare equal
+  /// always hash equally, so differing hashes prove two subtrees differ
+  /// without walking them.
+  Optional<uint64_t> getContentHash() const;
+  /// Drop the cached hashes of this node and its ancestors after a mutation
+  /// that affects compared content.
+  void invalidateContentHash();
   void output(json::Output &out, KeyKind Key, bool Value);
   void output(json::Output &out, KeyKind Key, StringRef Value);
 
@@ -289,7 +305,10 @@ public:
   StringRef getName() const { return Name; }
   bool isNameValid() const { return Name != "_"; }
   StringRef getPrintedName() const { return PrintedName; }
-  void removeChild(ChildIt CI) { Children.erase(CI); }
+  void removeChild(ChildIt CI) {
+    Children.erase(CI);
+    invalidateContentHash();
+  }
   ChildIt getChildBegin() { return Children.begin(); }
   void annotate(NodeAnnotation Anno) { Annotations.insert(Anno); }
   void annotate(NodeAnnotation Anno, StringRef Comment);
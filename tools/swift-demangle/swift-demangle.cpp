@@ -74,6 +74,11 @@ static llvm::cl::opt<bool>
 Classify("classify",
            llvm::cl::desc("Display symbol classification characters"));
 
+static llvm::cl::opt<bool>
+BatchMode("batch",
+           llvm::cl::desc("Batch mode (read one mangled name per line from "
+                          "stdin instead of scanning lines for symbols)"));
+
 /// Options that are primarily used for testing.
 /// \{
 static llvm::cl::opt<bool> DisplayLocalNameContexts(
@@ -224,6 +229,22 @@ static void demangle(llvm::raw_ostream &os, llvm::StringRef name,
   DCtx.clear();
 }
 
+static int demangleBatchSTDIN(const swift::Demangle::DemangleOptions &options) {
+  // Each line is exactly one mangled name; skip the regex scan that the
+  // filter mode below does on every line. This path is meant for
+  // long-running symbolication pipelines that stream millions of symbols
+  // through a single process, so per-line overhead matters. The Context
+  // (and with it the demangler's node arena) is reused across all lines;
+  // demangle() resets it after each symbol.
+  swift::Demangle::Context DCtx;
+  for (std::string mangled; std::getline(std::cin, mangled);) {
+    demangle(llvm::outs(), mangled, DCtx, options);
+    llvm::outs() << '\n';
+  }
+
+  return EXIT_SUCCESS;
+}
+
 static int demangleSTDIN(const swift::Demangle::DemangleOptions &options) {
   // This doesn't handle Unicode symbols, but maybe that's okay.
   // Also accept the future mangling prefix.
@@ -264,7 +285,12 @@ int main(int argc, char **argv) {
   options.DisplayLocalNameContexts = DisplayLocalNameContexts;
 
   if (InputNames.empty()) {
+    // Don't sync std::getline with C stdio; stdin inputs commonly run to
+    // millions of lines.
+    std::ios::sync_with_stdio(false);
     CompactMode = true;
+    if (BatchMode)
+      return demangleBatchSTDIN(options);
     return demangleSTDIN(options);
   } else {
     swift::Demangle::Context DCtx;
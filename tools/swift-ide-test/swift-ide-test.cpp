@@ -1598,7 +1598,7 @@ static int doSyntaxColoring(const CompilerInvocation &InitInvok,
     SourceManager SM;
     unsigned BufferID = SM.addNewSourceBuffer(std::move(FileBuf));
 
-    RC<SyntaxArena> syntaxArena{new syntax::SyntaxArena()};
+    RC<SyntaxArena> syntaxArena = syntax::SyntaxArena::make();
     std::shared_ptr<SyntaxTreeCreator> SynTreeCreator =
         std::make_shared<SyntaxTreeCreator>(
             SM, BufferID, Invocation.getMainFileSyntaxParsingCache(),
@@ -1832,7 +1832,7 @@ static int doStructureAnnotation(const CompilerInvocation &InitInvok,
   SourceManager SM;
   unsigned BufferID = SM.addNewSourceBuffer(std::move(FileBuf));
 
-  RC<SyntaxArena> syntaxArena{new syntax::SyntaxArena()};
+  RC<SyntaxArena> syntaxArena = syntax::SyntaxArena::make();
   std::shared_ptr<SyntaxTreeCreator> SynTreeCreator =
       std::make_shared<SyntaxTreeCreator>(
           SM, BufferID, Invocation.getMainFileSyntaxParsingCache(),
@@ -126,6 +126,11 @@ func makeReflectionContext(
     argFail("Failed to create reflection context")
   }
 
+  // The dumps below take a point-in-time snapshot of the target, so serve
+  // repeated reads of the same remote pages from a local cache rather than
+  // issuing a mach call per read.
+  swift_reflection_setCacheRemoteReads(reflectionContext, 1)
+
   return (inspector, reflectionContext)
 }
 
@@ -12,6 +12,7 @@
 
 #include "swift/Basic/Cache.h"
 #include "gtest/gtest.h"
+#include <cstdlib>
 
 #if defined(__APPLE__)
 #define USES_LIBCACHE 1
@@ -49,6 +50,36 @@ struct CacheValueInfo<Counter>{
 }
 }
 
+namespace {
+struct CostlyCounter {
+  mutable int enter = 0;
+  mutable int exit = 0;
+};
+}
+
+namespace swift {
+namespace sys {
+template <>
+struct CacheValueInfo<CostlyCounter>{
+  static void *enterCache(const CostlyCounter &value) {
+    return const_cast<CostlyCounter *>(&value);
+  }
+  static void retain(void *ptr) {
+    static_cast<CostlyCounter*>(ptr)->enter+= 1;
+  }
+  static void release(void *ptr) {
+    static_cast<CostlyCounter*>(ptr)->exit += 1;
+  }
+  static const CostlyCounter &getFromCache(void *ptr) {
+    return *static_cast<CostlyCounter *>(ptr);
+  }
+  static size_t getCost(const CostlyCounter &value) {
+    return 1;
+  }
+};
+}
+}
+
 namespace {
 struct KeyCounter {
   int key = 0;
@@ -92,6 +123,43 @@ struct RefCntToken : llvm::RefCountedBase<RefCntToken> {
   RefCntToken(bool &freed) : freed(freed) {}
   ~RefCntToken() { freed = true; }
 };
+
+/// Exposes the low-level retain/release interface of CacheImpl, which the
+/// Cache wrapper hides, to test value lifetime management directly.  Keys
+/// are pointers to ints owned by the test; values are pointers to Counters.
+struct RawCache : swift::sys::CacheImpl {
+  RawCache() {
+    CallBacks CBs = {
+      /*UserData=*/nullptr,
+      keyHash,
+      keyIsEqual,
+      keyDestroy,
+      valueRetain,
+      valueRelease,
+    };
+    Impl = create("RawCache", CBs);
+  }
+  ~RawCache() { destroy(); }
+
+  using CacheImpl::setAndRetain;
+  using CacheImpl::getAndRetain;
+  using CacheImpl::releaseValue;
+  using CacheImpl::remove;
+
+  static uintptr_t keyHash(void *Key, void *) {
+    return llvm::DenseMapInfo<int>::getHashValue(*static_cast<int *>(Key));
+  }
+  static bool keyIsEqual(void *Key1, void *Key2, void *) {
+    return *static_cast<int *>(Key1) == *static_cast<int *>(Key2);
+  }
+  static void keyDestroy(void *Key, void *) {}
+  static void valueRetain(void *Value, void *) {
+    static_cast<Counter *>(Value)->enter += 1;
+  }
+  static void valueRelease(void *Value, void *) {
+    static_cast<Counter *>(Value)->exit += 1;
+  }
+};
 }
 
 TEST(Cache, sameKey) {
@@ -215,6 +283,61 @@ TEST(Cache, sameKeyValueIntrusiveRefCountPter) {
   EXPECT_TRUE(freed);
 }
 
+#if !USES_LIBCACHE && !defined(_WIN32)
+TEST(Cache, costLimitEviction) {
+  // The default backend only evicts when a cost budget is configured; it
+  // reads the budget when the cache is created.
+  setenv("SWIFT_CACHE_COST_LIMIT", "1", /*overwrite=*/1);
+  {
+    CostlyCounter values[100];
+    swift::sys::Cache<int, CostlyCounter> cache(__func__);
+    for (int i = 0; i < 100; ++i) {
+      cache.set(i, values[i]);
+      // A value is always retrievable right after it was stored, even though
+      // its cost exceeds the budget.
+      EXPECT_TRUE(cache.get(i).hasValue());
+    }
+
+    int evicted = 0;
+    for (int i = 0; i < 100; ++i) {
+      if (values[i].exit == 0) {
+        EXPECT_TRUE(cache.get(i).hasValue());
+      } else {
+        EXPECT_EQ(1, values[i].exit);
+        EXPECT_FALSE(cache.get(i).hasValue());
+        evicted += 1;
+      }
+    }
+    // The cache keeps at most one entry per shard (currently 16 shards).
+    EXPECT_GE(evicted, 84);
+  }
+  unsetenv("SWIFT_CACHE_COST_LIMIT");
+}
+#endif
+
+#if !USES_LIBCACHE
+TEST(Cache, deferredReleaseSurvivesReinsert) {
+  Counter c;
+  int key = 1;
+  RawCache cache;
+
+  cache.setAndRetain(&key, &c, 0);
+  // Removing the entry while the client retain from setAndRetain() is still
+  // outstanding defers the final release.
+  cache.remove(&key);
+  EXPECT_EQ(1, c.enter);
+  EXPECT_EQ(0, c.exit);
+
+  // Re-inserting the same value must settle the deferred release rather
+  // than lose it.
+  cache.setAndRetain(&key, &c, 0);
+  cache.releaseValue(&c);
+  cache.releaseValue(&c);
+  cache.remove(&key);
+  EXPECT_EQ(c.enter, c.exit);
+}
+#endif
+
 TEST(Cache, copyValue) {
   struct S {
     int ident, copy;
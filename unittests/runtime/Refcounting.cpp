@@ -13,9 +13,16 @@
 #include "swift/Runtime/HeapObject.h"
 #include "swift/Runtime/Metadata.h"
 #include "gtest/gtest.h"
+#include "ThreadingHelpers.h"
 
 using namespace swift;
 
+// A fake definition of Swift runtime's WeakReference.
+// This has the proper size and alignment which is all we need.
+namespace swift {
+class WeakReference { void *value __attribute__((unused)); };
+}
+
 struct TestObject : HeapObject {
   constexpr TestObject(HeapMetadata const *newMetadata)
     : HeapObject(newMetadata, InlineRefCounts::Immortal)
@@ -272,3 +279,63 @@ TEST(RefcountingTest, immortal_retain_release) {
     EXPECT_EQ(initialBitsValue, ImmortalTestObject.refCounts.getBitsValue());
   }
 }
+
+// Weak loads never take a lock: concurrent readers only retry a
+// compare-and-swap on the side table's reference counts, so any number
+// of them may race each other and the object's deallocation. Pin that
+// down by hammering a single weak variable from many threads.
+TEST(RefcountingTest, concurrent_weak_load) {
+  const int threadCount = 8;
+  const int loadsPerThread = 10000;
+
+  size_t value = 0;
+  auto object = allocTestObject(&value, 1);
+  WeakReference ref;
+  swift_weakInit(&ref, object);
+
+  threadedExecute(threadCount, [&](int) {
+    for (int i = 0; i < loadsPerThread; i++) {
+      auto loaded = swift_weakLoadStrong(&ref);
+      EXPECT_EQ(object, loaded);
+      swift_release(loaded);
+    }
+  });
+
+  EXPECT_EQ(0u, value);
+  swift_release(object);
+  EXPECT_EQ(1u, value);
+  EXPECT_EQ(nullptr, swift_weakLoadStrong(&ref));
+  swift_weakDestroy(&ref);
+}
+
+// Race weak loads against the release of the object's last strong
+// reference. Every load must observe either the fully live object or
+// null, and the loads themselves must not extend the object's life
+// beyond their own retains.
+TEST(RefcountingTest, concurrent_weak_load_during_deallocation) {
+  const int readerCount = 7;
+  const int maxLoadsPerReader = 100000;
+
+  size_t value = 0;
+  auto object = allocTestObject(&value, 1);
+  WeakReference ref;
+  swift_weakInit(&ref, object);
+
+  threadedExecute(readerCount + 1, [&](int i) {
+    if (i == 0) {
+      swift_release(object);
+      return;
+    }
+    for (int j = 0; j < maxLoadsPerReader; j++) {
+      auto loaded = swift_weakLoadStrong(&ref);
+      if (!loaded)
+        break;
+      EXPECT_EQ(object, loaded);
+      swift_release(loaded);
+    }
+  });
+
+  EXPECT_EQ(1u, value);
+  EXPECT_EQ(nullptr, swift_weakLoadStrong(&ref));
+  swift_weakDestroy(&ref);
+}
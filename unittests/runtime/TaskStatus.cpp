@@ -137,6 +137,53 @@ TEST(TaskStatusTest, cancellation_simple) {
   });
 }
 
+SWIFT_CC(swift)
+static void emptyTaskInvokeFunction(AsyncTask *task, ExecutorRef executor,
+                                    AsyncContext *context) {
+  // Return to finish off the task.
+  context->ResumeParent(task, executor, context->Parent);
+}
+
+TEST(TaskStatusTest, cancellation_broadcastToChild) {
+  struct Storage { int value; };
+  withSimpleTask(Storage{47},
+    [&](AsyncTask *task, ExecutorRef executor,
+        ValueContext<Storage> *context) {
+    // Create a child task, which we'll run to completion at the end.
+    JobFlags childFlags(JobKind::Task, JobPriority::Background);
+    childFlags.task_setIsChildTask(true);
+    auto childTaskAndContext =
+      swift_task_create_f(childFlags, task, &emptyTaskInvokeFunction,
+                          sizeof(AsyncContext));
+    auto childTask = childTaskAndContext.Task;
+
+    ChildTaskStatusRecord childRecord(childTask);
+    bool result = swift_task_addStatusRecord(task, &childRecord);
+    EXPECT_TRUE(result);
+
+    // Escalating the parent escalates the child.
+    EXPECT_EQ(JobPriority::Background, childTask->Flags.getPriority());
+    swift_task_escalate(task, JobPriority::Default);
+    EXPECT_EQ(JobPriority::Default, childTask->Flags.getPriority());
+
+    // Cancelling the parent cancels the child, and both are visible
+    // to the wait-free check.
+    EXPECT_FALSE(swift_task_isCancelled(task));
+    EXPECT_FALSE(swift_task_isCancelled(childTask));
+    swift_task_cancel(task);
+    EXPECT_TRUE(swift_task_isCancelled(task));
+    EXPECT_TRUE(swift_task_isCancelled(childTask));
+
+    result = swift_task_removeStatusRecord(task, &childRecord);
+    EXPECT_FALSE(result);
+
+    // Run the child to completion, releasing it.
+    childTask->run(executor);
+  }, [&](AsyncTask *task) {
+    task->run(createFakeExecutor(1234));
+  });
+}
+
 // Test basic deadline mechanics (other than actually setting up
 // something to cancel the task).  Also tests adding and removing
 // records quite a bit.